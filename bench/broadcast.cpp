@@ -0,0 +1,333 @@
+#include "../include/client.hpp"
+#include "../include/latencyHistogram.hpp"
+#include "../include/server.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Represents the options of a benchmark run.
+ * @version 1.0.0
+ */
+struct BenchmarkOptions
+{
+    std::string mode        = "shared";
+    std::string policy      = "drop";
+    std::string label       = "";
+    size_t      subscribers = 64;
+    size_t      slow        = 2;
+    size_t      payloadSize = 4096;
+    size_t      queueLimit  = 1 << 20;
+    int         rate        = 2000;
+    int         seconds     = 5;
+    int         port        = 47106;
+};
+
+/**
+ * @brief Parses the command line options.
+ * @param t_argc The number of arguments.
+ * @param t_argv The arguments.
+ * @return The options.
+ * @version 1.0.0
+ */
+static BenchmarkOptions parseOptions(int t_argc, char **t_argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < t_argc; i++)
+    {
+        std::string argument = t_argv[i];
+        size_t      equals   = argument.find('=');
+        std::string key      = argument.substr(0, equals);
+        std::string value    = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--mode")
+        {
+            options.mode = value;
+        }
+        else if (key == "--policy")
+        {
+            options.policy = value;
+        }
+        else if (key == "--label")
+        {
+            options.label = value;
+        }
+        else if (key == "--subscribers")
+        {
+            options.subscribers = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--slow")
+        {
+            options.slow = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--size")
+        {
+            options.payloadSize = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--queue-limit")
+        {
+            options.queueLimit = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--rate")
+        {
+            options.rate = std::atoi(value.c_str());
+        }
+        else if (key == "--seconds")
+        {
+            options.seconds = std::atoi(value.c_str());
+        }
+        else if (key == "--port")
+        {
+            options.port = std::atoi(value.c_str());
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argument.c_str());
+            std::exit(2);
+        }
+    }
+    if ((options.mode != "shared" && options.mode != "loop") || (options.policy != "drop" && options.policy != "disconnect") ||
+        options.subscribers == 0 || options.payloadSize < sizeof(int64_t) || options.queueLimit == 0 || options.rate < 1 ||
+        options.seconds < 1)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        std::exit(2);
+    }
+    return options;
+}
+
+/**
+ * @brief Retrieves the current time of the steady clock in nanoseconds.
+ * @return The time.
+ * @version 1.0.0
+ */
+static int64_t getNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Runs the event loop of the server until `t_isRunning` is cleared and one more event arrives.
+ * @details The subscribers never send, so a readable client has disconnected and is closed.
+ * @param t_server The server.
+ * @param t_isRunning Whether the server keeps running.
+ * @param t_acceptedClients The number of accepted clients.
+ * @version 1.0.0
+ */
+static void runServer(FBNetwork::Server &t_server, const std::atomic<bool> &t_isRunning, std::atomic<size_t> &t_acceptedClients)
+{
+    while (t_isRunning.load())
+    {
+        std::vector<FBNetwork::eventTuple> events;
+        try
+        {
+            events = t_server.getPendingEvents();
+        }
+        catch (std::exception &e)
+        {
+            continue;
+        }
+        for (FBNetwork::eventTuple event : events)
+        {
+            if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_CONNECT)
+            {
+                try
+                {
+                    t_acceptedClients.fetch_add(t_server.acceptAll().size());
+                }
+                catch (std::exception &e)
+                {
+                    std::fprintf(stderr, "Accepting clients failed: %s\n", e.what());
+                }
+            }
+            else if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA)
+            {
+                try
+                {
+                    t_server.closeClient(std::get<1>(event));
+                }
+                catch (std::exception &e)
+                {
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Reads the updates on one fast subscriber until the end of the run.
+ * @param t_options The options.
+ * @param t_end The end of the run.
+ * @param t_latency The time from publishing an update until it was read.
+ * @param t_errors The number of failed subscribers.
+ * @version 1.0.0
+ */
+static void runSubscriber(const BenchmarkOptions &t_options, const std::chrono::steady_clock::time_point t_end,
+                          FBNetwork::LatencyHistogram &t_latency, std::atomic<uint64_t> &t_errors)
+{
+    try
+    {
+        FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", t_options.port);
+        client.setTimeout({5, 0});
+        client.connectToServer();
+        while (std::chrono::steady_clock::now() < t_end)
+        {
+            client.readXData(static_cast<ssize_t>(t_options.payloadSize));
+            std::string update = client.getData();
+            int64_t     publishedAt;
+            std::memcpy(&publishedAt, update.data(), sizeof(publishedAt));
+            t_latency.record(static_cast<uint64_t>(getNanoseconds() - publishedAt));
+        }
+        client.disconnectFromServer();
+    }
+    catch (std::exception &e)
+    {
+        t_errors.fetch_add(1);
+    }
+}
+
+/**
+ * @brief Connects a subscriber that never reads until the end of the run.
+ * @param t_options The options.
+ * @param t_end The end of the run.
+ * @version 1.0.0
+ */
+static void runSlowSubscriber(const BenchmarkOptions &t_options, const std::chrono::steady_clock::time_point t_end)
+{
+    try
+    {
+        FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", t_options.port);
+        client.connectToServer();
+        std::this_thread::sleep_until(t_end);
+    }
+    catch (std::exception &e)
+    {
+    }
+}
+
+/**
+ * @brief Publishes updates to many subscribers while some of them stop reading and prints one JSON line.
+ * @details Usage: `broadcast [--mode=shared|loop] [--subscribers=N] [--slow=N] [--size=BYTES] [--rate=UPDATES_PER_SECOND]
+ * [--queue-limit=BYTES] [--policy=drop|disconnect] [--seconds=N] [--port=N] [--label=TEXT]`. With `shared` every update is one
+ * `sharedPayload` passed to `Server::broadcast()`, with `loop` it is sent with `Server::sendData()` to one client after the other.
+ * `slow` more clients connect but never read, so their socket buffers fill up. `publish_ns` is the time one update takes to hand out,
+ * `fanout_latency_ns` the time from publishing until a fast subscriber read it.
+ * @version 1.0.0
+ */
+int main(int argc, char **argv)
+{
+    BenchmarkOptions    options = parseOptions(argc, argv);
+    std::atomic<bool>   isRunning{true};
+    std::atomic<size_t> acceptedClients{0};
+    std::signal(SIGPIPE, SIG_IGN);
+
+    FBNetwork::Server server(FBNetwork::Domain::IPV4_DOMAIN, options.port, static_cast<int>(options.subscribers + options.slow + 16));
+    server.setTimeout({1, 0});
+    server.setOutputQueueLimit(options.queueLimit, options.policy == "drop" ? FBNetwork::SlowClientPolicy::DROP_MESSAGE
+                                                                               : FBNetwork::SlowClientPolicy::DISCONNECT);
+    server.startServer();
+    server.startListening();
+    std::thread serverThread(runServer, std::ref(server), std::cref(isRunning), std::ref(acceptedClients));
+
+    // Give every client time to connect before the first update
+
+    FBNetwork::LatencyHistogram fanoutLatency;
+    FBNetwork::LatencyHistogram publishLatency;
+    std::atomic<uint64_t>       errors{0};
+    auto                        end = std::chrono::steady_clock::now() + std::chrono::seconds(options.seconds + 1);
+    std::vector<std::thread>    subscribers;
+    for (size_t i = 0; i < options.subscribers; i++)
+    {
+        subscribers.emplace_back(runSubscriber, std::cref(options), end, std::ref(fanoutLatency), std::ref(errors));
+    }
+    for (size_t i = 0; i < options.slow; i++)
+    {
+        subscribers.emplace_back(runSlowSubscriber, std::cref(options), end + std::chrono::milliseconds(300));
+    }
+    while (acceptedClients.load() < options.subscribers + options.slow && std::chrono::steady_clock::now() < end)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    uint64_t    published = 0;
+    int         clients   = static_cast<int>(acceptedClients.load());
+    auto        interval  = std::chrono::nanoseconds(1000000000LL / options.rate);
+    auto        next      = std::chrono::steady_clock::now();
+    auto        start     = next;
+    std::string body(options.payloadSize, 'u');
+
+    // Keep publishing a little after the fast subscribers stopped reading, so none of them waits for an update that never comes
+
+    while (next < end + std::chrono::milliseconds(300))
+    {
+        std::this_thread::sleep_until(next);
+        next += interval;
+        int64_t publishedAt = getNanoseconds();
+        std::memcpy(&body[0], &publishedAt, sizeof(publishedAt));
+        auto publishStart = std::chrono::steady_clock::now();
+        if (options.mode == "shared")
+        {
+            server.broadcast(std::make_shared<const std::string>(body));
+        }
+        else
+        {
+            for (int clientID = 0; clientID < clients; clientID++)
+            {
+                std::error_code error;
+                server.sendData(clientID, body, error);
+                if (error && error != FBNetwork::NetworkError::INVALID_CLIENT)
+                {
+                    try
+                    {
+                        server.closeClient(clientID);
+                    }
+                    catch (std::exception &e)
+                    {
+                    }
+                }
+            }
+        }
+        publishLatency.recordSince(publishStart);
+        published++;
+    }
+    double elapsed = std::chrono::duration<double>(end - start).count();
+    for (std::thread &subscriber : subscribers)
+    {
+        subscriber.join();
+    }
+
+    // Wake the server thread up with one more connection, so it sees that it has to stop
+
+    isRunning.store(false);
+    try
+    {
+        FBNetwork::Client wakeUp(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", options.port);
+        wakeUp.connectToServer();
+    }
+    catch (std::exception &e)
+    {
+    }
+    serverThread.join();
+
+    FBNetwork::HistogramSnapshot     fanout  = fanoutLatency.getSnapshot();
+    FBNetwork::HistogramSnapshot     publish = publishLatency.getSnapshot();
+    FBNetwork::ServerMetricsSnapshot metrics = server.getMetrics();
+    std::printf("{\"benchmark\": \"broadcast_%s\", \"label\": \"%s\", \"subscribers\": %zu, \"slow\": %zu, \"size\": %zu, \"policy\": \"%s\", "
+                "\"seconds\": %.3f, \"published\": %llu, \"delivered_per_subscriber\": %.0f, \"dropped\": %llu, \"errors\": %llu, "
+                "\"publish_ns\": {\"p50\": %llu, \"p99\": %llu, \"max\": %llu}, \"fanout_latency_ns\": {\"p50\": %llu, \"p99\": %llu, "
+                "\"p999\": %llu, \"max\": %llu}}\n",
+                options.mode.c_str(), options.label.c_str(), options.subscribers, options.slow, options.payloadSize, options.policy.c_str(),
+                elapsed, static_cast<unsigned long long>(published), static_cast<double>(fanout.count) / static_cast<double>(options.subscribers),
+                static_cast<unsigned long long>(metrics.droppedMessages),
+                static_cast<unsigned long long>(errors.load()), static_cast<unsigned long long>(publish.getPercentile(50)),
+                static_cast<unsigned long long>(publish.getPercentile(99)), static_cast<unsigned long long>(publish.maximum),
+                static_cast<unsigned long long>(fanout.getPercentile(50)), static_cast<unsigned long long>(fanout.getPercentile(99)),
+                static_cast<unsigned long long>(fanout.getPercentile(99.9)), static_cast<unsigned long long>(fanout.maximum));
+    return 0;
+}
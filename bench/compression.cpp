@@ -0,0 +1,232 @@
+#include "../include/compression.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Represents the options of a benchmark run.
+ * @version 1.0.0
+ */
+struct BenchmarkOptions
+{
+    std::string codec       = "all";
+    std::string label       = "";
+    size_t      messageSize = 512;
+    size_t      messages    = 20000;
+};
+
+/**
+ * @brief Represents one codec and level to measure.
+ * @version 1.0.0
+ */
+struct BenchmarkCase
+{
+    std::string                 name;
+    FBNetwork::CompressionCodec codec;
+    int                         level;
+    bool                        usesDictionary;
+};
+
+/**
+ * @brief Parses the command line options.
+ * @param t_argc The number of arguments.
+ * @param t_argv The arguments.
+ * @return The options.
+ * @version 1.0.0
+ */
+static BenchmarkOptions parseOptions(int t_argc, char **t_argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < t_argc; i++)
+    {
+        std::string argument = t_argv[i];
+        size_t      equals   = argument.find('=');
+        std::string key      = argument.substr(0, equals);
+        std::string value    = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--codec")
+        {
+            options.codec = value;
+        }
+        else if (key == "--label")
+        {
+            options.label = value;
+        }
+        else if (key == "--message-size")
+        {
+            options.messageSize = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--messages")
+        {
+            options.messages = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argument.c_str());
+            std::exit(2);
+        }
+    }
+    if ((options.codec != "all" && options.codec != "none" && options.codec != "lz4" && options.codec != "zstd") ||
+        options.messageSize == 0 || options.messages == 0)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        std::exit(2);
+    }
+    return options;
+}
+
+/**
+ * @brief Retrieves the CPU time of the calling thread in nanoseconds.
+ * @return The CPU time.
+ * @version 1.0.0
+ */
+static double getThreadCpuNanoseconds()
+{
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return static_cast<double>(time.tv_sec) * 1e9 + static_cast<double>(time.tv_nsec);
+}
+
+/**
+ * @brief Creates messages that look like the JSON records of an API, same keys, varying values.
+ * @param t_count The number of messages.
+ * @param t_size The size of every message.
+ * @param t_seed The seed of the values.
+ * @return The messages.
+ * @version 1.0.0
+ */
+static std::vector<std::string> createMessages(const size_t t_count, const size_t t_size, const unsigned t_seed)
+{
+    static const char *const STATUSES[] = {"active", "pending", "suspended", "closed"};
+    std::mt19937             random(t_seed);
+    std::vector<std::string> messages;
+    messages.reserve(t_count);
+    for (size_t i = 0; i < t_count; i++)
+    {
+        std::string message;
+        while (message.size() < t_size)
+        {
+            char record[192];
+            std::snprintf(record, sizeof(record),
+                          "{\"id\": %u, \"user\": \"user%u@example.com\", \"status\": \"%s\", \"balance\": %u.%02u, "
+                          "\"updated\": \"2024-%02u-%02uT%02u:%02u:00Z\"},",
+                          static_cast<unsigned>(random() % 1000000), static_cast<unsigned>(random() % 5000), STATUSES[random() % 4],
+                          static_cast<unsigned>(random() % 100000), static_cast<unsigned>(random() % 100),
+                          static_cast<unsigned>(random() % 12 + 1), static_cast<unsigned>(random() % 28 + 1),
+                          static_cast<unsigned>(random() % 24), static_cast<unsigned>(random() % 60));
+            message += record;
+        }
+        message.resize(t_size);
+        messages.push_back(message);
+    }
+    return messages;
+}
+
+/**
+ * @brief Compresses and decompresses all messages with one case and prints one JSON line.
+ * @details Both sides negotiate like a connection does, and every message is one frame through the contexts of one connection.
+ * @param t_options The options.
+ * @param t_case The codec and level.
+ * @param t_messages The messages.
+ * @param t_dictionary The dictionary for cases that use one.
+ * @return true if every message came back unchanged, false otherwise.
+ * @version 1.0.0
+ */
+static bool runCase(const BenchmarkOptions &t_options, const BenchmarkCase &t_case, const std::vector<std::string> &t_messages,
+                    const std::shared_ptr<const FBNetwork::CompressionDictionary> &t_dictionary)
+{
+    FBNetwork::CompressionOptions compressionOptions;
+    compressionOptions.codec      = t_case.codec;
+    compressionOptions.level      = t_case.level;
+    compressionOptions.dictionary = t_case.usesDictionary ? t_dictionary : nullptr;
+    FBNetwork::Compressor sender(compressionOptions);
+    FBNetwork::Compressor receiver(compressionOptions);
+    std::string           offer  = sender.createOffer();
+    std::string           answer = receiver.answerOffer(offer.substr(FBNetwork::Constants::COMPRESSION_FRAME_HEADER_SIZE));
+    sender.acceptAnswer(answer.substr(FBNetwork::Constants::COMPRESSION_FRAME_HEADER_SIZE));
+
+    std::vector<std::string> frames(t_messages.size());
+    size_t                   messageBytes = 0;
+    size_t                   frameBytes   = 0;
+    double                   cpuStart     = getThreadCpuNanoseconds();
+    auto                     start        = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < t_messages.size(); i++)
+    {
+        sender.compress(t_messages[i], frames[i]);
+        messageBytes += t_messages[i].size();
+        frameBytes   += frames[i].size();
+    }
+    double compressSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double compressCpu     = getThreadCpuNanoseconds() - cpuStart;
+
+    std::string header;
+    std::string payload;
+    std::string message;
+    bool        isIntact = true;
+    cpuStart             = getThreadCpuNanoseconds();
+    start                = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        header.assign(frames[i], 0, FBNetwork::Constants::COMPRESSION_FRAME_HEADER_SIZE);
+        payload.assign(frames[i], FBNetwork::Constants::COMPRESSION_FRAME_HEADER_SIZE, std::string::npos);
+        receiver.decompress(header, payload, message);
+        isIntact = isIntact && message == t_messages[i];
+    }
+    double decompressSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double decompressCpu     = getThreadCpuNanoseconds() - cpuStart;
+
+    std::printf("{\"benchmark\": \"compression_%s\", \"label\": \"%s\", \"level\": %d, \"message_size\": %zu, \"messages\": %zu, "
+                "\"ratio\": %.3f, \"compress_mb_per_second\": %.1f, \"decompress_mb_per_second\": %.1f, "
+                "\"compress_cpu_ns_per_byte\": %.3f, \"decompress_cpu_ns_per_byte\": %.3f, \"intact\": %s}\n",
+                t_case.name.c_str(), t_options.label.c_str(), t_case.level, t_options.messageSize, t_messages.size(),
+                static_cast<double>(messageBytes) / static_cast<double>(frameBytes),
+                static_cast<double>(messageBytes) / compressSeconds / 1e6, static_cast<double>(messageBytes) / decompressSeconds / 1e6,
+                compressCpu / static_cast<double>(messageBytes), decompressCpu / static_cast<double>(messageBytes),
+                isIntact ? "true" : "false");
+    return isIntact;
+}
+
+/**
+ * @brief Measures the ratio, throughput and CPU cost per byte of the codecs at several levels and prints one JSON line per case.
+ * @details Usage: `compression [--codec=all|none|lz4|zstd] [--message-size=BYTES] [--messages=N] [--label=TEXT]`. The messages are
+ * JSON records of the same shape, the kind of traffic that compresses poorly one message at a time without a dictionary. `ratio` counts
+ * the frame headers, so small messages show the overhead as well. Codecs that were not found at build time are skipped.
+ * @version 1.0.0
+ */
+int main(int argc, char **argv)
+{
+    BenchmarkOptions           options  = parseOptions(argc, argv);
+    std::vector<std::string>   messages = createMessages(options.messages, options.messageSize, 1);
+    std::vector<BenchmarkCase> cases    = {{"none", FBNetwork::CompressionCodec::NONE, 0, false},
+                                           {"lz4", FBNetwork::CompressionCodec::LZ4, 1, false},
+                                           {"lz4", FBNetwork::CompressionCodec::LZ4, 8, false},
+                                           {"zstd", FBNetwork::CompressionCodec::ZSTD, -5, false},
+                                           {"zstd", FBNetwork::CompressionCodec::ZSTD, 1, false},
+                                           {"zstd", FBNetwork::CompressionCodec::ZSTD, 3, false},
+                                           {"zstd", FBNetwork::CompressionCodec::ZSTD, 9, false},
+                                           {"zstd", FBNetwork::CompressionCodec::ZSTD, 19, false},
+                                           {"zstd_dictionary", FBNetwork::CompressionCodec::ZSTD, 1, true},
+                                           {"zstd_dictionary", FBNetwork::CompressionCodec::ZSTD, 3, true}};
+
+    // The dictionary is trained on other messages of the same shape, like a dictionary that ships with both sides
+
+    std::shared_ptr<const FBNetwork::CompressionDictionary> dictionary;
+    if (FBNetwork::Compressor::isAvailable(FBNetwork::CompressionCodec::ZSTD))
+    {
+        dictionary = FBNetwork::CompressionDictionary::train(createMessages(2000, options.messageSize, 2), 16384);
+    }
+    bool isIntact = true;
+    for (const BenchmarkCase &benchmarkCase : cases)
+    {
+        std::string codec = benchmarkCase.name.substr(0, benchmarkCase.name.find('_'));
+        if ((options.codec != "all" && options.codec != codec) || !FBNetwork::Compressor::isAvailable(benchmarkCase.codec))
+        {
+            continue;
+        }
+        isIntact = runCase(options, benchmarkCase, messages, dictionary) && isIntact;
+    }
+    return isIntact ? 0 : 1;
+}
@@ -0,0 +1,373 @@
+#include "../include/client.hpp"
+#include "../include/cpuPlacement.hpp"
+#include "../include/latencyHistogram.hpp"
+#include "../include/server.hpp"
+#include "../include/socketOptions.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <linux/perf_event.h>
+#include <memory>
+#include <string>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Represents the options of a benchmark run.
+ * @version 1.0.0
+ */
+struct BenchmarkOptions
+{
+    std::string placement   = "pinned";
+    std::string label       = "";
+    size_t      loops       = 0;
+    size_t      connections = 0;
+    int         seconds     = 5;
+    size_t      payloadSize = 64;
+    int         port        = 47104;
+};
+
+/**
+ * @brief Represents what the event loops observed.
+ * @version 1.0.0
+ */
+struct LoopObservations
+{
+    std::atomic<uint64_t> localReads{0};
+    std::atomic<uint64_t> remoteReads{0};
+    std::atomic<size_t>   stoppedLoops{0};
+};
+
+/**
+ * @brief Represents a hardware or software counter of the kernel for the whole process.
+ * @details The counter is opened before the threads start and inherited by them, their counts are added when they exit. It reads -1
+ * where `perf_event_open` is not allowed, see `/proc/sys/kernel/perf_event_paranoid`, or the event does not exist, like hardware
+ * events in most virtual machines.
+ * @version 1.0.0
+ */
+class PerfCounter
+{
+private:
+    int m_fileDescriptor = -1;
+
+public:
+    /**
+     * @brief Constructs a PerfCounter object and starts counting.
+     * @param t_type The type of the event, like `PERF_TYPE_HARDWARE`.
+     * @param t_config The event, like `PERF_COUNT_HW_CACHE_MISSES`.
+     * @version 1.0.0
+     */
+    PerfCounter(const uint32_t t_type, const uint64_t t_config)
+    {
+        perf_event_attr attributes = {};
+        attributes.size            = sizeof(attributes);
+        attributes.type            = t_type;
+        attributes.config          = t_config;
+        attributes.inherit         = 1;
+        attributes.exclude_hv      = 1;
+        m_fileDescriptor           = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+    }
+
+    ~PerfCounter()
+    {
+        if (m_fileDescriptor != -1)
+        {
+            close(m_fileDescriptor);
+        }
+    }
+
+    PerfCounter(const PerfCounter &)            = delete;
+    PerfCounter &operator=(const PerfCounter &) = delete;
+
+    /**
+     * @brief Reads the counter.
+     * @return The count, or -1 if the counter is not available.
+     * @version 1.0.0
+     */
+    long long read() const
+    {
+        long long value = -1;
+        if (m_fileDescriptor == -1 || ::read(m_fileDescriptor, &value, sizeof(value)) != sizeof(value))
+        {
+            return -1;
+        }
+        return value;
+    }
+};
+
+/**
+ * @brief Parses the command line options.
+ * @param t_argc The number of arguments.
+ * @param t_argv The arguments.
+ * @return The options.
+ * @version 1.0.0
+ */
+static BenchmarkOptions parseOptions(int t_argc, char **t_argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < t_argc; i++)
+    {
+        std::string argument = t_argv[i];
+        size_t      equals   = argument.find('=');
+        std::string key      = argument.substr(0, equals);
+        std::string value    = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--placement")
+        {
+            options.placement = value;
+        }
+        else if (key == "--label")
+        {
+            options.label = value;
+        }
+        else if (key == "--loops")
+        {
+            options.loops = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--connections")
+        {
+            options.connections = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--seconds")
+        {
+            options.seconds = std::atoi(value.c_str());
+        }
+        else if (key == "--size")
+        {
+            options.payloadSize = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--port")
+        {
+            options.port = std::atoi(value.c_str());
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argument.c_str());
+            std::exit(2);
+        }
+    }
+    if (options.loops == 0)
+    {
+        options.loops = FBNetwork::CpuPlacement::getCpuCount();
+    }
+    if (options.connections == 0)
+    {
+        options.connections = 2 * options.loops;
+    }
+    if ((options.placement != "pinned" && options.placement != "none") || options.seconds < 1 || options.payloadSize == 0)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        std::exit(2);
+    }
+    return options;
+}
+
+/**
+ * @brief Runs the event loop of one server until `t_isRunning` is cleared and one more event arrives.
+ * @details Every request is echoed. The loop counts the reads where the kernel processed the packet on the CPU of the loop as local.
+ * @param t_server The server.
+ * @param t_options The options.
+ * @param t_isRunning Whether the loop keeps running.
+ * @param t_observations What the loops observed.
+ * @version 1.0.0
+ */
+static void runLoop(FBNetwork::Server &t_server, const BenchmarkOptions &t_options, const std::atomic<bool> &t_isRunning,
+                    LoopObservations &t_observations)
+{
+    while (t_isRunning.load())
+    {
+        std::vector<FBNetwork::eventTuple> events;
+        try
+        {
+            events = t_server.getPendingEvents();
+        }
+        catch (std::exception &e)
+        {
+            continue;
+        }
+        for (FBNetwork::eventTuple event : events)
+        {
+            int clientID = std::get<1>(event);
+            if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_CONNECT)
+            {
+                try
+                {
+                    t_server.acceptAll();
+                }
+                catch (std::exception &e)
+                {
+                    std::fprintf(stderr, "Accepting clients failed: %s\n", e.what());
+                }
+                continue;
+            }
+            if (std::get<0>(event) != FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA)
+            {
+                continue;
+            }
+            try
+            {
+                t_server.readXData(clientID, static_cast<ssize_t>(t_options.payloadSize));
+                if (t_server.getClientIncomingCpu(clientID) == FBNetwork::CpuPlacement::getCurrentCpu())
+                {
+                    t_observations.localReads.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    t_observations.remoteReads.fetch_add(1, std::memory_order_relaxed);
+                }
+                t_server.sendData(clientID, t_server.getData(clientID));
+            }
+            catch (std::exception &e)
+            {
+                try
+                {
+                    t_server.closeClient(clientID);
+                }
+                catch (std::exception &e)
+                {
+                }
+            }
+        }
+    }
+    t_observations.stoppedLoops.fetch_add(1);
+}
+
+/**
+ * @brief Sends echo requests on one connection until the end of the run.
+ * @param t_connectionIndex The index of the connection.
+ * @param t_options The options.
+ * @param t_end The end of the run.
+ * @param t_latency The latency histogram.
+ * @param t_errors The number of failed requests.
+ * @version 1.0.0
+ */
+static void runConnection(const size_t t_connectionIndex, const BenchmarkOptions &t_options,
+                          const std::chrono::steady_clock::time_point t_end, FBNetwork::LatencyHistogram &t_latency,
+                          std::atomic<uint64_t> &t_errors)
+{
+
+    // A pinned connection runs on the CPU of one loop, its SYN is processed there and SO_INCOMING_CPU steers it to that loop
+
+    if (t_options.placement == "pinned")
+    {
+        FBNetwork::CpuPlacement::forLoop(t_connectionIndex % t_options.loops, t_options.loops).applyToCurrentThread();
+    }
+    std::string request(t_options.payloadSize, 'x');
+    try
+    {
+        FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", t_options.port);
+        client.setTimeout({5, 0});
+        client.connectToServer();
+        while (std::chrono::steady_clock::now() < t_end)
+        {
+            auto operationStart = std::chrono::steady_clock::now();
+            client.sendData(request);
+            client.readXData(static_cast<ssize_t>(t_options.payloadSize));
+            t_latency.recordSince(operationStart);
+        }
+        client.disconnectFromServer();
+    }
+    catch (std::exception &e)
+    {
+        t_errors.fetch_add(1);
+    }
+}
+
+/**
+ * @brief Measures echo requests over loopback with several event loops on one port and prints one JSON line.
+ * @details Usage: `cpuPlacement [--placement=pinned|none] [--loops=N] [--connections=N] [--seconds=N] [--size=BYTES] [--port=N]
+ * [--label=TEXT]`. Every loop is a `Server` with `SO_REUSEPORT` on its own thread, one per CPU by default, with two connections per
+ * loop on their own threads. With `pinned`, every loop gets `CpuPlacement::forLoop()` and every connection thread the CPU of one
+ * loop. With `none`, the scheduler places all threads and the kernel spreads the connections by hash. The output contains the
+ * reads whose packets the kernel processed on the CPU of the loop (`local_reads`) or on another CPU (`remote_reads`), and the
+ * cache misses, CPU migrations and context switches of the process, where `perf_event_open` is allowed.
+ * @version 1.0.0
+ */
+int main(int argc, char **argv)
+{
+    BenchmarkOptions  options = parseOptions(argc, argv);
+    std::atomic<bool> isRunning{true};
+    LoopObservations  observations;
+    std::signal(SIGPIPE, SIG_IGN);
+
+    PerfCounter cacheMisses(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    PerfCounter cpuMigrations(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS);
+    PerfCounter contextSwitches(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES);
+
+    FBNetwork::SocketOptions socketOptions;
+    socketOptions.setReusePort(true);
+    socketOptions.setNoDelay(true);
+    std::vector<std::unique_ptr<FBNetwork::Server>> servers;
+    std::vector<std::thread>                        loops;
+    for (size_t i = 0; i < options.loops; i++)
+    {
+        servers.push_back(std::make_unique<FBNetwork::Server>(FBNetwork::Domain::IPV4_DOMAIN, options.port, 1024));
+        servers.back()->setTimeout({5, 0});
+        servers.back()->setSocketOptions(socketOptions);
+        if (options.placement == "pinned")
+        {
+            servers.back()->setCpuPlacement(FBNetwork::CpuPlacement::forLoop(i, options.loops));
+        }
+        servers.back()->startServer();
+        servers.back()->startListening();
+        loops.emplace_back(runLoop, std::ref(*servers.back()), std::cref(options), std::cref(isRunning), std::ref(observations));
+    }
+
+    FBNetwork::LatencyHistogram latency;
+    std::atomic<uint64_t>       errors{0};
+    std::vector<std::thread>    connections;
+    auto                        start = std::chrono::steady_clock::now();
+    auto                        end   = start + std::chrono::seconds(options.seconds);
+    for (size_t i = 0; i < options.connections; i++)
+    {
+        connections.emplace_back(runConnection, i, std::cref(options), end, std::ref(latency), std::ref(errors));
+    }
+    for (std::thread &connection : connections)
+    {
+        connection.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Wake the loops up until all of them saw that they have to stop. With placements a connection only reaches the loop on the CPU
+    // it was sent from, so the wake-ups go out from every loop CPU in turn
+
+    isRunning.store(false);
+    for (size_t i = 0; observations.stoppedLoops.load() < options.loops; i++)
+    {
+        try
+        {
+            if (options.placement == "pinned")
+            {
+                FBNetwork::CpuPlacement::forLoop(i % options.loops, options.loops).applyToCurrentThread();
+            }
+            FBNetwork::Client wakeUp(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", options.port);
+            wakeUp.connectToServer();
+        }
+        catch (std::exception &e)
+        {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (std::thread &loop : loops)
+    {
+        loop.join();
+    }
+
+    FBNetwork::HistogramSnapshot snapshot = latency.getSnapshot();
+    std::printf("{\"benchmark\": \"cpu_placement_%s\", \"label\": \"%s\", \"loops\": %zu, \"connections\": %zu, \"cpus\": %zu, "
+                "\"seconds\": %.3f, \"operations\": %llu, \"errors\": %llu, \"operations_per_second\": %.0f, \"latency_ns\": {\"p50\": %llu, "
+                "\"p99\": %llu, \"p999\": %llu, \"mean\": %.0f, \"max\": %llu}, \"local_reads\": %llu, \"remote_reads\": %llu, "
+                "\"perf\": {\"cache_misses\": %lld, \"cpu_migrations\": %lld, \"context_switches\": %lld}}\n",
+                options.placement.c_str(), options.label.c_str(), options.loops, options.connections,
+                FBNetwork::CpuPlacement::getCpuCount(), elapsed, static_cast<unsigned long long>(snapshot.count),
+                static_cast<unsigned long long>(errors.load()), static_cast<double>(snapshot.count) / elapsed,
+                static_cast<unsigned long long>(snapshot.getPercentile(50)), static_cast<unsigned long long>(snapshot.getPercentile(99)),
+                static_cast<unsigned long long>(snapshot.getPercentile(99.9)), snapshot.getMean(),
+                static_cast<unsigned long long>(snapshot.maximum), static_cast<unsigned long long>(observations.localReads.load()),
+                static_cast<unsigned long long>(observations.remoteReads.load()), cacheMisses.read(), cpuMigrations.read(),
+                contextSwitches.read());
+    return 0;
+}
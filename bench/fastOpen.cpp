@@ -0,0 +1,267 @@
+#include "../include/client.hpp"
+#include "../include/latencyHistogram.hpp"
+#include "../include/server.hpp"
+#include "../include/socketOptions.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Represents the options of a benchmark run.
+ * @version 1.0.0
+ */
+struct BenchmarkOptions
+{
+    std::string mode        = "fastopen";
+    std::string label       = "";
+    int         seconds     = 5;
+    size_t      payloadSize = 64;
+    int         port        = 47103;
+};
+
+static const std::string RESPONSE = "OK";
+
+/**
+ * @brief Parses the command line options.
+ * @param t_argc The number of arguments.
+ * @param t_argv The arguments.
+ * @return The options.
+ * @version 1.0.0
+ */
+static BenchmarkOptions parseOptions(int t_argc, char **t_argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < t_argc; i++)
+    {
+        std::string argument = t_argv[i];
+        size_t      equals   = argument.find('=');
+        std::string key      = argument.substr(0, equals);
+        std::string value    = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--mode")
+        {
+            options.mode = value;
+        }
+        else if (key == "--label")
+        {
+            options.label = value;
+        }
+        else if (key == "--seconds")
+        {
+            options.seconds = std::atoi(value.c_str());
+        }
+        else if (key == "--size")
+        {
+            options.payloadSize = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--port")
+        {
+            options.port = std::atoi(value.c_str());
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argument.c_str());
+            std::exit(2);
+        }
+    }
+    if ((options.mode != "fastopen" && options.mode != "handshake") || options.seconds < 1 || options.payloadSize == 0)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        std::exit(2);
+    }
+    return options;
+}
+
+/**
+ * @brief Reads the TCP Fast Open counters of the kernel.
+ * @return The counters from `/proc/net/netstat` by name, empty where the file does not exist.
+ * @version 1.0.0
+ */
+static std::map<std::string, long long> readFastOpenCounters()
+{
+    std::map<std::string, long long> counters;
+    std::ifstream                    netstat("/proc/net/netstat");
+    std::string                      names;
+    std::string                      values;
+    while (std::getline(netstat, names) && std::getline(netstat, values))
+    {
+        if (names.compare(0, 7, "TcpExt:") != 0)
+        {
+            continue;
+        }
+        std::istringstream nameStream(names);
+        std::istringstream valueStream(values);
+        std::string        name;
+        std::string        value;
+        while (nameStream >> name && valueStream >> value)
+        {
+            if (name.compare(0, 11, "TCPFastOpen") == 0)
+            {
+                counters[name] = std::atoll(value.c_str());
+            }
+        }
+    }
+    return counters;
+}
+
+/**
+ * @brief Runs the event loop of the server until `t_isRunning` is cleared and one more event arrives.
+ * @param t_server The server.
+ * @param t_options The options.
+ * @param t_isRunning Whether the server keeps running.
+ * @version 1.0.0
+ */
+static void runServer(FBNetwork::Server &t_server, const BenchmarkOptions &t_options, const std::atomic<bool> &t_isRunning)
+{
+    while (t_isRunning.load())
+    {
+        std::vector<FBNetwork::eventTuple> events;
+        try
+        {
+            events = t_server.getPendingEvents();
+        }
+        catch (std::exception &e)
+        {
+            continue;
+        }
+        for (FBNetwork::eventTuple event : events)
+        {
+            int clientID = std::get<1>(event);
+            if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_CONNECT)
+            {
+                try
+                {
+                    t_server.acceptAll();
+                }
+                catch (std::exception &e)
+                {
+                    std::fprintf(stderr, "Accepting clients failed: %s\n", e.what());
+                }
+                continue;
+            }
+            if (std::get<0>(event) != FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA)
+            {
+                continue;
+            }
+            try
+            {
+                t_server.readXData(clientID, static_cast<ssize_t>(t_options.payloadSize));
+                t_server.sendData(clientID, RESPONSE);
+            }
+            catch (std::exception &e)
+            {
+                try
+                {
+                    t_server.closeClient(clientID);
+                }
+                catch (std::exception &e)
+                {
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Measures the latency from connecting to the first response of short-lived connections over loopback and prints one JSON line.
+ * @details Usage: `fastOpen [--mode=fastopen|handshake] [--seconds=N] [--size=BYTES] [--port=N] [--label=TEXT]`. Every operation opens
+ * a connection, sends a request of `size` bytes, 64 by default, reads a 2 byte response and closes the connection. In the mode
+ * - `fastopen` the server has TCP Fast Open on its listening socket and the client uses `connectAndSend()`,
+ * - `handshake` the client uses `connectToServer()` and `sendData()`.
+ * The output contains how the `TCPFastOpen*` counters of the kernel changed during the run. On Linux, fast open over loopback needs
+ * `net.ipv4.tcp_fastopen=3`, with the default of 1 the server side is off and every connection falls back to the normal handshake.
+ * @version 1.0.0
+ */
+int main(int argc, char **argv)
+{
+    BenchmarkOptions  options = parseOptions(argc, argv);
+    std::atomic<bool> isRunning{true};
+    std::signal(SIGPIPE, SIG_IGN);
+
+    FBNetwork::SocketOptions socketOptions;
+    socketOptions.setNoDelay(true);
+    if (options.mode == "fastopen")
+    {
+        socketOptions.setFastOpen(256);
+    }
+    FBNetwork::Server server(FBNetwork::Domain::IPV4_DOMAIN, options.port, 4096);
+    server.setTimeout({5, 0});
+    server.setSocketOptions(socketOptions);
+    server.startServer();
+    server.startListening();
+    std::thread serverThread(runServer, std::ref(server), std::cref(options), std::cref(isRunning));
+
+    FBNetwork::LatencyHistogram      latency;
+    uint64_t                         operations = 0;
+    uint64_t                         errors     = 0;
+    std::string                      request(options.payloadSize, 'x');
+    std::map<std::string, long long> countersBefore = readFastOpenCounters();
+    auto                             start          = std::chrono::steady_clock::now();
+    auto                             end            = start + std::chrono::seconds(options.seconds);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        auto operationStart = std::chrono::steady_clock::now();
+        try
+        {
+            FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", options.port);
+            client.setTimeout({5, 0});
+            client.setSocketOptions(socketOptions);
+            if (options.mode == "fastopen")
+            {
+                client.connectAndSend(request);
+            }
+            else
+            {
+                client.connectToServer();
+                client.sendData(request);
+            }
+            client.readXData(static_cast<ssize_t>(RESPONSE.size()));
+            latency.recordSince(operationStart);
+            operations++;
+            client.disconnectFromServer();
+        }
+        catch (std::exception &e)
+        {
+            errors++;
+        }
+    }
+    double                           elapsed       = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::map<std::string, long long> countersAfter = readFastOpenCounters();
+
+    std::string counters;
+    for (const std::pair<const std::string, long long> &counter : countersAfter)
+    {
+        counters += (counters.empty() ? "" : ", ") + ("\"" + counter.first + "\": ") +
+                    std::to_string(counter.second - countersBefore[counter.first]);
+    }
+    FBNetwork::HistogramSnapshot snapshot = latency.getSnapshot();
+    std::printf("{\"benchmark\": \"fast_open_%s\", \"label\": \"%s\", \"payload_size\": %zu, \"seconds\": %.3f, \"operations\": %llu, "
+                "\"errors\": %llu, \"operations_per_second\": %.0f, \"latency_ns\": {\"p50\": %llu, \"p99\": %llu, \"p999\": %llu, "
+                "\"mean\": %.0f, \"max\": %llu}, \"kernel_counters\": {%s}}\n",
+                options.mode.c_str(), options.label.c_str(), options.payloadSize, elapsed, static_cast<unsigned long long>(operations),
+                static_cast<unsigned long long>(errors), static_cast<double>(operations) / elapsed,
+                static_cast<unsigned long long>(snapshot.getPercentile(50)), static_cast<unsigned long long>(snapshot.getPercentile(99)),
+                static_cast<unsigned long long>(snapshot.getPercentile(99.9)), snapshot.getMean(),
+                static_cast<unsigned long long>(snapshot.maximum), counters.c_str());
+
+    // Wake the server thread up with one more connection, so it sees that it has to stop
+
+    isRunning.store(false);
+    try
+    {
+        FBNetwork::Client wakeUp(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", options.port);
+        wakeUp.connectToServer();
+    }
+    catch (std::exception &e)
+    {
+    }
+    serverThread.join();
+    return 0;
+}
@@ -0,0 +1,517 @@
+#include "../include/client.hpp"
+#include "../include/latencyHistogram.hpp"
+#include "../include/server.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Represents the options of a benchmark run.
+ * @version 1.0.0
+ */
+struct BenchmarkOptions
+{
+    std::string scenario    = "echo";
+    std::string label       = "";
+    int         threads     = 4;
+    int         connections = 1;
+    int         idle        = 0;
+    int         idleTimeout = 0;
+    int         seconds     = 5;
+    size_t      payloadSize = 64;
+    int         port        = 47001;
+};
+
+/**
+ * @brief Represents the resource usage of the process at one point in time.
+ * @version 1.0.0
+ */
+struct ResourceUsage
+{
+    double  userSeconds                = 0;
+    double  systemSeconds              = 0;
+    long    voluntaryContextSwitches   = 0;
+    long    involuntaryContextSwitches = 0;
+    long    maximumResidentSetSize     = 0;
+    int64_t readSystemCalls            = -1;
+    int64_t writeSystemCalls           = -1;
+};
+
+/**
+ * @brief Represents the counters shared by all client threads.
+ * @version 1.0.0
+ */
+struct BenchmarkResult
+{
+    FBNetwork::LatencyHistogram latency;
+    std::atomic<uint64_t>       operations{0};
+    std::atomic<uint64_t>       bytes{0};
+    std::atomic<uint64_t>       errors{0};
+    std::atomic<bool>           isDone{false};
+};
+
+static const std::string REQUEST  = "GET /benchmark HTTP/1.1\r\nHost: localhost\r\n\r\n";
+static const std::string RESPONSE = "HTTP/1.1 204 No Content\r\nServer: FBNetwork\r\n\r\n";
+static const std::string ACK      = "ACK\n";
+
+/**
+ * @brief Parses the command line options.
+ * @param t_argc The number of arguments.
+ * @param t_argv The arguments.
+ * @return The options.
+ * @version 1.0.0
+ */
+static BenchmarkOptions parseOptions(int t_argc, char **t_argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < t_argc; i++)
+    {
+        std::string argument = t_argv[i];
+        size_t      equals   = argument.find('=');
+        std::string key      = argument.substr(0, equals);
+        std::string value    = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--scenario")
+        {
+            options.scenario = value;
+        }
+        else if (key == "--label")
+        {
+            options.label = value;
+        }
+        else if (key == "--threads")
+        {
+            options.threads = std::atoi(value.c_str());
+        }
+        else if (key == "--connections")
+        {
+            options.connections = std::atoi(value.c_str());
+        }
+        else if (key == "--idle")
+        {
+            options.idle = std::atoi(value.c_str());
+        }
+        else if (key == "--idle-timeout")
+        {
+            options.idleTimeout = std::atoi(value.c_str());
+        }
+        else if (key == "--seconds")
+        {
+            options.seconds = std::atoi(value.c_str());
+        }
+        else if (key == "--size")
+        {
+            options.payloadSize = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--port")
+        {
+            options.port = std::atoi(value.c_str());
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argument.c_str());
+            std::exit(2);
+        }
+    }
+    if (options.scenario == "bulk" && options.payloadSize == 64)
+    {
+        options.payloadSize = 1 << 20;
+    }
+    if (options.threads < 1 || options.connections < 1 || options.idle < 0 || options.idleTimeout < 0 || options.seconds < 1 ||
+        options.payloadSize == 0)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        std::exit(2);
+    }
+    return options;
+}
+
+/**
+ * @brief Reads the resource usage of the process.
+ * @details The system call counts are read from `/proc/self/io` and stay -1 where it is not available.
+ * @return The resource usage.
+ * @version 1.0.0
+ */
+static ResourceUsage getResourceUsage()
+{
+    ResourceUsage usage;
+    rusage        resourceUsage = {};
+    getrusage(RUSAGE_SELF, &resourceUsage);
+    usage.userSeconds                = resourceUsage.ru_utime.tv_sec + resourceUsage.ru_utime.tv_usec / 1e6;
+    usage.systemSeconds              = resourceUsage.ru_stime.tv_sec + resourceUsage.ru_stime.tv_usec / 1e6;
+    usage.voluntaryContextSwitches   = resourceUsage.ru_nvcsw;
+    usage.involuntaryContextSwitches = resourceUsage.ru_nivcsw;
+    usage.maximumResidentSetSize     = resourceUsage.ru_maxrss;
+
+    std::ifstream io("/proc/self/io");
+    std::string   key;
+    int64_t       value = 0;
+    while (io >> key >> value)
+    {
+        if (key == "syscr:")
+        {
+            usage.readSystemCalls = value;
+        }
+        else if (key == "syscw:")
+        {
+            usage.writeSystemCalls = value;
+        }
+    }
+    return usage;
+}
+
+/**
+ * @brief Answers one message of a client according to the scenario.
+ * @param t_server The server.
+ * @param t_clientID The ID of the client.
+ * @param t_options The options.
+ * @throws `ServerRuntimeException` If the client disconnected or an error occurred.
+ * @throws `ServerTimeoutException` If the message did not arrive within the timeout.
+ * @version 1.0.0
+ */
+static void answerClient(FBNetwork::Server &t_server, const int t_clientID, const BenchmarkOptions &t_options)
+{
+    if (t_options.scenario == "request" || t_options.scenario == "accept")
+    {
+        t_server.readTillXData(t_clientID, "\r\n\r\n");
+        t_server.sendData(t_clientID, RESPONSE);
+    }
+    else if (t_options.scenario == "bulk")
+    {
+        t_server.readXData(t_clientID, static_cast<ssize_t>(t_options.payloadSize));
+        t_server.sendData(t_clientID, ACK);
+    }
+    else
+    {
+        t_server.readXData(t_clientID, static_cast<ssize_t>(t_options.payloadSize));
+        t_server.sendData(t_clientID, t_server.getData(t_clientID));
+    }
+}
+
+/**
+ * @brief Closes a client after a failed read.
+ * @details The client may already be gone if it disconnected while its event was pending, so errors are ignored.
+ * @param t_server The server.
+ * @param t_clientID The ID of the client.
+ * @version 1.0.0
+ */
+static void closeClient(FBNetwork::Server &t_server, const int t_clientID)
+{
+    try
+    {
+        t_server.closeClient(t_clientID);
+    }
+    catch (std::exception &e)
+    {
+    }
+}
+
+/**
+ * @brief Runs the event loop of the server until `t_isRunning` is cleared and one more event arrives.
+ * @details Data events are handled before new connections, because a client closed in this batch frees its ID for the next accepted
+ * client. New connections are accepted with `acceptAll`, so a burst of connections costs one event.
+ * @param t_server The server.
+ * @param t_options The options.
+ * @param t_isRunning Whether the server keeps running.
+ * @version 1.0.0
+ */
+static void runServer(FBNetwork::Server &t_server, const BenchmarkOptions &t_options, const std::atomic<bool> &t_isRunning)
+{
+    while (t_isRunning.load())
+    {
+        std::vector<FBNetwork::eventTuple> events;
+        try
+        {
+            events = t_server.getPendingEvents();
+        }
+        catch (std::exception &e)
+        {
+            continue;
+        }
+        bool hasPendingConnections = false;
+        for (FBNetwork::eventTuple event : events)
+        {
+            FBNetwork::EventType type     = std::get<0>(event);
+            int                  clientID = std::get<1>(event);
+            if (type == FBNetwork::EventType::CLIENT_WANTS_TO_CONNECT)
+            {
+                hasPendingConnections = true;
+                continue;
+            }
+            if (type != FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA)
+            {
+                continue;
+            }
+            try
+            {
+                answerClient(t_server, clientID, t_options);
+            }
+            catch (std::exception &e)
+            {
+                closeClient(t_server, clientID);
+            }
+        }
+        if (!hasPendingConnections)
+        {
+            continue;
+        }
+        try
+        {
+            t_server.acceptAll();
+        }
+        catch (std::exception &e)
+        {
+            std::fprintf(stderr, "Accepting clients failed: %s\n", e.what());
+        }
+    }
+}
+
+/**
+ * @brief Creates a client that is connected to the benchmark server.
+ * @param t_options The options.
+ * @return The connected client.
+ * @throws `ClientCreationException` If connecting failed.
+ * @version 1.0.0
+ */
+static std::unique_ptr<FBNetwork::Client> connectClient(const BenchmarkOptions &t_options)
+{
+    std::unique_ptr<FBNetwork::Client> client =
+        std::make_unique<FBNetwork::Client>(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", t_options.port);
+    client->setTimeout({5, 0});
+    client->connectToServer();
+    return client;
+}
+
+/**
+ * @brief Sends one message and waits for the answer according to the scenario.
+ * @param t_client The client.
+ * @param t_options The options.
+ * @param t_payload The payload for the echo and bulk scenarios.
+ * @return The number of bytes sent and received.
+ * @throws `ClientRuntimeException` If an error occurred.
+ * @throws `ClientTimeoutException` If the answer did not arrive within the timeout.
+ * @version 1.0.0
+ */
+static uint64_t exchangeMessage(FBNetwork::Client &t_client, const BenchmarkOptions &t_options, const std::string &t_payload)
+{
+    if (t_options.scenario == "request" || t_options.scenario == "accept")
+    {
+        t_client.sendData(REQUEST);
+        t_client.readTillXData("\r\n\r\n");
+        return REQUEST.size() + t_client.getData().size();
+    }
+    t_client.sendData(t_payload);
+    if (t_options.scenario == "bulk")
+    {
+        t_client.readXData(static_cast<ssize_t>(ACK.size()));
+        return t_payload.size() + ACK.size();
+    }
+    t_client.readXData(static_cast<ssize_t>(t_payload.size()));
+    return 2 * t_payload.size();
+}
+
+/**
+ * @brief Runs the client side of the benchmark on one thread.
+ * @details Every thread owns `connections` clients and sends one message at a time on each of them in turn. In the accept scenario
+ * every message uses a new connection instead.
+ * @param t_options The options.
+ * @param t_end The end of the measurement.
+ * @param t_result The shared result.
+ * @version 1.0.0
+ */
+static void runClients(const BenchmarkOptions &t_options, const std::chrono::steady_clock::time_point t_end, BenchmarkResult &t_result)
+{
+    std::string                                     payload(t_options.payloadSize, 'x');
+    std::vector<std::unique_ptr<FBNetwork::Client>> clients;
+    if (t_options.scenario == "burst")
+    {
+
+        // Keep the connections open until the server has accepted all of them
+
+        for (int i = 0; i < t_options.connections && std::chrono::steady_clock::now() < t_end; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            try
+            {
+                clients.push_back(connectClient(t_options));
+                t_result.latency.recordSince(start);
+                t_result.operations.fetch_add(1, std::memory_order_relaxed);
+            }
+            catch (std::exception &e)
+            {
+                t_result.errors.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        while (!t_result.isDone.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return;
+    }
+    if (t_options.scenario != "accept")
+    {
+        for (int i = 0; i < t_options.connections; i++)
+        {
+            clients.push_back(connectClient(t_options));
+        }
+    }
+    size_t next = 0;
+    while (std::chrono::steady_clock::now() < t_end)
+    {
+        auto start = std::chrono::steady_clock::now();
+        try
+        {
+            uint64_t bytes = 0;
+            if (t_options.scenario == "accept")
+            {
+                std::unique_ptr<FBNetwork::Client> client = connectClient(t_options);
+                bytes                                     = exchangeMessage(*client, t_options, payload);
+            }
+            else
+            {
+                bytes = exchangeMessage(*clients[next], t_options, payload);
+                next  = (next + 1) % clients.size();
+            }
+            t_result.latency.recordSince(start);
+            t_result.operations.fetch_add(1, std::memory_order_relaxed);
+            t_result.bytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+        catch (std::exception &e)
+        {
+            t_result.errors.fetch_add(1, std::memory_order_relaxed);
+            if (t_options.scenario != "accept")
+            {
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Measures `Server`, `Client` and `EventQueue` over loopback and prints the result as one JSON line.
+ * @details Usage: `loadGenerator [--scenario=echo|request|bulk|accept|burst|idle] [--threads=N] [--connections=N] [--idle=N]
+ * [--idle-timeout=MS] [--seconds=N] [--size=BYTES] [--port=N] [--label=TEXT]`. The server runs in the same process on its own thread,
+ * so the CPU time and system call counts cover both sides. The scenarios are
+ * - `echo`: every connection sends `size` bytes and reads them back.
+ * - `request`: every connection sends a small HTTP request, the server reads it with `readTillXData` and answers with a header.
+ * - `bulk`: every connection sends `size` bytes, 1 MiB by default, the server reads them with `readXData` and answers with a short ack.
+ * - `accept`: every message uses a new connection that is closed after the answer.
+ * - `burst`: all threads open `connections` connections at once, 10000 in total by default or as many as the file limit allows, and
+ *   the run ends when the server has accepted all of them. The operations are the accepted connections, the latency is the time of
+ *   `connect`.
+ * - `idle`: like `echo`, with `idle` additional connections that are open but never send anything.
+ *
+ * `--idle-timeout` sets the idle timeout of the server, so the cost of the client deadlines can be compared with a run without it.
+ *
+ * The system call counts are the `syscr` and `syscw` fields of `/proc/self/io`, which count `read` and `write` style calls but not
+ * `recv`, or -1 where the file does not exist. Pass the commit as `--label` to compare runs across commits. `Client` waits with
+ * `select`, so all file descriptors of the process have to stay below `FD_SETSIZE`.
+ * @version 1.0.0
+ */
+int main(int argc, char **argv)
+{
+    BenchmarkOptions  options = parseOptions(argc, argv);
+    BenchmarkResult   result;
+    std::atomic<bool> isRunning{true};
+    rlimit            fileLimit = {};
+    getrlimit(RLIMIT_NOFILE, &fileLimit);
+    fileLimit.rlim_cur = fileLimit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &fileLimit);
+    if (options.scenario == "burst" && options.connections == 1)
+    {
+
+        // Both ends of every connection live in this process
+
+        int burstSize       = static_cast<int>(std::min<rlim_t>(10000, (fileLimit.rlim_cur - 128) / 2));
+        options.connections = burstSize / options.threads;
+    }
+    if (options.scenario != "idle")
+    {
+        options.idle = 0;
+    }
+
+    FBNetwork::Server server(FBNetwork::Domain::IPV4_DOMAIN, options.port, options.threads * options.connections + options.idle + 64);
+    server.setTimeout({1, 0});
+    server.setIdleTimeout(std::chrono::milliseconds(options.idleTimeout));
+    server.startServer();
+    server.startListening();
+    std::thread serverThread(runServer, std::ref(server), std::cref(options), std::cref(isRunning));
+
+    std::vector<std::unique_ptr<FBNetwork::Client>> idleClients;
+    for (int i = 0; i < options.idle; i++)
+    {
+        idleClients.push_back(connectClient(options));
+    }
+
+    std::vector<std::thread> clientThreads;
+    ResourceUsage            before = getResourceUsage();
+    auto                     start  = std::chrono::steady_clock::now();
+    auto                     end    = start + std::chrono::seconds(options.seconds);
+    for (int i = 0; i < options.threads; i++)
+    {
+        clientThreads.emplace_back(runClients, std::cref(options), end, std::ref(result));
+    }
+    if (options.scenario == "burst")
+    {
+
+        // Measure until the server has accepted the whole burst, not until the clients have connected
+
+        uint64_t expectedAccepts = static_cast<uint64_t>(options.threads) * options.connections + options.idle;
+        while (server.getMetrics().accepts < expectedAccepts && std::chrono::steady_clock::now() < end)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        result.operations.store(server.getMetrics().accepts);
+        result.isDone.store(true);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (std::thread &clientThread : clientThreads)
+    {
+        clientThread.join();
+    }
+    if (options.scenario != "burst")
+    {
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    ResourceUsage after = getResourceUsage();
+
+    // Wake the server thread up with one more connection, so it sees that it has to stop
+
+    isRunning.store(false);
+    try
+    {
+        connectClient(options);
+    }
+    catch (std::exception &e)
+    {
+    }
+    serverThread.join();
+
+    FBNetwork::HistogramSnapshot latency    = result.latency.getSnapshot();
+    uint64_t                     operations = result.operations.load();
+    std::printf("{\"benchmark\": \"tcp_%s\", \"label\": \"%s\", \"threads\": %d, \"connections\": %d, \"idle_connections\": %d, "
+                "\"idle_timeout_ms\": %d, \"payload_size\": %zu, \"seconds\": %.3f, \"operations\": %llu, \"errors\": %llu, "
+                "\"operations_per_second\": %.0f, "
+                "\"bytes_per_second\": %.0f, \"latency_ns\": {\"p50\": %llu, \"p99\": %llu, \"p999\": %llu, \"mean\": %.0f, "
+                "\"max\": %llu}, \"cpu\": {\"user_seconds\": %.3f, \"system_seconds\": %.3f, \"voluntary_context_switches\": %ld, "
+                "\"involuntary_context_switches\": %ld, \"max_rss_kb\": %ld}, \"syscalls\": {\"syscr\": %lld, \"syscw\": %lld}}\n",
+                options.scenario.c_str(), options.label.c_str(), options.threads, options.connections, options.idle,
+                options.idleTimeout, options.payloadSize, elapsed, static_cast<unsigned long long>(operations),
+                static_cast<unsigned long long>(result.errors.load()), static_cast<double>(operations) / elapsed,
+                static_cast<double>(result.bytes.load()) / elapsed, static_cast<unsigned long long>(latency.getPercentile(50)),
+                static_cast<unsigned long long>(latency.getPercentile(99)),
+                static_cast<unsigned long long>(latency.getPercentile(99.9)), latency.getMean(),
+                static_cast<unsigned long long>(latency.maximum), after.userSeconds - before.userSeconds,
+                after.systemSeconds - before.systemSeconds, after.voluntaryContextSwitches - before.voluntaryContextSwitches,
+                after.involuntaryContextSwitches - before.involuntaryContextSwitches, after.maximumResidentSetSize,
+                static_cast<long long>(before.readSystemCalls == -1 ? -1 : after.readSystemCalls - before.readSystemCalls),
+                static_cast<long long>(before.writeSystemCalls == -1 ? -1 : after.writeSystemCalls - before.writeSystemCalls));
+    return 0;
+}
@@ -0,0 +1,277 @@
+#include "../include/client.hpp"
+#include "../include/latencyHistogram.hpp"
+#include "../include/server.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Represents the options of a benchmark run.
+ * @version 1.0.0
+ */
+struct BenchmarkOptions
+{
+    std::string policy           = "pause";
+    std::string label            = "";
+    int         maximumClients   = 32;
+    size_t      clients          = 128;
+    int         holdMilliseconds = 20;
+    int         seconds          = 5;
+    int         port             = 47108;
+};
+
+static const size_t MESSAGE_SIZE = 16;
+
+/**
+ * @brief Parses the command line options.
+ * @param t_argc The number of arguments.
+ * @param t_argv The arguments.
+ * @return The options.
+ * @version 1.0.0
+ */
+static BenchmarkOptions parseOptions(int t_argc, char **t_argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < t_argc; i++)
+    {
+        std::string argument = t_argv[i];
+        size_t      equals   = argument.find('=');
+        std::string key      = argument.substr(0, equals);
+        std::string value    = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--policy")
+        {
+            options.policy = value;
+        }
+        else if (key == "--label")
+        {
+            options.label = value;
+        }
+        else if (key == "--max")
+        {
+            options.maximumClients = std::atoi(value.c_str());
+        }
+        else if (key == "--clients")
+        {
+            options.clients = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--hold-ms")
+        {
+            options.holdMilliseconds = std::atoi(value.c_str());
+        }
+        else if (key == "--seconds")
+        {
+            options.seconds = std::atoi(value.c_str());
+        }
+        else if (key == "--port")
+        {
+            options.port = std::atoi(value.c_str());
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argument.c_str());
+            std::exit(2);
+        }
+    }
+    if ((options.policy != "throw" && options.policy != "pause" && options.policy != "close") || options.maximumClients < 1 ||
+        options.clients == 0 || options.holdMilliseconds < 0 || options.seconds < 1)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        std::exit(2);
+    }
+    return options;
+}
+
+/**
+ * @brief Retrieves the CPU time of the calling thread in seconds.
+ * @return The CPU time.
+ * @version 1.0.0
+ */
+static double getThreadCpuSeconds()
+{
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) / 1e9;
+}
+
+/**
+ * @brief Runs the event loop of the server until `t_isRunning` is cleared and one more event arrives.
+ * @details Every message is answered with a message of the same size, a client that has closed its side is closed.
+ * @param t_server The server.
+ * @param t_isRunning Whether the server keeps running.
+ * @param t_wakeUps The number of returns from `getPendingEvents()`.
+ * @param t_failedAccepts The number of `acceptAll()` calls that threw.
+ * @param t_cpuSeconds The CPU time the event loop used.
+ * @version 1.0.0
+ */
+static void runServer(FBNetwork::Server &t_server, const std::atomic<bool> &t_isRunning, uint64_t &t_wakeUps, uint64_t &t_failedAccepts,
+                      double &t_cpuSeconds)
+{
+    double cpuStart = getThreadCpuSeconds();
+    while (t_isRunning.load())
+    {
+        std::vector<FBNetwork::eventTuple> events;
+        try
+        {
+            events = t_server.getPendingEvents();
+        }
+        catch (std::exception &e)
+        {
+            continue;
+        }
+        t_wakeUps++;
+        for (FBNetwork::eventTuple event : events)
+        {
+            int clientID = std::get<1>(event);
+            if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_CONNECT)
+            {
+                try
+                {
+                    t_server.acceptAll();
+                }
+                catch (std::exception &e)
+                {
+                    t_failedAccepts++;
+                }
+                continue;
+            }
+            if (std::get<0>(event) != FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA)
+            {
+                continue;
+            }
+            try
+            {
+                t_server.readXData(clientID, static_cast<ssize_t>(MESSAGE_SIZE));
+                t_server.sendData(clientID, t_server.getData(clientID));
+            }
+            catch (std::exception &e)
+            {
+                try
+                {
+                    t_server.closeClient(clientID);
+                }
+                catch (std::exception &e)
+                {
+                }
+            }
+        }
+    }
+    t_cpuSeconds = getThreadCpuSeconds() - cpuStart;
+}
+
+/**
+ * @brief Opens connections one after another, sends one message on each, holds it for a while and closes it until the end of the run.
+ * @param t_options The options.
+ * @param t_end The end of the run.
+ * @param t_latency The time from connecting until the answer was read.
+ * @param t_rejected The number of connections that were closed or timed out without an answer.
+ * @version 1.0.0
+ */
+static void runClient(const BenchmarkOptions &t_options, const std::chrono::steady_clock::time_point t_end,
+                      FBNetwork::LatencyHistogram &t_latency, std::atomic<uint64_t> &t_rejected)
+{
+    std::string message(MESSAGE_SIZE, 'm');
+    while (std::chrono::steady_clock::now() < t_end)
+    {
+        auto operationStart = std::chrono::steady_clock::now();
+        try
+        {
+            FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", t_options.port);
+            client.setTimeout({2, 0});
+            client.connectToServer();
+            client.sendData(message);
+            client.readXData(static_cast<ssize_t>(MESSAGE_SIZE));
+            t_latency.recordSince(operationStart);
+            std::this_thread::sleep_for(std::chrono::milliseconds(t_options.holdMilliseconds));
+            client.disconnectFromServer();
+        }
+        catch (std::exception &e)
+        {
+            t_rejected.fetch_add(1);
+
+            // Back off a little like a real client, so a shed connection is not retried in a tight loop
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
+/**
+ * @brief Connects more clients than the server takes and prints one JSON line.
+ * @details Usage: `overload [--policy=throw|pause|close] [--max=N] [--clients=N] [--hold-ms=MILLISECONDS] [--seconds=N] [--port=N]
+ * [--label=TEXT]`. The server takes `max` clients, `clients` threads keep opening connections that send one message and stay open for
+ * `hold-ms` after the answer. With `throw` the listening socket stays readable while the server is full, so the event loop wakes up
+ * for nothing, with `pause` it stops watching the listener, with `close` it sheds the surplus connections with a short response.
+ * `loop_cpu_seconds` is the CPU time of the event loop, `wake_ups` how often `getPendingEvents()` returned.
+ * @version 1.0.0
+ */
+int main(int argc, char **argv)
+{
+    BenchmarkOptions  options = parseOptions(argc, argv);
+    std::atomic<bool> isRunning{true};
+    std::signal(SIGPIPE, SIG_IGN);
+
+    FBNetwork::Server server(FBNetwork::Domain::IPV4_DOMAIN, options.port, options.maximumClients);
+    server.setTimeout({10, 0});
+    if (options.policy == "pause")
+    {
+        server.setOverloadPolicy(FBNetwork::OverloadPolicy::PAUSE_ACCEPTING);
+    }
+    else if (options.policy == "close")
+    {
+        server.setOverloadPolicy(FBNetwork::OverloadPolicy::ACCEPT_AND_CLOSE, "BUSY\n");
+    }
+    server.startServer();
+    server.startListening();
+    uint64_t    wakeUps       = 0;
+    uint64_t    failedAccepts = 0;
+    double      cpuSeconds    = 0;
+    std::thread serverThread(runServer, std::ref(server), std::cref(isRunning), std::ref(wakeUps), std::ref(failedAccepts),
+                             std::ref(cpuSeconds));
+
+    FBNetwork::LatencyHistogram latency;
+    std::atomic<uint64_t>       rejected{0};
+    std::vector<std::thread>    clients;
+    auto                        start = std::chrono::steady_clock::now();
+    auto                        end   = start + std::chrono::seconds(options.seconds);
+    for (size_t i = 0; i < options.clients; i++)
+    {
+        clients.emplace_back(runClient, std::cref(options), end, std::ref(latency), std::ref(rejected));
+    }
+    for (std::thread &client : clients)
+    {
+        client.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Wake the server thread up with one more connection, so it sees that it has to stop
+
+    isRunning.store(false);
+    server.setOverloadPolicy(FBNetwork::OverloadPolicy::ACCEPT_AND_CLOSE);
+    try
+    {
+        FBNetwork::Client wakeUp(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", options.port);
+        wakeUp.connectToServer();
+    }
+    catch (std::exception &e)
+    {
+    }
+    serverThread.join();
+
+    FBNetwork::HistogramSnapshot     snapshot = latency.getSnapshot();
+    FBNetwork::ServerMetricsSnapshot metrics  = server.getMetrics();
+    std::printf("{\"benchmark\": \"overload_%s\", \"label\": \"%s\", \"max\": %d, \"clients\": %zu, \"seconds\": %.3f, "
+                "\"loop_cpu_seconds\": %.3f, \"wake_ups\": %llu, \"failed_accepts\": %llu, \"shed\": %llu, \"rejected\": %llu, "
+                "\"served\": %llu, \"latency_ns\": {\"p50\": %llu, \"p99\": %llu, \"max\": %llu}}\n",
+                options.policy.c_str(), options.label.c_str(), options.maximumClients, options.clients, elapsed, cpuSeconds,
+                static_cast<unsigned long long>(wakeUps), static_cast<unsigned long long>(failedAccepts),
+                static_cast<unsigned long long>(metrics.shedConnections), static_cast<unsigned long long>(rejected.load()),
+                static_cast<unsigned long long>(snapshot.count), static_cast<unsigned long long>(snapshot.getPercentile(50)),
+                static_cast<unsigned long long>(snapshot.getPercentile(99)), static_cast<unsigned long long>(snapshot.maximum));
+    return 0;
+}
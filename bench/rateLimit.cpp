@@ -0,0 +1,290 @@
+#include "../include/client.hpp"
+#include "../include/latencyHistogram.hpp"
+#include "../include/server.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Represents the options of a benchmark run.
+ * @version 1.0.0
+ */
+struct BenchmarkOptions
+{
+    std::string mode              = "limited";
+    std::string label             = "";
+    size_t      lightConnections  = 4;
+    size_t      floodConnections  = 1;
+    size_t      floodBatch        = 256;
+    double      messagesPerSecond = 2000;
+    int         seconds           = 5;
+    int         port              = 47107;
+};
+
+static const size_t MESSAGE_SIZE = 16;
+
+/**
+ * @brief Parses the command line options.
+ * @param t_argc The number of arguments.
+ * @param t_argv The arguments.
+ * @return The options.
+ * @version 1.0.0
+ */
+static BenchmarkOptions parseOptions(int t_argc, char **t_argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < t_argc; i++)
+    {
+        std::string argument = t_argv[i];
+        size_t      equals   = argument.find('=');
+        std::string key      = argument.substr(0, equals);
+        std::string value    = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--mode")
+        {
+            options.mode = value;
+        }
+        else if (key == "--label")
+        {
+            options.label = value;
+        }
+        else if (key == "--light")
+        {
+            options.lightConnections = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--flood")
+        {
+            options.floodConnections = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--flood-batch")
+        {
+            options.floodBatch = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--messages-per-second")
+        {
+            options.messagesPerSecond = std::strtod(value.c_str(), nullptr);
+        }
+        else if (key == "--seconds")
+        {
+            options.seconds = std::atoi(value.c_str());
+        }
+        else if (key == "--port")
+        {
+            options.port = std::atoi(value.c_str());
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argument.c_str());
+            std::exit(2);
+        }
+    }
+    if ((options.mode != "limited" && options.mode != "unlimited") || options.lightConnections == 0 || options.floodBatch == 0 ||
+        !(options.messagesPerSecond > 0) || options.seconds < 1)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        std::exit(2);
+    }
+    return options;
+}
+
+/**
+ * @brief Runs the event loop of the server until `t_isRunning` is cleared and one more event arrives.
+ * @details Every message is answered with a message of the same size.
+ * @param t_server The server.
+ * @param t_isRunning Whether the server keeps running.
+ * @version 1.0.0
+ */
+static void runServer(FBNetwork::Server &t_server, const std::atomic<bool> &t_isRunning)
+{
+    while (t_isRunning.load())
+    {
+        std::vector<FBNetwork::eventTuple> events;
+        try
+        {
+            events = t_server.getPendingEvents();
+        }
+        catch (std::exception &e)
+        {
+            continue;
+        }
+        for (FBNetwork::eventTuple event : events)
+        {
+            int clientID = std::get<1>(event);
+            if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_CONNECT)
+            {
+                try
+                {
+                    t_server.acceptAll();
+                }
+                catch (std::exception &e)
+                {
+                    std::fprintf(stderr, "Accepting clients failed: %s\n", e.what());
+                }
+                continue;
+            }
+            if (std::get<0>(event) != FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA)
+            {
+                continue;
+            }
+            try
+            {
+                t_server.readXData(clientID, static_cast<ssize_t>(MESSAGE_SIZE));
+                t_server.sendData(clientID, t_server.getData(clientID));
+            }
+            catch (std::exception &e)
+            {
+                try
+                {
+                    t_server.closeClient(clientID);
+                }
+                catch (std::exception &e)
+                {
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sends one message at a time on one connection and waits for its answer until the end of the run.
+ * @param t_options The options.
+ * @param t_end The end of the run.
+ * @param t_latency The time from sending a message until its answer was read.
+ * @param t_errors The number of failed connections.
+ * @version 1.0.0
+ */
+static void runLightConnection(const BenchmarkOptions &t_options, const std::chrono::steady_clock::time_point t_end,
+                               FBNetwork::LatencyHistogram &t_latency, std::atomic<uint64_t> &t_errors)
+{
+    std::string message(MESSAGE_SIZE, 'l');
+    try
+    {
+        FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", t_options.port);
+        client.setTimeout({10, 0});
+        client.connectToServer();
+        while (std::chrono::steady_clock::now() < t_end)
+        {
+            auto operationStart = std::chrono::steady_clock::now();
+            client.sendData(message);
+            client.readXData(static_cast<ssize_t>(MESSAGE_SIZE));
+            t_latency.recordSince(operationStart);
+
+            // A well-behaved client sends far below the limit
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        client.disconnectFromServer();
+    }
+    catch (std::exception &e)
+    {
+        t_errors.fetch_add(1);
+    }
+}
+
+/**
+ * @brief Sends batches of pipelined messages on one connection as fast as the answers come back until the end of the run.
+ * @param t_options The options.
+ * @param t_end The end of the run.
+ * @param t_messages The number of answered messages.
+ * @param t_errors The number of failed connections.
+ * @version 1.0.0
+ */
+static void runFloodConnection(const BenchmarkOptions &t_options, const std::chrono::steady_clock::time_point t_end,
+                               std::atomic<uint64_t> &t_messages, std::atomic<uint64_t> &t_errors)
+{
+    std::string batch(MESSAGE_SIZE * t_options.floodBatch, 'f');
+    try
+    {
+        FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", t_options.port);
+        client.setTimeout({10, 0});
+        client.connectToServer();
+        while (std::chrono::steady_clock::now() < t_end)
+        {
+            client.sendData(batch);
+            client.readXData(static_cast<ssize_t>(batch.size()));
+            t_messages.fetch_add(t_options.floodBatch);
+        }
+        client.disconnectFromServer();
+    }
+    catch (std::exception &e)
+    {
+        t_errors.fetch_add(1);
+    }
+}
+
+/**
+ * @brief Measures the latency of well-behaved clients while other clients flood the same server with pipelined messages and prints
+ * one JSON line.
+ * @details Usage: `rateLimit [--mode=limited|unlimited] [--light=N] [--flood=N] [--flood-batch=N] [--messages-per-second=N]
+ * [--seconds=N] [--port=N] [--label=TEXT]`. `light` connections send one message per millisecond and wait for each answer, `flood`
+ * connections send `flood-batch` messages at once. With `limited` the server allows every client `messages-per-second` messages, so
+ * the flooding clients are paused by `Server::setRateLimits()` instead of taking the event loop from the others.
+ * @version 1.0.0
+ */
+int main(int argc, char **argv)
+{
+    BenchmarkOptions  options = parseOptions(argc, argv);
+    std::atomic<bool> isRunning{true};
+    std::signal(SIGPIPE, SIG_IGN);
+
+    FBNetwork::Server server(FBNetwork::Domain::IPV4_DOMAIN, options.port, 1024);
+    server.setTimeout({10, 0});
+    if (options.mode == "limited")
+    {
+        FBNetwork::RateLimits rateLimits;
+        rateLimits.messagesPerSecond = options.messagesPerSecond;
+        server.setRateLimits(rateLimits);
+    }
+    server.startServer();
+    server.startListening();
+    std::thread serverThread(runServer, std::ref(server), std::cref(isRunning));
+
+    FBNetwork::LatencyHistogram lightLatency;
+    std::atomic<uint64_t>       floodMessages{0};
+    std::atomic<uint64_t>       errors{0};
+    std::vector<std::thread>    connections;
+    auto                        start = std::chrono::steady_clock::now();
+    auto                        end   = start + std::chrono::seconds(options.seconds);
+    for (size_t i = 0; i < options.floodConnections; i++)
+    {
+        connections.emplace_back(runFloodConnection, std::cref(options), end, std::ref(floodMessages), std::ref(errors));
+    }
+    for (size_t i = 0; i < options.lightConnections; i++)
+    {
+        connections.emplace_back(runLightConnection, std::cref(options), end, std::ref(lightLatency), std::ref(errors));
+    }
+    for (std::thread &connection : connections)
+    {
+        connection.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Wake the server thread up with one more connection, so it sees that it has to stop
+
+    isRunning.store(false);
+    try
+    {
+        FBNetwork::Client wakeUp(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", options.port);
+        wakeUp.connectToServer();
+    }
+    catch (std::exception &e)
+    {
+    }
+    serverThread.join();
+
+    FBNetwork::HistogramSnapshot     light   = lightLatency.getSnapshot();
+    FBNetwork::ServerMetricsSnapshot metrics = server.getMetrics();
+    std::printf("{\"benchmark\": \"rate_limit_%s\", \"label\": \"%s\", \"messages_per_second\": %.0f, \"seconds\": %.3f, "
+                "\"errors\": %llu, \"paused_reads\": %llu, \"flood_messages_per_second\": %.0f, \"light\": {\"operations\": %llu, "
+                "\"latency_ns\": {\"p50\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu}}}\n",
+                options.mode.c_str(), options.label.c_str(), options.mode == "limited" ? options.messagesPerSecond : 0.0, elapsed,
+                static_cast<unsigned long long>(errors.load()), static_cast<unsigned long long>(metrics.pausedReads),
+                static_cast<double>(floodMessages.load()) / elapsed, static_cast<unsigned long long>(light.count),
+                static_cast<unsigned long long>(light.getPercentile(50)), static_cast<unsigned long long>(light.getPercentile(99)),
+                static_cast<unsigned long long>(light.getPercentile(99.9)), static_cast<unsigned long long>(light.maximum));
+    return 0;
+}
@@ -0,0 +1,342 @@
+#include "../include/client.hpp"
+#include "../include/latencyHistogram.hpp"
+#include "../include/rpc.hpp"
+#include "../include/server.hpp"
+#include "../include/taskPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Represents the options of a benchmark run.
+ * @version 1.0.0
+ */
+struct BenchmarkOptions
+{
+    std::string mode                 = "rpc";
+    std::string label                = "";
+    size_t      inFlight             = 64;
+    size_t      workers              = 4;
+    int         delayMicroseconds    = 0;
+    int         deadlineMilliseconds = 1000;
+    int         seconds              = 5;
+    int         port                 = 47109;
+};
+
+static const size_t MESSAGE_SIZE = 64;
+
+/**
+ * @brief Parses the command line options.
+ * @param t_argc The number of arguments.
+ * @param t_argv The arguments.
+ * @return The options.
+ * @version 1.0.0
+ */
+static BenchmarkOptions parseOptions(int t_argc, char **t_argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < t_argc; i++)
+    {
+        std::string argument = t_argv[i];
+        size_t      equals   = argument.find('=');
+        std::string key      = argument.substr(0, equals);
+        std::string value    = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--mode")
+        {
+            options.mode = value;
+        }
+        else if (key == "--label")
+        {
+            options.label = value;
+        }
+        else if (key == "--in-flight")
+        {
+            options.inFlight = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--workers")
+        {
+            options.workers = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--delay-us")
+        {
+            options.delayMicroseconds = std::atoi(value.c_str());
+        }
+        else if (key == "--deadline-ms")
+        {
+            options.deadlineMilliseconds = std::atoi(value.c_str());
+        }
+        else if (key == "--seconds")
+        {
+            options.seconds = std::atoi(value.c_str());
+        }
+        else if (key == "--port")
+        {
+            options.port = std::atoi(value.c_str());
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argument.c_str());
+            std::exit(2);
+        }
+    }
+    if ((options.mode != "rpc" && options.mode != "lockstep") || options.inFlight == 0 || options.workers == 0 ||
+        options.delayMicroseconds < 0 || options.deadlineMilliseconds < 0 || options.seconds < 1)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        std::exit(2);
+    }
+    return options;
+}
+
+/**
+ * @brief Runs the event loop of the server until `t_isRunning` is cleared and one more event arrives.
+ * @details Every request is answered with itself. Without a delay it is answered on the event loop, otherwise a handler on the task
+ * pool sleeps for the delay first, like a call to a backend. In `rpc` mode the handlers of one connection run in parallel, in `lockstep`
+ * mode the client waits for every response anyway.
+ * @param t_server The server.
+ * @param t_taskPool The task pool of the handlers.
+ * @param t_options The options.
+ * @param t_isRunning Whether the server keeps running.
+ * @version 1.0.0
+ */
+static void runServer(FBNetwork::Server &t_server, FBNetwork::TaskPool &t_taskPool, const BenchmarkOptions &t_options,
+                      const std::atomic<bool> &t_isRunning)
+{
+    std::chrono::microseconds delay(t_options.delayMicroseconds);
+    while (t_isRunning.load())
+    {
+        std::vector<FBNetwork::eventTuple> events;
+        try
+        {
+            events = t_server.getPendingEvents();
+        }
+        catch (std::exception &e)
+        {
+            continue;
+        }
+        for (FBNetwork::eventTuple event : events)
+        {
+            int clientID = std::get<1>(event);
+            if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_CONNECT)
+            {
+                try
+                {
+                    t_server.acceptAll();
+                }
+                catch (std::exception &e)
+                {
+                    std::fprintf(stderr, "Accepting clients failed: %s\n", e.what());
+                }
+                continue;
+            }
+            if (std::get<0>(event) != FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA)
+            {
+                continue;
+            }
+            try
+            {
+                if (t_options.mode == "rpc")
+                {
+                    uint64_t    correlationID = t_server.readRpcRequest(clientID);
+                    std::string request       = t_server.getData(clientID);
+                    if (delay.count() == 0)
+                    {
+                        t_server.sendRpcResponse(clientID, correlationID, request);
+                        continue;
+                    }
+                    t_server.dispatchRpc(t_taskPool, clientID, correlationID,
+                                         [request, delay]()
+                                         {
+                                             std::this_thread::sleep_for(delay);
+                                             return request;
+                                         });
+                    continue;
+                }
+                t_server.readXData(clientID, static_cast<ssize_t>(MESSAGE_SIZE));
+                std::string request = t_server.getData(clientID);
+                if (delay.count() == 0)
+                {
+                    t_server.sendData(clientID, request);
+                    continue;
+                }
+                t_server.dispatch(t_taskPool, clientID,
+                                  [request, delay]()
+                                  {
+                                      std::this_thread::sleep_for(delay);
+                                      return request;
+                                  });
+            }
+            catch (std::exception &e)
+            {
+                try
+                {
+                    t_server.closeClient(clientID);
+                }
+                catch (std::exception &e)
+                {
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sends one request at a time and waits for its response, the pattern of plain `Client` calls.
+ * @param t_options The options.
+ * @param t_end The end of the run.
+ * @param t_latency The time from sending a request until its response was read.
+ * @param t_errors The number of failed requests.
+ * @version 1.0.0
+ */
+static void runLockstep(const BenchmarkOptions &t_options, const std::chrono::steady_clock::time_point t_end,
+                        FBNetwork::LatencyHistogram &t_latency, uint64_t &t_errors)
+{
+    std::string request(MESSAGE_SIZE, 'r');
+    try
+    {
+        FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", t_options.port);
+        client.setTimeout({10, 0});
+        client.connectToServer();
+        while (std::chrono::steady_clock::now() < t_end)
+        {
+            auto operationStart = std::chrono::steady_clock::now();
+            client.sendData(request);
+            client.readXData(static_cast<ssize_t>(MESSAGE_SIZE));
+            t_latency.recordSince(operationStart);
+        }
+        client.disconnectFromServer();
+    }
+    catch (std::exception &e)
+    {
+        t_errors++;
+    }
+}
+
+/**
+ * @brief Keeps `in-flight` calls in flight on one connection until the end of the run and waits for the last responses.
+ * @param t_options The options.
+ * @param t_end The end of the run.
+ * @param t_latency The time from sending a call until its callback ran.
+ * @param t_errors The number of failed calls, timed out ones included.
+ * @version 1.0.0
+ */
+static void runRpc(const BenchmarkOptions &t_options, const std::chrono::steady_clock::time_point t_end,
+                   FBNetwork::LatencyHistogram &t_latency, uint64_t &t_errors)
+{
+    std::string             request(MESSAGE_SIZE, 'r');
+    std::mutex              mutex;
+    std::condition_variable hasRoom;
+    size_t                  inFlight = 0;
+    std::atomic<uint64_t>   errors{0};
+    try
+    {
+        std::shared_ptr<FBNetwork::Client> client =
+            std::make_shared<FBNetwork::Client>(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", t_options.port);
+        client->setTimeout({10, 0});
+        client->connectToServer();
+        FBNetwork::RpcClient rpcClient(client);
+        while (std::chrono::steady_clock::now() < t_end)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                hasRoom.wait(lock, [&inFlight, &t_options]() { return inFlight < t_options.inFlight; });
+                inFlight++;
+            }
+            auto operationStart = std::chrono::steady_clock::now();
+            rpcClient.call(
+                request,
+                [&, operationStart](const std::string &t_response, std::exception_ptr t_error)
+                {
+                    if (t_error != nullptr || t_response.size() != MESSAGE_SIZE)
+                    {
+                        errors.fetch_add(1);
+                    }
+                    else
+                    {
+                        t_latency.recordSince(operationStart);
+                    }
+                    std::lock_guard<std::mutex> lock(mutex);
+                    inFlight--;
+                    hasRoom.notify_one();
+                },
+                std::chrono::milliseconds(t_options.deadlineMilliseconds));
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        hasRoom.wait(lock, [&inFlight]() { return inFlight == 0; });
+        lock.unlock();
+        rpcClient.close();
+        client->disconnectFromServer();
+    }
+    catch (std::exception &e)
+    {
+        errors.fetch_add(1);
+    }
+    t_errors = errors.load();
+}
+
+/**
+ * @brief Measures requests per second on one connection, with many calls in flight or one at a time, and prints one JSON line.
+ * @details Usage: `rpc [--mode=rpc|lockstep] [--in-flight=N] [--delay-us=MICROSECONDS] [--workers=N] [--deadline-ms=MILLISECONDS]
+ * [--seconds=N] [--port=N] [--label=TEXT]`. `lockstep` sends a request and reads its response before it sends the next one, so it
+ * does at most one request per round trip. `rpc` keeps `in-flight` calls of an `RpcClient` in flight. With `delay-us` every request
+ * takes that long on one of `workers` handler threads of the server.
+ * @version 1.0.0
+ */
+int main(int argc, char **argv)
+{
+    BenchmarkOptions  options = parseOptions(argc, argv);
+    std::atomic<bool> isRunning{true};
+    std::signal(SIGPIPE, SIG_IGN);
+
+    FBNetwork::Server server(FBNetwork::Domain::IPV4_DOMAIN, options.port, 16);
+    server.setTimeout({10, 0});
+    server.startServer();
+    server.startListening();
+    FBNetwork::TaskPool taskPool(options.workers);
+    std::thread         serverThread(runServer, std::ref(server), std::ref(taskPool), std::cref(options), std::cref(isRunning));
+
+    FBNetwork::LatencyHistogram latency;
+    uint64_t                    errors = 0;
+    auto                        start  = std::chrono::steady_clock::now();
+    auto                        end    = start + std::chrono::seconds(options.seconds);
+    if (options.mode == "rpc")
+    {
+        runRpc(options, end, latency, errors);
+    }
+    else
+    {
+        runLockstep(options, end, latency, errors);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Wake the server thread up with one more connection, so it sees that it has to stop
+
+    isRunning.store(false);
+    try
+    {
+        FBNetwork::Client wakeUp(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", options.port);
+        wakeUp.connectToServer();
+    }
+    catch (std::exception &e)
+    {
+    }
+    serverThread.join();
+    taskPool.waitUntilIdle();
+
+    FBNetwork::HistogramSnapshot snapshot = latency.getSnapshot();
+    std::printf("{\"benchmark\": \"rpc_%s\", \"label\": \"%s\", \"in_flight\": %zu, \"delay_us\": %d, \"workers\": %zu, "
+                "\"seconds\": %.3f, \"requests\": %llu, \"requests_per_second\": %.0f, \"errors\": %llu, "
+                "\"latency_ns\": {\"p50\": %llu, \"p99\": %llu, \"max\": %llu}}\n",
+                options.mode.c_str(), options.label.c_str(), options.mode == "rpc" ? options.inFlight : size_t(1),
+                options.delayMicroseconds, options.workers, elapsed, static_cast<unsigned long long>(snapshot.count),
+                static_cast<double>(snapshot.count) / elapsed, static_cast<unsigned long long>(errors),
+                static_cast<unsigned long long>(snapshot.getPercentile(50)), static_cast<unsigned long long>(snapshot.getPercentile(99)),
+                static_cast<unsigned long long>(snapshot.maximum));
+    return 0;
+}
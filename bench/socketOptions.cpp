@@ -0,0 +1,247 @@
+#include "../include/client.hpp"
+#include "../include/latencyHistogram.hpp"
+#include "../include/server.hpp"
+#include "../include/socketOptions.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Represents the options of a benchmark run.
+ * @version 1.0.0
+ */
+struct BenchmarkOptions
+{
+    std::string mode        = "default";
+    std::string label       = "";
+    int         seconds     = 5;
+    size_t      payloadSize = 64;
+    int         port        = 47102;
+};
+
+static const std::string HEADER = "FRAME-HEADER-16\n";
+
+/**
+ * @brief Parses the command line options.
+ * @param t_argc The number of arguments.
+ * @param t_argv The arguments.
+ * @return The options.
+ * @version 1.0.0
+ */
+static BenchmarkOptions parseOptions(int t_argc, char **t_argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < t_argc; i++)
+    {
+        std::string argument = t_argv[i];
+        size_t      equals   = argument.find('=');
+        std::string key      = argument.substr(0, equals);
+        std::string value    = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--mode")
+        {
+            options.mode = value;
+        }
+        else if (key == "--label")
+        {
+            options.label = value;
+        }
+        else if (key == "--seconds")
+        {
+            options.seconds = std::atoi(value.c_str());
+        }
+        else if (key == "--size")
+        {
+            options.payloadSize = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--port")
+        {
+            options.port = std::atoi(value.c_str());
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argument.c_str());
+            std::exit(2);
+        }
+    }
+    if ((options.mode != "default" && options.mode != "nodelay" && options.mode != "cork" && options.mode != "quickack") ||
+        options.seconds < 1 || options.payloadSize == 0)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        std::exit(2);
+    }
+    return options;
+}
+
+/**
+ * @brief Builds the socket options of a mode.
+ * @param t_mode The mode.
+ * @return The socket options.
+ * @version 1.0.0
+ */
+static FBNetwork::SocketOptions getSocketOptions(const std::string &t_mode)
+{
+    FBNetwork::SocketOptions socketOptions;
+    if (t_mode == "nodelay")
+    {
+        socketOptions.setNoDelay(true);
+    }
+    else if (t_mode == "cork")
+    {
+        socketOptions.setCork(true);
+    }
+    else if (t_mode == "quickack")
+    {
+        socketOptions.setQuickAck(true);
+    }
+    return socketOptions;
+}
+
+/**
+ * @brief Runs the event loop of the server until `t_isRunning` is cleared and one more event arrives.
+ * @details Every request is answered with a header and a body in two writes, like a response with a separate header.
+ * @param t_server The server.
+ * @param t_options The options.
+ * @param t_isRunning Whether the server keeps running.
+ * @version 1.0.0
+ */
+static void runServer(FBNetwork::Server &t_server, const BenchmarkOptions &t_options, const std::atomic<bool> &t_isRunning)
+{
+    std::string body(t_options.payloadSize, 'y');
+    while (t_isRunning.load())
+    {
+        std::vector<FBNetwork::eventTuple> events;
+        try
+        {
+            events = t_server.getPendingEvents();
+        }
+        catch (std::exception &e)
+        {
+            continue;
+        }
+        for (FBNetwork::eventTuple event : events)
+        {
+            int clientID = std::get<1>(event);
+            if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_CONNECT)
+            {
+                try
+                {
+                    t_server.acceptAll();
+                }
+                catch (std::exception &e)
+                {
+                    std::fprintf(stderr, "Accepting clients failed: %s\n", e.what());
+                }
+                continue;
+            }
+            if (std::get<0>(event) != FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA)
+            {
+                continue;
+            }
+            try
+            {
+                t_server.readXData(clientID, static_cast<ssize_t>(HEADER.size() + t_options.payloadSize));
+                t_server.sendData(clientID, HEADER);
+                t_server.sendData(clientID, body);
+                t_server.flush(clientID);
+            }
+            catch (std::exception &e)
+            {
+                try
+                {
+                    t_server.closeClient(clientID);
+                }
+                catch (std::exception &e)
+                {
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Measures the latency of small requests and responses that are written in two parts over loopback and prints one JSON line.
+ * @details Usage: `socketOptions [--mode=default|nodelay|cork|quickack] [--seconds=N] [--size=BYTES] [--port=N] [--label=TEXT]`. One
+ * connection sends a header and a body of `size` bytes, 64 by default, in two writes and reads a response that the server writes the
+ * same way. With the default options, Nagle's algorithm holds the second write back until the first is acknowledged, and the peer
+ * delays that ACK. The modes set the same options on both sides:
+ * - `default`: the options of the system.
+ * - `nodelay`: `TCP_NODELAY`, every write leaves right away.
+ * - `cork`: `TCP_CORK` and a flush after the body, both parts leave in one segment.
+ * - `quickack`: `TCP_QUICKACK` before every read, Nagle stays on but the ACK it waits for is not delayed.
+ * @version 1.0.0
+ */
+int main(int argc, char **argv)
+{
+    BenchmarkOptions  options = parseOptions(argc, argv);
+    std::atomic<bool> isRunning{true};
+    std::signal(SIGPIPE, SIG_IGN);
+
+    FBNetwork::SocketOptions socketOptions = getSocketOptions(options.mode);
+    FBNetwork::Server        server(FBNetwork::Domain::IPV4_DOMAIN, options.port, 64);
+    server.setTimeout({5, 0});
+    server.setSocketOptions(socketOptions);
+    server.startServer();
+    server.startListening();
+    std::thread serverThread(runServer, std::ref(server), std::cref(options), std::cref(isRunning));
+
+    FBNetwork::LatencyHistogram latency;
+    uint64_t                    operations = 0;
+    uint64_t                    errors     = 0;
+    std::string                 body(options.payloadSize, 'x');
+    {
+        FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", options.port);
+        client.setTimeout({5, 0});
+        client.setSocketOptions(socketOptions);
+        client.connectToServer();
+        auto start = std::chrono::steady_clock::now();
+        auto end   = start + std::chrono::seconds(options.seconds);
+        while (std::chrono::steady_clock::now() < end)
+        {
+            auto operationStart = std::chrono::steady_clock::now();
+            try
+            {
+                client.sendData(HEADER);
+                client.sendData(body);
+                client.flush();
+                client.readXData(static_cast<ssize_t>(HEADER.size() + options.payloadSize));
+                latency.recordSince(operationStart);
+                operations++;
+            }
+            catch (std::exception &e)
+            {
+                errors++;
+                break;
+            }
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        FBNetwork::HistogramSnapshot snapshot = latency.getSnapshot();
+        std::printf("{\"benchmark\": \"socket_options_%s\", \"label\": \"%s\", \"payload_size\": %zu, \"seconds\": %.3f, "
+                    "\"operations\": %llu, \"errors\": %llu, \"operations_per_second\": %.0f, \"latency_ns\": {\"p50\": %llu, "
+                    "\"p99\": %llu, \"p999\": %llu, \"mean\": %.0f, \"max\": %llu}}\n",
+                    options.mode.c_str(), options.label.c_str(), options.payloadSize, elapsed, static_cast<unsigned long long>(operations),
+                    static_cast<unsigned long long>(errors), static_cast<double>(operations) / elapsed,
+                    static_cast<unsigned long long>(snapshot.getPercentile(50)), static_cast<unsigned long long>(snapshot.getPercentile(99)),
+                    static_cast<unsigned long long>(snapshot.getPercentile(99.9)), snapshot.getMean(),
+                    static_cast<unsigned long long>(snapshot.maximum));
+    }
+
+    // Wake the server thread up with one more connection, so it sees that it has to stop
+
+    isRunning.store(false);
+    try
+    {
+        FBNetwork::Client wakeUp(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", options.port);
+        wakeUp.connectToServer();
+    }
+    catch (std::exception &e)
+    {
+    }
+    serverThread.join();
+    return 0;
+}
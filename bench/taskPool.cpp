@@ -0,0 +1,308 @@
+#include "../include/client.hpp"
+#include "../include/latencyHistogram.hpp"
+#include "../include/server.hpp"
+#include "../include/taskPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Represents the options of a benchmark run.
+ * @version 1.0.0
+ */
+struct BenchmarkOptions
+{
+    std::string mode              = "pool";
+    std::string label             = "";
+    size_t      workers           = 0;
+    size_t      lightConnections  = 4;
+    size_t      heavyConnections  = 2;
+    int         heavyMicroseconds = 2000;
+    int         seconds           = 5;
+    int         port              = 47105;
+};
+
+static const size_t MESSAGE_SIZE = 16;
+
+/**
+ * @brief Parses the command line options.
+ * @param t_argc The number of arguments.
+ * @param t_argv The arguments.
+ * @return The options.
+ * @version 1.0.0
+ */
+static BenchmarkOptions parseOptions(int t_argc, char **t_argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < t_argc; i++)
+    {
+        std::string argument = t_argv[i];
+        size_t      equals   = argument.find('=');
+        std::string key      = argument.substr(0, equals);
+        std::string value    = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--mode")
+        {
+            options.mode = value;
+        }
+        else if (key == "--label")
+        {
+            options.label = value;
+        }
+        else if (key == "--workers")
+        {
+            options.workers = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--light")
+        {
+            options.lightConnections = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--heavy")
+        {
+            options.heavyConnections = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--heavy-us")
+        {
+            options.heavyMicroseconds = std::atoi(value.c_str());
+        }
+        else if (key == "--seconds")
+        {
+            options.seconds = std::atoi(value.c_str());
+        }
+        else if (key == "--port")
+        {
+            options.port = std::atoi(value.c_str());
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argument.c_str());
+            std::exit(2);
+        }
+    }
+    if ((options.mode != "pool" && options.mode != "inline") || options.seconds < 1 || options.heavyMicroseconds < 0 ||
+        options.lightConnections == 0)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        std::exit(2);
+    }
+    return options;
+}
+
+/**
+ * @brief Handles one request: a heavy request burns CPU time, a light one returns right away.
+ * @param t_request The request, its first byte is `H` for heavy or `L` for light.
+ * @param t_heavyMicroseconds The CPU time of a heavy request.
+ * @return The response.
+ * @version 1.0.0
+ */
+static std::string handleRequest(const std::string &t_request, const int t_heavyMicroseconds)
+{
+    if (!t_request.empty() && t_request[0] == 'H')
+    {
+        auto              end = std::chrono::steady_clock::now() + std::chrono::microseconds(t_heavyMicroseconds);
+        volatile uint64_t sum = 0;
+        while (std::chrono::steady_clock::now() < end)
+        {
+            for (int i = 0; i < 1000; i++)
+            {
+                sum = sum + static_cast<uint64_t>(i) * 31;
+            }
+        }
+    }
+    return std::string(MESSAGE_SIZE, 'r');
+}
+
+/**
+ * @brief Runs the event loop of the server until `t_isRunning` is cleared and one more event arrives.
+ * @param t_server The server.
+ * @param t_taskPool The task pool, only used in `pool` mode.
+ * @param t_options The options.
+ * @param t_isRunning Whether the server keeps running.
+ * @version 1.0.0
+ */
+static void runServer(FBNetwork::Server &t_server, FBNetwork::TaskPool &t_taskPool, const BenchmarkOptions &t_options,
+                      const std::atomic<bool> &t_isRunning)
+{
+    while (t_isRunning.load())
+    {
+        std::vector<FBNetwork::eventTuple> events;
+        try
+        {
+            events = t_server.getPendingEvents();
+        }
+        catch (std::exception &e)
+        {
+            continue;
+        }
+        for (FBNetwork::eventTuple event : events)
+        {
+            int clientID = std::get<1>(event);
+            if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_CONNECT)
+            {
+                try
+                {
+                    t_server.acceptAll();
+                }
+                catch (std::exception &e)
+                {
+                    std::fprintf(stderr, "Accepting clients failed: %s\n", e.what());
+                }
+                continue;
+            }
+            if (std::get<0>(event) != FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA)
+            {
+                continue;
+            }
+            try
+            {
+                t_server.readXData(clientID, static_cast<ssize_t>(MESSAGE_SIZE));
+                std::string request = t_server.getData(clientID);
+                if (t_options.mode == "inline")
+                {
+                    t_server.sendData(clientID, handleRequest(request, t_options.heavyMicroseconds));
+                    continue;
+                }
+                int heavyMicroseconds = t_options.heavyMicroseconds;
+                t_server.dispatch(t_taskPool, clientID, [request, heavyMicroseconds]() { return handleRequest(request, heavyMicroseconds); });
+            }
+            catch (std::exception &e)
+            {
+                try
+                {
+                    t_server.closeClient(clientID);
+                }
+                catch (std::exception &e)
+                {
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Sends requests of one kind on one connection until the end of the run.
+ * @param t_isHeavy Whether the requests are heavy.
+ * @param t_options The options.
+ * @param t_end The end of the run.
+ * @param t_latency The latency histogram of the kind.
+ * @param t_errors The number of failed connections.
+ * @version 1.0.0
+ */
+static void runConnection(const bool t_isHeavy, const BenchmarkOptions &t_options, const std::chrono::steady_clock::time_point t_end,
+                          FBNetwork::LatencyHistogram &t_latency, std::atomic<uint64_t> &t_errors)
+{
+    std::string request(MESSAGE_SIZE, 'x');
+    request[0] = t_isHeavy ? 'H' : 'L';
+    try
+    {
+        FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", t_options.port);
+        client.setTimeout({10, 0});
+        client.connectToServer();
+        while (std::chrono::steady_clock::now() < t_end)
+        {
+            auto operationStart = std::chrono::steady_clock::now();
+            client.sendData(request);
+            client.readXData(static_cast<ssize_t>(MESSAGE_SIZE));
+            t_latency.recordSince(operationStart);
+        }
+        client.disconnectFromServer();
+    }
+    catch (std::exception &e)
+    {
+        t_errors.fetch_add(1);
+    }
+}
+
+/**
+ * @brief Prints the latency of one kind of request as a JSON object.
+ * @param t_name The name of the object.
+ * @param t_snapshot The latency.
+ * @param t_elapsed The duration of the run in seconds.
+ * @version 1.0.0
+ */
+static void printLatency(const char *t_name, const FBNetwork::HistogramSnapshot &t_snapshot, const double t_elapsed)
+{
+    std::printf("\"%s\": {\"operations\": %llu, \"operations_per_second\": %.0f, \"latency_ns\": {\"p50\": %llu, \"p99\": %llu, "
+                "\"p999\": %llu, \"mean\": %.0f, \"max\": %llu}}",
+                t_name, static_cast<unsigned long long>(t_snapshot.count), static_cast<double>(t_snapshot.count) / t_elapsed,
+                static_cast<unsigned long long>(t_snapshot.getPercentile(50)), static_cast<unsigned long long>(t_snapshot.getPercentile(99)),
+                static_cast<unsigned long long>(t_snapshot.getPercentile(99.9)), t_snapshot.getMean(),
+                static_cast<unsigned long long>(t_snapshot.maximum));
+}
+
+/**
+ * @brief Measures the latency of light requests while other clients send CPU-heavy requests to the same server and prints one JSON
+ * line.
+ * @details Usage: `taskPool [--mode=pool|inline] [--workers=N] [--light=N] [--heavy=N] [--heavy-us=MICROSECONDS] [--seconds=N]
+ * [--port=N] [--label=TEXT]`. `light` connections send requests that are answered right away, `heavy` connections send requests that
+ * burn `heavy-us` microseconds of CPU time, 2000 by default. With `inline` the event loop runs the handlers itself, so every light
+ * request can wait behind heavy ones. With `pool` the event loop hands them to a `TaskPool` of `workers` threads, one per CPU by
+ * default, with `Server::dispatch()`.
+ * @version 1.0.0
+ */
+int main(int argc, char **argv)
+{
+    BenchmarkOptions  options = parseOptions(argc, argv);
+    std::atomic<bool> isRunning{true};
+    std::signal(SIGPIPE, SIG_IGN);
+
+    FBNetwork::Server server(FBNetwork::Domain::IPV4_DOMAIN, options.port, 1024);
+    server.setTimeout({10, 0});
+    server.startServer();
+    server.startListening();
+    FBNetwork::LatencyHistogram lightLatency;
+    FBNetwork::LatencyHistogram heavyLatency;
+    std::atomic<uint64_t>       errors{0};
+    uint64_t                    stolenTasks = 0;
+    size_t                      workers     = 0;
+    double                      elapsed     = 0;
+    {
+        FBNetwork::TaskPool taskPool(options.workers);
+        workers = taskPool.getThreadCount();
+        std::thread serverThread(runServer, std::ref(server), std::ref(taskPool), std::cref(options), std::cref(isRunning));
+
+        std::vector<std::thread> connections;
+        auto                     start = std::chrono::steady_clock::now();
+        auto                     end   = start + std::chrono::seconds(options.seconds);
+        for (size_t i = 0; i < options.lightConnections + options.heavyConnections; i++)
+        {
+            bool isHeavy = i >= options.lightConnections;
+            connections.emplace_back(runConnection, isHeavy, std::cref(options), end, std::ref(isHeavy ? heavyLatency : lightLatency),
+                                     std::ref(errors));
+        }
+        for (std::thread &connection : connections)
+        {
+            connection.join();
+        }
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // Wake the server thread up with one more connection, so it sees that it has to stop
+
+        isRunning.store(false);
+        try
+        {
+            FBNetwork::Client wakeUp(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", options.port);
+            wakeUp.connectToServer();
+        }
+        catch (std::exception &e)
+        {
+        }
+        serverThread.join();
+        taskPool.waitUntilIdle();
+        stolenTasks = taskPool.getStolenTaskCount();
+    }
+
+    std::printf("{\"benchmark\": \"task_pool_%s\", \"label\": \"%s\", \"workers\": %zu, \"heavy_us\": %d, \"seconds\": %.3f, "
+                "\"errors\": %llu, \"stolen_tasks\": %llu, ",
+                options.mode.c_str(), options.label.c_str(), options.mode == "pool" ? workers : 0, options.heavyMicroseconds, elapsed,
+                static_cast<unsigned long long>(errors.load()), static_cast<unsigned long long>(stolenTasks));
+    printLatency("light", lightLatency.getSnapshot(), elapsed);
+    std::printf(", ");
+    printLatency("heavy", heavyLatency.getSnapshot(), elapsed);
+    std::printf("}\n");
+    return 0;
+}
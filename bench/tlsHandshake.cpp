@@ -0,0 +1,361 @@
+#include "../include/client.hpp"
+#include "../include/latencyHistogram.hpp"
+#include "../include/server.hpp"
+#include "../include/tlsContext.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Represents the options of a benchmark run.
+ * @version 1.0.0
+ */
+struct BenchmarkOptions
+{
+    std::string scenario    = "resumed";
+    std::string label       = "";
+    bool        isPlaintext = false;
+    bool        usesKtls    = false;
+    int         seconds     = 5;
+    size_t      payloadSize = 1 << 20;
+    int         port        = 47101;
+};
+
+/**
+ * @brief Represents what the server observed during the run.
+ * @version 1.0.0
+ */
+struct ServerObservations
+{
+    std::atomic<uint64_t> resumedHandshakes{0};
+    std::atomic<uint64_t> kernelTlsSends{0};
+};
+
+static const std::string REQUEST  = "GET /benchmark HTTP/1.1\r\nHost: localhost\r\n\r\n";
+static const std::string RESPONSE = "HTTP/1.1 204 No Content\r\nServer: FBNetwork\r\n\r\n";
+static const std::string ACK      = "ACK\n";
+
+/**
+ * @brief Parses the command line options.
+ * @param t_argc The number of arguments.
+ * @param t_argv The arguments.
+ * @return The options.
+ * @version 1.0.0
+ */
+static BenchmarkOptions parseOptions(int t_argc, char **t_argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < t_argc; i++)
+    {
+        std::string argument = t_argv[i];
+        size_t      equals   = argument.find('=');
+        std::string key      = argument.substr(0, equals);
+        std::string value    = equals == std::string::npos ? "" : argument.substr(equals + 1);
+        if (key == "--scenario")
+        {
+            options.scenario = value;
+        }
+        else if (key == "--label")
+        {
+            options.label = value;
+        }
+        else if (key == "--plaintext")
+        {
+            options.isPlaintext = true;
+        }
+        else if (key == "--ktls")
+        {
+            options.usesKtls = true;
+        }
+        else if (key == "--seconds")
+        {
+            options.seconds = std::atoi(value.c_str());
+        }
+        else if (key == "--size")
+        {
+            options.payloadSize = std::strtoul(value.c_str(), nullptr, 10);
+        }
+        else if (key == "--port")
+        {
+            options.port = std::atoi(value.c_str());
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option %s\n", argument.c_str());
+            std::exit(2);
+        }
+    }
+    if ((options.scenario != "full" && options.scenario != "resumed" && options.scenario != "throughput") || options.seconds < 1 ||
+        options.payloadSize == 0)
+    {
+        std::fprintf(stderr, "Invalid options\n");
+        std::exit(2);
+    }
+    return options;
+}
+
+/**
+ * @brief Writes a self-signed certificate for localhost and its P-256 key into a temporary directory.
+ * @param t_certificatePath The path of the certificate.
+ * @param t_privateKeyPath The path of the private key.
+ * @return true if both files were written, false otherwise.
+ * @version 1.0.0
+ */
+static bool writeCertificate(std::string &t_certificatePath, std::string &t_privateKeyPath)
+{
+    char directory[] = "/tmp/fbnetwork-tls-XXXXXX";
+    if (mkdtemp(directory) == nullptr)
+    {
+        return false;
+    }
+    t_certificatePath = std::string(directory) + "/certificate.pem";
+    t_privateKeyPath  = std::string(directory) + "/key.pem";
+
+    EVP_PKEY     *key        = nullptr;
+    EVP_PKEY_CTX *keyContext = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    if (keyContext == nullptr || EVP_PKEY_keygen_init(keyContext) != 1 ||
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(keyContext, NID_X9_62_prime256v1) != 1 || EVP_PKEY_keygen(keyContext, &key) != 1)
+    {
+        EVP_PKEY_CTX_free(keyContext);
+        return false;
+    }
+    EVP_PKEY_CTX_free(keyContext);
+    X509 *certificate = X509_new();
+    X509_set_version(certificate, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1);
+    X509_gmtime_adj(X509_getm_notBefore(certificate), 0);
+    X509_gmtime_adj(X509_getm_notAfter(certificate), 24 * 60 * 60);
+    X509_set_pubkey(certificate, key);
+    X509_NAME *name = X509_get_subject_name(certificate);
+    X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char *>("localhost"), -1, -1, 0);
+    X509_set_issuer_name(certificate, name);
+    bool  isWritten       = X509_sign(certificate, key, EVP_sha256()) > 0;
+    FILE *certificateFile = std::fopen(t_certificatePath.c_str(), "w");
+    FILE *keyFile         = std::fopen(t_privateKeyPath.c_str(), "w");
+    isWritten             = isWritten && certificateFile != nullptr && keyFile != nullptr &&
+                PEM_write_X509(certificateFile, certificate) == 1 &&
+                PEM_write_PrivateKey(keyFile, key, nullptr, nullptr, 0, nullptr, nullptr) == 1;
+    if (certificateFile != nullptr)
+    {
+        std::fclose(certificateFile);
+    }
+    if (keyFile != nullptr)
+    {
+        std::fclose(keyFile);
+    }
+    X509_free(certificate);
+    EVP_PKEY_free(key);
+    return isWritten;
+}
+
+/**
+ * @brief Runs the event loop of the server until `t_isRunning` is cleared and one more event arrives.
+ * @param t_server The server.
+ * @param t_options The options.
+ * @param t_isRunning Whether the server keeps running.
+ * @param t_observations What the server observed.
+ * @version 1.0.0
+ */
+static void runServer(FBNetwork::Server &t_server, const BenchmarkOptions &t_options, const std::atomic<bool> &t_isRunning,
+                      ServerObservations &t_observations)
+{
+    while (t_isRunning.load())
+    {
+        std::vector<FBNetwork::eventTuple> events;
+        try
+        {
+            events = t_server.getPendingEvents();
+        }
+        catch (std::exception &e)
+        {
+            continue;
+        }
+        for (FBNetwork::eventTuple event : events)
+        {
+            int clientID = std::get<1>(event);
+            if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_CONNECT)
+            {
+                try
+                {
+                    t_server.acceptAll();
+                }
+                catch (std::exception &e)
+                {
+                    std::fprintf(stderr, "Accepting clients failed: %s\n", e.what());
+                }
+                continue;
+            }
+            if (std::get<0>(event) != FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA)
+            {
+                continue;
+            }
+            try
+            {
+                std::shared_ptr<FBNetwork::TlsConnection> tlsConnection = t_server.getTlsConnection(clientID);
+                if (t_options.scenario == "throughput")
+                {
+                    t_server.readXData(clientID, static_cast<ssize_t>(t_options.payloadSize));
+                    t_server.sendData(clientID, ACK);
+                    if (tlsConnection != nullptr && tlsConnection->usesKernelTlsSend())
+                    {
+                        t_observations.kernelTlsSends.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    continue;
+                }
+                t_server.readTillXData(clientID, "\r\n\r\n");
+                if (tlsConnection != nullptr && tlsConnection->isSessionReused())
+                {
+                    t_observations.resumedHandshakes.fetch_add(1, std::memory_order_relaxed);
+                }
+                t_server.sendData(clientID, RESPONSE);
+            }
+            catch (std::exception &e)
+            {
+                try
+                {
+                    t_server.closeClient(clientID);
+                }
+                catch (std::exception &e)
+                {
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Measures TLS handshakes per second and TLS throughput of `Server` and `Client` over loopback and prints one JSON line.
+ * @details Usage: `tlsHandshake [--scenario=full|resumed|throughput] [--plaintext] [--ktls] [--seconds=N] [--size=BYTES] [--port=N]
+ * [--label=TEXT]`. The server runs in the same process on its own thread with a self-signed P-256 certificate. The scenarios are
+ * - `full`: every operation opens a connection, does a full handshake, sends one small request and reads the answer.
+ * - `resumed`: like `full`, but the server issues session tickets, so all connections after the first resume their session.
+ * - `throughput`: one connection sends `size` bytes, 1 MiB by default, and waits for a short ack.
+ *
+ * `--plaintext` runs the same scenario without TLS as the baseline, `--ktls` asks for kernel TLS on the server and reports whether the
+ * server sent with it, which needs the `tls` kernel module.
+ * @version 1.0.0
+ */
+int main(int argc, char **argv)
+{
+    BenchmarkOptions   options = parseOptions(argc, argv);
+    ServerObservations observations;
+    std::atomic<bool>  isRunning{true};
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::string certificatePath;
+    std::string privateKeyPath;
+    if (!writeCertificate(certificatePath, privateKeyPath))
+    {
+        std::fprintf(stderr, "Writing the certificate failed\n");
+        return 1;
+    }
+    std::shared_ptr<FBNetwork::TlsContext> serverContext = std::make_shared<FBNetwork::TlsContext>(FBNetwork::TlsRole::SERVER);
+    std::shared_ptr<FBNetwork::TlsContext> clientContext = std::make_shared<FBNetwork::TlsContext>(FBNetwork::TlsRole::CLIENT);
+    serverContext->loadCertificate(certificatePath, privateKeyPath);
+    serverContext->setSessionResumption(options.scenario != "full");
+    serverContext->setKernelTls(options.usesKtls);
+    clientContext->loadTrustedCertificates(certificatePath);
+
+    FBNetwork::Server server(FBNetwork::Domain::IPV4_DOMAIN, options.port, 64);
+    server.setTimeout({5, 0});
+    if (!options.isPlaintext)
+    {
+        server.setTlsContext(serverContext);
+    }
+    server.startServer();
+    server.startListening();
+    std::thread serverThread(runServer, std::ref(server), std::cref(options), std::cref(isRunning), std::ref(observations));
+
+    FBNetwork::LatencyHistogram        latency;
+    uint64_t                           operations      = 0;
+    uint64_t                           bytes           = 0;
+    uint64_t                           errors          = 0;
+    uint64_t                           resumedOnClient = 0;
+    std::string                        payload(options.payloadSize, 'x');
+    std::unique_ptr<FBNetwork::Client> connection;
+    auto                               start = std::chrono::steady_clock::now();
+    auto                               end   = start + std::chrono::seconds(options.seconds);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        auto operationStart = std::chrono::steady_clock::now();
+        try
+        {
+            if (connection == nullptr || options.scenario != "throughput")
+            {
+                connection = std::make_unique<FBNetwork::Client>(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", options.port);
+                connection->setTimeout({5, 0});
+                if (!options.isPlaintext)
+                {
+                    connection->setTlsContext(clientContext, "localhost");
+                }
+                connection->connectToServer();
+            }
+            if (options.scenario == "throughput")
+            {
+                connection->sendData(payload);
+                connection->readXData(static_cast<ssize_t>(ACK.size()));
+                bytes += payload.size();
+            }
+            else
+            {
+                connection->sendData(REQUEST);
+                connection->readTillXData("\r\n\r\n");
+                bytes += REQUEST.size() + RESPONSE.size();
+                if (connection->getTlsConnection() != nullptr && connection->getTlsConnection()->isSessionReused())
+                {
+                    resumedOnClient++;
+                }
+            }
+            latency.recordSince(operationStart);
+            operations++;
+        }
+        catch (std::exception &e)
+        {
+            errors++;
+            connection = nullptr;
+        }
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    connection     = nullptr;
+
+    // Wake the server thread up with one more connection, so it sees that it has to stop
+
+    isRunning.store(false);
+    try
+    {
+        FBNetwork::Client wakeUp(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", options.port);
+        wakeUp.connectToServer();
+    }
+    catch (std::exception &e)
+    {
+    }
+    serverThread.join();
+
+    FBNetwork::HistogramSnapshot snapshot = latency.getSnapshot();
+    std::printf("{\"benchmark\": \"tls_%s\", \"label\": \"%s\", \"tls\": %s, \"ktls_requested\": %s, \"ktls_send\": %s, "
+                "\"payload_size\": %zu, \"seconds\": %.3f, \"operations\": %llu, \"errors\": %llu, \"operations_per_second\": %.0f, "
+                "\"bytes_per_second\": %.0f, \"resumed_client\": %llu, \"resumed_server\": %llu, \"latency_ns\": {\"p50\": %llu, "
+                "\"p99\": %llu, \"p999\": %llu, \"mean\": %.0f, \"max\": %llu}}\n",
+                options.scenario.c_str(), options.label.c_str(), options.isPlaintext ? "false" : "true", options.usesKtls ? "true" : "false",
+                observations.kernelTlsSends.load() > 0 ? "true" : "false", options.payloadSize, elapsed, static_cast<unsigned long long>(operations),
+                static_cast<unsigned long long>(errors), static_cast<double>(operations) / elapsed, static_cast<double>(bytes) / elapsed,
+                static_cast<unsigned long long>(resumedOnClient),
+                static_cast<unsigned long long>(observations.resumedHandshakes.load()),
+                static_cast<unsigned long long>(snapshot.getPercentile(50)), static_cast<unsigned long long>(snapshot.getPercentile(99)),
+                static_cast<unsigned long long>(snapshot.getPercentile(99.9)), snapshot.getMean(),
+                static_cast<unsigned long long>(snapshot.maximum));
+    std::remove(certificatePath.c_str());
+    std::remove(privateKeyPath.c_str());
+    rmdir(certificatePath.substr(0, certificatePath.rfind('/')).c_str());
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "../include/udpServer.hpp"
+#include "../include/udpSocket.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Measures the datagram rate of `UdpSocket` and `UdpServer` over loopback.
+ * @details Usage: `udpPacketsPerSecond [seconds] [batchSize] [payloadSize]`. One thread sends datagrams in batches of `batchSize` as
+ * fast as possible, the main thread receives them in batches. Run it once with a batch size of 1 and once with the default to see what
+ * `recvmmsg` and `sendmmsg` save.
+ * @version 1.0.0
+ */
+int main(int argc, char **argv)
+{
+    int               seconds     = argc > 1 ? std::atoi(argv[1]) : 5;
+    size_t            batchSize   = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : FBNetwork::Constants::UDP_BATCH_SIZE;
+    size_t            payloadSize = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 64;
+    std::atomic<bool> isRunning{true};
+    uint64_t          sent     = 0;
+    uint64_t          received = 0;
+    uint64_t          batches  = 0;
+
+    FBNetwork::UdpServer server(FBNetwork::Domain::IPV4_DOMAIN, 0, batchSize, payloadSize);
+    server.startServer();
+
+    std::thread sender(
+        [&]
+        {
+            FBNetwork::UdpSocket socket(FBNetwork::Domain::IPV4_DOMAIN, batchSize, payloadSize);
+            std::string          payload(payloadSize, 'x');
+            socket.connectToServer("127.0.0.1", server.getPort());
+            while (isRunning.load(std::memory_order_relaxed))
+            {
+                while (socket.queueDatagram(payload))
+                {
+                }
+                try
+                {
+                    sent += socket.sendQueuedDatagrams();
+                }
+                catch (FBNetwork::ClientRuntimeException &e)
+                {
+
+                    // ECONNREFUSED or ENOBUFS under overload, keep sending
+
+                }
+            }
+        });
+
+    timeval pollTimeout = {0, 100000};
+    auto    start       = std::chrono::steady_clock::now();
+    auto    end         = start + std::chrono::seconds(seconds);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        if (!server.isDataAvailable(&pollTimeout))
+        {
+            continue;
+        }
+        size_t count = 0;
+        while ((count = server.receiveDatagrams()) > 0)
+        {
+            received += count;
+            batches++;
+        }
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    isRunning.store(false);
+    sender.join();
+
+    std::printf("{\"benchmark\": \"udp_pps\", \"batch_size\": %zu, \"payload_size\": %zu, \"seconds\": %.3f, \"sent_pps\": %.0f, "
+                "\"received_pps\": %.0f, \"datagrams_per_receive\": %.2f, \"loss\": %.4f}\n",
+                batchSize, payloadSize, elapsed, static_cast<double>(sent) / elapsed, static_cast<double>(received) / elapsed,
+                batches == 0 ? 0.0 : static_cast<double>(received) / static_cast<double>(batches),
+                sent == 0 ? 0.0 : 1.0 - static_cast<double>(received) / static_cast<double>(sent));
+    return 0;
+}
@@ -1,18 +1,29 @@
 #ifndef FBNETWORK_CLIENT_HPP
 #define FBNETWORK_CLIENT_HPP
 
+#include "compression.hpp"
 #include "constants.hpp"
 #include "exceptions.hpp"
 #include "extendedSystem.hpp"
+#include "resolver.hpp"
+#include "socketOptions.hpp"
+#ifdef FBNETWORK_WITH_TLS
+#include "tlsConnection.hpp"
+#endif
 #include <arpa/inet.h>
 #include <cstdlib>
 #include <errno.h>
+#include <fcntl.h>
 #include <iostream>
+#include <memory>
+#include <poll.h>
 #include <string>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/un.h>
+#include <system_error>
 #include <unistd.h>
 
 namespace FBNetwork
@@ -33,6 +44,7 @@ namespace FBNetwork
         std::string                          m_serverIpAddress      = "";
         std::string                          m_serverSocketPath     = "";
         std::string                          m_data                 = "";
+        std::string                          m_residualData         = "";
         bool                                 m_usesIpv4Domain       = false;
         bool                                 m_usesIpv6Domain       = false;
         bool                                 m_usesLocalDomain      = false;
@@ -40,6 +52,14 @@ namespace FBNetwork
         std::shared_ptr<struct sockaddr_in>  m_serverAddressIpv4    = nullptr;
         std::shared_ptr<struct sockaddr_in6> m_serverAddressIpv6    = nullptr;
         std::shared_ptr<struct sockaddr_un>  m_serverAddressLocal   = nullptr;
+        std::shared_ptr<Resolver>            m_resolver             = nullptr;
+        SocketOptions                        m_socketOptions;
+        std::shared_ptr<Compressor>          m_compressor           = nullptr;
+#ifdef FBNETWORK_WITH_TLS
+        std::shared_ptr<TlsContext>          m_tlsContext           = nullptr;
+        std::shared_ptr<TlsConnection>       m_tlsConnection        = nullptr;
+        std::string                          m_tlsServerName        = "";
+#endif
 
         /**
          * @brief Sets the server file descriptor.
@@ -241,11 +261,151 @@ namespace FBNetwork
          */
         std::shared_ptr<sockaddr_un> getServerAddressLocal();
 
+        /**
+         * @brief Checks if the server is given by a host name instead of an IP address.
+         * @return true if the IP address of the server is neither an IPv4 nor an IPv6 address, false otherwise.
+         * @version 1.0.0
+         */
+        bool usesHostName() const;
+
+        /**
+         * @brief Connects to the server and optionally starts sending the first data with TCP Fast Open.
+         * @details For a server given by an IP address, a non-empty `t_firstData` turns on `TCP_FASTOPEN_CONNECT`, so the first write
+         * goes out in the SYN. Where the platform does not have that option, the data is sent with `MSG_FASTOPEN` instead, which connects
+         * and sends in one call. Host names and local domain sockets connect without fast open.
+         * @param t_firstData The data that is sent first, or an empty string.
+         * @return The number of bytes of `t_firstData` that are already sent.
+         * @throws `ClientCreationException` if the connection fails or a socket option could not be set.
+         * @version 1.0.0
+         */
+        size_t openConnection(const std::string &t_firstData);
+
+        /**
+         * @brief Connects a socket to an IP address, with TCP Fast Open if there is data to send.
+         * @param t_fileDescriptor The socket.
+         * @param t_address The address of the server.
+         * @param t_addressLength The length of the address.
+         * @param t_firstData The data that is sent first, or an empty string.
+         * @return The number of bytes of `t_firstData` that are already sent, or -1 if the connection failed.
+         * @version 1.0.0
+         */
+        ssize_t connectSocket(const fileDescriptor t_fileDescriptor, const sockaddr *t_address, const socklen_t t_addressLength,
+                              const std::string &t_firstData);
+
+        /**
+         * @brief Resolves the host name of the server and connects to one of its addresses.
+         * @details The addresses are tried as described in RFC 8305 (Happy Eyeballs): the families alternate, starting with the domain
+         * of the client, and a new attempt starts every `Constants::CONNECTION_ATTEMPT_DELAY` or as soon as an attempt fails, while the
+         * earlier attempts keep running. The first connection wins, the others are closed. Afterwards the domain of the client is the
+         * family of the address that won.
+         * @throws `ClientCreationException` if the host name could not be resolved, no address accepted the connection or the timeout
+         * passed.
+         * @version 1.0.0
+         */
+        void connectToHost();
+
+        /**
+         * @brief Races connection attempts to several addresses.
+         * @param t_addresses The addresses with the port, in the order to try them.
+         * @param t_connectedAddress Set to the index of the address that was connected to.
+         * @return The connected socket, in blocking mode.
+         * @throws `ClientCreationException` if no address accepted the connection or the timeout passed.
+         * @version 1.0.0
+         */
+        fileDescriptor connectToFirstAddress(const addressList &t_addresses, size_t &t_connectedAddress);
+
+        /**
+         * @brief Starts the TLS session on the connected socket, if a TLS context is set.
+         * @details The handshake offers the session of the last connection to the same server, so it is resumed if the server agrees.
+         * @throws `ClientCreationException` if the handshake fails.
+         * @throws `ClientTimeoutException` if the handshake does not finish within the timeout.
+         * @version 1.0.0
+         */
+        void startTls();
+
+        /**
+         * @brief Checks if decrypted data can be read without waiting for the socket.
+         * @return true if data is buffered, false otherwise.
+         * @version 1.0.0
+         */
+        bool hasBufferedData() const;
+
+        /**
+         * @brief Receives data from the server, through the TLS session if there is one.
+         * @param t_buffer The buffer to receive into.
+         * @param t_size The size of the buffer.
+         * @return The number of received bytes, or 0 and -1 like `recv`. `EAGAIN` means that TLS only received a control message.
+         * @version 1.0.0
+         */
+        ssize_t receive(char *t_buffer, const size_t t_size);
+
+        /**
+         * @brief Retrieves the `poll` events to wait for before the next read or write.
+         * @details A TLS read may have to wait until the socket is writable and the other way round.
+         * @param t_events The events to wait for without TLS.
+         * @return The events to wait for.
+         * @version 1.0.0
+         */
+        short getPollEvents(const short t_events) const;
+
+        /**
+         * @brief Retrieves the timeout in milliseconds for `poll`.
+         * @return The timeout, rounded up.
+         * @version 1.0.0
+         */
+        int getPollTimeout();
+
+        /**
+         * @brief Receives the next chunk of data from the server.
+         * @details This function waits with `poll` until data is available or the timeout passes.
+         * @param t_buffer The buffer to receive into.
+         * @param t_size The size of the buffer.
+         * @param t_error Set to `NetworkError::TIMEOUT` if the timeout passed, to `NetworkError::CONNECTION_CLOSED` if the server closed
+         * the connection or to the `errno` of the failed system call.
+         * @return The number of received bytes, always greater than 0, or -1 if `t_error` is set.
+         * @version 1.0.0
+         */
+        ssize_t receiveChunk(char *t_buffer, const size_t t_size, std::error_code &t_error);
+
+        /**
+         * @brief Throws the exception that matches the error of a non-throwing function.
+         * @param t_error The error.
+         * @param t_context What failed, like "Reading the data failed.".
+         * @param t_timeoutContext The message of a timeout, like "Timeout reached while reading data.".
+         * @throws `InvalidArgumentException` if the error is `NetworkError::INVALID_ARGUMENT`.
+         * @throws `ClientTimeoutException` if the error is `NetworkError::TIMEOUT`.
+         * @throws `ClientRuntimeException` otherwise.
+         * @version 1.0.0
+         */
+        [[noreturn]] static void throwError(const std::error_code &t_error, const char *t_context, const char *t_timeoutContext);
+
+        /**
+         * @brief Sends data to the server, through the TLS session if there is one.
+         * @param t_data The data to send.
+         * @param t_size The size of the data.
+         * @return The number of sent bytes or -1 like `send`.
+         * @version 1.0.0
+         */
+        ssize_t transmit(const char *t_data, const size_t t_size);
+
+        /**
+         * @brief Sends a part of a file to the server, through the TLS session if there is one.
+         * @details Without TLS and with kernel TLS the data goes from the page cache to the socket without a copy.
+         * @param t_fileDescriptor The file.
+         * @param t_offset The offset in the file to start at.
+         * @param t_size The number of bytes to send.
+         * @return The number of sent bytes, 0 if the file ended or -1 like `send`.
+         * @version 1.0.0
+         */
+        ssize_t transmitFile(const fileDescriptor t_fileDescriptor, const off_t t_offset, const size_t t_size);
+
     public:
         /**
          * @brief Constructs a IP Client object.
+         * @details Instead of an IP address, the server can be given by a host name. `connectToServer()` resolves it and connects to
+         * the address that answers first, trying the addresses of `t_domain` first.
          * @param t_domain The domain of the server.
-         * @param t_ipAddress The IP address of the server.
+         * @param t_ipAddress The IP address or the host name of the server.
          * @param t_port The port of the server.
          * @throws `InvalidDomainException` if the domain is not IPV4_DOMAIN or IPV6_DOMAIN.
          * @throws `InvalidArgumentException` if the IP address is empty or the port is less than 0 or greater than 65535.
@@ -291,12 +451,28 @@ namespace FBNetwork
 
         /**
          * @brief Connects to the server.
-         * @details This function connects to the server.
-         * @throws `ClientCreationException` if the connection fails.
+         * @details This function connects to the server. A host name is resolved by the resolver of the client, see `setResolver()`, and
+         * connected to with `connectToHost()`. The socket options of the client are applied before the TLS handshake.
+         * @throws `ClientCreationException` if the connection fails or a socket option could not be set.
          * @version 1.0.0
          */
         void connectToServer();
 
+        /**
+         * @brief Connects to the server and sends the first request, in the SYN if TCP Fast Open is possible.
+         * @details A short-lived connection saves the round trip of the handshake before its request, if the server has fast open on
+         * its listening socket, see `SocketOptions::setFastOpen()`, and the client has a cookie from an earlier connection to it. The
+         * first connection to a server gets the cookie and sends the data after the handshake, like `connectToServer()` and
+         * `sendData()`. With TLS the ClientHello goes out in the SYN and `t_data` is sent after the TLS handshake.
+         * @param t_data The first request. The server may receive it twice if the network replays the SYN, so it must be idempotent.
+         * @throws `InvalidArgumentException` if the data is empty.
+         * @throws `ClientCreationException` if the connection fails or a socket option could not be set.
+         * @throws `ClientRuntimeException` if the data could not be sent. With fast open a refused connection is only noticed here.
+         * @throws `ClientTimeoutException` if the data could not be sent within the timeout.
+         * @version 1.0.0
+         */
+        void connectAndSend(const std::string &t_data);
+
         /**
          * @brief Disconnects from the server.
          * @details This function disconnects from the server.
@@ -311,50 +487,216 @@ namespace FBNetwork
          * @param t_data The data to send.
          * @throws `InvalidArgumentException` if the data is empty.
          * @throws `ClientRuntimeException` if the data cannot be sent.
+         * @throws `ClientTimeoutException` if the timeout passed.
          * @version 1.0.0
          */
         void sendData(const std::string t_data);
 
+        /**
+         * @brief Sends data to the server without throwing.
+         * @details This function works like `sendData()`, but reports failures through `t_error` instead of throwing. Partial sends are
+         * continued until all data is sent.
+         * @param t_data The data to send.
+         * @param t_error Set to `NetworkError::INVALID_ARGUMENT` if the data is empty, `NetworkError::TIMEOUT`, the `errno` of the failed
+         * system call or cleared.
+         * @version 1.0.0
+         */
+        void sendData(const std::string &t_data, std::error_code &t_error);
+
+        /**
+         * @brief Sends a file to the server.
+         * @details This function opens the file and sends it like `sendFile()` with a file descriptor. The file is closed afterwards.
+         * @param t_filePath The path of the file.
+         * @param t_offset The offset in the file to start at.
+         * @param t_length The number of bytes to send, 0 sends everything after `t_offset`.
+         * @throws `InvalidArgumentException` if the file path is empty or the range is not inside the file.
+         * @throws `SystemRuntimeException` if the file could not be opened.
+         * @throws `ClientRuntimeException` if the file cannot be sent.
+         * @throws `ClientTimeoutException` if the server did not read within the timeout.
+         * @version 1.0.0
+         */
+        void sendFile(const std::string &t_filePath, const off_t t_offset = 0, const size_t t_length = 0);
+
+        /**
+         * @brief Sends a part of an open file to the server.
+         * @details This function sends the file with `sendfile`, so the data is not copied into the process. Partial sends are continued
+         * at the new offset, the file position is not changed and the file stays open.
+         * @param t_fileDescriptor The file, opened for reading.
+         * @param t_offset The offset in the file to start at.
+         * @param t_length The number of bytes to send, 0 sends everything after `t_offset`.
+         * @throws `InvalidArgumentException` if the range is not inside the file.
+         * @throws `SystemRuntimeException` if the size of the file could not be retrieved.
+         * @throws `ClientRuntimeException` if the file cannot be sent or got shorter.
+         * @throws `ClientTimeoutException` if the server did not read within the timeout.
+         * @version 1.0.0
+         */
+        void sendFile(const fileDescriptor t_fileDescriptor, const off_t t_offset = 0, const size_t t_length = 0);
+
         /**
          * @brief Reads data from the server.
-         * @details This function reads data from the server.
+         * @details This function reads data from the server. Bytes received after the data are kept for the next read, so pipelined
+         * responses are not lost.
          * @param t_x The size of the data to read.
          * @throws `InvalidArgumentException` if the size is less or equal to 0.
          * @throws `ClientRuntimeException` if the data cannot be read.
+         * @throws `ClientTimeoutException` if the timeout passed.
          * @version 1.0.0
          */
         void readXData(const ssize_t t_x);
 
+        /**
+         * @brief Reads data from the server without throwing.
+         * @details This function works like `readXData()`, but reports failures through `t_error` instead of throwing.
+         * @param t_x The size of the data to read.
+         * @param t_error Set to `NetworkError::INVALID_ARGUMENT` if the size is less or equal to 0, `NetworkError::TIMEOUT`,
+         * `NetworkError::CONNECTION_CLOSED`, the `errno` of the failed system call or cleared.
+         * @version 1.0.0
+         */
+        void readXData(const ssize_t t_x, std::error_code &t_error);
+
         /**
          * @brief Reads data from the server until a specific character is encountered.
-         * @details This function reads data from the server until a specific character is encountered.
+         * @details This function reads data from the server until a specific character is encountered. Bytes received after the
+         * character are kept for the next read, which consumes them before it receives anything.
          * @param t_x The character to read until.
          * @throws `InvalidArgumentException` if the character is empty.
          * @throws `ClientRuntimeException` if the data cannot be read.
+         * @throws `ClientTimeoutException` if the timeout passed.
          * @version 1.0.0
          */
         void readTillXData(const std::string t_x);
 
+        /**
+         * @brief Reads data from the server until a specific string is encountered without throwing.
+         * @details This function works like `readTillXData()`, but reports failures through `t_error` instead of throwing.
+         * @param t_x The string to read until.
+         * @param t_error Set to `NetworkError::INVALID_ARGUMENT` if the string is empty, `NetworkError::TIMEOUT`,
+         * `NetworkError::CONNECTION_CLOSED`, the `errno` of the failed system call or cleared.
+         * @version 1.0.0
+         */
+        void readTillXData(const std::string &t_x, std::error_code &t_error);
+
         /**
          * @brief Reads data from the server until a specific character is encountered a specific number of times.
          * @details This function reads data from the server until a specific character is encountered a specific number of times.
+         * Bytes received after the last character are kept for the next read.
          * @param t_x The character to read until.
          * @param t_y The number of times to read the character.
          * @throws `InvalidArgumentException` if the delimiter is empty or the number of times is less than 0.
          * @throws `ClientRuntimeException` if the data cannot be read.
+         * @throws `ClientTimeoutException` if the timeout passed.
          * @version 1.0.0
          */
         void readTillXComesYTimesData(const std::string t_x, const int t_y);
 
         /**
          * @brief Checks if data is available in the given timeout.
-         * @details This function checks if data is available in the given timeout.
+         * @details This function checks if data is available in the given timeout. Data kept by the last read is available right away.
          * @param t_timeout The timeout.
          * @return true if data is available, false otherwise.
          * @throws `ClientRuntimeException` if the data availability cannot be checked.
          * @version 1.0.0
          */
         bool isDataAvailable(const std::shared_ptr<timeval> t_timeout);
+
+        /**
+         * @brief Sends a file descriptor to the server.
+         * @details This function sends a file descriptor with `SCM_RIGHTS`, so it only works with a local domain server. The server
+         * receives a duplicate that stays valid after this process closes its own.
+         * @param t_fileDescriptor The file descriptor to send.
+         * @throws `InvalidArgumentException` if the client does not use the local domain or the file descriptor is negative.
+         * @throws `ClientRuntimeException` if the file descriptor cannot be sent.
+         * @version 1.0.0
+         */
+        void sendFileDescriptor(const fileDescriptor t_fileDescriptor);
+
+        /**
+         * @brief Sets the resolver for host names.
+         * @details Clients without their own resolver share `Resolver::getInstance()`, so they share its cache as well.
+         * @param t_resolver The resolver, or nullptr for the shared one.
+         * @version 1.0.0
+         */
+        void setResolver(std::shared_ptr<Resolver> t_resolver);
+
+        /**
+         * @brief Sets the socket options of the connection.
+         * @details The connection options are applied by the next `connectToServer()`, after the connection is established. The
+         * listener options are not used by a client.
+         * @param t_socketOptions The socket options.
+         * @version 1.0.0
+         */
+        void setSocketOptions(const SocketOptions &t_socketOptions);
+
+        /**
+         * @brief Sends the data that the corked socket holds back.
+         * @details Without cork in the socket options nothing is held back and this function does nothing.
+         * @throws `ClientRuntimeException` if the socket could not be flushed.
+         * @version 1.0.0
+         */
+        void flush();
+
+        /**
+         * @brief Negotiates the compression of `sendCompressedData()` and `readCompressedData()` with the server.
+         * @details This function sends a compression offer and waits for the answer of the server, see `Server::setCompression()`. The
+         * server decides the codec, so it can be another one than in the options, or none. Without this call, and after
+         * `disconnectFromServer()`, compressed frames are sent uncompressed.
+         * @param t_options The options, the codec is the one this client prefers.
+         * @throws `InvalidArgumentException` if the codec was not found at build time.
+         * @throws `ClientRuntimeException` if the server did not answer the offer or the answer is malformed.
+         * @throws `ClientTimeoutException` if the timeout passed.
+         * @version 1.0.0
+         */
+        void enableCompression(const CompressionOptions &t_options);
+
+        /**
+         * @brief Retrieves the codec the server chose.
+         * @return The codec, `CompressionCodec::NONE` before the negotiation.
+         * @version 1.0.0
+         */
+        CompressionCodec getCompressionCodec() const;
+
+        /**
+         * @brief Sends data to the server as one compression frame.
+         * @details The data is compressed with the negotiated codec, or sent uncompressed in a frame if it is short or does not get
+         * shorter. The server reads it with `Server::readCompressedData()`.
+         * @param t_data The data to send.
+         * @throws `InvalidArgumentException` if the data is empty or larger than `Constants::COMPRESSION_MAXIMUM_FRAME_SIZE`.
+         * @throws `ClientRuntimeException` if the data cannot be compressed or sent.
+         * @throws `ClientTimeoutException` if the timeout passed.
+         * @version 1.0.0
+         */
+        void sendCompressedData(const std::string &t_data);
+
+        /**
+         * @brief Reads one compression frame from the server and decompresses it.
+         * @details The data is available with `getData()` afterwards. If the payload times out, the whole frame is kept and the next
+         * call reads it again from its header.
+         * @throws `ClientRuntimeException` if the data cannot be read or the frame is malformed.
+         * @throws `ClientTimeoutException` if the timeout passed.
+         * @version 1.0.0
+         */
+        void readCompressedData();
+#ifdef FBNETWORK_WITH_TLS
+
+        /**
+         * @brief Sets the TLS context of the client.
+         * @details The next `connectToServer()` does the TLS handshake after connecting. Pass nullptr to connect in plaintext again.
+         * @param t_tlsContext The TLS context, created with `TlsRole::CLIENT`. It can be shared by many clients, which share the
+         * stored sessions as well.
+         * @param t_serverName The name of the server, which is sent as SNI and checked against the certificate. If it is empty, the
+         * certificate is not matched against a name.
+         * @throws `InvalidArgumentException` if the context is not a client context.
+         * @version 1.0.0
+         */
+        void setTlsContext(std::shared_ptr<TlsContext> t_tlsContext, const std::string &t_serverName = "");
+
+        /**
+         * @brief Gets the TLS session of the connection, for example to check whether the session was resumed.
+         * @return The TLS session, or nullptr if the client does not use TLS.
+         * @version 1.0.0
+         */
+        std::shared_ptr<TlsConnection> getTlsConnection() const;
+#endif
     };
 }  // namespace FBNetwork
 
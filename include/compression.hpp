@@ -0,0 +1,282 @@
+#ifndef FBNETWORK_COMPRESSION_HPP
+#define FBNETWORK_COMPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "constants.hpp"
+#include "exceptions.hpp"
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents a compression codec.
+     * @details LZ4 compresses and decompresses at several GB/s with a moderate ratio, for links where latency matters. ZSTD reaches a
+     * much better ratio, especially with a shared dictionary, for bandwidth-bound links. Only the codecs found at build time are
+     * available, see `Compressor::isAvailable()`.
+     * @version 1.0.0
+     */
+    enum class CompressionCodec : uint8_t
+    {
+        NONE = 0,
+        LZ4  = 1,
+        ZSTD = 2
+    };
+
+    class CompressionDictionary;
+
+    /**
+     * @brief Represents the options of the compression of a connection.
+     * @details `level` 0 is the default of the codec. For ZSTD it is the compression level, 1 to 22, higher is slower with a better
+     * ratio, negative levels are faster still. For LZ4 it is the acceleration, higher is faster with a lower ratio. Messages shorter than
+     * `minimumSize` are sent uncompressed. The dictionary is used by ZSTD, and only if both sides have the same one.
+     * @version 1.0.0
+     */
+    struct CompressionOptions
+    {
+        CompressionCodec                             codec       = CompressionCodec::NONE;
+        int                                          level       = 0;
+        size_t                                       minimumSize = Constants::COMPRESSION_MINIMUM_SIZE;
+        std::shared_ptr<const CompressionDictionary> dictionary  = nullptr;
+    };
+
+    /**
+     * @brief Represents a dictionary shared by many connections.
+     * @details Short messages of the same kind compress badly on their own, since every message starts without history. A dictionary
+     * of typical content is that history. The `CompressionDictionary` class digests it once per level for compression and once for
+     * decompression, every connection that uses it shares the digested forms.
+     * @note The `CompressionDictionary` class is thread-safe.
+     * @version 1.0.0
+     */
+    class CompressionDictionary
+    {
+    private:
+        std::string                           m_content;
+        uint32_t                              m_id = 0;
+        mutable std::mutex                    m_mutex;
+        mutable std::map<int, ZSTD_CDict_s *> m_compressionDictionaries;
+        mutable ZSTD_DDict_s                 *m_decompressionDictionary = nullptr;
+
+    public:
+        /**
+         * @brief Constructs a CompressionDictionary object.
+         * @param t_content The dictionary, trained with `train()` or the `zstd --train` tool, or raw typical content.
+         * @throws `InvalidArgumentException` If the dictionary is empty.
+         * @version 1.0.0
+         */
+        explicit CompressionDictionary(const std::string &t_content);
+
+        /**
+         * @brief Destroys the CompressionDictionary object.
+         * @version 1.0.0
+         */
+        ~CompressionDictionary();
+
+        CompressionDictionary(const CompressionDictionary &)            = delete;
+        CompressionDictionary &operator=(const CompressionDictionary &) = delete;
+
+        /**
+         * @brief Trains a dictionary from sample messages.
+         * @param t_samples The samples, a few hundred typical messages or more.
+         * @param t_capacity The maximum size of the dictionary in bytes, around 100 times smaller than all samples together.
+         * @return The dictionary.
+         * @throws `InvalidArgumentException` If there are no samples or the capacity is 0.
+         * @throws `SystemRuntimeException` If ZSTD is not available or the training failed, for example with too few samples.
+         * @version 1.0.0
+         */
+        static std::shared_ptr<const CompressionDictionary> train(const std::vector<std::string> &t_samples, const size_t t_capacity);
+
+        /**
+         * @brief Retrieves the ID of the dictionary, which both sides of a connection compare during the negotiation.
+         * @return The ID of a trained dictionary, or a hash of the content of a raw one.
+         * @version 1.0.0
+         */
+        uint32_t getId() const;
+
+        /**
+         * @brief Retrieves the content of the dictionary.
+         * @return The content.
+         * @version 1.0.0
+         */
+        const std::string &getContent() const;
+
+        /**
+         * @brief Retrieves the digested dictionary for compression at a level, and digests it on the first call.
+         * @param t_level The ZSTD level.
+         * @return The digested dictionary.
+         * @throws `SystemRuntimeException` If ZSTD is not available or the dictionary could not be digested.
+         * @version 1.0.0
+         */
+        ZSTD_CDict_s *getCompressionDictionary(const int t_level) const;
+
+        /**
+         * @brief Retrieves the digested dictionary for decompression, and digests it on the first call.
+         * @return The digested dictionary.
+         * @throws `SystemRuntimeException` If ZSTD is not available or the dictionary could not be digested.
+         * @version 1.0.0
+         */
+        ZSTD_DDict_s *getDecompressionDictionary() const;
+    };
+
+    /**
+     * @brief Represents the compression stage of one connection.
+     * @details The `Compressor` class turns messages into frames and back. A frame is a header of
+     * `Constants::COMPRESSION_FRAME_HEADER_SIZE` bytes, the codec, the size of the payload and the size of the message, each size
+     * as 4 bytes in network byte order, followed by the payload. Every frame is compressed on its own, so a lost connection loses no
+     * state, but the contexts of the codecs are created once and reused for every frame of the connection.
+     *
+     * Both sides start out sending uncompressed frames. `createOffer()` and `answerOffer()` negotiate the codec: the side that
+     * answers chooses its own codec if the offering side has it, otherwise none, and the dictionary is used if both have the same one.
+     * Every side decompresses whatever codec a frame names.
+     * @note The `Compressor` class is not thread-safe, but compressing and decompressing use separate contexts, so one thread can send
+     * while another one reads.
+     * @version 1.0.0
+     */
+    class Compressor
+    {
+    private:
+        CompressionOptions m_options;
+        CompressionCodec   m_codec                    = CompressionCodec::NONE;
+        bool               m_usesDictionary           = false;
+        std::vector<char>  m_lz4State;
+        ZSTD_CCtx_s       *m_zstdCompressionContext   = nullptr;
+        ZSTD_DCtx_s       *m_zstdDecompressionContext = nullptr;
+
+        /**
+         * @brief Writes the header of a frame.
+         * @param t_frame The frame, at least `Constants::COMPRESSION_FRAME_HEADER_SIZE` bytes long.
+         * @param t_codec The codec byte.
+         * @param t_payloadSize The size of the payload.
+         * @param t_messageSize The size of the message.
+         * @version 1.0.0
+         */
+        static void writeHeader(std::string &t_frame, const uint8_t t_codec, const size_t t_payloadSize, const size_t t_messageSize);
+
+        /**
+         * @brief Compresses a message with the negotiated codec into the payload of a frame.
+         * @param t_message The message.
+         * @param t_size The size of the message.
+         * @param t_frame The frame, the payload is written after the header.
+         * @return The size of the payload, 0 if the compressed message would not be shorter.
+         * @throws `SystemRuntimeException` If the codec failed.
+         * @version 1.0.0
+         */
+        size_t compressPayload(const char *t_message, const size_t t_size, std::string &t_frame);
+
+    public:
+        /**
+         * @brief Constructs a Compressor object.
+         * @param t_options The options.
+         * @throws `InvalidArgumentException` If the codec is not available.
+         * @version 1.0.0
+         */
+        explicit Compressor(const CompressionOptions &t_options = CompressionOptions());
+
+        /**
+         * @brief Destroys the Compressor object.
+         * @version 1.0.0
+         */
+        ~Compressor();
+
+        Compressor(const Compressor &)            = delete;
+        Compressor &operator=(const Compressor &) = delete;
+
+        /**
+         * @brief Checks if a codec was found at build time.
+         * @param t_codec The codec.
+         * @return true if the codec is available, false otherwise. `CompressionCodec::NONE` is always available.
+         * @version 1.0.0
+         */
+        static bool isAvailable(const CompressionCodec t_codec);
+
+        /**
+         * @brief Turns a message into a frame.
+         * @details The message is compressed with the negotiated codec, unless it is shorter than the minimum size or does not get
+         * shorter, then it is stored as it is.
+         * @param t_message The message.
+         * @param t_frame The frame, its memory is reused.
+         * @throws `InvalidArgumentException` If the message is larger than `Constants::COMPRESSION_MAXIMUM_FRAME_SIZE`.
+         * @throws `SystemRuntimeException` If the codec failed.
+         * @version 1.0.0
+         */
+        void compress(const std::string &t_message, std::string &t_frame);
+
+        /**
+         * @brief Retrieves the size of the payload that follows a header.
+         * @param t_header The header, `Constants::COMPRESSION_FRAME_HEADER_SIZE` bytes.
+         * @return The size of the payload.
+         * @throws `InvalidArgumentException` If the header is malformed or names a frame larger than
+         * `Constants::COMPRESSION_MAXIMUM_FRAME_SIZE`.
+         * @version 1.0.0
+         */
+        static size_t getPayloadSize(const std::string &t_header);
+
+        /**
+         * @brief Checks if a header starts a negotiation frame.
+         * @param t_header The header.
+         * @return true if it is a negotiation frame, false otherwise.
+         * @version 1.0.0
+         */
+        static bool isOffer(const std::string &t_header);
+
+        /**
+         * @brief Turns a frame back into its message.
+         * @param t_header The header, `Constants::COMPRESSION_FRAME_HEADER_SIZE` bytes.
+         * @param t_payload The payload.
+         * @param t_message The message, its memory is reused.
+         * @throws `InvalidArgumentException` If the frame is malformed or names a codec that is not available.
+         * @throws `SystemRuntimeException` If the codec failed.
+         * @version 1.0.0
+         */
+        void decompress(const std::string &t_header, const std::string &t_payload, std::string &t_message);
+
+        /**
+         * @brief Creates the negotiation frame that offers the codecs of this side.
+         * @return The frame.
+         * @version 1.0.0
+         */
+        std::string createOffer() const;
+
+        /**
+         * @brief Chooses the codec for an offer of the other side and starts using it.
+         * @param t_payload The payload of the negotiation frame of the other side.
+         * @return The negotiation frame that tells the other side the choice.
+         * @throws `InvalidArgumentException` If the payload is malformed.
+         * @version 1.0.0
+         */
+        std::string answerOffer(const std::string &t_payload);
+
+        /**
+         * @brief Starts using the codec the other side chose for an offer of this side.
+         * @param t_payload The payload of the negotiation frame of the other side.
+         * @throws `InvalidArgumentException` If the payload is malformed or names a codec that is not available.
+         * @version 1.0.0
+         */
+        void acceptAnswer(const std::string &t_payload);
+
+        /**
+         * @brief Retrieves the negotiated codec.
+         * @return The codec, `CompressionCodec::NONE` before the negotiation.
+         * @version 1.0.0
+         */
+        CompressionCodec getCodec() const;
+
+        /**
+         * @brief Checks if the negotiated codec uses the dictionary.
+         * @return true if both sides have the same dictionary, false otherwise.
+         * @version 1.0.0
+         */
+        bool usesDictionary() const;
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef FBNETWORK_CONCURRENCY_LIMIT_HPP
+#define FBNETWORK_CONCURRENCY_LIMIT_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+#include "exceptions.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents the algorithm that adapts a concurrency limit.
+     * @details With AIMD the limit grows by one per sample while it is used and shrinks by the backoff ratio when a request fails or
+     * takes longer than the latency threshold. With GRADIENT the limit follows the ratio of the long-term to the recent latency, so it
+     * shrinks as soon as requests start to queue, without a fixed threshold.
+     * @version 1.0.0
+     */
+    enum class ConcurrencyAlgorithm
+    {
+        AIMD,
+        GRADIENT
+    };
+
+    /**
+     * @brief Represents the options of a concurrency limit.
+     * @details `latencyThreshold` and `backoffRatio` are used by AIMD, `tolerance`, `smoothing` and `longWindow` by GRADIENT.
+     * `tolerance` is how much slower than the long-term latency a request may be before the limit shrinks, `longWindow` the number of
+     * samples the long-term latency averages over.
+     * @version 1.0.0
+     */
+    struct ConcurrencyLimitOptions
+    {
+        ConcurrencyAlgorithm     algorithm        = ConcurrencyAlgorithm::GRADIENT;
+        double                   initialLimit     = 20;
+        double                   minimumLimit     = 1;
+        double                   maximumLimit     = 1000;
+        std::chrono::nanoseconds latencyThreshold = std::chrono::milliseconds(10);
+        double                   backoffRatio     = 0.9;
+        double                   tolerance        = 2;
+        double                   smoothing        = 0.2;
+        size_t                   longWindow       = 600;
+    };
+
+    /**
+     * @brief Represents a concurrency limit that adapts to the measured latency.
+     * @details The `ConcurrencyLimit` class counts the requests in flight and learns how many of them the server handles before they
+     * start to wait for each other. Every request is counted with `acquire()` or `tryAcquire()` and reports its latency with
+     * `release()`. `Server::dispatch()` and `Server::dispatchRpc()` admit every handler with `tryAcquire()` and reject it when the limit
+     * is reached, and `Server::setConcurrencyLimit()` stops accepting connections meanwhile.
+     * @note The `ConcurrencyLimit` class is thread-safe.
+     * @version 1.0.0
+     */
+    class ConcurrencyLimit
+    {
+    private:
+        mutable std::mutex      m_mutex;
+        ConcurrencyLimitOptions m_options;
+        double                  m_limit       = 0;
+        size_t                  m_inFlight    = 0;
+        double                  m_longLatency = 0;
+        size_t                  m_longSamples = 0;
+
+        /**
+         * @brief Adapts the limit to one sample with AIMD.
+         * @param t_latency The latency of the request in nanoseconds.
+         * @param t_isDropped Whether the request failed.
+         * @version 1.0.0
+         */
+        void updateAimd(const double t_latency, const bool t_isDropped);
+
+        /**
+         * @brief Adapts the limit to one sample with the gradient of the latency.
+         * @param t_latency The latency of the request in nanoseconds.
+         * @param t_isDropped Whether the request failed.
+         * @version 1.0.0
+         */
+        void updateGradient(const double t_latency, const bool t_isDropped);
+
+    public:
+        /**
+         * @brief Constructs a ConcurrencyLimit object.
+         * @param t_options The options.
+         * @throws `InvalidArgumentException` If the limits are not ordered as `0 < minimumLimit <= initialLimit <= maximumLimit`, or an
+         * option of the algorithm is out of range.
+         * @version 1.0.0
+         */
+        explicit ConcurrencyLimit(const ConcurrencyLimitOptions &t_options = ConcurrencyLimitOptions());
+
+        /**
+         * @brief Counts a request in flight, even above the limit.
+         * @details Only for requests that cannot be rejected. A limit that is exceeded this way does not hold back anything, use
+         * `tryAcquire()` to enforce it.
+         * @version 1.0.0
+         */
+        void acquire();
+
+        /**
+         * @brief Counts a request in flight if the limit is not reached.
+         * @return true if the request was counted, false if it should be rejected.
+         * @version 1.0.0
+         */
+        bool tryAcquire();
+
+        /**
+         * @brief Ends a request and adapts the limit to its latency.
+         * @param t_latency The time from the start of the request until its end, including the time it waited.
+         * @param t_isDropped Whether the request failed, which counts as overload.
+         * @version 1.0.0
+         */
+        void release(const std::chrono::nanoseconds t_latency, const bool t_isDropped = false);
+
+        /**
+         * @brief Checks if the limit is reached.
+         * @return true if at least as many requests are in flight as the limit allows, false otherwise.
+         * @version 1.0.0
+         */
+        bool isSaturated() const;
+
+        /**
+         * @brief Retrieves the current limit.
+         * @return The limit, rounded down.
+         * @version 1.0.0
+         */
+        size_t getLimit() const;
+
+        /**
+         * @brief Retrieves the number of requests in flight.
+         * @return The number of requests.
+         * @version 1.0.0
+         */
+        size_t getInFlight() const;
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -1,11 +1,13 @@
 #ifndef FBNETWORK_CONSTANTS_HPP
 #define FBNETWORK_CONSTANTS_HPP
 
-#include <mysql/mysql.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
 #include <set>
 #include <string>
 #include <sys/socket.h>
-#include <variant>
+#include <tuple>
 #include <vector>
 #ifdef __APPLE__
 #include <sys/event.h>
@@ -61,14 +63,15 @@ typedef struct epoll_event event;
 
 /**
  * @brief Represents the type of event.
- * @details The `EventType` enum class is used to represent the type of event in the event queue. It can be one of the following values: ERROR, CLIENT_WANTS_TO_CONNECT, or CLIENT_WANTS_TO_SEND_DATA.
+ * @details The `EventType` enum class is used to represent the type of event in the event queue. It can be one of the following values: ERROR, CLIENT_WANTS_TO_CONNECT, CLIENT_WANTS_TO_SEND_DATA, or CLIENT_TIMED_OUT. For CLIENT_TIMED_OUT the client was already closed by the server and its ID is only reported. A client that was reset by its peer is reported as CLIENT_WANTS_TO_SEND_DATA, so the next read fails and the client can be closed.
  * @version 1.0.0
  */
 enum class EventType
 {
     ERROR,
     CLIENT_WANTS_TO_CONNECT,
-    CLIENT_WANTS_TO_SEND_DATA
+    CLIENT_WANTS_TO_SEND_DATA,
+    CLIENT_TIMED_OUT
 };
 
 /**
@@ -86,16 +89,36 @@ typedef std::vector<event> eventList;
 typedef std::tuple<EventType, int> eventTuple;
 
 /**
- * @namespace SQL
- * @brief Contains constants and types related to SQL operations.
- * @details This namespace contains constants and types related to SQL operations, such as parameter types and result types.
+ * @brief Represents an immutable payload shared by several clients.
+ * @details The `sharedPayload` type is a typedef for `std::shared_ptr<const std::string>`. The output queue of every client that the
+ * payload is sent to holds a reference instead of a copy, and the payload is freed once the last client has written it.
  * @version 1.0.0
  */
-namespace SQL
+typedef std::shared_ptr<const std::string> sharedPayload;
+
+/**
+ * @brief Represents what happens to a client whose output queue is full.
+ * @details The `SlowClientPolicy` enum class is used when a payload would grow the output queue of a client above its limit. With DROP_MESSAGE the payload is not queued for that client, with DISCONNECT the client is closed.
+ * @version 1.0.0
+ */
+enum class SlowClientPolicy
+{
+    DROP_MESSAGE,
+    DISCONNECT
+};
+
+/**
+ * @brief Represents what the server does with new connections while it is overloaded.
+ * @details The `OverloadPolicy` enum class is used when every client ID is taken or the concurrency limit is reached. With THROW the accept functions throw and the connections stay in the backlog, with PAUSE_ACCEPTING the event queue stops reporting the listener until the load has dropped, with ACCEPT_AND_CLOSE the pending connections are accepted, answered with the overload response and closed.
+ * @version 1.0.0
+ */
+enum class OverloadPolicy
 {
-const std::vector<std::string> EMPTY_RESULT = {};
-typedef std::variant<std::string, int, double, MYSQL_TIME, std::vector<char>> parameter;
-} // namespace SQL
+    THROW,
+    PAUSE_ACCEPTING,
+    ACCEPT_AND_CLOSE
+};
+
 /**
  * @namespace Constants
  * @brief Contains constants used in the project.
@@ -109,6 +132,36 @@ const size_t BUFFER_SIZE = 1024;
 const struct timeval DEFAULT_TIMEOUT = {60, 0};
 const int MAX_EVENTS = 2048;
 const int EVENT_ERROR = -1;
+const size_t LOG_QUEUE_CAPACITY = 8192;
+const std::chrono::milliseconds LOG_FLUSH_INTERVAL = std::chrono::milliseconds(100);
+const size_t MYSQL_MAXIMUM_PARAMETERS = 65535;
+const std::string METRICS_PATH = "/metrics";
+const std::string METRICS_CONTENT_TYPE = "text/plain; version=0.0.4; charset=utf-8";
+const struct timeval METRICS_TIMEOUT = {0, 50000};
+const std::chrono::milliseconds METRICS_REQUEST_TIMEOUT = std::chrono::milliseconds(2000);
+const int METRICS_MAXIMUM_CONNECTIONS = 16;
+const size_t UDP_BATCH_SIZE = 64;
+const size_t UDP_DATAGRAM_SIZE = 2048;
+const std::chrono::milliseconds TIMING_WHEEL_RESOLUTION = std::chrono::milliseconds(10);
+const size_t SENDFILE_CHUNK_SIZE = 1 << 20;
+const size_t TLS_RECORD_SIZE = 16384;
+const size_t RESOLVER_THREAD_COUNT = 2;
+const size_t RESOLVER_CACHE_CAPACITY = 4096;
+const std::chrono::seconds RESOLVER_CACHE_TTL = std::chrono::seconds(30);
+const std::chrono::seconds RESOLVER_NEGATIVE_CACHE_TTL = std::chrono::seconds(5);
+const std::chrono::milliseconds CONNECTION_ATTEMPT_DELAY = std::chrono::milliseconds(250);
+const int MAXIMUM_NUMA_NODES = 1024;
+const size_t OUTPUT_QUEUE_LIMIT = 4 << 20;
+const size_t OUTPUT_QUEUE_BATCH_SIZE = 64;
+const size_t RATE_LIMIT_MAXIMUM_SOURCES = 65536;
+const int LISTEN_BACKLOG = SOMAXCONN;
+const size_t COMPRESSION_FRAME_HEADER_SIZE = 9;
+const size_t COMPRESSION_MAXIMUM_FRAME_SIZE = 64 << 20;
+const size_t COMPRESSION_MINIMUM_SIZE = 64;
+const size_t RPC_FRAME_HEADER_SIZE = 13;
+const size_t RPC_MAXIMUM_FRAME_SIZE = 64 << 20;
+const unsigned RPC_SLOT_BITS = 20;
+const std::chrono::milliseconds RPC_POLL_INTERVAL = std::chrono::milliseconds(10);
 } // namespace Constants
 /**
  * @namespace Log
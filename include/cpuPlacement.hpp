@@ -0,0 +1,155 @@
+#ifndef FBNETWORK_CPU_PLACEMENT_HPP
+#define FBNETWORK_CPU_PLACEMENT_HPP
+
+#include <algorithm>
+#include <dirent.h>
+#include <errno.h>
+#include <fstream>
+#include <string>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+#include "constants.hpp"
+#include "exceptions.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents where an event loop runs: its CPUs and the NUMA node its memory comes from.
+     * @details The `CpuPlacement` class pins the thread of an event loop to a set of CPUs and makes the pages the thread allocates come
+     * from the NUMA node of those CPUs, so the stack, the read buffers and the client data of the loop stay in its local memory. A
+     * server that has a placement also sets `SO_INCOMING_CPU` on its listening socket to the first CPU. When several servers share a
+     * port with `SocketOptions::setReusePort()`, the kernel then hands a new connection to the server whose CPU received it, so the
+     * interrupt, the protocol processing and the event loop of a connection share one cache.
+     * @note Placements only work on Linux. The NUMA topology is read from `/sys/devices/system`, machines without NUMA have one node 0.
+     * @version 1.0.0
+     */
+    class CpuPlacement
+    {
+    private:
+        std::vector<int> m_cpus;
+        int              m_numaNode    = -1;
+        bool             m_bindsMemory = true;
+
+    public:
+        /**
+         * @brief Retrieves the number of online CPUs.
+         * @return The number of online CPUs, at least 1.
+         * @version 1.0.0
+         */
+        static size_t getCpuCount();
+
+        /**
+         * @brief Retrieves the CPU the calling thread runs on.
+         * @return The CPU, or -1 if it is not known.
+         * @version 1.0.0
+         */
+        static int getCurrentCpu();
+
+        /**
+         * @brief Retrieves the NUMA node of a CPU.
+         * @param t_cpu The CPU.
+         * @return The node, or -1 if it is not known.
+         * @version 1.0.0
+         */
+        static int getNumaNodeOfCpu(const int t_cpu);
+
+        /**
+         * @brief Retrieves the online CPUs of a NUMA node.
+         * @param t_numaNode The node.
+         * @return The CPUs in ascending order, empty if the node does not exist.
+         * @version 1.0.0
+         */
+        static std::vector<int> getCpusOfNumaNode(const int t_numaNode);
+
+        /**
+         * @brief Builds the placement of one of several event loops, each pinned to its own CPU.
+         * @details The loops are spread evenly over the CPUs ordered by NUMA node, so two loops on a machine with two nodes run on
+         * different nodes, and more loops than CPUs share CPUs.
+         * @param t_loopIndex The index of the loop, starting at 0.
+         * @param t_loopCount The number of loops.
+         * @return The placement.
+         * @throws `InvalidArgumentException` If `t_loopIndex` is not less than `t_loopCount`.
+         * @version 1.0.0
+         */
+        static CpuPlacement forLoop(const size_t t_loopIndex, const size_t t_loopCount);
+
+        /**
+         * @brief Sets the CPUs the thread may run on.
+         * @details The NUMA node becomes the node of the CPUs, or unknown if they are on several nodes.
+         * @param t_cpus The CPUs, an empty list removes the placement.
+         * @throws `InvalidArgumentException` If a CPU is negative or too large.
+         * @version 1.0.0
+         */
+        void setCpus(const std::vector<int> &t_cpus);
+
+        /**
+         * @brief Sets the CPUs the thread may run on to all CPUs of a NUMA node.
+         * @param t_numaNode The node.
+         * @throws `InvalidArgumentException` If the node has no online CPUs.
+         * @version 1.0.0
+         */
+        void setNumaNode(const int t_numaNode);
+
+        /**
+         * @brief Sets whether the thread allocates its memory on the NUMA node of its CPUs. This is the default.
+         * @param t_bindsMemory Whether memory is allocated on the local node.
+         * @version 1.0.0
+         */
+        void setBindsMemory(const bool t_bindsMemory);
+
+        /**
+         * @brief Retrieves the CPUs the thread may run on.
+         * @return The CPUs, empty if the placement is empty.
+         * @version 1.0.0
+         */
+        const std::vector<int> &getCpus() const;
+
+        /**
+         * @brief Retrieves the NUMA node of the placement.
+         * @return The node, or -1 if it is not known or the CPUs are on several nodes.
+         * @version 1.0.0
+         */
+        int getNumaNode() const;
+
+        /**
+         * @brief Checks if the placement is empty, so that threads run wherever the scheduler puts them.
+         * @return true if no CPUs are set, false otherwise.
+         * @version 1.0.0
+         */
+        bool isEmpty() const;
+
+        /**
+         * @brief Pins the calling thread to the CPUs and prefers the NUMA node of the CPUs for its new pages.
+         * @details Pages that the thread touched before keep their node. An empty placement does nothing.
+         * @throws `SystemRuntimeException` If the affinity or the memory policy could not be set.
+         * @version 1.0.0
+         */
+        void applyToCurrentThread() const;
+
+        /**
+         * @brief Sets `SO_INCOMING_CPU` of a listening socket to the first CPU of the placement.
+         * @details An empty placement does nothing.
+         * @param t_fileDescriptor The listening socket.
+         * @throws `SystemRuntimeException` If the option could not be set.
+         * @version 1.0.0
+         */
+        void applyToListener(const fileDescriptor t_fileDescriptor) const;
+
+        /**
+         * @brief Retrieves the CPU that processed the last packet received on a socket (`SO_INCOMING_CPU`).
+         * @param t_fileDescriptor The socket.
+         * @return The CPU, or -1 if it is not known.
+         * @version 1.0.0
+         */
+        static int getIncomingCpu(const fileDescriptor t_fileDescriptor);
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef FBNETWORK_DATAGRAM_BATCH_HPP
+#define FBNETWORK_DATAGRAM_BATCH_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <errno.h>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <stdexcept>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <vector>
+#include "constants.hpp"
+#include "exceptions.hpp"
+
+namespace FBNetwork
+{
+#ifdef __APPLE__
+
+    /**
+     * @brief Represents a message header for batched system calls.
+     * @details macOS does not provide `recvmmsg` and `sendmmsg`, so the header is defined here and the batch falls back to one
+     * `recvmsg` or `sendmsg` call per datagram.
+     * @version 1.0.0
+     */
+    struct mmsghdr
+    {
+        msghdr       msg_hdr;
+        unsigned int msg_len;
+    };
+
+#endif
+
+    /**
+     * @brief Represents a received datagram.
+     * @details The `Datagram` struct points into the buffers of a `DatagramBatch`. It is valid until the next call of `receive`.
+     * @version 1.0.0
+     */
+    struct Datagram
+    {
+        std::string_view data;
+        const sockaddr  *address       = nullptr;
+        socklen_t        addressLength = 0;
+        uint16_t         segmentSize   = 0;
+        bool             isTruncated   = false;
+    };
+
+    /**
+     * @brief Represents the preallocated buffers for batched datagram I/O.
+     * @details The `DatagramBatch` class owns all buffers, I/O vectors, addresses and message headers needed to receive or send up to
+     * `batchSize` datagrams with a single `recvmmsg` or `sendmmsg` call. Nothing is allocated after construction. The functions do not
+     * throw on system call failures, they return -1 and leave `errno` set, so `UdpSocket` and `UdpServer` can throw their own exceptions.
+     * @version 1.0.0
+     */
+    class DatagramBatch
+    {
+    private:
+        static constexpr size_t CONTROL_SIZE = 64;
+
+        size_t                        m_batchSize     = 0;
+        size_t                        m_datagramSize  = 0;
+        size_t                        m_receivedCount = 0;
+        size_t                        m_queuedCount   = 0;
+        size_t                        m_sentCount     = 0;
+        std::unique_ptr<char[]>       m_receiveBuffer = nullptr;
+        std::unique_ptr<char[]>       m_sendBuffer    = nullptr;
+        std::unique_ptr<char[]>       m_controlBuffer = nullptr;
+        std::vector<iovec>            m_receiveVectors;
+        std::vector<iovec>            m_sendVectors;
+        std::vector<mmsghdr>          m_receiveHeaders;
+        std::vector<mmsghdr>          m_sendHeaders;
+        std::vector<sockaddr_storage> m_receiveAddresses;
+        std::vector<sockaddr_storage> m_sendAddresses;
+        std::vector<Datagram>         m_datagrams;
+
+    public:
+        /**
+         * @brief Constructs a new DatagramBatch object.
+         * @param t_batchSize The maximum number of datagrams per system call.
+         * @param t_datagramSize The maximum size of a datagram in bytes. With generic receive offload it must be large enough for the
+         * coalesced datagrams, up to 65535 bytes.
+         * @throws `InvalidArgumentException` If `t_batchSize` or `t_datagramSize` is 0, or `t_datagramSize` is greater than 65535.
+         * @version 1.0.0
+         */
+        DatagramBatch(const size_t t_batchSize, const size_t t_datagramSize);
+
+        DatagramBatch(const DatagramBatch &)            = delete;
+        DatagramBatch &operator=(const DatagramBatch &) = delete;
+
+        /**
+         * @brief Receives datagrams.
+         * @details This function receives up to `batchSize` datagrams with one `recvmmsg` call. Previously received datagrams are
+         * overwritten.
+         * @param t_fileDescriptor The socket to receive from.
+         * @param t_flags The flags passed to `recvmmsg`, for example `MSG_DONTWAIT` or `MSG_WAITFORONE`.
+         * @return The number of received datagrams, or -1 if the call failed.
+         * @version 1.0.0
+         */
+        int receive(const fileDescriptor t_fileDescriptor, const int t_flags);
+
+        /**
+         * @brief Retrieves the number of datagrams received by the last `receive` call.
+         * @return The number of received datagrams.
+         * @version 1.0.0
+         */
+        size_t getReceivedCount() const;
+
+        /**
+         * @brief Retrieves a received datagram.
+         * @param t_index The index of the datagram.
+         * @return The datagram.
+         * @throws `std::out_of_range` If `t_index` is not less than the number of received datagrams.
+         * @version 1.0.0
+         */
+        const Datagram &getDatagram(const size_t t_index) const;
+
+        /**
+         * @brief Queues a datagram for sending.
+         * @details This function copies the data and the address into the send buffers.
+         * @param t_data The payload of the datagram.
+         * @param t_address The destination address, or `nullptr` for a connected socket.
+         * @param t_addressLength The length of the destination address.
+         * @return `true` if the datagram was queued, `false` if the queue is full.
+         * @throws `InvalidArgumentException` If `t_data` is larger than the datagram size.
+         * @version 1.0.0
+         */
+        bool queue(const std::string_view t_data, const sockaddr *t_address, const socklen_t t_addressLength);
+
+        /**
+         * @brief Retrieves the number of queued datagrams that were not sent yet.
+         * @return The number of pending datagrams.
+         * @version 1.0.0
+         */
+        size_t getPendingCount() const;
+
+        /**
+         * @brief Sends the queued datagrams.
+         * @details This function sends the pending datagrams with as few `sendmmsg` calls as possible. If the socket would block, the
+         * remaining datagrams stay queued.
+         * @param t_fileDescriptor The socket to send on.
+         * @return The number of sent datagrams, or -1 if the first call failed.
+         * @version 1.0.0
+         */
+        int send(const fileDescriptor t_fileDescriptor);
+
+        /**
+         * @brief Drops all queued datagrams.
+         * @version 1.0.0
+         */
+        void clearQueue();
+
+        /**
+         * @brief Retrieves the maximum number of datagrams per system call.
+         * @return The batch size.
+         * @version 1.0.0
+         */
+        size_t getBatchSize() const;
+
+        /**
+         * @brief Retrieves the maximum size of a datagram.
+         * @return The datagram size in bytes.
+         * @version 1.0.0
+         */
+        size_t getDatagramSize() const;
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef FBNETWORK_EVENT_HPP
 #define FBNETWORK_EVENT_HPP
 
+#include <algorithm>
+#include <chrono>
 #include <mutex>
 #include <shared_mutex>
 #include <tuple>
@@ -111,6 +113,20 @@ namespace FBNetwork
          */
         void removeClient(const FBNetwork::fileDescriptor t_clientFileDescriptor);
 
+        /**
+         * @brief Changes what the event queue reports for a client.
+         * @details This function sets whether a client that is already in the event queue is watched for data to read and for room in
+         * its socket buffer. A client with write interest is reported by every poll while its socket buffer has room, so the interest
+         * should only be set while there is something left to write. Errors and hang-ups may be reported without any interest.
+         * @param t_clientFileDescriptor The file descriptor of the client.
+         * @param t_isReadable Whether the client is watched for data to read.
+         * @param t_isWritable Whether the client is watched for room in its socket buffer.
+         * @throws `InvalidArgumentException` If `t_clientFileDescriptor` is -1.
+         * @throws `ServerRuntimeException` If changing the event in the event queue fails.
+         * @version 1.0.0
+         */
+        void setInterest(const FBNetwork::fileDescriptor t_clientFileDescriptor, const bool t_isReadable, const bool t_isWritable);
+
         /**
          * @brief Polls the events in the event queue.
          * @details This function polls the events in the event queue. It waits for events to occur and returns the events in the event
@@ -127,10 +143,22 @@ namespace FBNetwork
          * @param t_timeout The timeout value in milliseconds.
          * @return A vector of `event` structures representing the events in the event queue.
          * @throws `ServerTimeoutException` If the timeout is reached while polling the events.
+         * @throws `ServerRuntimeException` If retrieving the events fails.
          * @version 1.0.0
          */
         eventList pollEvents(const int t_timeout);
 
+        /**
+         * @brief Polls the events in the event queue without throwing.
+         * @details This function works like `pollEvents(t_timeout)`, but reports a timeout or a failure through `t_error`. An event loop
+         * that wakes up for its deadlines reaches the timeout all the time, so it should use this function.
+         * @param t_timeout The timeout value in milliseconds.
+         * @param t_error Set to `NetworkError::TIMEOUT` if the timeout is reached, to the `errno` of the failed system call or cleared.
+         * @return A vector of `event` structures representing the events in the event queue, empty on error.
+         * @version 1.0.0
+         */
+        eventList pollEvents(const int t_timeout, std::error_code &t_error);
+
         /**
          * @brief Checks if the given event has an error.
          * @details This function checks if the given event has an error.
@@ -140,6 +168,22 @@ namespace FBNetwork
          */
         bool hasAnError(event *t_event) const;
 
+        /**
+         * @brief Checks if the given event reports data to read.
+         * @param t_event The event to check.
+         * @return `true` if the file descriptor of the event can be read, `false` otherwise.
+         * @version 1.0.0
+         */
+        bool isReadableEvent(const event *t_event) const;
+
+        /**
+         * @brief Checks if the given event reports room in the socket buffer.
+         * @param t_event The event to check.
+         * @return `true` if the file descriptor of the event can be written, `false` otherwise.
+         * @version 1.0.0
+         */
+        bool isWritableEvent(const event *t_event) const;
+
         /**
          * @brief Checks if the given event is a server event.
          * @details This function checks if the given event is a server event.
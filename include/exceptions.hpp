@@ -12,5 +12,6 @@
 #include "mysqlCreationException.hpp"
 #include "mysqlRuntimeException.hpp"
 #include "systemRuntimeException.hpp"
+#include "networkError.hpp"
 
 #endif
\ No newline at end of file
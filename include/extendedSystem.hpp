@@ -1,6 +1,7 @@
 #ifndef FBNETWORK_EXTENDEDSYSTEM_HPP
 #define FBNETWORK_EXTENDEDSYSTEM_HPP
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
@@ -11,22 +12,80 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#ifdef __APPLE__
+#include <sys/uio.h>
+#else
+#include <sys/sendfile.h>
+#endif
 #include "constants.hpp"
 #include "exceptions.hpp"
+#include "mappedFile.hpp"
 
 namespace FBNetwork
 {
+    /**
+     * @brief Represents the format of a formatted point in time.
+     * @details `DATE`, `TIME` and `DATE_TIME` use the local time zone, `HTTP` is the IMF-fixdate of HTTP headers in UTC, like
+     * "Sun, 06 Nov 1994 08:49:37 GMT".
+     * @version 1.0.0
+     */
+    enum class TimeFormat
+    {
+        DATE,
+        TIME,
+        DATE_TIME,
+        HTTP
+    };
+
     /**
      * @brief The ExtendedSystem class provides additional system functionality.
      * @details This class provides additional system functionality such as getting the current date and time, reading and
-     * writing to files and loading environment variables from a file.
+     * writing to files and loading environment variables from a file. Files are read through a `MappedFile`, use it directly to read a
+     * file without copying it.
      * @version 1.0.0
      */
     class ExtendedSystem
     {
+    private:
+        static constexpr size_t TIME_FORMAT_COUNT = 4;
+        static constexpr size_t TIME_BUFFER_SIZE  = 32;
+
+        /**
+         * @brief Represents the formatted current time of one thread.
+         * @version 1.0.0
+         */
+        struct TimeCache
+        {
+            time_t second = -1;
+            char   texts[TIME_FORMAT_COUNT][TIME_BUFFER_SIZE];
+            size_t lengths[TIME_FORMAT_COUNT] = {0};
+        };
+
+        /**
+         * @brief Retrieves the time cache of the calling thread, formatted for the current second.
+         * @details Every thread has its own cache, so reading it needs no lock. It is formatted again at most once per second.
+         * @return The time cache.
+         * @version 1.0.0
+         */
+        static const TimeCache &getTimeCache();
+
+        /**
+         * @brief Writes a number with a fixed number of digits, padded with zeros.
+         * @param t_buffer The buffer to write to.
+         * @param t_value The number.
+         * @param t_digits The number of digits.
+         * @version 1.0.0
+         */
+        static void writeDigits(char *t_buffer, int t_value, const int t_digits);
+
     public:
         /**
          * @brief Get the current date as a string.
+         * @details The date comes from the cache of `getCachedTime()`.
          * @return The current date in the format "dd.mm.yyyy".
          * @throws SystemRuntimeException If the current date could not be retrieved.
          * @version 1.0.0
@@ -35,12 +94,37 @@ namespace FBNetwork
 
         /**
          * @brief Returns the current time as a string.
+         * @details The time comes from the cache of `getCachedTime()`.
          * @return The current time as a string in the format "hh:mm:ss".
          * @throws SystemRuntimeException If the current time could not be retrieved.
          * @version 1.0.0
          */
         static std::string getCurrentTime();
 
+        /**
+         * @brief Retrieves the current time, formatted at most once per second.
+         * @details Every thread keeps its own formatted copy of the current second, so this function takes no lock and does not
+         * allocate. It is meant for timestamps on every log line or response header.
+         * @param t_format The format.
+         * @return The formatted time, or an empty view if the time could not be retrieved. The view is valid until the calling thread
+         * calls this function again in a later second.
+         * @version 1.0.0
+         */
+        static std::string_view getCachedTime(const TimeFormat t_format);
+
+        /**
+         * @brief Formats a point in time.
+         * @details This function uses `localtime_r` or `gmtime_r` and writes the digits by hand, so it is thread-safe and does not depend
+         * on the locale.
+         * @param t_time The point in time.
+         * @param t_format The format.
+         * @param t_buffer The buffer to write to, the result is null-terminated.
+         * @param t_size The size of the buffer, 32 bytes fit every format.
+         * @return The length of the formatted time, or 0 if the time could not be converted or the buffer is too small.
+         * @version 1.0.0
+         */
+        static size_t formatTime(const time_t t_time, const TimeFormat t_format, char *t_buffer, const size_t t_size);
+
         /**
          * @brief Retrieves the current error message associated with the value of `errno`.
          * @return A string containing the error message.
@@ -50,9 +134,10 @@ namespace FBNetwork
 
         /**
          * @brief Reads the contents of a file located at the specified file path.
+         * @details The file is mapped and copied once into the returned string.
          * @param t_filePath The path to the file to be read.
          * @return A string containing the contents of the file.
-         * @throws `InvalidArgumentException` If the file path is empty.
+         * @throws `InvalidArgumentException` If the file path is empty or does not name a regular file.
          * @throws `SystemRuntimeException` If the file could not be opened.
          * @version 1.0.0
          */
@@ -60,11 +145,11 @@ namespace FBNetwork
 
         /**
          * @brief Retrieves the size of a file.
-         * @details This function takes a file path as input and returns the size of the file in bytes.
+         * @details This function takes a file path as input and returns the size of the file in bytes. The file is not opened.
          * @param t_filePath The path of the file to retrieve the size of.
          * @return The size of the file in bytes.
          * @throws `InvalidArgumentException` If the file path is empty.
-         * @throws `SystemRuntimeException` If the file could not be opened.
+         * @throws `SystemRuntimeException` If the file does not exist or cannot be accessed.
          * @version 1.0.0
          */
         static size_t getFileSize(const std::string &t_filePath);
@@ -79,12 +164,27 @@ namespace FBNetwork
          */
         static void writeToFile(const std::string &t_filePath, const std::string &t_data);
 
+        /**
+         * @brief Sends a part of a file to a socket without copying it through user space.
+         * @details This function uses `sendfile`, so the kernel sends the data straight from the page cache. Like `send` on a
+         * non-blocking socket it may send less than `t_size` bytes, the caller continues at the new offset.
+         * @param t_socketFileDescriptor The connected socket.
+         * @param t_fileFileDescriptor The file, opened for reading.
+         * @param t_offset The offset in the file to start at. The file position is not changed.
+         * @param t_size The number of bytes to send, at most `Constants::SENDFILE_CHUNK_SIZE` are sent at once.
+         * @return The number of bytes sent, 0 if `t_offset` is at the end of the file or -1 like `send`.
+         * @version 1.0.0
+         */
+        static ssize_t sendFile(const fileDescriptor t_socketFileDescriptor, const fileDescriptor t_fileFileDescriptor, const off_t t_offset,
+                                const size_t t_size);
+
         /**
          * @brief Loads environment variables from a file.
          * @details This function takes a file path as input and loads the environment variables from the file. The file must be be in a
-         * KEY=VALUE pattern with no spaces. It does not validate if the file is a valid environment file.
+         * KEY=VALUE pattern with no spaces. It does not validate if the file is a valid environment file. The lines are parsed straight
+         * from the mapped file.
          * @param t_filePath The path of the file to load the environment variables from.
-         * @throws `InvalidArgumentException` If the file path is empty.
+         * @throws `InvalidArgumentException` If the file path is empty or does not name a regular file.
          * @throws `SystemRuntimeException` If the file could not be opened.
          * @version 1.0.0
          */
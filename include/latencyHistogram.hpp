@@ -0,0 +1,117 @@
+#ifndef FBNETWORK_LATENCY_HISTOGRAM_HPP
+#define FBNETWORK_LATENCY_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents a snapshot of a `LatencyHistogram`.
+     * @details The `HistogramSnapshot` struct holds a copy of the bucket counters of a `LatencyHistogram` and provides functions to
+     * calculate percentiles from them. All values are in nanoseconds.
+     * @version 1.0.0
+     */
+    struct HistogramSnapshot
+    {
+        uint64_t              count   = 0;
+        uint64_t              sum     = 0;
+        uint64_t              maximum = 0;
+        std::vector<uint64_t> buckets;
+
+        /**
+         * @brief Calculates a percentile.
+         * @details This function returns the upper bound of the bucket that contains the specified percentile. The relative error is
+         * below 3.2%.
+         * @param t_percentile The percentile between 0 and 100.
+         * @return The percentile in nanoseconds, or 0 if the histogram is empty.
+         * @version 1.0.0
+         */
+        uint64_t getPercentile(const double t_percentile) const;
+
+        /**
+         * @brief Calculates the mean.
+         * @return The mean in nanoseconds, or 0 if the histogram is empty.
+         * @version 1.0.0
+         */
+        double getMean() const;
+
+        /**
+         * @brief Counts the values less than or equal to a bound.
+         * @details This function returns the number of recorded values whose bucket lies completely below or at the specified bound. The
+         * count is exact only if the bound is the upper bound of a bucket, see `LatencyHistogram::getBucketUpperBound()`, otherwise the
+         * values of the bucket that straddles the bound are left out.
+         * @param t_bound The bound in nanoseconds.
+         * @return The number of values less than or equal to the bound.
+         * @version 1.0.0
+         */
+        uint64_t getCountAtOrBelow(const uint64_t t_bound) const;
+    };
+
+    /**
+     * @brief Represents a lock-free latency histogram.
+     * @details The `LatencyHistogram` class records latencies in nanoseconds into log-linear buckets in the style of HdrHistogram: every
+     * power of two is split into 32 linear sub-buckets. Recording a value is a handful of relaxed atomic increments, so it can be called
+     * from any thread on the hot path.
+     * @version 1.0.0
+     */
+    class LatencyHistogram
+    {
+    public:
+        static constexpr unsigned SUB_BUCKET_BITS  = 5;
+        static constexpr unsigned SUB_BUCKET_COUNT = 1U << SUB_BUCKET_BITS;
+        static constexpr unsigned MAXIMUM_EXPONENT = 40;
+        static constexpr size_t   BUCKET_COUNT     = (MAXIMUM_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKET_COUNT;
+
+    private:
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_buckets{};
+        std::atomic<uint64_t>                            m_sum{0};
+        std::atomic<uint64_t>                            m_maximum{0};
+
+    public:
+        /**
+         * @brief Records a latency.
+         * @param t_nanoseconds The latency in nanoseconds. Values above 2^40 ns are recorded in the last bucket.
+         * @version 1.0.0
+         */
+        void record(const uint64_t t_nanoseconds);
+
+        /**
+         * @brief Records the time passed since a start time.
+         * @param t_start The start time.
+         * @version 1.0.0
+         */
+        void recordSince(const std::chrono::steady_clock::time_point t_start);
+
+        /**
+         * @brief Creates a snapshot of the histogram.
+         * @details This function copies the counters of the histogram. Values recorded while the snapshot is taken may or may not be
+         * included.
+         * @return The snapshot of the histogram.
+         * @version 1.0.0
+         */
+        HistogramSnapshot getSnapshot() const;
+
+        /**
+         * @brief Calculates the bucket of a value.
+         * @param t_nanoseconds The value in nanoseconds.
+         * @return The index of the bucket.
+         * @version 1.0.0
+         */
+        static size_t getBucketIndex(const uint64_t t_nanoseconds);
+
+        /**
+         * @brief Calculates the largest value of a bucket.
+         * @param t_index The index of the bucket.
+         * @return The largest value in nanoseconds that is recorded in the bucket.
+         * @version 1.0.0
+         */
+        static uint64_t getBucketUpperBound(const size_t t_index);
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef FBNETWORK_LOGGER_HPP
+#define FBNETWORK_LOGGER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fcntl.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "constants.hpp"
+#include "exceptions.hpp"
+#include "extendedSystem.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents the level of a log entry.
+     * @details The `LogLevel` enum class is used to represent the level of a log entry. Its names map to the `Log::INFO`,
+     * `Log::WARNING` and `Log::ERROR` constants.
+     * @version 1.0.0
+     */
+    enum class LogLevel
+    {
+        INFO,
+        WARNING,
+        ERROR
+    };
+
+    /**
+     * @brief Represents a log entry handed to the database writer.
+     * @details The `LogEntry` struct holds one log entry. `type`, `source` and `message` map to the `Log::DATABASE_TYPE_NAME`,
+     * `Log::DATABASE_SOURCE_NAME` and `Log::DATABASE_MESSAGE_NAME` columns.
+     * @version 1.0.0
+     */
+    struct LogEntry
+    {
+        std::string type;
+        std::string source;
+        std::string message;
+        time_t      time = 0;
+    };
+
+    /**
+     * @brief Represents the counters of a `Logger`.
+     * @details The `LoggerStatistics` struct is a snapshot of the counters of a `Logger`.
+     * @version 1.0.0
+     */
+    struct LoggerStatistics
+    {
+        uint64_t written     = 0;
+        uint64_t dropped     = 0;
+        uint64_t rateLimited = 0;
+        uint64_t writeErrors = 0;
+    };
+
+    /**
+     * @brief Represents an asynchronous, batching logger.
+     * @details The `Logger` class copies log entries into a bounded lock-free multi-producer single-consumer ring. Producers never
+     * block and never allocate: if the ring is full or the rate limit of the level is exceeded, the entry is dropped and counted. A
+     * background thread drains the ring in batches, appends them to the log file with a single `write` per batch and hands them to the
+     * database writer, if one is set.
+     * @note Source and message are truncated to `SOURCE_SIZE` and `MESSAGE_SIZE` bytes.
+     * @version 1.0.0
+     */
+    class Logger
+    {
+    public:
+        static constexpr size_t SOURCE_SIZE  = 32;
+        static constexpr size_t MESSAGE_SIZE = 464;
+
+    private:
+        struct alignas(64) Slot
+        {
+            std::atomic<uint64_t> sequence{0};
+            int64_t               time          = 0;
+            LogLevel              level         = LogLevel::INFO;
+            uint16_t              sourceLength  = 0;
+            uint16_t              messageLength = 0;
+            char                  source[SOURCE_SIZE];
+            char                  message[MESSAGE_SIZE];
+        };
+
+        struct alignas(64) RateLimit
+        {
+            std::atomic<int64_t> theoreticalArrivalTime{0};
+            std::atomic<int64_t> interval{0};
+            std::atomic<int64_t> tolerance{0};
+        };
+
+        std::unique_ptr<Slot[]>                            m_slots           = nullptr;
+        size_t                                             m_capacity        = 0;
+        alignas(64) std::atomic<uint64_t>                  m_enqueuePosition{0};
+        alignas(64) uint64_t                               m_dequeuePosition = 0;
+        RateLimit                                          m_rateLimits[3];
+        std::atomic<uint64_t>                              m_written{0};
+        std::atomic<uint64_t>                              m_dropped{0};
+        std::atomic<uint64_t>                              m_rateLimited{0};
+        std::atomic<uint64_t>                              m_writeErrors{0};
+        fileDescriptor                                     m_fileDescriptor  = -1;
+        std::chrono::milliseconds                          m_flushInterval   = Constants::LOG_FLUSH_INTERVAL;
+        std::function<void(const std::vector<LogEntry> &)> m_databaseWriter  = nullptr;
+        std::mutex                                         m_writerMutex;
+        std::mutex                                         m_wakeUpMutex;
+        std::condition_variable                            m_wakeUp;
+        std::atomic<bool>                                  m_isRunning{false};
+        std::atomic<uint64_t>                              m_flushRequests{0};
+        std::atomic<uint64_t>                              m_flushedRequests{0};
+        std::condition_variable                            m_flushed;
+        std::thread                                        m_thread;
+
+        /**
+         * @brief Checks whether an entry of the given level passes the rate limit.
+         * @details This function implements a token bucket as generic cell rate algorithm on a single atomic, so it does not need a lock.
+         * @param t_level The level of the entry.
+         * @return `true` if the entry may be logged, `false` otherwise.
+         * @version 1.0.0
+         */
+        bool isWithinRateLimit(const LogLevel t_level);
+
+        /**
+         * @brief Drains the ring and writes the entries.
+         * @details This function moves all published entries out of the ring, formats them into one buffer and writes the buffer to the
+         * log file. Afterwards the entries are handed to the database writer.
+         * @version 1.0.0
+         */
+        void drain();
+
+        /**
+         * @brief The loop of the background thread.
+         * @details This function drains the ring every flush interval or when a flush is requested, until the logger is stopped.
+         * @version 1.0.0
+         */
+        void run();
+
+    public:
+        /**
+         * @brief Constructs a new Logger object.
+         * @details This constructor opens the log file in append mode and starts the background thread.
+         * @param t_filePath The path of the log file. If it is empty, entries are only handed to the database writer.
+         * @param t_capacity The number of entries the ring can hold. It is rounded up to the next power of two.
+         * @throws `InvalidArgumentException` If `t_capacity` is 0.
+         * @throws `SystemRuntimeException` If the log file could not be opened.
+         * @version 1.0.0
+         */
+        explicit Logger(const std::string &t_filePath, const size_t t_capacity = Constants::LOG_QUEUE_CAPACITY);
+
+        /**
+         * @brief Destroys the Logger object.
+         * @details This destructor stops the background thread, writes the remaining entries and closes the log file.
+         * @version 1.0.0
+         */
+        ~Logger();
+
+        Logger(const Logger &)            = delete;
+        Logger &operator=(const Logger &) = delete;
+
+        /**
+         * @brief Logs an entry.
+         * @details This function copies the entry into the ring and returns immediately. It does not block, lock or allocate.
+         * @param t_level The level of the entry.
+         * @param t_source The source of the entry, for example the name of the component.
+         * @param t_message The message of the entry.
+         * @return `true` if the entry was queued, `false` if it was dropped because the ring was full or the rate limit was exceeded.
+         * @version 1.0.0
+         */
+        bool log(const LogLevel t_level, const std::string_view t_source, const std::string_view t_message);
+
+        /**
+         * @brief Logs an entry with the level `LogLevel::INFO`.
+         * @param t_source The source of the entry.
+         * @param t_message The message of the entry.
+         * @return `true` if the entry was queued, `false` otherwise.
+         * @version 1.0.0
+         */
+        bool info(const std::string_view t_source, const std::string_view t_message);
+
+        /**
+         * @brief Logs an entry with the level `LogLevel::WARNING`.
+         * @param t_source The source of the entry.
+         * @param t_message The message of the entry.
+         * @return `true` if the entry was queued, `false` otherwise.
+         * @version 1.0.0
+         */
+        bool warning(const std::string_view t_source, const std::string_view t_message);
+
+        /**
+         * @brief Logs an entry with the level `LogLevel::ERROR`.
+         * @param t_source The source of the entry.
+         * @param t_message The message of the entry.
+         * @return `true` if the entry was queued, `false` otherwise.
+         * @version 1.0.0
+         */
+        bool error(const std::string_view t_source, const std::string_view t_message);
+
+        /**
+         * @brief Sets the rate limit of a level.
+         * @details This function limits the number of entries of the specified level to `t_entriesPerSecond`, allowing bursts of up to
+         * `t_burst` entries. A rate of 0 removes the limit.
+         * @param t_level The level to limit.
+         * @param t_entriesPerSecond The sustained number of entries per second.
+         * @param t_burst The number of entries that may be logged at once.
+         * @throws `InvalidArgumentException` If `t_burst` is 0 while `t_entriesPerSecond` is not 0.
+         * @version 1.0.0
+         */
+        void setRateLimit(const LogLevel t_level, const uint32_t t_entriesPerSecond, const uint32_t t_burst);
+
+        /**
+         * @brief Sets the database writer.
+         * @details This function sets a function that receives every batch of entries on the background thread, for example
+         * `[database](const auto &entries) { database->insertLogEntries("log", entries); }`. Exceptions thrown by the writer are counted
+         * as write errors.
+         * @param t_databaseWriter The function that writes a batch of entries. `nullptr` removes the writer.
+         * @note The writer runs on the background thread. If it uses a `MySQL` object, that object must not be used by another thread at
+         * the same time.
+         * @version 1.0.0
+         */
+        void setDatabaseWriter(std::function<void(const std::vector<LogEntry> &)> t_databaseWriter);
+
+        /**
+         * @brief Sets the flush interval.
+         * @details This function sets the interval in which the background thread drains the ring.
+         * @param t_flushInterval The flush interval.
+         * @throws `InvalidArgumentException` If `t_flushInterval` is less than or equal to 0.
+         * @version 1.0.0
+         */
+        void setFlushInterval(const std::chrono::milliseconds t_flushInterval);
+
+        /**
+         * @brief Writes all queued entries.
+         * @details This function wakes up the background thread and blocks until all entries queued before the call are written.
+         * @version 1.0.0
+         */
+        void flush();
+
+        /**
+         * @brief Retrieves the statistics of the logger.
+         * @details This function returns the number of written, dropped and rate limited entries and the number of failed writes.
+         * @return The statistics of the logger.
+         * @version 1.0.0
+         */
+        LoggerStatistics getStatistics() const;
+
+        /**
+         * @brief Converts a level to its name.
+         * @details This function returns `Log::INFO`, `Log::WARNING` or `Log::ERROR`.
+         * @param t_level The level to convert.
+         * @return The name of the level.
+         * @version 1.0.0
+         */
+        static const std::string &getLevelName(const LogLevel t_level);
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef FBNETWORK_MAPPED_FILE_HPP
+#define FBNETWORK_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <errno.h>
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "constants.hpp"
+#include "exceptions.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents how a mapped file is going to be read.
+     * @details The `MappedFileAccess` enum class decides which hint the kernel gets for the pages of a `MappedFile`. `SEQUENTIAL`
+     * reads ahead aggressively and drops pages behind the reader, `RANDOM` turns read ahead off.
+     * @version 1.0.0
+     */
+    enum class MappedFileAccess
+    {
+        SEQUENTIAL,
+        RANDOM
+    };
+
+    /**
+     * @brief Represents a read-only file that is mapped into memory.
+     * @details The `MappedFile` class maps a whole file with `mmap`, so its contents can be read through a `std::string_view` without
+     * copying them into the process. The file descriptor is closed right after mapping, the mapping stays valid until the object is
+     * destructed. An empty file is not mapped, its view is empty.
+     * @note If another process truncates the file while it is mapped, reading the removed part raises `SIGBUS`. Map files that are
+     * replaced atomically, like configuration files, or copy the view first.
+     * @version 1.0.0
+     */
+    class MappedFile
+    {
+    private:
+        void  *m_data = nullptr;
+        size_t m_size = 0;
+
+    public:
+        /**
+         * @brief Constructs a MappedFile object and maps the file.
+         * @param t_filePath The path of the file.
+         * @param t_access How the file is going to be read.
+         * @throws `InvalidArgumentException` If the file path is empty or does not name a regular file.
+         * @throws `SystemRuntimeException` If the file could not be opened or mapped.
+         * @version 1.0.0
+         */
+        explicit MappedFile(const std::string &t_filePath, const MappedFileAccess t_access = MappedFileAccess::SEQUENTIAL);
+
+        /**
+         * @brief Destructs a MappedFile object and unmaps the file.
+         * @version 1.0.0
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile &)            = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /**
+         * @brief Retrieves the contents of the file.
+         * @return A view of the contents, valid as long as the `MappedFile` object exists.
+         * @version 1.0.0
+         */
+        std::string_view getView() const;
+
+        /**
+         * @brief Retrieves the size of the file.
+         * @return The size of the file in bytes.
+         * @version 1.0.0
+         */
+        size_t getSize() const;
+    };
+}  // namespace FBNetwork
+
+#endif
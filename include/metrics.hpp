@@ -0,0 +1,312 @@
+#ifndef FBNETWORK_METRICS_HPP
+#define FBNETWORK_METRICS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <sstream>
+#include <string>
+#include <sys/types.h>
+#include "latencyHistogram.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents a snapshot of the counters of a connection.
+     * @details The `ConnectionMetricsSnapshot` struct is a copy of the counters of a `ConnectionMetrics` object.
+     * @version 1.0.0
+     */
+    struct ConnectionMetricsSnapshot
+    {
+        uint64_t bytesIn     = 0;
+        uint64_t bytesOut    = 0;
+        uint64_t reads       = 0;
+        uint64_t writes      = 0;
+        uint64_t timeouts    = 0;
+        uint64_t wouldBlocks = 0;
+        uint64_t errors      = 0;
+        time_t   connectedAt = 0;
+    };
+
+    /**
+     * @brief Represents the counters of a connection.
+     * @details The `ConnectionMetrics` class holds the counters of one connection. A connection is only read and written by one thread at
+     * a time, so the counters are relaxed atomics that live on one cache line and are never contended.
+     * @version 1.0.0
+     */
+    class alignas(64) ConnectionMetrics
+    {
+    private:
+        std::atomic<uint64_t> m_bytesIn{0};
+        std::atomic<uint64_t> m_bytesOut{0};
+        std::atomic<uint64_t> m_reads{0};
+        std::atomic<uint64_t> m_writes{0};
+        std::atomic<uint64_t> m_timeouts{0};
+        std::atomic<uint64_t> m_wouldBlocks{0};
+        std::atomic<uint64_t> m_errors{0};
+        time_t                m_connectedAt = 0;
+
+    public:
+        /**
+         * @brief Constructs a new ConnectionMetrics object.
+         * @details This constructor stores the current time as the time the connection was established.
+         * @version 1.0.0
+         */
+        ConnectionMetrics();
+
+        /**
+         * @brief Records a successful read.
+         * @param t_bytes The number of bytes read.
+         * @version 1.0.0
+         */
+        void recordRead(const ssize_t t_bytes);
+
+        /**
+         * @brief Records a successful write.
+         * @param t_bytes The number of bytes written.
+         * @version 1.0.0
+         */
+        void recordWrite(const ssize_t t_bytes);
+
+        /**
+         * @brief Records a timeout.
+         * @version 1.0.0
+         */
+        void recordTimeout();
+
+        /**
+         * @brief Records a read or write that returned `EAGAIN` or `EWOULDBLOCK`.
+         * @version 1.0.0
+         */
+        void recordWouldBlock();
+
+        /**
+         * @brief Records a failed read or write.
+         * @version 1.0.0
+         */
+        void recordError();
+
+        /**
+         * @brief Creates a snapshot of the counters.
+         * @return The snapshot of the counters.
+         * @version 1.0.0
+         */
+        ConnectionMetricsSnapshot getSnapshot() const;
+    };
+
+    /**
+     * @brief Represents a snapshot of the metrics of a server.
+     * @details The `ServerMetricsSnapshot` struct is a copy of the counters and histograms of a `ServerMetrics` object. Latencies are in
+     * nanoseconds.
+     * @version 1.0.0
+     */
+    struct ServerMetricsSnapshot
+    {
+        uint64_t          accepts            = 0;
+        uint64_t          closes             = 0;
+        uint64_t          bytesIn            = 0;
+        uint64_t          bytesOut           = 0;
+        uint64_t          reads              = 0;
+        uint64_t          writes             = 0;
+        uint64_t          timeouts           = 0;
+        uint64_t          wouldBlocks        = 0;
+        uint64_t          errors             = 0;
+        uint64_t          droppedMessages    = 0;
+        uint64_t          pausedReads        = 0;
+        uint64_t          rejectedAccepts    = 0;
+        uint64_t          shedConnections    = 0;
+        uint64_t          shedRequests       = 0;
+        int64_t           currentConnections = 0;
+        time_t            lifeTime           = 0;
+        HistogramSnapshot readLatency;
+        HistogramSnapshot framingLatency;
+        HistogramSnapshot sendLatency;
+
+        /**
+         * @brief Formats the snapshot in the Prometheus text exposition format.
+         * @details This function returns all counters as `fbnetwork_*_total` counters and the latencies as `fbnetwork_*_seconds`
+         * histograms with fixed bucket bounds from 1 µs to 10 s.
+         * @param t_labels Labels added to every sample without braces, for example `server="api"`. May be empty.
+         * @return The formatted snapshot.
+         * @version 1.0.0
+         */
+        std::string toPrometheusText(const std::string &t_labels) const;
+
+    private:
+        /**
+         * @brief Combines the labels of a sample.
+         * @param t_labels The labels of the snapshot. May be empty.
+         * @param t_extraLabel An additional label, for example `le="0.001"`. May be empty.
+         * @return The labels in braces, or an empty string if there are no labels.
+         * @version 1.0.0
+         */
+        static std::string withLabels(const std::string &t_labels, const std::string &t_extraLabel);
+
+        /**
+         * @brief Appends a counter or gauge.
+         * @param t_stream The stream to append to.
+         * @param t_name The name of the metric.
+         * @param t_type The type of the metric, either `counter` or `gauge`.
+         * @param t_help The description of the metric.
+         * @param t_labels The labels of the metric.
+         * @param t_value The value of the metric.
+         * @version 1.0.0
+         */
+        static void appendSample(std::ostringstream &t_stream, const std::string &t_name, const std::string &t_type,
+                                 const std::string &t_help, const std::string &t_labels, const int64_t t_value);
+
+        /**
+         * @brief Appends a histogram.
+         * @details This function appends the cumulative buckets, the sum and the count of a histogram, converted to seconds. The `le`
+         * bounds are the upper edges of the histogram buckets closest to 1 µs, 5 µs, ..., 10 s, so every exported count is exact.
+         * @param t_stream The stream to append to.
+         * @param t_name The name of the metric.
+         * @param t_help The description of the metric.
+         * @param t_labels The labels of the metric.
+         * @param t_histogram The histogram to append.
+         * @version 1.0.0
+         */
+        static void appendHistogram(std::ostringstream &t_stream, const std::string &t_name, const std::string &t_help,
+                                    const std::string &t_labels, const HistogramSnapshot &t_histogram);
+    };
+
+    /**
+     * @brief Represents the metrics of a server.
+     * @details The `ServerMetrics` class holds the counters and latency histograms of a server. Every counter is a relaxed atomic on its
+     * own cache line, so threads serving different clients do not invalidate each others cache lines when they count.
+     * @version 1.0.0
+     */
+    class ServerMetrics
+    {
+    private:
+        struct alignas(64) Counter
+        {
+            std::atomic<uint64_t> value{0};
+        };
+
+        Counter          m_accepts;
+        Counter          m_closes;
+        Counter          m_bytesIn;
+        Counter          m_bytesOut;
+        Counter          m_reads;
+        Counter          m_writes;
+        Counter          m_timeouts;
+        Counter          m_wouldBlocks;
+        Counter          m_errors;
+        Counter          m_droppedMessages;
+        Counter          m_pausedReads;
+        Counter          m_rejectedAccepts;
+        Counter          m_shedConnections;
+        Counter          m_shedRequests;
+        LatencyHistogram m_readLatency;
+        LatencyHistogram m_framingLatency;
+        LatencyHistogram m_sendLatency;
+
+    public:
+        /**
+         * @brief Records an accepted client.
+         * @version 1.0.0
+         */
+        void recordAccept();
+
+        /**
+         * @brief Records a closed client.
+         * @version 1.0.0
+         */
+        void recordClose();
+
+        /**
+         * @brief Records a successful read.
+         * @param t_bytes The number of bytes read.
+         * @version 1.0.0
+         */
+        void recordRead(const ssize_t t_bytes);
+
+        /**
+         * @brief Records a successful write.
+         * @param t_bytes The number of bytes written.
+         * @version 1.0.0
+         */
+        void recordWrite(const ssize_t t_bytes);
+
+        /**
+         * @brief Records a timeout.
+         * @version 1.0.0
+         */
+        void recordTimeout();
+
+        /**
+         * @brief Records a read or write that returned `EAGAIN` or `EWOULDBLOCK`.
+         * @version 1.0.0
+         */
+        void recordWouldBlock();
+
+        /**
+         * @brief Records a failed accept, read or write.
+         * @version 1.0.0
+         */
+        void recordError();
+
+        /**
+         * @brief Records a message that was not queued for a client because its output queue was full.
+         * @version 1.0.0
+         */
+        void recordDroppedMessage();
+
+        /**
+         * @brief Records that the reads of a client were paused because it exceeded its rate limits.
+         * @version 1.0.0
+         */
+        void recordPausedRead();
+
+        /**
+         * @brief Records a connection that was closed right after accepting it because its source exceeded its rate limit.
+         * @version 1.0.0
+         */
+        void recordRejectedAccept();
+
+        /**
+         * @brief Records a connection that was closed right after accepting it because the server was overloaded.
+         * @version 1.0.0
+         */
+        void recordShedConnection();
+
+        /**
+         * @brief Records a request that was not run because the concurrency limit was reached.
+         * @version 1.0.0
+         */
+        void recordShedRequest();
+
+        /**
+         * @brief Retrieves the histogram of the read latency.
+         * @details The read latency is the time a read function needs from its call until the requested data is complete.
+         * @return The histogram of the read latency.
+         * @version 1.0.0
+         */
+        LatencyHistogram &getReadLatency();
+
+        /**
+         * @brief Retrieves the histogram of the framing latency.
+         * @details The framing latency is the time a read function spends searching for delimiters and assembling the data.
+         * @return The histogram of the framing latency.
+         * @version 1.0.0
+         */
+        LatencyHistogram &getFramingLatency();
+
+        /**
+         * @brief Retrieves the histogram of the send latency.
+         * @return The histogram of the send latency.
+         * @version 1.0.0
+         */
+        LatencyHistogram &getSendLatency();
+
+        /**
+         * @brief Creates a snapshot of the metrics.
+         * @return The snapshot of the metrics. `lifeTime` is not set.
+         * @version 1.0.0
+         */
+        ServerMetricsSnapshot getSnapshot() const;
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef FBNETWORK_METRICS_EXPORTER_HPP
+#define FBNETWORK_METRICS_EXPORTER_HPP
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include "constants.hpp"
+#include "exceptions.hpp"
+#include "metrics.hpp"
+#include "server.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents a Prometheus endpoint for the metrics of a server.
+     * @details The `MetricsExporter` class runs its own `Server` on a background thread and answers `GET /metrics` requests with the
+     * metrics of the observed server in the Prometheus text exposition format. Every request is answered on a new connection, which is
+     * closed afterwards.
+     * @note The observed server must outlive the exporter.
+     * @version 1.0.0
+     */
+    class MetricsExporter
+    {
+    private:
+        const Server           &m_observedServer;
+        std::unique_ptr<Server> m_server = nullptr;
+        std::string             m_labels = "";
+        std::atomic<bool>       m_isRunning{false};
+        std::thread             m_thread;
+
+        /**
+         * @brief Answers a single request.
+         * @details This function reads what arrived of the request header. Once the header is complete, it sends the metrics or
+         * `404 Not Found` and closes the connection. An incomplete header is kept until the next event of the client, so a slow scraper
+         * does not hold up the others. A scraper that does not finish its request within `Constants::METRICS_REQUEST_TIMEOUT` is closed.
+         * @param t_clientID The ID of the client.
+         * @version 1.0.0
+         */
+        void answerClient(const int t_clientID);
+
+        /**
+         * @brief The loop of the background thread.
+         * @details This function runs the event loop of the endpoint and answers clients until the exporter is stopped.
+         * @version 1.0.0
+         */
+        void run();
+
+    public:
+        /**
+         * @brief Constructs a new MetricsExporter object.
+         * @details This constructor starts a server on the specified port and the background thread that answers its clients.
+         * @param t_observedServer The server whose metrics are exported.
+         * @param t_domain The domain of the endpoint, either `Domain::IPV4_DOMAIN` or `Domain::IPV6_DOMAIN`.
+         * @param t_port The port of the endpoint.
+         * @param t_labels Labels added to every sample without braces, for example `server="api"`. May be empty.
+         * @throws `InvalidArgumentException` If `t_port` is invalid.
+         * @throws `InvalidDomainException` If `t_domain` is invalid.
+         * @throws `ServerCreationException` If the server of the endpoint could not be created.
+         * @throws `ServerRuntimeException` If the server of the endpoint could not listen.
+         * @version 1.0.0
+         */
+        MetricsExporter(const Server &t_observedServer, const domain t_domain, const port t_port, const std::string &t_labels = "");
+
+        /**
+         * @brief Destroys the MetricsExporter object.
+         * @details This destructor stops the background thread and the server of the endpoint.
+         * @version 1.0.0
+         */
+        ~MetricsExporter();
+
+        MetricsExporter(const MetricsExporter &)            = delete;
+        MetricsExporter &operator=(const MetricsExporter &) = delete;
+
+        /**
+         * @brief Formats the metrics of the observed server.
+         * @details This function returns the same text the endpoint sends, which is useful to export the metrics by other means.
+         * @return The metrics in the Prometheus text exposition format.
+         * @version 1.0.0
+         */
+        std::string getPrometheusText() const;
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -1,13 +1,19 @@
 #ifndef FBNETWORK_MYSQL_HPP
 #define FBNETWORK_MYSQL_HPP
 
+#include <chrono>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <mysql/mysql.h>
 #include <string>
 #include <variant>
 #include <vector>
 #include "constants.hpp"
 #include "exceptions.hpp"
+#include "logger.hpp"
+#include "mySQLCache.hpp"
+#include "mySQLTypes.hpp"
 
 namespace FBNetwork
 {
@@ -20,15 +26,18 @@ namespace FBNetwork
     class MySQL
     {
     private:
-        MYSQL_ROW                  m_row;
-        std::shared_ptr<MYSQL>     m_connection = nullptr;
-        std::shared_ptr<MYSQL_RES> m_result     = nullptr;
-        std::string                m_socket     = "";
-        std::string                m_user       = "";
-        std::string                m_password   = "";
-        std::string                m_database   = "";
-        std::string                m_host       = "";
-        port                       m_port       = 0;
+        mutable std::mutex m_cacheMutex;
+
+        MYSQL_ROW                   m_row;
+        std::shared_ptr<MYSQL>      m_connection = nullptr;
+        std::shared_ptr<MYSQL_RES>  m_result     = nullptr;
+        std::shared_ptr<MySQLCache> m_cache      = nullptr;
+        std::string                 m_socket     = "";
+        std::string                 m_user       = "";
+        std::string                 m_password   = "";
+        std::string                 m_database   = "";
+        std::string                 m_host       = "";
+        port                        m_port       = 0;
 
         /**
          * @brief Sets the connection for the MySQL object.
@@ -186,6 +195,29 @@ namespace FBNetwork
          */
         std::shared_ptr<MYSQL_RES> executePreparedStatement(const std::string &t_query, const std::vector<SQL::parameter> &t_params) const;
 
+        /**
+         * @brief Retrieves the cache.
+         * @details This function returns the cache that was set using the `enableCache` function. The pointer is copied under a lock, so
+         * a query keeps using the cache it started with while another thread, such as the logger thread, replaces or removes it.
+         * @return The cache or `nullptr` if caching is disabled.
+         * @version 1.0.0
+         */
+        std::shared_ptr<MySQLCache> getCache() const;
+
+        /**
+         * @brief Creates the cache key of a query.
+         * @details This function creates an unambiguous key from the operation, the table, the columns and the parameter values of a
+         * query. Every part is prefixed with its length, so that different queries can never produce the same key.
+         * @param t_operation The name of the operation.
+         * @param t_table The table of the query.
+         * @param t_columns The columns of the query.
+         * @param t_values The parameter values of the query.
+         * @return The cache key.
+         * @version 1.0.0
+         */
+        static std::string createCacheKey(const std::string &t_operation, const std::string &t_table,
+                                          const std::vector<std::string> &t_columns, const std::vector<SQL::parameter> &t_values);
+
     public:
         /**
          * @brief Constructs a new MySQL object, running on the local machine.
@@ -292,6 +324,32 @@ namespace FBNetwork
          */
         void insert(const std::string &t_table, const std::vector<std::string> t_columns, const std::vector<SQL::parameter> t_values);
 
+        /**
+         * @brief Inserts multiple rows into the specified table with a single statement.
+         * @details This function inserts all rows with one multi-row `INSERT` statement, so that a batch costs one round trip instead of
+         * one per row. Batches with more parameters than a prepared statement can bind are split into several statements.
+         * @param t_table The name of the table to insert into.
+         * @param t_columns The list of column names for the new rows.
+         * @param t_rows The list of rows. Every row must have one value per column.
+         * @throws `InvalidArgumentException` If the table or columns are empty or the size of a row does not match the number of columns.
+         * @throws `MySQLRuntimeException` If the statement or binding failed.
+         * @version 1.0.0
+         */
+        void insertRows(const std::string &t_table, const std::vector<std::string> &t_columns,
+                        const std::vector<std::vector<SQL::parameter>> &t_rows);
+
+        /**
+         * @brief Inserts log entries into the specified table.
+         * @details This function inserts the entries into the columns `Log::DATABASE_TYPE_NAME`, `Log::DATABASE_SOURCE_NAME` and
+         * `Log::DATABASE_MESSAGE_NAME` of the specified table. It is meant to be used as the database writer of a `Logger`.
+         * @param t_table The name of the log table.
+         * @param t_entries The entries to insert.
+         * @throws `InvalidArgumentException` If the table is empty.
+         * @throws `MySQLRuntimeException` If the statement or binding failed.
+         * @version 1.0.0
+         */
+        void insertLogEntries(const std::string &t_table, const std::vector<LogEntry> &t_entries);
+
         /**
          * @brief Updates the given colums with the given values in the specified table, where the specified column has the
          * specified value.
@@ -321,6 +379,43 @@ namespace FBNetwork
          * @version 1.0.0
          */
         void deleteWhere(const std::string &t_table, const std::string &t_column, const SQL::parameter t_value);
+
+        /**
+         * @brief Enables the read-through cache.
+         * @details This function puts an in-process cache in front of `has`, `match` and `getWhere`. Results are kept for `t_timeToLive`
+         * and at most `t_maximumEntries` results are kept. `insert`, `updateWhere` and `deleteWhere` invalidate the cached results of the
+         * table they write to. Calling this function again replaces the cache and drops all cached results.
+         * @param t_timeToLive The time a cached result stays valid.
+         * @param t_maximumEntries The maximum number of cached results.
+         * @throws `InvalidArgumentException` If `t_timeToLive` is less than or equal to 0 or `t_maximumEntries` is 0.
+         * @note Writes that do not go through this object are not seen by the cache. Use `invalidateCache` after such writes.
+         * @version 1.0.0
+         */
+        void enableCache(const std::chrono::milliseconds t_timeToLive, const size_t t_maximumEntries);
+
+        /**
+         * @brief Disables the read-through cache.
+         * @details This function removes the cache, so that every query goes to the database again.
+         * @version 1.0.0
+         */
+        void disableCache();
+
+        /**
+         * @brief Invalidates the cached results of a table.
+         * @details This function invalidates all cached results of the specified table. It does nothing if caching is disabled.
+         * @param t_table The table to invalidate.
+         * @throws `InvalidArgumentException` If the table is empty.
+         * @version 1.0.0
+         */
+        void invalidateCache(const std::string &t_table);
+
+        /**
+         * @brief Retrieves the statistics of the cache.
+         * @details This function returns the hit, miss and eviction counters and the hit rate of the cache.
+         * @return The statistics of the cache. All counters are 0 if caching is disabled.
+         * @version 1.0.0
+         */
+        MySQLCacheStatistics getCacheStatistics() const;
     };
 }  // namespace FBNetwork
 
@@ -0,0 +1,160 @@
+#ifndef FBNETWORK_MYSQL_CACHE_HPP
+#define FBNETWORK_MYSQL_CACHE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "exceptions.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents a result stored in the `MySQLCache`.
+     * @details The `MySQLCacheResult` struct holds whether a matching record was found and, for value queries, the values that were
+     * returned by the database.
+     * @version 1.0.0
+     */
+    struct MySQLCacheResult
+    {
+        bool                     found = false;
+        std::vector<std::string> values;
+    };
+
+    /**
+     * @brief Represents the counters of a `MySQLCache`.
+     * @details The `MySQLCacheStatistics` struct is a snapshot of the hit, miss and eviction counters of a `MySQLCache` together with
+     * the number of entries currently stored.
+     * @version 1.0.0
+     */
+    struct MySQLCacheStatistics
+    {
+        uint64_t hits          = 0;
+        uint64_t misses        = 0;
+        uint64_t insertions    = 0;
+        uint64_t evictions     = 0;
+        uint64_t expirations   = 0;
+        uint64_t invalidations = 0;
+        size_t   entries       = 0;
+        double   hitRate       = 0.0;
+    };
+
+    /**
+     * @brief Represents an in-process read-through cache for MySQL query results.
+     * @details The `MySQLCache` class stores query results keyed by the query, its columns and its parameter values. Entries expire
+     * after a fixed time to live and the least recently used entry is evicted once the maximum number of entries is reached. Every
+     * table has a generation counter, invalidating a table only increments its counter, so that stale entries are dropped lazily on
+     * their next lookup.
+     * @note The `MySQLCache` class uses a mutex to ensure thread-safe access to its member variables.
+     * @version 1.0.0
+     */
+    class MySQLCache
+    {
+    private:
+        struct Entry
+        {
+            std::string                           table;
+            uint64_t                              generation = 0;
+            std::chrono::steady_clock::time_point expiresAt;
+            MySQLCacheResult                      result;
+            std::list<std::string>::iterator      leastRecentlyUsedPosition;
+        };
+
+        mutable std::mutex                        m_cacheMutex;
+        std::chrono::milliseconds                 m_timeToLive     = std::chrono::milliseconds(0);
+        size_t                                    m_maximumEntries = 0;
+        std::unordered_map<std::string, Entry>    m_entries;
+        std::list<std::string>                    m_leastRecentlyUsed;
+        std::unordered_map<std::string, uint64_t> m_tableGenerations;
+        MySQLCacheStatistics                      m_statistics;
+
+        /**
+         * @brief Retrieves the generation of a table.
+         * @details This function returns the current generation counter of the specified table. The caller must hold the cache mutex.
+         * @param t_table The table to retrieve the generation of.
+         * @return The generation of the table.
+         * @version 1.0.0
+         */
+        uint64_t getTableGenerationLocked(const std::string &t_table) const;
+
+        /**
+         * @brief Removes an entry from the cache.
+         * @details This function removes the entry the iterator points to from the map and from the least recently used list. The caller
+         * must hold the cache mutex.
+         * @param t_entry The entry to remove.
+         * @version 1.0.0
+         */
+        void eraseLocked(std::unordered_map<std::string, Entry>::iterator t_entry);
+
+    public:
+        /**
+         * @brief Constructs a new MySQLCache object.
+         * @param t_timeToLive The time an entry stays valid after it has been stored.
+         * @param t_maximumEntries The maximum number of entries the cache holds before evicting the least recently used one.
+         * @throws `InvalidArgumentException` If `t_timeToLive` is less than or equal to 0 or `t_maximumEntries` is 0.
+         * @version 1.0.0
+         */
+        MySQLCache(const std::chrono::milliseconds t_timeToLive, const size_t t_maximumEntries);
+
+        /**
+         * @brief Retrieves the generation of a table.
+         * @details This function returns the current generation counter of the specified table. It has to be read before the query is
+         * executed and passed to `store()`, so that results of queries that raced with a write are not stored.
+         * @param t_table The table to retrieve the generation of.
+         * @return The generation of the table.
+         * @version 1.0.0
+         */
+        uint64_t getTableGeneration(const std::string &t_table) const;
+
+        /**
+         * @brief Looks up a result in the cache.
+         * @details This function returns the cached result for the specified key, if it exists, has not expired and its table has not
+         * been invalidated since it was stored. The entry is marked as most recently used.
+         * @param t_key The key of the query.
+         * @return The cached result or `std::nullopt` if there is no valid entry.
+         * @version 1.0.0
+         */
+        std::optional<MySQLCacheResult> lookup(const std::string &t_key);
+
+        /**
+         * @brief Stores a result in the cache.
+         * @details This function stores the result of a query. If the table has been invalidated since `t_generation` was read, the result
+         * is discarded. If the cache is full, the least recently used entry is evicted.
+         * @param t_key The key of the query.
+         * @param t_table The table the query read from.
+         * @param t_generation The generation of the table before the query was executed.
+         * @param t_result The result to store.
+         * @version 1.0.0
+         */
+        void store(const std::string &t_key, const std::string &t_table, const uint64_t t_generation, const MySQLCacheResult &t_result);
+
+        /**
+         * @brief Invalidates all entries of a table.
+         * @details This function increments the generation of the specified table, so that all of its entries are treated as misses.
+         * @param t_table The table to invalidate.
+         * @version 1.0.0
+         */
+        void invalidateTable(const std::string &t_table);
+
+        /**
+         * @brief Removes all entries from the cache.
+         * @details This function removes all entries from the cache. The counters are not reset.
+         * @version 1.0.0
+         */
+        void clear();
+
+        /**
+         * @brief Retrieves the statistics of the cache.
+         * @details This function returns a snapshot of the counters of the cache.
+         * @return The statistics of the cache.
+         * @version 1.0.0
+         */
+        MySQLCacheStatistics getStatistics() const;
+    };
+}  // namespace FBNetwork
+
+#endif
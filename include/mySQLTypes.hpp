@@ -0,0 +1,31 @@
+#ifndef FBNETWORK_MYSQL_TYPES_HPP
+#define FBNETWORK_MYSQL_TYPES_HPP
+
+#include <mysql/mysql.h>
+#include <string>
+#include <variant>
+#include <vector>
+
+/**
+ * @namespace FBNetwork
+ * @brief Namespace for network-related constants and types.
+ * @details This namespace contains constants and types related to network operations.
+ * @version 1.0.0
+ */
+namespace FBNetwork
+{
+/**
+ * @namespace SQL
+ * @brief Contains constants and types related to SQL operations.
+ * @details This namespace contains constants and types related to SQL operations, such as parameter types and result types. It lives
+ * in its own header, so only the MySQL component depends on `<mysql/mysql.h>`.
+ * @version 1.0.0
+ */
+namespace SQL
+{
+const std::vector<std::string> EMPTY_RESULT = {};
+typedef std::variant<std::string, int, double, MYSQL_TIME, std::vector<char>> parameter;
+} // namespace SQL
+} // namespace FBNetwork
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef FBNETWORK_NETWORK_ERROR_HPP
+#define FBNETWORK_NETWORK_ERROR_HPP
+
+#include <string>
+#include <system_error>
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents the errors of FBNetwork that have no `errno` value.
+     * @details The `NetworkError` enum class is used as a `std::error_code` by the non-throwing functions. Errors of system calls use
+     * `std::system_category()` with the value of `errno` instead. Every value compares equal to a portable `std::errc` condition, so
+     * `t_error == std::errc::timed_out` holds for `NetworkError::TIMEOUT`.
+     * @version 1.0.0
+     */
+    enum class NetworkError
+    {
+        TIMEOUT = 1,
+        CONNECTION_CLOSED,
+        INVALID_CLIENT,
+        INVALID_ARGUMENT
+    };
+
+    /**
+     * @brief Represents the error category of `NetworkError`.
+     * @version 1.0.0
+     */
+    class NetworkErrorCategory : public std::error_category
+    {
+    public:
+        /**
+         * @brief Retrieves the name of the category.
+         * @return "fbnetwork".
+         * @version 1.0.0
+         */
+        const char *name() const noexcept override
+        {
+            return "fbnetwork";
+        }
+
+        /**
+         * @brief Retrieves the message of an error.
+         * @param t_value The value of the error.
+         * @return The message of the error.
+         * @version 1.0.0
+         */
+        std::string message(int t_value) const override
+        {
+            switch (static_cast<NetworkError>(t_value))
+            {
+            case NetworkError::TIMEOUT:
+                return "Timeout reached.";
+            case NetworkError::CONNECTION_CLOSED:
+                return "Connection closed by peer.";
+            case NetworkError::INVALID_CLIENT:
+                return "Invalid client ID.";
+            case NetworkError::INVALID_ARGUMENT:
+                return "Invalid argument.";
+            }
+            return "Unknown error.";
+        }
+
+        /**
+         * @brief Maps an error to its portable condition.
+         * @param t_value The value of the error.
+         * @return The condition of the error.
+         * @version 1.0.0
+         */
+        std::error_condition default_error_condition(int t_value) const noexcept override
+        {
+            switch (static_cast<NetworkError>(t_value))
+            {
+            case NetworkError::TIMEOUT:
+                return std::errc::timed_out;
+            case NetworkError::CONNECTION_CLOSED:
+                return std::errc::connection_reset;
+            case NetworkError::INVALID_CLIENT:
+            case NetworkError::INVALID_ARGUMENT:
+                return std::errc::invalid_argument;
+            }
+            return std::error_condition(t_value, *this);
+        }
+
+        /**
+         * @brief Retrieves the only instance of the category.
+         * @return The category.
+         * @version 1.0.0
+         */
+        static const NetworkErrorCategory &getInstance()
+        {
+            static const NetworkErrorCategory instance;
+            return instance;
+        }
+
+        /**
+         * @brief Formats the message of an exception that carries an error code.
+         * @details This is called lazily from `what()`, so throwing an exception with an error code does not build a string.
+         * @param t_prefix The prefix of the exception, like "Server Runtime Error: ".
+         * @param t_context What failed, like "Writing the data failed.".
+         * @param t_error The error.
+         * @return The message, or only the prefix and the context if it could not be formatted.
+         * @version 1.0.0
+         */
+        static std::string formatMessage(const char *t_prefix, const char *t_context, const std::error_code &t_error)
+        {
+            std::string message = std::string(t_prefix) + (t_context != nullptr ? t_context : "");
+            if (t_error)
+            {
+                message += " Error: " + t_error.message();
+            }
+            return message;
+        }
+    };
+
+    /**
+     * @brief Creates an error code from a `NetworkError`, found by `std::error_code` through argument-dependent lookup.
+     * @param t_error The error.
+     * @return The error code.
+     * @version 1.0.0
+     */
+    inline std::error_code make_error_code(const NetworkError t_error)
+    {
+        return std::error_code(static_cast<int>(t_error), NetworkErrorCategory::getInstance());
+    }
+}  // namespace FBNetwork
+
+namespace std
+{
+    template <>
+    struct is_error_code_enum<FBNetwork::NetworkError> : true_type
+    {
+    };
+}  // namespace std
+
+#endif
@@ -0,0 +1,182 @@
+#ifndef FBNETWORK_RESOLVER_HPP
+#define FBNETWORK_RESOLVER_HPP
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <string>
+#include <sys/socket.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "constants.hpp"
+#include "exceptions.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents the addresses of a host.
+     * @details The `addressList` type is a typedef for `std::vector<sockaddr_storage>`. Every entry is a `sockaddr_in` or a
+     * `sockaddr_in6`, the port is not set.
+     * @version 1.0.0
+     */
+    typedef std::vector<sockaddr_storage> addressList;
+
+    /**
+     * @brief Represents an asynchronous host name resolver with a cache.
+     * @details The `Resolver` class runs `getaddrinfo` on a few background threads, so a caller can start a lookup and do other work
+     * until it needs the addresses. Results are cached in the process: lookups of a cached host return right away, and concurrent
+     * lookups of the same host share one `getaddrinfo` call. Failed lookups are cached for a shorter time, so a missing host does not
+     * cost a query on every connect. IP address literals are never looked up or cached.
+     * @note `getaddrinfo` does not report the TTL of the DNS records, so entries expire after a fixed time, see `setCacheTtl()`. The
+     * `Resolver` class is thread-safe.
+     * @version 1.0.0
+     */
+    class Resolver
+    {
+    private:
+        struct CacheEntry
+        {
+            std::shared_future<addressList>       addresses;
+            std::chrono::steady_clock::time_point expiresAt = std::chrono::steady_clock::time_point::max();
+            uint64_t                              lookupID  = 0;
+        };
+
+        struct Lookup
+        {
+            std::string               hostName;
+            std::promise<addressList> addresses;
+            uint64_t                  lookupID = 0;
+        };
+
+        std::mutex                                  m_mutex;
+        std::condition_variable                     m_wakeUp;
+        std::deque<std::unique_ptr<Lookup>>         m_lookups;
+        std::unordered_map<std::string, CacheEntry> m_cache;
+        std::chrono::seconds                        m_cacheTtl         = Constants::RESOLVER_CACHE_TTL;
+        std::chrono::seconds                        m_negativeCacheTtl = Constants::RESOLVER_NEGATIVE_CACHE_TTL;
+        uint64_t                                    m_nextLookupID     = 0;
+        bool                                        m_isRunning        = true;
+        std::vector<std::thread>                    m_threads;
+
+        /**
+         * @brief The loop of a background thread.
+         * @details This function takes lookups from the queue and resolves them, until the resolver is destructed.
+         * @version 1.0.0
+         */
+        void run();
+
+        /**
+         * @brief Resolves a host name with `getaddrinfo`.
+         * @param t_hostName The host name.
+         * @return The addresses in the order of `getaddrinfo`, which sorts them by RFC 6724.
+         * @throws `SystemRuntimeException` If the host name could not be resolved.
+         * @version 1.0.0
+         */
+        static addressList lookUp(const std::string &t_hostName);
+
+        /**
+         * @brief Parses an IP address literal.
+         * @param t_hostName The host name.
+         * @param t_address The parsed address.
+         * @return true if `t_hostName` is an IPv4 or IPv6 address, false otherwise.
+         * @version 1.0.0
+         */
+        static bool parseIpAddress(const std::string &t_hostName, sockaddr_storage &t_address);
+
+        /**
+         * @brief Removes the expired entries from the cache, if it is full. The mutex must be held.
+         * @version 1.0.0
+         */
+        void pruneCache();
+
+    public:
+        /**
+         * @brief Retrieves the resolver that is shared by all clients without their own.
+         * @return The shared resolver.
+         * @version 1.0.0
+         */
+        static std::shared_ptr<Resolver> getInstance();
+
+        /**
+         * @brief Orders addresses for connection attempts.
+         * @details The address families alternate as described in RFC 8305, starting with `t_preferredFamily` if there is an address of
+         * that family. Within one family the order stays the same.
+         * @param t_addresses The addresses.
+         * @param t_preferredFamily `Domain::IPV4_DOMAIN` or `Domain::IPV6_DOMAIN`.
+         * @return The ordered addresses.
+         * @version 1.0.0
+         */
+        static addressList interleaveFamilies(const addressList &t_addresses, const domain t_preferredFamily);
+
+        /**
+         * @brief Constructs a Resolver object and starts its background threads.
+         * @param t_threadCount The number of lookups that can run at the same time.
+         * @throws `InvalidArgumentException` If `t_threadCount` is 0.
+         * @version 1.0.0
+         */
+        explicit Resolver(const size_t t_threadCount = Constants::RESOLVER_THREAD_COUNT);
+
+        /**
+         * @brief Destructs a Resolver object.
+         * @details Lookups that did not start yet fail, running lookups are waited for.
+         * @version 1.0.0
+         */
+        ~Resolver();
+
+        Resolver(const Resolver &)            = delete;
+        Resolver &operator=(const Resolver &) = delete;
+
+        /**
+         * @brief Starts resolving a host name.
+         * @param t_hostName The host name or an IP address literal.
+         * @return The future addresses. Getting them throws `SystemRuntimeException` if the host name could not be resolved.
+         * @throws `InvalidArgumentException` If the host name is empty.
+         * @version 1.0.0
+         */
+        std::shared_future<addressList> resolveAsync(const std::string &t_hostName);
+
+        /**
+         * @brief Resolves a host name and waits for the addresses.
+         * @param t_hostName The host name or an IP address literal.
+         * @return The addresses.
+         * @throws `InvalidArgumentException` If the host name is empty.
+         * @throws `SystemRuntimeException` If the host name could not be resolved.
+         * @version 1.0.0
+         */
+        addressList resolve(const std::string &t_hostName);
+
+        /**
+         * @brief Sets how long lookups are cached.
+         * @param t_ttl How long the addresses of a host are used before it is looked up again.
+         * @param t_negativeTtl How long a failed lookup is remembered.
+         * @throws `InvalidArgumentException` If a time is negative.
+         * @version 1.0.0
+         */
+        void setCacheTtl(const std::chrono::seconds t_ttl, const std::chrono::seconds t_negativeTtl);
+
+        /**
+         * @brief Removes a host from the cache, for example after none of its addresses accepted a connection.
+         * @param t_hostName The host name.
+         * @version 1.0.0
+         */
+        void removeFromCache(const std::string &t_hostName);
+
+        /**
+         * @brief Removes all hosts from the cache.
+         * @version 1.0.0
+         */
+        void clearCache();
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -0,0 +1,217 @@
+#ifndef FBNETWORK_RPC_HPP
+#define FBNETWORK_RPC_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "client.hpp"
+#include "constants.hpp"
+#include "exceptions.hpp"
+#include "timingWheel.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents the type of an RPC frame.
+     * @version 1.0.0
+     */
+    enum class RpcFrameType : uint8_t
+    {
+        REQUEST  = 0,
+        RESPONSE = 1,
+        ERROR    = 2
+    };
+
+    /**
+     * @brief Represents the header of an RPC frame.
+     * @details A frame is a header of `Constants::RPC_FRAME_HEADER_SIZE` bytes, the type, the correlation ID as 8 bytes and the size of
+     * the payload as 4 bytes, both in network byte order, followed by the payload. The server copies the correlation ID of a request
+     * into its response and treats it as opaque.
+     * @version 1.0.0
+     */
+    struct RpcFrameHeader
+    {
+        RpcFrameType type          = RpcFrameType::REQUEST;
+        uint64_t     correlationID = 0;
+        size_t       payloadSize   = 0;
+    };
+
+    /**
+     * @brief Represents the function that receives the result of an RPC call.
+     * @details The function receives the response and a null exception, or an empty response and the exception of the failed call:
+     * `ClientTimeoutException` if the deadline passed, `ClientRuntimeException` if the server answered with an error, the connection
+     * failed or the `RpcClient` was closed.
+     * @version 1.0.0
+     */
+    typedef std::function<void(const std::string &t_response, std::exception_ptr t_error)> rpcCallback;
+
+    /**
+     * @brief Represents an RPC client that keeps many calls in flight on one connection.
+     * @details With plain `Client` functions a request has to be answered before the next one is sent, so one connection does at most
+     * one call per round trip. The `RpcClient` class sends every call as a frame with a correlation ID and returns at once, a reader
+     * thread matches the responses to their calls in whatever order the server sends them. The calls of all threads share the
+     * connection, frames are written whole, one at a time.
+     *
+     * The correlation ID carries the slot of the call in its low `Constants::RPC_SLOT_BITS` bits and a sequence number above them, so
+     * slots are reused like client IDs while a late response for a call that already timed out never completes a newer call. The
+     * deadlines are kept in a `TimingWheel` keyed by the slot.
+     * @note The `RpcClient` class is thread-safe. Callbacks run on the reader thread, so they should be short and must not wait for
+     * another call. The client must not use TLS, since the reader thread and the callers use the connection at the same time.
+     * @version 1.0.0
+     */
+    class RpcClient
+    {
+    private:
+        struct PendingCall
+        {
+            uint64_t    correlationID = 0;
+            rpcCallback callback;
+        };
+
+        std::shared_ptr<Client>  m_client;
+        std::mutex               m_sendMutex;
+        mutable std::mutex       m_pendingCallsMutex;
+        std::vector<PendingCall> m_pendingCalls;
+        std::vector<int>         m_freeSlots;
+        size_t                   m_pendingCount = 0;
+        uint64_t                 m_sequence     = 0;
+        TimingWheel              m_deadlines;
+        std::exception_ptr       m_error        = nullptr;
+        std::atomic<bool>        m_isRunning{true};
+        std::thread              m_reader;
+
+        /**
+         * @brief Reads responses and expires deadlines until the client is closed or the connection fails.
+         * @version 1.0.0
+         */
+        void readResponses();
+
+        /**
+         * @brief Reads one frame and completes its call.
+         * @throws `ClientRuntimeException` If the frame could not be read or is malformed.
+         * @throws `ClientTimeoutException` If the rest of the frame did not arrive within the timeout of the client.
+         * @version 1.0.0
+         */
+        void readResponse();
+
+        /**
+         * @brief Removes a call and frees its slot.
+         * @details The caller must hold `m_pendingCallsMutex`.
+         * @param t_slot The slot of the call.
+         * @return The callback of the call.
+         * @version 1.0.0
+         */
+        rpcCallback takeCall(const int t_slot);
+
+        /**
+         * @brief Fails every call whose deadline has passed with `ClientTimeoutException`.
+         * @version 1.0.0
+         */
+        void expireDeadlines();
+
+        /**
+         * @brief Fails every pending call, and every later one, with an error.
+         * @param t_error The error.
+         * @version 1.0.0
+         */
+        void failPendingCalls(std::exception_ptr t_error);
+
+        /**
+         * @brief Runs a callback and ignores what it throws, so a faulty callback cannot stop the reader thread.
+         * @param t_callback The callback.
+         * @param t_response The response.
+         * @param t_error The error.
+         * @version 1.0.0
+         */
+        static void complete(const rpcCallback &t_callback, const std::string &t_response, std::exception_ptr t_error);
+
+    public:
+        /**
+         * @brief Constructs an RpcClient object and starts its reader thread.
+         * @param t_client The client, already connected to a server that answers with `Server::readRpcRequest()` and
+         * `Server::sendRpcResponse()`. It must not be used for anything else while the `RpcClient` exists.
+         * @throws `InvalidArgumentException` If the client is nullptr or uses TLS.
+         * @version 1.0.0
+         */
+        explicit RpcClient(std::shared_ptr<Client> t_client);
+
+        /**
+         * @brief Destroys the RpcClient object, see `close()`.
+         * @version 1.0.0
+         */
+        ~RpcClient();
+
+        RpcClient(const RpcClient &)            = delete;
+        RpcClient &operator=(const RpcClient &) = delete;
+
+        /**
+         * @brief Sends a request and returns at once.
+         * @details The callback runs on the reader thread when the response arrives, or on the calling thread if the request could not
+         * be sent.
+         * @param t_request The request, it can be empty.
+         * @param t_callback The callback.
+         * @param t_deadline The time the call may take, 0 for no deadline. It is checked with the resolution of the `TimingWheel`.
+         * @throws `InvalidArgumentException` If the callback is empty, the request is larger than `Constants::RPC_MAXIMUM_FRAME_SIZE` or
+         * the deadline is negative.
+         * @version 1.0.0
+         */
+        void call(const std::string &t_request, rpcCallback t_callback,
+                  const std::chrono::milliseconds t_deadline = std::chrono::milliseconds(0));
+
+        /**
+         * @brief Sends a request and returns a future of the response.
+         * @param t_request The request, it can be empty.
+         * @param t_deadline The time the call may take, 0 for no deadline.
+         * @return The future. `get()` throws the exceptions described at `rpcCallback`.
+         * @throws `InvalidArgumentException` If the request is larger than `Constants::RPC_MAXIMUM_FRAME_SIZE` or the deadline is
+         * negative.
+         * @version 1.0.0
+         */
+        std::future<std::string> call(const std::string &t_request, const std::chrono::milliseconds t_deadline = std::chrono::milliseconds(0));
+
+        /**
+         * @brief Retrieves the number of calls in flight.
+         * @return The number of calls.
+         * @version 1.0.0
+         */
+        size_t getPendingCount() const;
+
+        /**
+         * @brief Stops the reader thread and fails the pending calls with `ClientRuntimeException`.
+         * @details The connection stays open, the owner of the client disconnects it. Calls after `close()` fail at once.
+         * @version 1.0.0
+         */
+        void close();
+
+        /**
+         * @brief Turns a payload into a frame.
+         * @param t_type The type of the frame.
+         * @param t_correlationID The correlation ID.
+         * @param t_payload The payload.
+         * @return The frame.
+         * @throws `InvalidArgumentException` If the payload is larger than `Constants::RPC_MAXIMUM_FRAME_SIZE`.
+         * @version 1.0.0
+         */
+        static std::string encodeFrame(const RpcFrameType t_type, const uint64_t t_correlationID, const std::string &t_payload);
+
+        /**
+         * @brief Parses the header of a frame.
+         * @param t_header The header, `Constants::RPC_FRAME_HEADER_SIZE` bytes.
+         * @return The header.
+         * @throws `InvalidArgumentException` If the header is malformed or names a frame larger than `Constants::RPC_MAXIMUM_FRAME_SIZE`.
+         * @version 1.0.0
+         */
+        static RpcFrameHeader decodeHeader(const std::string &t_header);
+    };
+}  // namespace FBNetwork
+
+#endif
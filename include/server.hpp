@@ -1,28 +1,110 @@
 #ifndef FBNETWORK_SERVER_HPP
 #define FBNETWORK_SERVER_HPP
 
+#include "client.hpp"
+#include "compression.hpp"
+#include "concurrencyLimit.hpp"
 #include "constants.hpp"
+#include "cpuPlacement.hpp"
 #include "eventQueue.hpp"
 #include "exceptions.hpp"
 #include "extendedSystem.hpp"
+#include "metrics.hpp"
+#include "rpc.hpp"
+#include "socketOptions.hpp"
+#include "taskPool.hpp"
+#include "timingWheel.hpp"
+#include "tokenBucket.hpp"
+#ifdef FBNETWORK_WITH_TLS
+#include "tlsConnection.hpp"
+#endif
 #include <algorithm>
 #include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <errno.h>
+#include <fcntl.h>
+#include <limits>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <netinet/in.h>
+#include <poll.h>
+#include <set>
 #include <shared_mutex>
 #include <sstream>
 #include <string>
 #include <sys/socket.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/un.h>
+#include <system_error>
 #include <thread>
 #include <unistd.h>
 #include <unordered_map>
+#include <vector>
 
 namespace FBNetwork
 {
+    /**
+     * @brief Represents the deadlines of a client.
+     * @details A deadline of `std::chrono::steady_clock::time_point::max()` is disarmed. `drain` is armed for all clients when the server
+     * starts to drain. `resume` is not a timeout, it is when a client whose reads were paused by the rate limits may read again.
+     * `scheduled` is the deadline the timer of the client is scheduled for in the timing wheel of the server.
+     * @version 1.0.0
+     */
+    struct ClientDeadlines
+    {
+        std::chrono::steady_clock::time_point idle      = std::chrono::steady_clock::time_point::max();
+        std::chrono::steady_clock::time_point read      = std::chrono::steady_clock::time_point::max();
+        std::chrono::steady_clock::time_point write     = std::chrono::steady_clock::time_point::max();
+        std::chrono::steady_clock::time_point drain     = std::chrono::steady_clock::time_point::max();
+        std::chrono::steady_clock::time_point resume    = std::chrono::steady_clock::time_point::max();
+        std::chrono::steady_clock::time_point scheduled = std::chrono::steady_clock::time_point::max();
+    };
+
+    /**
+     * @brief Represents the payloads that are queued for a client but not written yet.
+     * @details `offset` is the number of bytes of the first payload that are already written. `queuedBytes` counts the bytes that are
+     * left. `isWriting` is set while one thread writes to the socket of the client, every other thread queues behind it, so the messages
+     * of different threads are never interleaved.
+     * @version 1.0.0
+     */
+    struct OutputQueue
+    {
+        std::deque<sharedPayload> payloads;
+        size_t                    offset      = 0;
+        size_t                    queuedBytes = 0;
+        bool                      isWriting   = false;
+    };
+
+    /**
+     * @brief Represents what the event queue of a server reports for a client.
+     * @details `isReadable` is cleared while the reads of the client are paused by the rate limits. `isWritable` is set while its
+     * output queue waits for room in the socket buffer. `hasPendingData` is set if the client had residual data ready while it was
+     * paused.
+     * @version 1.0.0
+     */
+    struct ClientInterest
+    {
+        bool isReadable     = true;
+        bool isWritable     = false;
+        bool hasPendingData = false;
+    };
+
+    /**
+     * @brief Represents the token buckets of a client.
+     * @version 1.0.0
+     */
+    struct ClientRateLimit
+    {
+        TokenBucket bytes;
+        TokenBucket messages;
+    };
+
     /**
      * @brief Represents a server object.
      * @details The `Server` class encapsulates the functionality and properties of a server. It provides methods to set and retrieve
@@ -53,12 +135,26 @@ namespace FBNetwork
         mutable std::shared_mutex m_eventQueueMutex;
         mutable std::shared_mutex m_startDateMutex;
         mutable std::shared_mutex m_clientFileDescriptorMutex;
-        mutable std::shared_mutex m_clientAddressIpv4Mutex;
-        mutable std::shared_mutex m_clientAddressIpv6Mutex;
-        mutable std::shared_mutex m_clientAddressLocalMutex;
+        mutable std::shared_mutex m_clientAddressMutex;
         mutable std::shared_mutex m_lifeTimeMutex;
         mutable std::shared_mutex m_clientIpAddressMutex;
         mutable std::shared_mutex m_currentClientIDMutex;
+        mutable std::shared_mutex m_clientMetricsMutex;
+        mutable std::shared_mutex m_freeClientIDsMutex;
+        mutable std::shared_mutex m_isDrainingMutex;
+        mutable std::shared_mutex m_residualDataMutex;
+        mutable std::shared_mutex m_socketOptionsMutex;
+        mutable std::shared_mutex m_cpuPlacementMutex;
+        mutable std::shared_mutex m_outputQueuesMutex;
+        mutable std::shared_mutex m_topicsMutex;
+        mutable std::shared_mutex m_slowClientPolicyMutex;
+        mutable std::mutex        m_postedTasksMutex;
+        mutable std::mutex        m_timingWheelMutex;
+        mutable std::mutex        m_clientInterestsMutex;
+        mutable std::mutex        m_rateLimitsMutex;
+        mutable std::shared_mutex m_overloadMutex;
+        mutable std::shared_mutex m_compressionMutex;
+        mutable std::shared_mutex m_compressorsMutex;
 
         fileDescriptor                                 m_serverFileDescriptor      = -1;
         port                                           m_port                      = 0;
@@ -72,18 +168,67 @@ namespace FBNetwork
         bool                                           m_usesIpv6Domain            = false;
         bool                                           m_usesLocalDomain           = false;
         bool                                           m_isServerOnline            = false;
+        bool                                           m_isDraining                = false;
         std::shared_ptr<struct sockaddr_in> m_serverAddressIpv4         = nullptr;
         std::shared_ptr<struct sockaddr_in6> m_serverAddressIpv6         = nullptr;
         std::shared_ptr<struct sockaddr_un> m_serverAddressLocal        = nullptr;
         std::shared_ptr<EventQueue> m_eventQueue                = nullptr;
         timeval                                        m_timeout;
         std::unordered_map<int, std::string>           m_data;
+        std::unordered_map<int, std::string>           m_residualData;
+        std::set<int>                                  m_residualClientIDs;
         std::unordered_map<int, int>                   m_clientFileDescriptor;
-        std::unordered_map<int, std::shared_ptr<struct sockaddr_in>>  m_clientAddressIpv4;
-        std::unordered_map<int, std::shared_ptr<struct sockaddr_in6>> m_clientAddressIpv6;
-        std::unordered_map<int, std::shared_ptr<struct sockaddr_un>>  m_clientAddressLocal;
+        std::unordered_map<int, int>                   m_clientIDs;
+        std::unordered_map<int, sockaddr_storage>      m_clientAddress;
+        std::unordered_map<int, std::shared_ptr<ConnectionMetrics>>   m_clientMetrics;
+        std::vector<int>                                              m_freeClientIDs;
+        ServerMetrics                                                 m_metrics;
+        TimingWheel                                                   m_timingWheel;
+        std::unordered_map<int, ClientDeadlines>                      m_clientDeadlines;
+        std::chrono::milliseconds                                     m_idleTimeout{0};
+        std::chrono::milliseconds                                     m_readTimeout{0};
+        std::chrono::milliseconds                                     m_writeTimeout{0};
+        std::atomic<bool>                                             m_hasClientTimeouts{false};
+        SocketOptions                                                 m_socketOptions;
+        std::atomic<bool>                                             m_usesQuickAck{false};
+        CpuPlacement                                                  m_cpuPlacement;
+        std::atomic<bool>                                             m_isCpuPlacementPending{false};
+        std::vector<std::function<void()>>                            m_postedTasks;
+        fileDescriptor                                                m_wakeUpFileDescriptors[2] = {-1, -1};
+        std::atomic<bool>                                             m_isWakeUpPending{false};
+        std::unordered_map<int, OutputQueue>                          m_outputQueues;
+        std::condition_variable_any                                   m_outputQueueWritten;
+        std::unordered_map<std::string, std::set<int>>                m_topics;
+        size_t                                                        m_outputQueueLimit = Constants::OUTPUT_QUEUE_LIMIT;
+        SlowClientPolicy                                              m_slowClientPolicy = SlowClientPolicy::DROP_MESSAGE;
+        std::unordered_map<int, ClientInterest>                       m_clientInterests;
+        RateLimits                                                    m_rateLimits;
+        std::atomic<bool>                                             m_hasRateLimits{false};
+        std::unordered_map<int, ClientRateLimit>                      m_clientRateLimits;
+        std::unordered_map<std::string, TokenBucket>                  m_sourceRateLimits;
+        OverloadPolicy                                                m_overloadPolicy = OverloadPolicy::THROW;
+        std::string                                                   m_overloadResponse;
+        std::shared_ptr<ConcurrencyLimit>                             m_concurrencyLimit = nullptr;
+        std::atomic<int>                                              m_listenBacklog{Constants::LISTEN_BACKLOG};
+        std::atomic<bool>                                             m_isAcceptingPaused{false};
+        fileDescriptor                                                m_reserveFileDescriptor = -1;
+        CompressionOptions                                            m_compressionOptions;
+        std::unordered_map<int, std::shared_ptr<Compressor>>          m_compressors;
+#ifdef FBNETWORK_WITH_TLS
+        mutable std::shared_mutex                                     m_tlsMutex;
+        std::shared_ptr<TlsContext>                                   m_tlsContext = nullptr;
+        std::unordered_map<int, std::shared_ptr<TlsConnection>>       m_tlsConnections;
+        std::set<int>                                                 m_tlsBufferedClientIDs;
+#endif
 
     private:
+        /**
+         * @brief Sets whether the server is draining.
+         * @param t_isDraining A boolean value indicating whether the server is draining.
+         * @version 1.0.0
+         */
+        void setIsDraining(const bool t_isDraining);
+
         /**
          * @brief Sets the server file descriptor.
          * @details This function sets the file descriptor for the server.
@@ -247,34 +392,44 @@ namespace FBNetwork
         void setClientFileDescriptor(const int t_clientID, const fileDescriptor t_clientFileDescriptor);
 
         /**
-         * @brief Sets the IPv4 address of a client.
-         * @details This function is used to set the IPv4 address of a client.
+         * @brief Takes the file descriptor of a client and leaves -1 in its place.
+         * @details Reading and replacing happen under one lock, so of two threads that close the same client only one gets the file
+         * descriptor.
+         * @param t_clientID The ID of the client.
+         * @return The file descriptor, -1 if the client was already closed.
+         * @throws `std::out_of_range` If the client ID does not exist.
+         * @version 1.0.0
+         */
+        fileDescriptor takeClientFileDescriptor(const int t_clientID);
+
+        /**
+         * @brief Replaces the file descriptor of a client and keeps the index from file descriptor to ID in sync.
+         * @details The caller must hold `m_clientFileDescriptorMutex` exclusively.
          * @param t_clientID The ID of the client.
-         * @param t_clientAddressIpv4 The IPv4 address of the client to set.
-         * @throws `InvalidArgumentException` If `t_clientAddressIpv4` is `nullptr`.
+         * @param t_clientFileDescriptor The new file descriptor of the client, -1 if it is closed.
+         * @return The old file descriptor, -1 if there was none.
          * @version 1.0.0
          */
-        void setClientAddressIpv4(const int t_clientID, std::shared_ptr<sockaddr_in> t_clientAddressIpv4);
+        fileDescriptor swapClientFileDescriptor(const int t_clientID, const fileDescriptor t_clientFileDescriptor);
 
         /**
-         * @brief Sets the IPv6 client address.
-         * @details This function sets the IPv6 client address  in the server.
+         * @brief Sets the address of a client.
+         * @details The address is stored by value in the slot of the client, so accepting a client does not allocate an address.
          * @param t_clientID The ID of the client.
-         * @param t_clientAddressIpv6 The IPv6 client address to set.
-         * @throws `InvalidArgumentException` If `t_clientAddressIpv6` is `nullptr`.
+         * @param t_clientAddress The address of the client, an IPv4, IPv6 or local address depending on the domain.
          * @version 1.0.0
          */
-        void setClientAddressIpv6(const int t_clientID, std::shared_ptr<sockaddr_in6>t_clientAddressIpv6);
+        void setClientAddress(const int t_clientID, const sockaddr_storage &t_clientAddress);
 
         /**
-         * @brief Sets the local client address.
-         * @details This function is used to set the local client address in the server.
+         * @brief Sets the metrics of a client.
+         * @details This function sets the counters of the connection with the specified client.
          * @param t_clientID The ID of the client.
-         * @param t_clientAddressLocal The local client address to set.
-         * @throws `InvalidArgumentException` If `t_clientAddressLocal` is `nullptr`.
+         * @param t_clientMetrics The metrics of the client.
+         * @throws `InvalidArgumentException` If `t_clientMetrics` is `nullptr`.
          * @version 1.0.0
          */
-        void setClientAddressLocal(const int t_clientID, std::shared_ptr<sockaddr_un> t_clientAddressLocal);
+        void setConnectionMetrics(const int t_clientID, std::shared_ptr<ConnectionMetrics> t_clientMetrics);
 
         /**
          * @brief Retrieves the file descriptor of the server.
@@ -411,291 +566,1409 @@ namespace FBNetwork
         int getClientID(const fileDescriptor t_clientFileDescriptor);
 
         /**
-         * @brief Retrieves the IPv4 address of the client.
-         * @details This function returns a pointer to a sockaddr_in structure that contains the IPv4 address of the client.
+         * @brief Retrieves the address of the client.
+         * @details This function returns the address of the client, an IPv4, IPv6 or local address depending on the domain.
          * @param t_clientID The ID of the client.
-         * @return A pointer to a sockaddr_in structure representing the IPv4 address of the client.
+         * @return The address of the client.
          * @throws `std::out_of_range` If the client ID is not found.
          * @version 1.0.0
          */
-        std::shared_ptr<sockaddr_in> getClientAddressIpv4(const int t_clientID);
+        sockaddr_storage getClientAddress(const int t_clientID);
 
         /**
-         * @brief Retrieves the IPv6 address of the client.
-         * @details This function returns a pointer to the `sockaddr_in6` structure representing the IPv6 address of the client.
+         * @brief Retrieves the metrics of a client.
+         * @details This function returns the counters of the connection with the specified client. `addClient()` creates them. For an
+         * ID without counters, a new set is returned that is not kept, so the lookup never adds an entry.
          * @param t_clientID The ID of the client.
-         * @return A pointer to the `sockaddr_in6` structure representing the IPv6 address of the client.
-         * @throws `std::out_of_range` If the client ID is not found.
+         * @return A pointer to the metrics of the client.
+         * @version 1.0.0
+         */
+        std::shared_ptr<ConnectionMetrics> getConnectionMetrics(const int t_clientID);
+
+        /**
+         * @brief Reserves an ID for a new client.
+         * @details This function reuses the ID of a closed client if there is one and hands out the next unused ID otherwise, so IDs of
+         * connected clients never change.
+         * @return The reserved ID, or -1 if the maximum number of current connections is reached.
          * @version 1.0.0
          */
-        std::shared_ptr<sockaddr_in6> getClientAddressIpv6(const int t_clientID);
+        int reserveClientID();
 
         /**
-         * @brief Retrieves the local client address.
-         * @details This function returns a pointer to the sockaddr_un structure representing the local client address.
+         * @brief Releases the ID of a closed client, so it can be reused by the next accepted client.
          * @param t_clientID The ID of the client.
-         * @return A pointer to the sockaddr_un structure representing the client's address.
-         * @throws `std::out_of_range` If the client ID is not found.
          * @version 1.0.0
          */
-        std::shared_ptr<sockaddr_un> getClientAddressLocal(const int t_clientID);
+        void releaseClientID(const int t_clientID);
 
         /**
-         * @brief Rearanges the client IDs.
-         * @details This function rearranges the client IDs to ensure that they are contiguous.
+         * @brief Accepts one pending connection.
+         * @details This function uses `accept4` with `SOCK_NONBLOCK | SOCK_CLOEXEC`, so the new socket needs no further system calls.
+         * Where `accept4` is not available, the flags are set with `fcntl`.
+         * @param t_serverFileDescriptor The file descriptor of the listening socket.
+         * @param t_clientAddress The address of the client.
+         * @return The file descriptor of the client, or -1 with `errno` set.
          * @version 1.0.0
          */
-        void rearrangeClientIDs();
+        static fileDescriptor acceptConnection(const fileDescriptor t_serverFileDescriptor, sockaddr_storage &t_clientAddress);
 
         /**
-         * @brief Checks if a clientID does not exist.
-         * @details This function checks if a client with the specified ID does not exist.
+         * @brief Stores an accepted client in the slot of a reserved ID.
+         * @param t_clientID The reserved ID.
+         * @param t_clientFileDescriptor The file descriptor of the client.
+         * @param t_clientAddress The address of the client.
          * @version 1.0.0
          */
-        bool thisClientDoesNotExist(const int t_clientID) const;
+        void addClient(const int t_clientID, const fileDescriptor t_clientFileDescriptor, const sockaddr_storage &t_clientAddress);
 
         /**
-         * @brief Checks if the client is disconnected.
-         * @details This function checks if the client is disconnected by checking if there is no more data to read from the client.
-         * @return True if the client is disconnected, false otherwise.
+         * @brief Schedules the timer of a client for its earliest deadline.
+         * @details The timer is only moved if the earliest deadline is before the scheduled one. Later deadlines, like an idle deadline
+         * that is pushed back by every read, are picked up when the timer expires, so refreshing a deadline is usually no more than a
+         * store. The caller must hold `m_timingWheelMutex`.
+         * @param t_clientID The ID of the client.
+         * @param t_clientDeadlines The deadlines of the client.
          * @version 1.0.0
          */
-        bool isDisconnected(const int t_clientID);
+        void scheduleClientTimer(const int t_clientID, ClientDeadlines &t_clientDeadlines);
 
-    public:
         /**
-         * @brief Returns the port number used by the server.
-         * @details This function returns the port number used by the server as a 16-bit unsigned integer.
-         * @return The port number as a 16-bit unsigned integer.
+         * @brief Arms the idle deadline of a newly accepted client.
+         * @param t_clientID The ID of the client.
          * @version 1.0.0
          */
-        port getPort();
+        void startClientDeadlines(const int t_clientID);
 
         /**
-         * @brief Retrieves the start date of the server.
-         * @details This function returns the start date of the server as a string.
-         * @return The start date of the server as a string.
+         * @brief Pushes the idle deadline of a client back, because the client read or wrote data.
+         * @param t_clientID The ID of the client.
          * @version 1.0.0
          */
-        std::string getStartDate();
+        void refreshIdleDeadline(const int t_clientID);
 
         /**
-         * @brief Checks if the server is currently online.
-         * @details This function returns true if the server is online, and false otherwise.
-         * @return true if the server is online, false otherwise.
+         * @brief Arms the read deadline of a client, unless it is already armed.
+         * @param t_clientID The ID of the client.
+         * @return The read deadline, or `std::chrono::steady_clock::time_point::max()` if there is no read timeout.
          * @version 1.0.0
          */
-        bool isServerOnline();
+        std::chrono::steady_clock::time_point armReadDeadline(const int t_clientID);
 
         /**
-         * @brief Retrieves the data.
-         * @details This function returns the data stored in the server as a string.
+         * @brief Arms the write deadline of a client, unless it is already armed.
          * @param t_clientID The ID of the client.
-         * @return The data as a string.
+         * @return The write deadline, or `std::chrono::steady_clock::time_point::max()` if there is no write timeout.
          * @version 1.0.0
          */
-        std::string getData(const int t_clientID);
+        std::chrono::steady_clock::time_point armWriteDeadline(const int t_clientID);
 
         /**
-         * @brief Gets the lifetime of an object.
-         * @details This function returns the lifetime of the object as a time_t value.
-         * @return The lifetime of the object as a time_t value.
+         * @brief Disarms the read deadline of a client after a complete read.
+         * @param t_clientID The ID of the client.
          * @version 1.0.0
          */
-        time_t getLifeTime();
+        void disarmReadDeadline(const int t_clientID);
 
         /**
-         * @brief Retrieves the IP address of the client.
-         * @details This function returns the IP address of the client as a string.
-         * @return The IP address of the client as a string.
-         * @throws `ServerRuntimeException` If something goes wrong while retrieving the IP address.
-         * @throws `InvalidDomainException` If the server domain is invalid
+         * @brief Disarms the write deadline of a client after a complete write.
+         * @param t_clientID The ID of the client.
          * @version 1.0.0
          */
-        std::string getClientIpAddress(const int t_clientID);
+        void disarmWriteDeadline(const int t_clientID);
 
         /**
-         * @brief Gets the count of currently connected clients.
-         * @details This function returns the count of currently connected clients to the server.
-         * @return The count of currently connected clients.
+         * @brief Removes the deadlines and the timer of a closed client.
+         * @param t_clientID The ID of the client.
          * @version 1.0.0
          */
-        int getCurrentlyConnectedClientsCount();
+        void cancelClientDeadlines(const int t_clientID);
 
         /**
-         * @brief Constructs a IP Domain Server object.
-         * @param t_domain The domain of the server.
-         * @param t_port The port number of the server.
-         * @param t_maximumCurrentConnections The maximum number of current connections allowed by the server.
-         * @throws `InvalidArgumentException` If `t_port` is less than 0 or greater than 65535, or `t_maximumCurrentConnections` is less
-         * than or equal to 0.
-         * @throws `InvalidDomainException` If `t_domain` is invalid.
-         * @note The domain can only be one of the following: `FBNetwork::Domain::IPV4_DOMAIN` (for IPv4 domain) and
-         * `FBNetwork::Domain::IPV6_DOMAIN` (for IPv6 domain). If you want to use the local domain, use the constructor that takes a socket
-         * path as an argument.
+         * @brief Advances the timing wheel and collects the clients with a passed deadline.
+         * @details Timers of clients whose deadlines were pushed back are scheduled again.
+         * @param t_resumedClientIDs Receives the IDs of the clients whose reads may resume.
+         * @return The IDs of the timed out clients. Their deadlines are already removed.
          * @version 1.0.0
          */
-        Server(const int t_domain, const port t_port, const int t_maximumCurrentConnections);
+        std::vector<int> expireClientDeadlines(std::vector<int> &t_resumedClientIDs);
 
         /**
-         * @brief Constructs a Unix Domain Server object.
-         * @param t_socketPath The path to the socket.
-         * @param t_port The port number.
-         * @param t_maximumCurrentConnections The maximum number of current connections.
-         * @throws `InvalidArgumentException` If `t_socketPath` is empty, `t_port` is less than 0 or greater than 65535, or
-         * `t_maximumCurrentConnections` is less than or equal to 0.
-         * @note The domain is set to FBNetwork::Domain::LOCAL_DOMAIN.
+         * @brief Retrieves the time until the next deadline of a client may pass.
+         * @return The time in milliseconds, or -1 if no deadline is armed.
          * @version 1.0.0
          */
-        Server(std::string &t_socketPath, const port t_port, const int t_maximumCurrentConnections);
+        int getMillisecondsUntilNextDeadline();
 
         /**
-         * @brief Destructor for the Server class.
-         * @details This destructor is responsible for cleaning up any resources used by the Server class. It is automatically called when
-         * an instance of the Server class is destroyed.
-         * @throws `ServerRuntimeException` If an error occurs while stopping the server.
-         * @note This destructor calls the `stopServer()` function.
+         * @brief Calculates the timeout of `poll` for a read or write.
+         * @param t_timeout The timeout of one read or write.
+         * @param t_deadline The deadline of the whole read or write.
+         * @return The shorter of both in milliseconds, rounded up.
          * @version 1.0.0
          */
-        ~Server();
+        static int getPollTimeout(const timeval &t_timeout, const std::chrono::steady_clock::time_point t_deadline);
 
         /**
-         * @brief Starts the server.
-         * @details This function initializes and starts the server.
-         * @throws `ServerCreationException` If an error occurs while creating the server.
-         * @note This function should be called after creating an instance of the Server class.
+         * @brief Starts the TLS session of a new client, if the server uses TLS.
+         * @param t_clientID The ID of the client.
+         * @param t_clientFileDescriptor The file descriptor of the client.
+         * @throws `ServerRuntimeException` If the TLS session could not be created.
          * @version 1.0.0
          */
-        void startServer();
+        void startTls(const int t_clientID, const fileDescriptor t_clientFileDescriptor);
 
         /**
-         * @brief Starts listening for incoming connections.
-         * @details This function initiates the server to start listening for incoming connections from clients. Once a connection is
-         * established, the server can receive and process client requests.
-         * @throws `ServerRuntimeException` if an error occurs while listening for incoming connections.
+         * @brief Sends a close notify alert to a client and ends its TLS session, if it has one.
+         * @param t_clientID The ID of the client.
          * @version 1.0.0
          */
-        void startListening();
+        void stopTls(const int t_clientID);
 
         /**
-         * @brief Stops the server.
-         * @details This function is responsible for stopping the server and terminating any active connections. It should be called when
-         * the server needs to be shut down.
-         * @throws `ServerRuntimeException` if an error occurs while disconnecting the clients or stopping the server.
+         * @brief Continues the TLS handshake of a client that sent data.
+         * @details Clients that fail the handshake are closed.
+         * @param t_clientID The ID of the client.
+         * @return true if the client has data for the application, false if the handshake needs more data or failed.
          * @version 1.0.0
          */
-        void stopServer();
+        bool completeTlsHandshake(const int t_clientID);
 
         /**
-         * @brief Sets the server to the provided keepAlive value.
-         * @details This function sets the server to keep alive. If `t_keepAlive` is `true`, the server will keep the connection alive.
-         * @param t_keepAlive A boolean value indicating whether the server should keep the connection alive or not.
-         * @throws `ServerRuntimeException` If an error occurred while setting the server option.
+         * @brief Retrieves the IDs of the clients with decrypted data that `poll` does not see.
+         * @return The IDs of the clients.
          * @version 1.0.0
          */
-        void setServerKeepAlive(const bool t_keepAlive);
+        std::vector<int> getTlsBufferedClientIDs();
 
         /**
-         * @brief Accepts a client connection. It automatically assigns an ID to the client and and prepares the ID for the next client.
-         * @details This function accepts a client connection. It blocks until a client connection is established.
-         * @throws `ServerRuntimeException` If an error occurred while accepting the client connection.
-         * @return The ID of the client.
+         * @brief Checks if decrypted data of a client can be read without waiting for the socket.
+         * @param t_clientID The ID of the client.
+         * @return true if data is buffered, false otherwise.
          * @version 1.0.0
          */
-        int acceptClient();
+        bool hasBufferedData(const int t_clientID);
 
         /**
-         * @brief Closes client connections of disconnected clients. (If clients do not have any data to send)
-         * @details This function closes the client connection if the client is disconnected. It checks if the client is disconnected by
-         * checking if there is no more data to read from the client.
-         * @throws `ServerRuntimeException` if an error occurred while closing the client connection.
+         * @brief Takes the data of a client that was received after the end of the last read.
+         * @param t_clientID The ID of the client.
+         * @return The data, the client has none left afterwards.
          * @version 1.0.0
          */
-        void closeDisconnectedClients();
+        std::string takeResidualData(const int t_clientID);
 
         /**
-         * @brief Sends data to a specific client.
-         * @details This function sends data to a specific client.
+         * @brief Keeps data of a client for the next read.
          * @param t_clientID The ID of the client.
-         * @param t_data The data to be sent.
-         * @throws `InvalidArgumentException` If `t_data` is empty.
-         * @throws `ServerRuntimeException` If an error occurred while sending the data.
+         * @param t_residualData The data.
+         * @param t_isReady Whether the data may hold the next message, then `getPendingEvents()` reports the client once, because the
+         * event queue does not see the data.
          * @version 1.0.0
          */
-        void sendData(const int t_clientID, const std::string &t_data);
+        void storeResidualData(const int t_clientID, std::string &&t_residualData, const bool t_isReady);
 
         /**
-         * @brief Reads x data from the client.
-         * @details This function reads x data from the client. The data is read up to the specified size (in bytes).
+         * @brief Keeps the part of a message that arrived before a read failed or timed out, so the next read continues it.
+         * @details The read deadline keeps running while a part of a message is kept. If nothing arrived, no read is in progress and the
+         * read deadline is disarmed, a silent client is left to the idle timeout.
          * @param t_clientID The ID of the client.
-         * @param t_x The size of the data to read.
-         * @throws `InvalidArgumentException` If `t_x` is less than or equal to 0.
-         * @throws `ServerRuntimeException` If an error occurred while reading the data.
-         * @throws `ServerTimeoutException` If the read operation timed out. The timeout is set via the `setSocketTimeout()` function. If
-         * the timeout is not set, it will be the default FBNetwork::Constants::DEFAULT_TIMEOUT.
+         * @param t_partialMessage The part of the message.
          * @version 1.0.0
          */
-        void readXData(const int t_clientID, const ssize_t t_x);
+        void suspendRead(const int t_clientID, std::string &&t_partialMessage);
 
         /**
-         * @brief Reads data from the client until the specified 'x' is encountered.
-         * @details This function reads data from the client until the specified character 'x' is encountered.
+         * @brief Puts the header of a frame back in front of the part of its payload that arrived, after reading the payload timed out.
+         * @details The next read starts at the header again, so a client that stalls between the header and the payload does not put
+         * the stream out of step. The read deadline keeps running, since the frame has started.
          * @param t_clientID The ID of the client.
-         * @param t_x The string to search for.
-         * @throws `InvalidArgumentException` If `t_x` is empty.
-         * @throws `ServerRuntimeException` If an error occurred while reading the data.
+         * @param t_header The header of the frame.
          * @version 1.0.0
          */
-        void readTillXData(const int t_clientID, const std::string &t_x);
+        void suspendFrame(const int t_clientID, const std::string &t_header);
 
         /**
-         * @brief Reads data from the client until the specified string 'x' appears 'y' times.
-         * @details This function reads data from the client until the specified string 'x' appears 'y' times.
+         * @brief Retrieves the IDs of the clients whose residual data was not reported yet and forgets them.
+         * @return The IDs of the clients.
+         * @version 1.0.0
+         */
+        std::vector<int> takeResidualClientIDs();
+
+        /**
+         * @brief Checks if a client has residual data.
          * @param t_clientID The ID of the client.
-         * @param t_x The string to search for.
-         * @param t_y The number of times the character 'x' should appear.
-         * @throws `InvalidArgumentException` if `t_x` is empty or `t_y` is less than or equal to 0.
-         * @throws `ServerRuntimeException` if an error occurred while reading the data.
+         * @return true if the client has residual data, false otherwise.
          * @version 1.0.0
          */
-        void readTillXComesYTimesData(const int t_clientID, const std::string &t_x, const int t_y);
+        bool hasResidualData(const int t_clientID);
 
         /**
-         * @brief Gets the pending events. Waits indefinitely until an event is available.
-         * @details This function returns the pending events in the event queue as a vector of event tuples, where the first element is the
-         * event type and the second element is the client ID, if applicable.
-         * @return The pending events in the event queue.
+         * @brief Queues a shared payload for a client and writes it right away if nothing else is queued and no other thread writes.
+         * @details If the payload would grow the output queue above its limit, the slow client policy decides whether the payload is
+         * dropped or the client is closed. A payload is always queued if the output queue is empty.
+         * @param t_clientID The ID of the client.
+         * @param t_payload The payload.
+         * @return true if the payload was queued, false if it was dropped or the client was closed.
          * @version 1.0.0
          */
-        std::vector<eventTuple> getPendingEvents();
+        bool queuePayload(const int t_clientID, const sharedPayload &t_payload);
 
         /**
-         * @brief Checks if data is available to be read from the specified client within the given timeout.
-         * @details This function checks if there is data available to be read from the client within the given timeout.
-         * @param t_timeout The timeout value in seconds and microseconds.
-         * @return true if data is available within the timeout, false otherwise.
-         * @throws `ServerRuntimeException` If an error occurred while checking for data availability.
+         * @brief Writes as much of the output queue of a client as its socket buffer takes without waiting.
+         * @details The client is watched for room in its socket buffer while something is left. `m_outputQueuesMutex` is only held
+         * between the writes, so other threads can queue payloads meanwhile. If another thread writes to the client, nothing is done, that
+         * thread writes the queue when it is finished.
+         * @param t_clientID The ID of the client.
+         * @return false if writing failed and the client has to be closed, true otherwise.
          * @version 1.0.0
          */
-        bool isDataAvailable(const timeval *t_timeout);
+        bool writeOutputQueue(const int t_clientID);
 
         /**
-         * @brief Closes the client connection.
-         * @details This function closes the connection with the client to make the server available for other clients.
+         * @brief Makes the calling thread the only writer of a client, after the payloads queued for it are written.
+         * @details The queued payloads are written first, waiting for room in the socket buffer like `sendData()` does. If another thread
+         * writes to the client, this function waits until it is done.
          * @param t_clientID The ID of the client.
-         * @throws `ServerRuntimeException` If an error occurred while closing the client connection.
+         * @param t_clientFileDescriptor The file descriptor of the client.
+         * @param t_deadline The time until which the queue has to be written.
+         * @param t_error Set to `NetworkError::TIMEOUT`, `NetworkError::CONNECTION_CLOSED` if writing the queue failed, or cleared.
          * @version 1.0.0
          */
-        void closeClient(const int t_clientID);
+        void acquireOutput(const int t_clientID, const fileDescriptor t_clientFileDescriptor,
+                           const std::chrono::steady_clock::time_point t_deadline, std::error_code &t_error);
 
         /**
-         * @brief Sets the socket timeout.
-         * @details This function sets the timeout for reading from a client.
-         * @param t_timeout The timeout value in seconds and microseconds.
-         * @throws `InvalidArgumentException` If tv_sec is negative,tv_usec is negative or tv_usec is greater than 999999.
+         * @brief Ends the write of a thread that called `acquireOutput()` or became the writer in `sendData()`.
+         * @details The payloads other threads queued meanwhile are written, unless the write of this thread failed halfway, then the
+         * stream is broken and the caller closes the client.
+         * @param t_clientID The ID of the client.
+         * @param t_isComplete Whether the write of this thread was complete.
          * @version 1.0.0
          */
-        void setTimeout(const timeval t_timeout);
+        void releaseOutput(const int t_clientID, const bool t_isComplete);
+
+        /**
+         * @brief Starts or stops watching a client for room in its socket buffer.
+         * @details Nothing is changed in the event queue if the interest is already set.
+         * @param t_clientID The ID of the client.
+         * @param t_isWritable Whether the client is watched for room in its socket buffer.
+         * @throws `ServerRuntimeException` If changing the event queue fails.
+         * @version 1.0.0
+         */
+        void watchWritable(const int t_clientID, const bool t_isWritable);
+
+        /**
+         * @brief Pauses the reads of a client.
+         * @details A paused client is not reported by the event queue, the data it sends waits in its socket buffer and TCP flow
+         * control slows it down. Nothing is changed in the event queue if the client is already paused.
+         * @param t_clientID The ID of the client.
+         * @throws `ServerRuntimeException` If changing the event queue fails.
+         * @version 1.0.0
+         */
+        void pauseReading(const int t_clientID);
+
+        /**
+         * @brief Resumes the reads of a paused client.
+         * @param t_clientID The ID of the client.
+         * @return true if the client has residual data that was held back while it was paused, false otherwise.
+         * @throws `ServerRuntimeException` If changing the event queue fails.
+         * @version 1.0.0
+         */
+        bool resumeReading(const int t_clientID);
+
+        /**
+         * @brief Checks if the reads of a client are paused.
+         * @param t_clientID The ID of the client.
+         * @return true if the reads are paused, false otherwise.
+         * @version 1.0.0
+         */
+        bool isReadingPaused(const int t_clientID);
+
+        /**
+         * @brief Holds back the ready residual data of a paused client until it resumes.
+         * @param t_clientID The ID of the client.
+         * @return true if the client is paused, false otherwise.
+         * @version 1.0.0
+         */
+        bool deferIfPaused(const int t_clientID);
+
+        /**
+         * @brief Retrieves the token buckets of a client and creates them with the current rate limits if it has none yet.
+         * @details The caller must hold `m_rateLimitsMutex`.
+         * @param t_clientID The ID of the client.
+         * @param t_now The current time.
+         * @return The token buckets.
+         * @version 1.0.0
+         */
+        ClientRateLimit &getClientRateLimit(const int t_clientID, const std::chrono::steady_clock::time_point t_now);
+
+        /**
+         * @brief Decides whether a client that has data may be reported as `EventType::CLIENT_WANTS_TO_SEND_DATA`.
+         * @details Without rate limits every client is admitted. Otherwise the client takes one message token, or, if it has no message
+         * token left or is in debt with its bytes, its reads are paused until its buckets have refilled.
+         * @param t_clientID The ID of the client.
+         * @return true if the client may be reported, false if its reads are paused.
+         * @version 1.0.0
+         */
+        bool admitClientEvent(const int t_clientID);
+
+        /**
+         * @brief Charges bytes read from a client to its byte bucket.
+         * @param t_clientID The ID of the client.
+         * @param t_bytes The number of bytes.
+         * @version 1.0.0
+         */
+        void chargeReceivedBytes(const int t_clientID, const ssize_t t_bytes);
+
+        /**
+         * @brief Decides whether a new connection is accepted or closed because its source IP address exceeded its rate limit.
+         * @param t_clientAddress The address of the client.
+         * @return true if the connection is accepted, false otherwise.
+         * @version 1.0.0
+         */
+        bool admitConnection(const sockaddr_storage &t_clientAddress);
+
+        /**
+         * @brief Forgets the event queue interest and the token buckets of a client.
+         * @param t_clientID The ID of the client.
+         * @version 1.0.0
+         */
+        void resetFlowControl(const int t_clientID);
+
+        /**
+         * @brief Retrieves the compression stage of a client and creates it with the current compression options if it has none yet.
+         * @param t_clientID The ID of the client.
+         * @return The compression stage.
+         * @throws `InvalidArgumentException` If the client ID is invalid.
+         * @version 1.0.0
+         */
+        std::shared_ptr<Compressor> getCompressor(const int t_clientID);
+
+        /**
+         * @brief Forgets the compression stage of a client, so the next client with its ID negotiates again.
+         * @param t_clientID The ID of the client.
+         * @version 1.0.0
+         */
+        void resetCompression(const int t_clientID);
+
+        /**
+         * @brief Checks if the concurrency limit of `setConcurrencyLimit()` is reached.
+         * @return true if it is reached, false if it is not or there is none.
+         * @version 1.0.0
+         */
+        bool isConcurrencyLimitReached();
+
+        /**
+         * @brief Checks if the server takes no more connections.
+         * @return true if every client ID is taken or the concurrency limit is reached, false otherwise.
+         * @version 1.0.0
+         */
+        bool isOverloaded();
+
+        /**
+         * @brief Applies the overload policy to the pending connections.
+         * @param t_hasAcceptedClients Whether the caller has accepted clients before the server became overloaded.
+         * @throws `ServerRuntimeException` If the policy is `OverloadPolicy::THROW` and no client was accepted.
+         * @version 1.0.0
+         */
+        void handleOverload(const bool t_hasAcceptedClients);
+
+        /**
+         * @brief Stops the event queue from reporting the listening socket.
+         * @details `getPendingEvents()` resumes it as soon as the server is not overloaded anymore.
+         * @version 1.0.0
+         */
+        void pauseAccepting();
+
+        /**
+         * @brief Lets the event queue report the listening socket again.
+         * @version 1.0.0
+         */
+        void resumeAccepting();
+
+        /**
+         * @brief Sends the overload response to a connection that was not handed a client ID and closes it.
+         * @details The response is written once without blocking, and not at all by a TLS server, since the connection has no session.
+         * @param t_clientFileDescriptor The file descriptor of the connection.
+         * @version 1.0.0
+         */
+        void shedConnection(const fileDescriptor t_clientFileDescriptor);
+
+        /**
+         * @brief Accepts and sheds every connection in the backlog of the listening socket.
+         * @version 1.0.0
+         */
+        void shedPendingConnections();
+
+        /**
+         * @brief Sheds one pending connection while the process has no file descriptor left.
+         * @details A connection that cannot be accepted keeps the listening socket readable, so the event loop would spin on it. The
+         * server keeps one file descriptor in reserve and gives it up for a moment to accept and close that connection.
+         * @return true if a connection was shed, false if there is no reserved file descriptor.
+         * @version 1.0.0
+         */
+        bool shedWithReserveFileDescriptor();
+
+        /**
+         * @brief Writes the output queue of a client after the event queue reported room in its socket buffer.
+         * @details The client is closed if writing fails.
+         * @param t_clientID The ID of the client.
+         * @version 1.0.0
+         */
+        void flushOutputQueue(const int t_clientID);
+
+        /**
+         * @brief Drops the output queue and the subscriptions of a client.
+         * @param t_clientID The ID of the client.
+         * @version 1.0.0
+         */
+        void dropOutputQueue(const int t_clientID);
+
+        /**
+         * @brief Retrieves the `poll` events to wait for before the next read or write of a client.
+         * @details A TLS read may have to wait until the socket is writable and the other way round.
+         * @param t_clientID The ID of the client.
+         * @param t_events The events to wait for without TLS.
+         * @return The events to wait for.
+         * @version 1.0.0
+         */
+        short getPollEvents(const int t_clientID, const short t_events);
+
+        /**
+         * @brief Receives data from a client, through its TLS session if it has one.
+         * @param t_clientID The ID of the client.
+         * @param t_clientFileDescriptor The file descriptor of the client.
+         * @param t_buffer The buffer to receive into.
+         * @param t_size The size of the buffer.
+         * @return The number of received bytes, or 0 and -1 like `recv`.
+         * @version 1.0.0
+         */
+        ssize_t receive(const int t_clientID, const fileDescriptor t_clientFileDescriptor, char *t_buffer, const size_t t_size);
+
+        /**
+         * @brief Sends data to a client, through its TLS session if it has one.
+         * @param t_clientID The ID of the client.
+         * @param t_clientFileDescriptor The file descriptor of the client.
+         * @param t_data The data to send.
+         * @param t_size The size of the data.
+         * @return The number of sent bytes or -1 like `send`.
+         * @version 1.0.0
+         */
+        ssize_t transmit(const int t_clientID, const fileDescriptor t_clientFileDescriptor, const char *t_data, const size_t t_size);
+
+        /**
+         * @brief Sends a part of a file to a client, through its TLS session if it has one.
+         * @details Without TLS and with kernel TLS the data goes from the page cache to the socket without a copy. With TLS in user
+         * space the part is read into a buffer of `Constants::TLS_RECORD_SIZE` bytes and encrypted by OpenSSL.
+         * @param t_clientID The ID of the client.
+         * @param t_clientFileDescriptor The file descriptor of the client.
+         * @param t_fileFileDescriptor The file.
+         * @param t_offset The offset in the file to start at.
+         * @param t_size The number of bytes to send.
+         * @return The number of sent bytes, 0 if the file ended or -1 like `send`.
+         * @version 1.0.0
+         */
+        ssize_t transmitFile(const int t_clientID, const fileDescriptor t_clientFileDescriptor, const fileDescriptor t_fileFileDescriptor,
+                             const off_t t_offset, const size_t t_size);
+
+        /**
+         * @brief Receives the next chunk of data from a client.
+         * @details This function waits with `poll` until data is available, the timeout of one read passes or the read deadline passes,
+         * and records the read in the metrics.
+         * @param t_clientID The ID of the client.
+         * @param t_clientFileDescriptor The file descriptor of the client.
+         * @param t_buffer The buffer to receive into.
+         * @param t_size The size of the buffer.
+         * @param t_deadline The read deadline of the client.
+         * @param t_connectionMetrics The metrics of the client.
+         * @param t_error Set to `NetworkError::TIMEOUT` if the timeout or the read deadline passed, to `NetworkError::CONNECTION_CLOSED`
+         * if the client closed the connection or to the `errno` of the failed system call.
+         * @return The number of received bytes, always greater than 0, or -1 if `t_error` is set.
+         * @version 1.0.0
+         */
+        ssize_t receiveChunk(const int t_clientID, const fileDescriptor t_clientFileDescriptor, char *t_buffer, const size_t t_size,
+                             const std::chrono::steady_clock::time_point t_deadline, ConnectionMetrics &t_connectionMetrics,
+                             std::error_code &t_error);
+
+        /**
+         * @brief Throws the exception that matches the error of a non-throwing function.
+         * @param t_error The error.
+         * @param t_context What failed, like "Reading the data failed.".
+         * @param t_timeoutContext The message of a timeout, like "Timeout reached while reading data.".
+         * @throws `InvalidArgumentException` If the error is `NetworkError::INVALID_CLIENT` or `NetworkError::INVALID_ARGUMENT`.
+         * @throws `ServerTimeoutException` If the error is `NetworkError::TIMEOUT`.
+         * @throws `ServerRuntimeException` Otherwise.
+         * @version 1.0.0
+         */
+        [[noreturn]] static void throwError(const std::error_code &t_error, const char *t_context, const char *t_timeoutContext);
+
+        /**
+         * @brief Retrieves the number of clients that were accepted and not closed yet.
+         * @details Unlike `getCurrentlyConnectedClientsCount()` this function does not issue a system call per client. Clients that
+         * disconnected but were not closed yet are counted.
+         * @return The number of open clients.
+         * @version 1.0.0
+         */
+        int getOpenClientsCount();
+
+        /**
+         * @brief Creates the event queue for the listening socket and marks the server as online.
+         * @throws `ServerCreationException` If creating the event queue failed.
+         * @version 1.0.0
+         */
+        void startEventQueue();
+
+        /**
+         * @brief Runs the functions that were posted to the event loop since the last wake-up.
+         * @details A function that throws is counted as an error in the metrics, the others still run.
+         * @version 1.0.0
+         */
+        void runPostedTasks();
+
+        /**
+         * @brief Checks if a clientID does not exist.
+         * @details This function checks if a client with the specified ID does not exist.
+         * @version 1.0.0
+         */
+        bool thisClientDoesNotExist(const int t_clientID) const;
+
+        /**
+         * @brief Checks if the client is disconnected.
+         * @details This function checks if the client is disconnected by checking if there is no more data to read from the client.
+         * @return True if the client is disconnected, false otherwise.
+         * @version 1.0.0
+         */
+        bool isDisconnected(const int t_clientID);
+
+    public:
+        /**
+         * @brief Returns the port number used by the server.
+         * @details This function returns the port number used by the server as a 16-bit unsigned integer.
+         * @return The port number as a 16-bit unsigned integer.
+         * @version 1.0.0
+         */
+        port getPort();
+
+        /**
+         * @brief Retrieves the start date of the server.
+         * @details This function returns the start date of the server as a string.
+         * @return The start date of the server as a string.
+         * @version 1.0.0
+         */
+        std::string getStartDate();
+
+        /**
+         * @brief Checks if the server is draining.
+         * @details This function returns true between `drain()` and `stopServer()`.
+         * @return true if the server is draining, false otherwise.
+         * @version 1.0.0
+         */
+        bool isDraining();
+
+        /**
+         * @brief Checks if the server is drained.
+         * @details This function returns true if the server is draining and all clients are closed, so `stopServer()` does not cut off
+         * any request.
+         * @return true if the server is drained, false otherwise.
+         * @version 1.0.0
+         */
+        bool isDrained();
+
+        /**
+         * @brief Checks if the server is currently online.
+         * @details This function returns true if the server is online, and false otherwise.
+         * @return true if the server is online, false otherwise.
+         * @version 1.0.0
+         */
+        bool isServerOnline();
+
+        /**
+         * @brief Retrieves the data.
+         * @details This function returns the data stored in the server as a string.
+         * @param t_clientID The ID of the client.
+         * @return The data as a string.
+         * @version 1.0.0
+         */
+        std::string getData(const int t_clientID);
+
+        /**
+         * @brief Gets the lifetime of an object.
+         * @details This function returns the lifetime of the object as a time_t value.
+         * @return The lifetime of the object as a time_t value.
+         * @version 1.0.0
+         */
+        time_t getLifeTime();
+
+        /**
+         * @brief Retrieves the IP address of the client.
+         * @details This function returns the IP address of the client as a string.
+         * @return The IP address of the client as a string.
+         * @throws `ServerRuntimeException` If something goes wrong while retrieving the IP address.
+         * @throws `InvalidDomainException` If the server domain is invalid
+         * @version 1.0.0
+         */
+        std::string getClientIpAddress(const int t_clientID);
+
+        /**
+         * @brief Gets the count of currently connected clients.
+         * @details This function returns the count of currently connected clients to the server.
+         * @return The count of currently connected clients.
+         * @version 1.0.0
+         */
+        int getCurrentlyConnectedClientsCount();
+
+        /**
+         * @brief Retrieves the metrics of the server.
+         * @details This function returns a snapshot of the counters and latency histograms of the server. It does not block the threads
+         * serving clients and does not issue any system call, so it is safe to call it frequently.
+         * @return The snapshot of the metrics of the server.
+         * @version 1.0.0
+         */
+        ServerMetricsSnapshot getMetrics() const;
+
+        /**
+         * @brief Retrieves the metrics of a client.
+         * @details This function returns a snapshot of the counters of the connection with the specified client.
+         * @param t_clientID The ID of the client.
+         * @return The snapshot of the metrics of the client.
+         * @throws `std::out_of_range` If the client ID is not found.
+         * @version 1.0.0
+         */
+        ConnectionMetricsSnapshot getClientMetrics(const int t_clientID) const;
+
+        /**
+         * @brief Constructs a IP Domain Server object.
+         * @param t_domain The domain of the server.
+         * @param t_port The port number of the server.
+         * @param t_maximumCurrentConnections The maximum number of current connections allowed by the server.
+         * @throws `InvalidArgumentException` If `t_port` is less than 0 or greater than 65535, or `t_maximumCurrentConnections` is less
+         * than or equal to 0.
+         * @throws `InvalidDomainException` If `t_domain` is invalid.
+         * @note The domain can only be one of the following: `FBNetwork::Domain::IPV4_DOMAIN` (for IPv4 domain) and
+         * `FBNetwork::Domain::IPV6_DOMAIN` (for IPv6 domain). If you want to use the local domain, use the constructor that takes a socket
+         * path as an argument.
+         * @version 1.0.0
+         */
+        Server(const int t_domain, const port t_port, const int t_maximumCurrentConnections);
+
+        /**
+         * @brief Constructs a Unix Domain Server object.
+         * @param t_socketPath The path to the socket.
+         * @param t_port The port number.
+         * @param t_maximumCurrentConnections The maximum number of current connections.
+         * @throws `InvalidArgumentException` If `t_socketPath` is empty, `t_port` is less than 0 or greater than 65535, or
+         * `t_maximumCurrentConnections` is less than or equal to 0.
+         * @note The domain is set to FBNetwork::Domain::LOCAL_DOMAIN.
+         * @version 1.0.0
+         */
+        Server(std::string &t_socketPath, const port t_port, const int t_maximumCurrentConnections);
+
+        /**
+         * @brief Destructor for the Server class.
+         * @details This destructor is responsible for cleaning up any resources used by the Server class. It is automatically called when
+         * an instance of the Server class is destroyed.
+         * @throws `ServerRuntimeException` If an error occurs while stopping the server.
+         * @note This destructor calls the `stopServer()` function.
+         * @version 1.0.0
+         */
+        ~Server();
+
+        /**
+         * @brief Starts the server.
+         * @details This function initializes and starts the server.
+         * @throws `ServerCreationException` If an error occurs while creating the server.
+         * @note This function should be called after creating an instance of the Server class.
+         * @version 1.0.0
+         */
+        void startServer();
+
+        /**
+         * @brief Starts the server on the listening socket of another process.
+         * @details This function is called by the replacement process of a zero-downtime restart instead of `startServer()` and
+         * `startListening()`. It creates a local domain server at `t_socketPath`, waits until the running process connects with
+         * `handOffListener()` and takes over the listening socket it receives, so no connection in the backlog is lost and the port is
+         * never closed. The domain of the received socket must match the domain of this server, the port is taken from the socket.
+         * @param t_socketPath The path of the local domain socket used for the handoff.
+         * @throws `ServerCreationException` If creating the local domain server failed or the received socket does not match.
+         * @throws `ServerRuntimeException` If receiving the socket failed.
+         * @throws `ServerTimeoutException` If the running process did not connect or did not send the socket within the timeout of
+         * `setTimeout()`.
+         * @version 1.0.0
+         */
+        void takeOverListener(const std::string &t_socketPath);
+
+        /**
+         * @brief Starts listening for incoming connections.
+         * @details This function initiates the server to start listening for incoming connections from clients. Once a connection is
+         * established, the server can receive and process client requests.
+         * @throws `ServerRuntimeException` if an error occurs while listening for incoming connections.
+         * @version 1.0.0
+         */
+        void startListening();
+
+        /**
+         * @brief Stops the server.
+         * @details This function is responsible for stopping the server and terminating any active connections. It should be called when
+         * the server needs to be shut down.
+         * @throws `ServerRuntimeException` if an error occurs while disconnecting the clients or stopping the server.
+         * @version 1.0.0
+         */
+        void stopServer();
+
+        /**
+         * @brief Starts to drain the server.
+         * @details This function stops accepting connections and closes the listening socket. Connected clients are served as usual until
+         * the application closes them or they disconnect, and clients that are still open after `t_timeout` are closed by
+         * `getPendingEvents()` and reported as `EventType::CLIENT_TIMED_OUT`. Once `isDrained()` returns true, `getPendingEvents()` returns
+         * without waiting and the server can be stopped with `stopServer()`. The application can check `isDraining()` to ask clients to
+         * reconnect, for example with `Connection: close`.
+         * @param t_timeout The time the connected clients have to finish.
+         * @throws `InvalidArgumentException` If `t_timeout` is negative.
+         * @throws `ServerRuntimeException` If the server is not online.
+         * @version 1.0.0
+         */
+        void drain(const std::chrono::milliseconds t_timeout);
+
+        /**
+         * @brief Hands the listening socket over to a replacement process.
+         * @details This function connects to the local domain socket at `t_socketPath`, where the replacement process waits in
+         * `takeOverListener()`, and sends the listening socket with `SCM_RIGHTS`. Both processes share the socket afterwards, so this
+         * process should call `drain()` next to leave all new connections to the replacement process.
+         * @param t_socketPath The path of the local domain socket used for the handoff.
+         * @throws `ServerRuntimeException` If the server is not online, or connecting or sending the socket failed.
+         * @version 1.0.0
+         */
+        void handOffListener(const std::string &t_socketPath);
+
+        /**
+         * @brief Receives a file descriptor from a client over a local domain socket.
+         * @details The file descriptor is sent with `SCM_RIGHTS`, for example with `Client::sendFileDescriptor()`.
+         * @param t_clientID The ID of the client.
+         * @return The received file descriptor. The caller owns it.
+         * @throws `ServerRuntimeException` If an error occurred while receiving, the client closed the connection or did not send a file
+         * descriptor.
+         * @throws `ServerTimeoutException` If the client did not send within the timeout.
+         * @version 1.0.0
+         */
+        fileDescriptor receiveFileDescriptor(const int t_clientID);
+
+        /**
+         * @brief Sets the server to the provided keepAlive value.
+         * @details This function sets the server to keep alive. If `t_keepAlive` is `true`, the server will keep the connection alive.
+         * @param t_keepAlive A boolean value indicating whether the server should keep the connection alive or not.
+         * @throws `ServerRuntimeException` If an error occurred while setting the server option.
+         * @version 1.0.0
+         */
+        void setServerKeepAlive(const bool t_keepAlive);
+
+        /**
+         * @brief Sets the socket options of the listening socket and of the clients.
+         * @details The listener options are applied right away if the server socket exists and by `startServer()`, the connection
+         * options to every client accepted afterwards. A client whose options cannot be set is accepted anyway and counted as an error
+         * in the metrics.
+         * @param t_socketOptions The socket options.
+         * @throws `ServerRuntimeException` If a listener option could not be set.
+         * @version 1.0.0
+         */
+        void setSocketOptions(const SocketOptions &t_socketOptions);
+
+        /**
+         * @brief Retrieves the socket options of the listening socket and of the clients.
+         * @return The socket options.
+         * @version 1.0.0
+         */
+        SocketOptions getSocketOptions();
+
+        /**
+         * @brief Sends the data that the corked socket of a client holds back.
+         * @details Without cork in the socket options nothing is held back and this function does nothing.
+         * @param t_clientID The ID of the client.
+         * @throws `InvalidArgumentException` If the client ID is invalid.
+         * @throws `ServerRuntimeException` If the socket could not be flushed.
+         * @version 1.0.0
+         */
+        void flush(const int t_clientID);
+
+        /**
+         * @brief Sets where the event loop of the server runs.
+         * @details The thread that calls `getPendingEvents()` next pins itself to the CPUs of the placement and allocates on their NUMA
+         * node from then on, and the listening socket reports the first CPU as its `SO_INCOMING_CPU`, right away if the server socket
+         * exists and by `startServer()`. To run several event loops, start one server per loop on the same port with
+         * `SocketOptions::setReusePort()` and give each one `CpuPlacement::forLoop()`. An empty placement stops pinning threads that
+         * call `getPendingEvents()` later, a thread that is already pinned stays pinned.
+         * @param t_cpuPlacement The placement.
+         * @throws `ServerRuntimeException` If `SO_INCOMING_CPU` could not be set.
+         * @version 1.0.0
+         */
+        void setCpuPlacement(const CpuPlacement &t_cpuPlacement);
+
+        /**
+         * @brief Retrieves where the event loop of the server runs.
+         * @return The placement.
+         * @version 1.0.0
+         */
+        CpuPlacement getCpuPlacement();
+
+        /**
+         * @brief Retrieves the CPU that processed the last packet of a client in the kernel (`SO_INCOMING_CPU`).
+         * @details If it differs from the CPU of the event loop, the data of the client crosses caches on every read, which the
+         * placement of the loops or the interrupt affinity of the network card can fix.
+         * @param t_clientID The ID of the client.
+         * @return The CPU, or -1 if it is not known.
+         * @throws `InvalidArgumentException` If the client ID is invalid.
+         * @version 1.0.0
+         */
+        int getClientIncomingCpu(const int t_clientID);
+
+        /**
+         * @brief Runs a function on the thread of the event loop.
+         * @details The function runs inside the next `getPendingEvents()`, which wakes up for it if it is waiting. Functions run in
+         * the order in which they were posted. This is how other threads, like the workers of a `TaskPool`, hand results back to the
+         * event loop, which owns the sockets.
+         * @param t_task The function.
+         * @throws `InvalidArgumentException` If the function is empty.
+         * @version 1.0.0
+         */
+        void post(std::function<void()> t_task);
+
+        /**
+         * @brief Runs a request handler on a task pool and sends its response from the event loop.
+         * @details Read the request on the event loop as usual and pass a handler that works on a copy of it. The handlers of one
+         * client run one after another in the order of the calls, so the responses are sent in the order of the requests, while the
+         * event loop serves the other clients. The response is handed back by `post()` and queued like a `broadcast()` payload, so the
+         * event loop never waits for the client to read. If the handler throws, or the response cannot be queued because of
+         * `setOutputQueueLimit()`, the client is closed. A response for a client that was closed in the meantime, or whose ID was
+         * reused by another connection, is dropped. If the limit of `setConcurrencyLimit()` is reached, the handler is not run and the
+         * caller rejects the request, for example by answering it with an HTTP 503.
+         * @param t_taskPool The task pool. It must be destroyed before the server.
+         * @param t_clientID The ID of the client.
+         * @param t_handler The handler, it returns the response, an empty response is not sent.
+         * @throws `InvalidArgumentException` If the client ID is invalid or the handler is empty.
+         * @throws `ServerRuntimeException` If the concurrency limit is reached.
+         * @version 1.0.0
+         */
+        void dispatch(TaskPool &t_taskPool, const int t_clientID, std::function<std::string()> t_handler);
+
+        /**
+         * @brief Runs an RPC handler on a task pool and sends its response from the event loop as soon as it is done.
+         * @details Unlike `dispatch()`, the handlers of one client run in parallel and their responses are sent in the order they finish,
+         * since the correlation ID tells the `RpcClient` which call a response belongs to. A handler that throws fails its call with
+         * an error frame and the client stays connected. The frame is queued like a `broadcast()` payload, so the event loop never waits
+         * for the client to read. If it cannot be queued because of `setOutputQueueLimit()`, the client is closed. The handlers are
+         * counted in the limit of `setConcurrencyLimit()` like those of `dispatch()`, a call above the limit is not run and fails with an
+         * error frame right away.
+         * @param t_taskPool The task pool. It must be destroyed before the server.
+         * @param t_clientID The ID of the client.
+         * @param t_correlationID The correlation ID that `readRpcRequest()` returned for the request.
+         * @param t_handler The handler, it returns the response.
+         * @throws `InvalidArgumentException` If the client ID is invalid or the handler is empty.
+         * @version 1.0.0
+         */
+        void dispatchRpc(TaskPool &t_taskPool, const int t_clientID, const uint64_t t_correlationID, std::function<std::string()> t_handler);
+
+        /**
+         * @brief Sends one payload to all clients, or to the clients a filter selects, without waiting for any of them.
+         * @details The payload is not copied: the output queue of every client holds a reference to it. Each queue is written as far as
+         * the socket buffer of its client allows and the rest is written by `getPendingEvents()` when the event queue reports room, so
+         * a slow client does not hold up the others. A client whose output queue would grow above the limit of
+         * `setOutputQueueLimit()` loses the payload or is closed. This function can be called from any thread.
+         * @note Data queued here and data written with `sendData()` are not ordered against each other, so do not mix them for one
+         * client while its output queue is not empty, see `getQueuedBytes()`.
+         * @param t_payload The payload, create it with `std::make_shared<const std::string>()`.
+         * @param t_filter Selects the clients by ID. Every client is selected if it is empty.
+         * @return The number of clients the payload was queued for.
+         * @throws `InvalidArgumentException` If the payload is empty.
+         * @version 1.0.0
+         */
+        size_t broadcast(const sharedPayload &t_payload, const std::function<bool(const int)> &t_filter = nullptr);
+
+        /**
+         * @brief Subscribes a client to a topic.
+         * @details The subscription ends when the client is closed.
+         * @param t_clientID The ID of the client.
+         * @param t_topic The topic.
+         * @throws `InvalidArgumentException` If the client ID is invalid or the topic is empty.
+         * @version 1.0.0
+         */
+        void subscribe(const int t_clientID, const std::string &t_topic);
+
+        /**
+         * @brief Unsubscribes a client from a topic.
+         * @param t_clientID The ID of the client.
+         * @param t_topic The topic.
+         * @version 1.0.0
+         */
+        void unsubscribe(const int t_clientID, const std::string &t_topic);
+
+        /**
+         * @brief Sends one payload to the subscribers of a topic without waiting for any of them.
+         * @details This function works like `broadcast()`, but only for the clients that subscribed to the topic.
+         * @param t_topic The topic.
+         * @param t_payload The payload.
+         * @return The number of clients the payload was queued for.
+         * @throws `InvalidArgumentException` If the payload is empty.
+         * @version 1.0.0
+         */
+        size_t publish(const std::string &t_topic, const sharedPayload &t_payload);
+
+        /**
+         * @brief Sets how many bytes may wait in the output queue of a client and what happens to a client above that.
+         * @details The limit is 4 MiB and the policy is `SlowClientPolicy::DROP_MESSAGE` by default. Dropped payloads are counted in
+         * the metrics.
+         * @param t_limit The limit in bytes.
+         * @param t_policy The policy for clients whose output queue is full.
+         * @throws `InvalidArgumentException` If the limit is 0.
+         * @version 1.0.0
+         */
+        void setOutputQueueLimit(const size_t t_limit, const SlowClientPolicy t_policy);
+
+        /**
+         * @brief Retrieves how many bytes of `broadcast()` and `publish()` are still queued for a client.
+         * @param t_clientID The ID of the client.
+         * @return The number of bytes.
+         * @throws `InvalidArgumentException` If the client ID is invalid.
+         * @version 1.0.0
+         */
+        size_t getQueuedBytes(const int t_clientID);
+
+        /**
+         * @brief Sets the rate limits of the clients.
+         * @details The limits are enforced by `getPendingEvents()`. A client that exceeds its bytes or messages per second is not
+         * disconnected: its reads are paused, so the event queue stops reporting it, until its token buckets have refilled, while the
+         * other clients are served. Checking a client costs one lookup per event. A connection from a source IP address that exceeds
+         * its connections per second is closed right after accepting it. Setting limits refills the token buckets of all clients and
+         * sources.
+         * @param t_rateLimits The rate limits, all 0 to disable them.
+         * @throws `InvalidArgumentException` If a rate or burst is negative.
+         * @version 1.0.0
+         */
+        void setRateLimits(const RateLimits &t_rateLimits);
+
+        /**
+         * @brief Retrieves the rate limits of the clients.
+         * @return The rate limits.
+         * @version 1.0.0
+         */
+        RateLimits getRateLimits();
+
+        /**
+         * @brief Sets what the server does with new connections while it is overloaded.
+         * @details The server is overloaded while every client ID is taken or the limit of `setConcurrencyLimit()` is reached. With
+         * `OverloadPolicy::THROW`, the default, the accept functions throw and the connections wait in the backlog, so the listening socket
+         * stays readable. With `OverloadPolicy::PAUSE_ACCEPTING` the event queue stops reporting the listening socket until the load has
+         * dropped; new connections wait in the backlog, up to `setListenBacklog()`, and the kernel refuses the rest. With
+         * `OverloadPolicy::ACCEPT_AND_CLOSE` the pending connections are accepted, sent the overload response and closed, which tells
+         * clients right away to try again later.
+         * @param t_overloadPolicy The policy.
+         * @param t_overloadResponse The response for `OverloadPolicy::ACCEPT_AND_CLOSE`, for example an HTTP 503. Nothing is sent if it
+         * is empty.
+         * @version 1.0.0
+         */
+        void setOverloadPolicy(const OverloadPolicy t_overloadPolicy, const std::string &t_overloadResponse = "");
+
+        /**
+         * @brief Retrieves what the server does with new connections while it is overloaded.
+         * @return The policy.
+         * @version 1.0.0
+         */
+        OverloadPolicy getOverloadPolicy();
+
+        /**
+         * @brief Sets an adaptive limit of the requests in flight, above which the server rejects handlers and new connections.
+         * @details `dispatch()` and `dispatchRpc()` count every handler in the limit and report the time from the call until the handler
+         * returned, so the limit shrinks when the handlers queue up in the task pool and grows while they keep up. While the limit is
+         * reached, new handlers are rejected, see `dispatch()`, and the server is overloaded, see `setOverloadPolicy()`. Requests that
+         * are read but not dispatched are not limited.
+         * @param t_concurrencyLimit The limit, shared with the handlers in flight, or `nullptr` to remove it.
+         * @version 1.0.0
+         */
+        void setConcurrencyLimit(std::shared_ptr<ConcurrencyLimit> t_concurrencyLimit);
+
+        /**
+         * @brief Retrieves the adaptive limit of the requests in flight.
+         * @return The limit, `nullptr` if there is none.
+         * @version 1.0.0
+         */
+        std::shared_ptr<ConcurrencyLimit> getConcurrencyLimit();
+
+        /**
+         * @brief Sets the length of the queue of connections that wait to be accepted.
+         * @details The backlog is independent of the maximum number of current connections: it holds connections during bursts and
+         * while accepting is paused. The kernel caps it, on Linux at `net.core.somaxconn`. It takes effect with `startListening()`.
+         * @param t_listenBacklog The length, `Constants::LISTEN_BACKLOG` by default.
+         * @throws `InvalidArgumentException` If the length is not greater than 0.
+         * @version 1.0.0
+         */
+        void setListenBacklog(const int t_listenBacklog);
+
+        /**
+         * @brief Retrieves the length of the queue of connections that wait to be accepted.
+         * @return The length.
+         * @version 1.0.0
+         */
+        int getListenBacklog();
+
+        /**
+         * @brief Checks if the event queue stopped reporting the listening socket because the server is overloaded.
+         * @return true if accepting is paused, false otherwise.
+         * @version 1.0.0
+         */
+        bool isAcceptingPaused();
+
+        /**
+         * @brief Sets the compression of `sendCompressedData()` and `readCompressedData()`.
+         * @details A client that sends a compression offer, see `Client::enableCompression()`, gets the codec of these options if it
+         * has it, and the dictionary is used if it has the same one. The options apply to clients whose first compressed frame comes
+         * after this call, a negotiated connection keeps its codec.
+         * @param t_compressionOptions The options, `CompressionCodec::NONE` to answer every offer with uncompressed frames.
+         * @throws `InvalidArgumentException` If the codec was not found at build time.
+         * @version 1.0.0
+         */
+        void setCompression(const CompressionOptions &t_compressionOptions);
+
+        /**
+         * @brief Retrieves the compression of `sendCompressedData()` and `readCompressedData()`.
+         * @return The options.
+         * @version 1.0.0
+         */
+        CompressionOptions getCompression();
+
+        /**
+         * @brief Retrieves the codec a client negotiated.
+         * @param t_clientID The ID of the client.
+         * @return The codec, `CompressionCodec::NONE` if the client did not negotiate one.
+         * @throws `InvalidArgumentException` If the client ID is invalid.
+         * @version 1.0.0
+         */
+        CompressionCodec getCompressionCodec(const int t_clientID);
+
+        /**
+         * @brief Accepts a client connection. It automatically assigns an ID to the client and and prepares the ID for the next client.
+         * @details This function accepts a client connection. It waits up to the timeout of `setTimeout()` until a client connection is
+         * established. Once a pending connection was rejected by the connection rate limit, aborted by its client or closed for lack of
+         * file descriptors, it does not wait anymore: it accepts the next pending connection or throws, so an event loop that calls it on
+         * `EventType::CLIENT_WANTS_TO_CONNECT` is never blocked. The IDs of closed clients are reused, the IDs of connected clients never
+         * change. Disconnected clients that were not closed yet are only closed when the maximum number of current connections is
+         * reached. A server that is overloaded throws, after applying `OverloadPolicy::PAUSE_ACCEPTING` or
+         * `OverloadPolicy::ACCEPT_AND_CLOSE`, since it cannot return a client.
+         * @throws `ServerRuntimeException` If an error occurred while accepting the client connection, no pending connection was left to
+         * accept, the server is overloaded or the server is draining.
+         * @throws `ServerTimeoutException` If no client connected within the timeout.
+         * @return The ID of the client.
+         * @version 1.0.0
+         */
+        int acceptClient();
+
+        /**
+         * @brief Accepts all pending client connections.
+         * @details This function accepts connections until the backlog of the listening socket is empty or the maximum number of current
+         * connections is reached, and then registers all new clients in the event queue. It does not block, so it is meant to be called
+         * on `EventType::CLIENT_WANTS_TO_CONNECT`. A draining server accepts no clients. When the server becomes overloaded, the
+         * policy of `setOverloadPolicy()` is applied. A connection that cannot be accepted because the process is out of file descriptors
+         * is closed right away.
+         * @return The IDs of the accepted clients, possibly none.
+         * @throws `ServerRuntimeException` If no client could be accepted because of an error or because the server is overloaded with
+         * `OverloadPolicy::THROW`.
+         * @version 1.0.0
+         */
+        std::vector<int> acceptAll();
+
+        /**
+         * @brief Closes client connections of disconnected clients. (If clients do not have any data to send)
+         * @details This function closes the client connection if the client is disconnected. It checks if the client is disconnected by
+         * checking if there is no more data to read from the client.
+         * @throws `ServerRuntimeException` if an error occurred while closing the client connection.
+         * @version 1.0.0
+         */
+        void closeDisconnectedClients();
+
+        /**
+         * @brief Sends data to a specific client.
+         * @details This function sends data to a specific client. Client sockets are non-blocking, so if the socket buffer is full the
+         * function waits up to the timeout for the client to read before it sends the rest. If payloads are queued for the client, see
+         * `broadcast()`, or another thread writes to it, the data is queued behind them and the function returns at once, so messages are
+         * never interleaved. The queued data is subject to `setOutputQueueLimit()`.
+         * @param t_clientID The ID of the client.
+         * @param t_data The data to be sent.
+         * @throws `InvalidArgumentException` If `t_data` is empty.
+         * @throws `ServerRuntimeException` If an error occurred while sending the data, or the data had to be queued and was dropped.
+         * @throws `ServerTimeoutException` If the client did not read within the timeout.
+         * @version 1.0.0
+         */
+        void sendData(const int t_clientID, const std::string &t_data);
+
+        /**
+         * @brief Sends data to a specific client without throwing.
+         * @details This function works like `sendData()`, but reports failures through `t_error` instead of throwing. Timeouts and closed
+         * connections are part of normal operation under load, so hot paths should use this function.
+         * @param t_clientID The ID of the client.
+         * @param t_data The data to be sent.
+         * @param t_error Set to `NetworkError::INVALID_CLIENT`, `NetworkError::INVALID_ARGUMENT` if `t_data` is empty,
+         * `NetworkError::TIMEOUT`, `NetworkError::CONNECTION_CLOSED` if the data had to be queued and the client was closed,
+         * `std::errc::no_buffer_space` if it had to be queued and was dropped, the `errno` of the failed system call or cleared.
+         * @version 1.0.0
+         */
+        void sendData(const int t_clientID, const std::string &t_data, std::error_code &t_error);
+
+        /**
+         * @brief Sends data to a specific client as one compression frame.
+         * @details The data is compressed with the codec the client negotiated, see `setCompression()`, or sent uncompressed in a frame
+         * if it did not negotiate one, is short or does not get shorter. The client reads it with `Client::readCompressedData()`. The
+         * compression contexts of a client are created once and reused for every frame.
+         * @param t_clientID The ID of the client.
+         * @param t_data The data to be sent.
+         * @throws `InvalidArgumentException` If the client ID is invalid, `t_data` is empty or larger than
+         * `Constants::COMPRESSION_MAXIMUM_FRAME_SIZE`.
+         * @throws `ServerRuntimeException` If an error occurred while compressing or sending the data.
+         * @throws `ServerTimeoutException` If the client did not read within the timeout.
+         * @version 1.0.0
+         */
+        void sendCompressedData(const int t_clientID, const std::string &t_data);
+
+        /**
+         * @brief Sends the response to an RPC request.
+         * @details Responses can be sent in any order, the `RpcClient` matches them to its calls by the correlation ID.
+         * @param t_clientID The ID of the client.
+         * @param t_correlationID The correlation ID that `readRpcRequest()` returned for the request.
+         * @param t_response The response, it can be empty.
+         * @throws `InvalidArgumentException` If the client ID is invalid or the response is larger than `Constants::RPC_MAXIMUM_FRAME_SIZE`.
+         * @throws `ServerRuntimeException` If an error occurred while sending the response.
+         * @throws `ServerTimeoutException` If the client did not read within the timeout.
+         * @version 1.0.0
+         */
+        void sendRpcResponse(const int t_clientID, const uint64_t t_correlationID, const std::string &t_response);
+
+        /**
+         * @brief Fails an RPC request, the call throws `ClientRuntimeException` with the message on the client.
+         * @param t_clientID The ID of the client.
+         * @param t_correlationID The correlation ID that `readRpcRequest()` returned for the request.
+         * @param t_message The error message.
+         * @throws `InvalidArgumentException` If the client ID is invalid or the message is larger than `Constants::RPC_MAXIMUM_FRAME_SIZE`.
+         * @throws `ServerRuntimeException` If an error occurred while sending the error.
+         * @throws `ServerTimeoutException` If the client did not read within the timeout.
+         * @version 1.0.0
+         */
+        void sendRpcError(const int t_clientID, const uint64_t t_correlationID, const std::string &t_message);
+
+        /**
+         * @brief Sends a file to a specific client.
+         * @details This function opens the file and sends it like `sendFile()` with a file descriptor. The file is closed afterwards.
+         * @param t_clientID The ID of the client.
+         * @param t_filePath The path of the file.
+         * @param t_offset The offset in the file to start at.
+         * @param t_length The number of bytes to send, 0 sends everything after `t_offset`.
+         * @throws `InvalidArgumentException` If the file path is empty or the range is not inside the file.
+         * @throws `SystemRuntimeException` If the file could not be opened.
+         * @throws `ServerRuntimeException` If an error occurred while sending the file.
+         * @throws `ServerTimeoutException` If the client did not read within the timeout.
+         * @version 1.0.0
+         */
+        void sendFile(const int t_clientID, const std::string &t_filePath, const off_t t_offset = 0, const size_t t_length = 0);
+
+        /**
+         * @brief Sends a part of an open file to a specific client.
+         * @details This function sends the file with `sendfile`, so the data goes from the page cache to the socket without being copied
+         * into the process, see `transmitFile()` for TLS. Like `sendData()` it waits up to the timeout whenever the socket buffer is full
+         * and continues where the last partial send stopped. Payloads queued for the client are written before the file, waiting up to
+         * the timeout as well. The file position is not changed and the file stays open, so one file descriptor can serve many clients.
+         * @param t_clientID The ID of the client.
+         * @param t_fileDescriptor The file, opened for reading.
+         * @param t_offset The offset in the file to start at.
+         * @param t_length The number of bytes to send, 0 sends everything after `t_offset`.
+         * @throws `InvalidArgumentException` If the range is not inside the file.
+         * @throws `SystemRuntimeException` If the size of the file could not be retrieved.
+         * @throws `ServerRuntimeException` If an error occurred while sending the queued payloads or the file, or the file got shorter.
+         * @throws `ServerTimeoutException` If the client did not read within the timeout.
+         * @version 1.0.0
+         */
+        void sendFile(const int t_clientID, const fileDescriptor t_fileDescriptor, const off_t t_offset = 0, const size_t t_length = 0);
+
+        /**
+         * @brief Reads x data from the client.
+         * @details This function reads x data from the client. The data is read up to the specified size (in bytes). Bytes received
+         * after the data are kept for the next read of the client, so pipelined messages are not lost.
+         * @param t_clientID The ID of the client.
+         * @param t_x The size of the data to read.
+         * @throws `InvalidArgumentException` If `t_x` is less than or equal to 0.
+         * @throws `ServerRuntimeException` If an error occurred while reading the data.
+         * @throws `ServerTimeoutException` If the read operation timed out. The timeout is set via the `setSocketTimeout()` function. If
+         * the timeout is not set, it will be the default FBNetwork::Constants::DEFAULT_TIMEOUT. Also thrown if the read deadline passed,
+         * see `setReadTimeout()`.
+         * @version 1.0.0
+         */
+        void readXData(const int t_clientID, const ssize_t t_x);
+
+        /**
+         * @brief Reads x data from the client without throwing.
+         * @details This function works like `readXData()`, but reports failures through `t_error` instead of throwing.
+         * @param t_clientID The ID of the client.
+         * @param t_x The size of the data to read.
+         * @param t_error Set to `NetworkError::INVALID_CLIENT`, `NetworkError::INVALID_ARGUMENT` if `t_x` is less than or equal to 0,
+         * `NetworkError::TIMEOUT`, `NetworkError::CONNECTION_CLOSED`, the `errno` of the failed system call or cleared.
+         * @version 1.0.0
+         */
+        void readXData(const int t_clientID, const ssize_t t_x, std::error_code &t_error);
+
+        /**
+         * @brief Reads one compression frame from the client and decompresses it.
+         * @details The data is available with `getData()` afterwards. A compression offer of the client is answered right away and
+         * leaves the data empty, so the caller can treat it like a message without content. If the payload times out, the whole frame
+         * is kept and the next call reads it again from its header.
+         * @param t_clientID The ID of the client.
+         * @throws `InvalidArgumentException` If the client ID is invalid.
+         * @throws `ServerRuntimeException` If an error occurred while reading the data or the frame is malformed.
+         * @throws `ServerTimeoutException` If the read operation timed out or the read deadline passed.
+         * @version 1.0.0
+         */
+        void readCompressedData(const int t_clientID);
+
+        /**
+         * @brief Reads one RPC request of an `RpcClient`.
+         * @details The request is available with `getData()` afterwards. A client keeps many requests in flight, so the bytes of the
+         * next requests are kept for the next read and the client is reported once more by `getPendingEvents()`. If the payload times
+         * out, the whole frame is kept and the next call reads it again from its header.
+         * @param t_clientID The ID of the client.
+         * @return The correlation ID, which the response has to carry.
+         * @throws `InvalidArgumentException` If the client ID is invalid.
+         * @throws `ServerRuntimeException` If an error occurred while reading the request or the frame is not a request.
+         * @throws `ServerTimeoutException` If the read operation timed out or the read deadline passed.
+         * @version 1.0.0
+         */
+        uint64_t readRpcRequest(const int t_clientID);
+
+        /**
+         * @brief Reads data from the client until the specified 'x' is encountered.
+         * @details This function reads data from the client until the specified character 'x' is encountered. Bytes received after 'x'
+         * are kept for the next read of the client, which consumes them before it receives anything, and the client is reported once more
+         * by `getPendingEvents()`.
+         * @param t_clientID The ID of the client.
+         * @param t_x The string to search for.
+         * @throws `InvalidArgumentException` If `t_x` is empty.
+         * @throws `ServerRuntimeException` If an error occurred while reading the data.
+         * @throws `ServerTimeoutException` If the read operation timed out or the read deadline passed.
+         * @version 1.0.0
+         */
+        void readTillXData(const int t_clientID, const std::string &t_x);
+
+        /**
+         * @brief Reads data from the client until the specified 'x' is encountered without throwing.
+         * @details This function works like `readTillXData()`, but reports failures through `t_error` instead of throwing.
+         * @param t_clientID The ID of the client.
+         * @param t_x The string to search for.
+         * @param t_error Set to `NetworkError::INVALID_CLIENT`, `NetworkError::INVALID_ARGUMENT` if `t_x` is empty,
+         * `NetworkError::TIMEOUT`, `NetworkError::CONNECTION_CLOSED`, the `errno` of the failed system call or cleared.
+         * @version 1.0.0
+         */
+        void readTillXData(const int t_clientID, const std::string &t_x, std::error_code &t_error);
+
+        /**
+         * @brief Reads data from the client until the specified string 'x' appears 'y' times.
+         * @details This function reads data from the client until the specified string 'x' appears 'y' times. Bytes received after the
+         * last 'x' are kept for the next read of the client.
+         * @param t_clientID The ID of the client.
+         * @param t_x The string to search for.
+         * @param t_y The number of times the character 'x' should appear.
+         * @throws `InvalidArgumentException` if `t_x` is empty or `t_y` is less than or equal to 0.
+         * @throws `ServerRuntimeException` if an error occurred while reading the data.
+         * @throws `ServerTimeoutException` If the read operation timed out or the read deadline passed.
+         * @version 1.0.0
+         */
+        void readTillXComesYTimesData(const int t_clientID, const std::string &t_x, const int t_y);
+
+        /**
+         * @brief Gets the pending events. Waits indefinitely until an event is available.
+         * @details This function returns the pending events in the event queue as a vector of event tuples, where the first element is the
+         * event type and the second element is the client ID, if applicable. If client timeouts are set, the wait is limited to the next
+         * deadline of a client, clients with a passed deadline are closed and reported as `EventType::CLIENT_TIMED_OUT`. While draining,
+         * it returns an empty vector as soon as all clients are closed. After `setCpuPlacement()`, the first call pins the calling thread.
+         * Functions passed to `post()` run inside this function, and so do the writes of output queues that waited for room in the
+         * socket buffer.
+         * @return The pending events in the event queue.
+         * @throws `ServerRuntimeException` If the CPU placement could not be applied to the calling thread.
+         * @version 1.0.0
+         */
+        std::vector<eventTuple> getPendingEvents();
+
+        /**
+         * @brief Checks if data is available to be read from the specified client within the given timeout.
+         * @details This function checks if there is data available to be read from the client within the given timeout.
+         * @param t_timeout The timeout value in seconds and microseconds.
+         * @return true if data is available within the timeout, false otherwise.
+         * @throws `ServerRuntimeException` If an error occurred while checking for data availability.
+         * @version 1.0.0
+         */
+        bool isDataAvailable(const timeval *t_timeout);
+
+        /**
+         * @brief Closes the client connection.
+         * @details This function closes the connection with the client to make the server available for other clients. Threads may close
+         * the same client at once, only one of them closes the connection and releases the client ID, the others return.
+         * @param t_clientID The ID of the client.
+         * @throws `ServerRuntimeException` If an error occurred while closing the client connection.
+         * @version 1.0.0
+         */
+        void closeClient(const int t_clientID);
+
+        /**
+         * @brief Sets the socket timeout.
+         * @details This function sets the timeout for reading from a client.
+         * @param t_timeout The timeout value in seconds and microseconds.
+         * @throws `InvalidArgumentException` If tv_sec is negative,tv_usec is negative or tv_usec is greater than 999999.
+         * @version 1.0.0
+         */
+        void setTimeout(const timeval t_timeout);
+
+        /**
+         * @brief Sets the idle timeout of the clients.
+         * @details A client that neither sent nor received data for this long is closed by `getPendingEvents()`. The timeout applies to a
+         * connected client from its next read or write on.
+         * @param t_idleTimeout The idle timeout, 0 disables it.
+         * @throws `InvalidArgumentException` If `t_idleTimeout` is negative.
+         * @version 1.0.0
+         */
+        void setIdleTimeout(const std::chrono::milliseconds t_idleTimeout);
+
+        /**
+         * @brief Sets the read timeout of the clients.
+         * @details Every read of a message has this long to complete. The deadline starts with the read, keeps running while a part of the
+         * message waits in the event loop for the rest and is set again by the next read once the message is complete. It bounds slow
+         * clients that send a message byte by byte, which the timeout of `setTimeout()` does not, because it restarts with every byte.
+         * A client that connected but sends nothing is not reading a message, `setIdleTimeout()` bounds it. Clients that miss the
+         * deadline while waiting in the event loop are closed by `getPendingEvents()`.
+         * @param t_readTimeout The read timeout, 0 disables it.
+         * @throws `InvalidArgumentException` If `t_readTimeout` is negative.
+         * @version 1.0.0
+         */
+        void setReadTimeout(const std::chrono::milliseconds t_readTimeout);
+
+        /**
+         * @brief Sets the write timeout of the clients.
+         * @details Once the socket buffer of a client is full, the rest of the data has to be sent within this time.
+         * @param t_writeTimeout The write timeout, 0 disables it.
+         * @throws `InvalidArgumentException` If `t_writeTimeout` is negative.
+         * @version 1.0.0
+         */
+        void setWriteTimeout(const std::chrono::milliseconds t_writeTimeout);
+#ifdef FBNETWORK_WITH_TLS
+
+        /**
+         * @brief Sets the TLS context of the server.
+         * @details Clients accepted afterwards talk TLS, the handshake runs in `getPendingEvents()` without blocking, and the read and
+         * send functions encrypt and decrypt transparently. Clients that fail the handshake are closed without an event. Pass nullptr to
+         * accept plaintext clients again.
+         * @param t_tlsContext The TLS context, created with `TlsRole::SERVER` and a certificate.
+         * @throws `InvalidArgumentException` If the context is not a server context.
+         * @version 1.0.0
+         */
+        void setTlsContext(std::shared_ptr<TlsContext> t_tlsContext);
+
+        /**
+         * @brief Retrieves the TLS session of a client, for example to check whether the session was resumed.
+         * @param t_clientID The ID of the client.
+         * @return The TLS session, or nullptr if the client does not use TLS.
+         * @version 1.0.0
+         */
+        std::shared_ptr<TlsConnection> getTlsConnection(const int t_clientID);
+#endif
     };
 }  // namespace FBNetwork
 
@@ -3,6 +3,8 @@
 
 #include <exception>
 #include <string>
+#include <system_error>
+#include "networkError.hpp"
 
 namespace FBNetwork
 {
@@ -14,7 +16,9 @@ namespace FBNetwork
     class ServerTimeoutException : public std::exception
     {
     private:
-        std::string m_message;
+        mutable std::string m_message;
+        const char         *m_context = nullptr;
+        std::error_code     m_error;
 
     public:
         /**
@@ -28,6 +32,30 @@ namespace FBNetwork
             m_message = "Server Timeout Error: " + t_message;
         }
 
+        /**
+         * @brief Constructs a ServerTimeoutException with an error code.
+         * @details The message is only formatted when `what()` is called, so throwing this exception does not allocate for the
+         * message. `t_context` is not copied, it must be a string literal. The error is not part of the message, a timeout needs no
+         * explanation.
+         * @param t_context What failed, like "Writing the data failed.".
+         * @param t_error The error, like `std::error_code(errno, std::system_category())`.
+         * @version 1.0.0
+         */
+        ServerTimeoutException(const char *t_context, const std::error_code &t_error) : m_context(t_context), m_error(t_error)
+        {
+        }
+
+        /**
+         * @brief Constructs a ServerTimeoutException with the value of `errno`.
+         * @param t_context What failed, it must be a string literal.
+         * @param t_errorNumber The value of `errno`.
+         * @version 1.0.0
+         */
+        ServerTimeoutException(const char *t_context, const int t_errorNumber)
+            : ServerTimeoutException(t_context, std::error_code(t_errorNumber, std::system_category()))
+        {
+        }
+
         /**
          * @brief Returns the error message associated with the exception.
          * @details This method returns the error message associated with the exception.
@@ -36,8 +64,29 @@ namespace FBNetwork
          */
         const char *what() const noexcept override
         {
+            if (m_message.empty() && m_context != nullptr)
+            {
+                try
+                {
+                    m_message = NetworkErrorCategory::formatMessage("Server Timeout Error: ", m_context, std::error_code());
+                }
+                catch (...)
+                {
+                    return m_context;
+                }
+            }
             return m_message.c_str();
         }
+
+        /**
+         * @brief Retrieves the error code associated with the exception.
+         * @return The error code, or an empty error code if the exception was constructed with a message only.
+         * @version 1.0.0
+         */
+        const std::error_code &getErrorCode() const noexcept
+        {
+            return m_error;
+        }
     };
 }  // namespace FBNetwork
 
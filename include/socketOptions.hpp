@@ -0,0 +1,221 @@
+#ifndef FBNETWORK_SOCKET_OPTIONS_HPP
+#define FBNETWORK_SOCKET_OPTIONS_HPP
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <netinet/tcp.h>
+#include <optional>
+#include <sys/socket.h>
+#include "constants.hpp"
+#include "exceptions.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents the TCP options of the connections of a `Server` or of a `Client`.
+     * @details The `SocketOptions` class is a profile of socket options. Only the options that were set are applied, every other option
+     * keeps the default of the system, so an empty profile costs no system call. A `Server` applies the listener options to its listening
+     * socket and the connection options to every accepted socket, a `Client` applies the connection options after connecting. On local
+     * domain sockets only the buffer sizes are applied, the TCP and IP options do not exist there.
+     * @note `TCP_CORK`, `TCP_QUICKACK` and `TCP_DEFER_ACCEPT` only exist on Linux, on macOS cork maps to `TCP_NOPUSH`. Applying an
+     * option the platform does not have fails with `ENOPROTOOPT`.
+     * @version 1.0.0
+     */
+    class SocketOptions
+    {
+    private:
+        std::optional<bool> m_noDelay;
+        std::optional<bool> m_cork;
+        std::optional<bool> m_quickAck;
+        std::optional<int>  m_notSentLowWatermark;
+        std::optional<int>  m_deferAcceptTimeout;
+        std::optional<int>  m_fastOpenQueueLength;
+        std::optional<bool> m_reusePort;
+        std::optional<int>  m_keepAliveIdleTime;
+        std::optional<int>  m_keepAliveInterval;
+        std::optional<int>  m_keepAliveCount;
+        std::optional<int>  m_receiveBufferSize;
+        std::optional<int>  m_sendBufferSize;
+        std::optional<int>  m_typeOfService;
+
+        /**
+         * @brief Sets one integer option.
+         * @param t_fileDescriptor The socket.
+         * @param t_level The level of the option, like `IPPROTO_TCP`.
+         * @param t_name The name of the option, like `TCP_NODELAY`.
+         * @param t_value The value.
+         * @param t_optionName The name of the option for the error message.
+         * @throws `SystemRuntimeException` If the option could not be set.
+         * @version 1.0.0
+         */
+        static void setOption(const fileDescriptor t_fileDescriptor, const int t_level, const int t_name, const int t_value,
+                              const char *t_optionName);
+
+        /**
+         * @brief Fails like `setsockopt` does for an option that the platform does not have.
+         * @param t_optionName The name of the option for the error message.
+         * @throws `SystemRuntimeException` Always.
+         * @version 1.0.0
+         */
+        [[noreturn]] static void throwUnsupported(const char *t_optionName);
+
+    public:
+        /**
+         * @brief Sets whether small writes are sent right away instead of being coalesced by Nagle's algorithm (`TCP_NODELAY`).
+         * @param t_noDelay Whether Nagle's algorithm is turned off.
+         * @version 1.0.0
+         */
+        void setNoDelay(const bool t_noDelay);
+
+        /**
+         * @brief Sets whether partial frames are held back until they are full or flushed (`TCP_CORK`).
+         * @details Corking lets a response that is written in several parts, like a header followed by `sendFile()`, leave in full
+         * segments. The kernel sends a held back partial frame after 200 ms, so call `Server::flush()` or `Client::flush()` after the last
+         * part of a message.
+         * @param t_cork Whether the socket is corked.
+         * @version 1.0.0
+         */
+        void setCork(const bool t_cork);
+
+        /**
+         * @brief Sets whether received data is acknowledged right away instead of with a delayed ACK (`TCP_QUICKACK`).
+         * @details The kernel leaves quick ACK mode on its own, so `Server` and `Client` set the option again before every read.
+         * @param t_quickAck Whether data is acknowledged right away.
+         * @version 1.0.0
+         */
+        void setQuickAck(const bool t_quickAck);
+
+        /**
+         * @brief Sets how many unsent bytes the socket may hold before it stops reporting that it is writable (`TCP_NOTSENT_LOWAT`).
+         * @details A small limit keeps data that is not sent yet in the application, where it can still be replaced or prioritized,
+         * instead of in a large send buffer.
+         * @param t_bytes The number of bytes.
+         * @throws `InvalidArgumentException` If `t_bytes` is negative.
+         * @version 1.0.0
+         */
+        void setNotSentLowWatermark(const int t_bytes);
+
+        /**
+         * @brief Sets how long the listening socket waits for the first data of a connection before it reports it (`TCP_DEFER_ACCEPT`).
+         * @details The server then wakes up once per connection for the accept and the first request together. This is a listener
+         * option, it only makes sense for protocols where the client speaks first.
+         * @param t_timeout The time in seconds.
+         * @throws `InvalidArgumentException` If `t_timeout` is negative.
+         * @version 1.0.0
+         */
+        void setDeferAcceptTimeout(const int t_timeout);
+
+        /**
+         * @brief Sets how many connections the listening socket accepts with data in the SYN before it has sent them a SYN-ACK
+         * (`TCP_FASTOPEN`).
+         * @details With TCP Fast Open, a client that got a cookie from the server on an earlier connection sends its first request in
+         * the SYN, and the server can read it one round trip earlier. This is a listener option. Requests that arrive in a SYN can be
+         * replayed by the network, so only use it for protocols where the first request is idempotent. On Linux the server side also
+         * needs bit 2 of `net.ipv4.tcp_fastopen`, otherwise connections fall back to the normal handshake.
+         * @param t_queueLength The number of pending fast open connections, 0 turns fast open off.
+         * @throws `InvalidArgumentException` If `t_queueLength` is negative.
+         * @version 1.0.0
+         */
+        void setFastOpen(const int t_queueLength);
+
+        /**
+         * @brief Sets whether several listening sockets can bind the same port (`SO_REUSEPORT`).
+         * @details This lets several `Server` objects on the same port run one event loop each, the kernel spreads the new connections
+         * over them. Together with a `CpuPlacement` per server, a connection goes to the server on the CPU that received it. This is a
+         * listener option, it only takes effect in `startServer()`, before the socket is bound.
+         * @param t_reusePort Whether the port can be shared.
+         * @version 1.0.0
+         */
+        void setReusePort(const bool t_reusePort);
+
+        /**
+         * @brief Turns keep-alive probes on and sets when they are sent (`SO_KEEPALIVE`, `TCP_KEEPIDLE`, `TCP_KEEPINTVL`, `TCP_KEEPCNT`).
+         * @param t_idleTime The idle time in seconds before the first probe.
+         * @param t_interval The time in seconds between probes.
+         * @param t_count The number of unanswered probes after which the connection is dropped.
+         * @throws `InvalidArgumentException` If a value is less than 1.
+         * @version 1.0.0
+         */
+        void setKeepAlive(const int t_idleTime, const int t_interval, const int t_count);
+
+        /**
+         * @brief Sets the sizes of the receive and send buffers (`SO_RCVBUF`, `SO_SNDBUF`).
+         * @details Fixed sizes turn off the automatic tuning of the kernel. The kernel doubles the values for its bookkeeping. A server
+         * sets them on the listening socket as well, so the window scale of accepted connections matches the receive buffer.
+         * @param t_receiveBufferSize The size of the receive buffer in bytes, 0 keeps the automatic tuning.
+         * @param t_sendBufferSize The size of the send buffer in bytes, 0 keeps the automatic tuning.
+         * @throws `InvalidArgumentException` If a size is negative.
+         * @version 1.0.0
+         */
+        void setBufferSizes(const int t_receiveBufferSize, const int t_sendBufferSize);
+
+        /**
+         * @brief Sets the type of service byte of sent packets (`IP_TOS`, `IPV6_TCLASS` for IPv6), for example a DSCP class.
+         * @param t_typeOfService The type of service byte.
+         * @throws `InvalidArgumentException` If `t_typeOfService` is not between 0 and 255.
+         * @version 1.0.0
+         */
+        void setTypeOfService(const int t_typeOfService);
+
+        /**
+         * @brief Checks if the profile corks the socket.
+         * @return true if cork is set, false otherwise.
+         * @version 1.0.0
+         */
+        bool usesCork() const;
+
+        /**
+         * @brief Checks if the profile acknowledges received data right away.
+         * @return true if quick ACK is set, false otherwise.
+         * @version 1.0.0
+         */
+        bool usesQuickAck() const;
+
+        /**
+         * @brief Applies the listener options to a listening socket.
+         * @param t_fileDescriptor The socket, before `listen` is called.
+         * @param t_domain The domain of the socket.
+         * @throws `SystemRuntimeException` If an option could not be set.
+         * @version 1.0.0
+         */
+        void applyToListener(const fileDescriptor t_fileDescriptor, const domain t_domain) const;
+
+        /**
+         * @brief Asks the kernel to send the data of the first write in the SYN of a socket that is connected next
+         * (`TCP_FASTOPEN_CONNECT`).
+         * @details `connect()` then returns right away, and the handshake starts with the first write. Without a cookie for the server
+         * the SYN carries a cookie request and the data follows the handshake as usual.
+         * @param t_fileDescriptor The socket, before `connect()` is called.
+         * @return true if the option is set, false if the platform does not have it.
+         * @version 1.0.0
+         */
+        static bool enableFastOpenConnect(const fileDescriptor t_fileDescriptor);
+
+        /**
+         * @brief Applies the connection options to a connected socket.
+         * @param t_fileDescriptor The socket.
+         * @param t_domain The domain of the socket.
+         * @throws `SystemRuntimeException` If an option could not be set.
+         * @version 1.0.0
+         */
+        void applyToConnection(const fileDescriptor t_fileDescriptor, const domain t_domain) const;
+
+        /**
+         * @brief Sends the partial frame that a corked socket holds back, the socket stays corked.
+         * @param t_fileDescriptor The socket.
+         * @throws `SystemRuntimeException` If the cork could not be toggled.
+         * @version 1.0.0
+         */
+        static void flushCork(const fileDescriptor t_fileDescriptor);
+
+        /**
+         * @brief Puts a socket into quick ACK mode again.
+         * @param t_fileDescriptor The socket.
+         * @version 1.0.0
+         */
+        static void rearmQuickAck(const fileDescriptor t_fileDescriptor);
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef FBNETWORK_TASK_POOL_HPP
+#define FBNETWORK_TASK_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "constants.hpp"
+#include "exceptions.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents a pool of worker threads that run tasks away from the event loops.
+     * @details The `TaskPool` class runs CPU-heavy request handlers, so the thread that polls the events keeps serving the other
+     * clients. Every worker has its own deque: tasks submitted by a worker go to its own deque, tasks from other threads are spread
+     * over the deques in turn. A worker takes the oldest task of its own deque and, when that is empty, steals the newest task of
+     * another worker chosen at random, so long tasks on one worker do not hold up the tasks queued behind them.
+     *
+     * Tasks submitted with the same key run one after another in the order of submission, on whichever worker is free, while tasks
+     * with different keys run in parallel. `Server::dispatch()` uses the connection as the key, so the responses of one client are sent
+     * in the order of its requests.
+     * @note Exceptions thrown by a task are caught and counted, they do not stop the worker. The `TaskPool` class is thread-safe.
+     * @version 1.0.0
+     */
+    class TaskPool
+    {
+    public:
+        typedef std::function<void()> task;
+
+    private:
+        struct Worker
+        {
+            std::mutex       mutex;
+            std::deque<task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Worker>>           m_workers;
+        std::vector<std::thread>                       m_threads;
+        std::mutex                                     m_sleepMutex;
+        std::condition_variable                        m_wakeUp;
+        std::condition_variable                        m_idle;
+        std::mutex                                     m_strandsMutex;
+        std::unordered_map<uint64_t, std::deque<task>> m_strands;
+        std::atomic<size_t>                            m_queuedTasks{0};
+        std::atomic<size_t>                            m_outstandingTasks{0};
+        std::atomic<size_t>                            m_nextWorker{0};
+        std::atomic<uint64_t>                          m_stolenTasks{0};
+        std::atomic<uint64_t>                          m_failedTasks{0};
+        bool                                           m_isRunning = true;
+
+        /**
+         * @brief The loop of a worker thread.
+         * @param t_workerIndex The index of the worker.
+         * @version 1.0.0
+         */
+        void run(const size_t t_workerIndex);
+
+        /**
+         * @brief Puts a task into the deque of a worker and wakes up a sleeping worker.
+         * @details A worker of this pool puts it into its own deque, other threads into the next deque in turn.
+         * @param t_task The task.
+         * @version 1.0.0
+         */
+        void schedule(task &&t_task);
+
+        /**
+         * @brief Takes the oldest task from the deque of a worker.
+         * @param t_workerIndex The index of the worker.
+         * @param t_task The task that was taken.
+         * @return true if there was a task, false otherwise.
+         * @version 1.0.0
+         */
+        bool takeTask(const size_t t_workerIndex, task &t_task);
+
+        /**
+         * @brief Takes the newest task from the deque of another worker, starting at a random one.
+         * @param t_workerIndex The index of the worker that steals.
+         * @param t_seed The random state of the worker.
+         * @param t_task The task that was stolen.
+         * @return true if a task was stolen, false if all deques are empty.
+         * @version 1.0.0
+         */
+        bool stealTask(const size_t t_workerIndex, uint32_t &t_seed, task &t_task);
+
+        /**
+         * @brief Runs a task and marks it as finished.
+         * @param t_task The task.
+         * @version 1.0.0
+         */
+        void execute(task &t_task);
+
+        /**
+         * @brief Runs a task of a key and schedules the next task of the same key.
+         * @param t_key The key.
+         * @param t_task The task.
+         * @version 1.0.0
+         */
+        void runInOrder(const uint64_t t_key, task &t_task);
+
+    public:
+        /**
+         * @brief Constructs a TaskPool object and starts its workers.
+         * @param t_threadCount The number of workers, 0 for one per CPU.
+         * @version 1.0.0
+         */
+        explicit TaskPool(const size_t t_threadCount = 0);
+
+        /**
+         * @brief Destructs a TaskPool object.
+         * @details The tasks that are already submitted still run, then the workers are joined.
+         * @version 1.0.0
+         */
+        ~TaskPool();
+
+        TaskPool(const TaskPool &)            = delete;
+        TaskPool &operator=(const TaskPool &) = delete;
+
+        /**
+         * @brief Submits a task that can run in parallel with every other task.
+         * @param t_task The task.
+         * @throws `InvalidArgumentException` If the task is empty.
+         * @version 1.0.0
+         */
+        void submit(task t_task);
+
+        /**
+         * @brief Submits a task that runs after all tasks submitted earlier with the same key.
+         * @param t_key The key, for example a connection.
+         * @param t_task The task.
+         * @throws `InvalidArgumentException` If the task is empty.
+         * @version 1.0.0
+         */
+        void submit(const uint64_t t_key, task t_task);
+
+        /**
+         * @brief Waits until every submitted task has run.
+         * @version 1.0.0
+         */
+        void waitUntilIdle();
+
+        /**
+         * @brief Retrieves the number of workers.
+         * @return The number of workers.
+         * @version 1.0.0
+         */
+        size_t getThreadCount() const;
+
+        /**
+         * @brief Retrieves how many tasks ran on another worker than the one they were queued on.
+         * @return The number of stolen tasks.
+         * @version 1.0.0
+         */
+        uint64_t getStolenTaskCount() const;
+
+        /**
+         * @brief Retrieves how many tasks threw an exception.
+         * @return The number of failed tasks.
+         * @version 1.0.0
+         */
+        uint64_t getFailedTaskCount() const;
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef FBNETWORK_TIMING_WHEEL_HPP
+#define FBNETWORK_TIMING_WHEEL_HPP
+
+#include "constants.hpp"
+#include "exceptions.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace FBNetwork
+{
+    /**
+     * @brief Tracks deadlines of many keys with O(1) updates.
+     * @details The `TimingWheel` class is a hierarchical timing wheel in the style of the Linux kernel timers. Time is split into ticks of
+     * a fixed resolution, and every level has 64 slots that each cover 64 times the span of a slot of the level below. A deadline is put
+     * into the slot that covers it, and when the wheel reaches a slot of a higher level its timers are moved down to the slots of the level
+     * below. Scheduling, rescheduling and cancelling a timer only link or unlink a node of an intrusive list, so it does not allocate and
+     * does not depend on the number of timers. Timers never expire before their deadline, but up to one resolution after it.
+     * @note The keys are small non-negative integers, like client IDs, and the timers are stored in a vector indexed by the key. The
+     * `TimingWheel` class is not thread-safe.
+     * @version 1.0.0
+     */
+    class TimingWheel
+    {
+    public:
+        static constexpr unsigned SLOT_BITS   = 6;
+        static constexpr unsigned SLOT_COUNT  = 1U << SLOT_BITS;
+        static constexpr unsigned LEVEL_COUNT = 4;
+
+    private:
+        struct Timer
+        {
+            uint64_t expiry   = 0;
+            int      previous = -1;
+            int      next     = -1;
+            int      slot     = -1;
+        };
+
+        std::chrono::steady_clock::time_point m_start;
+        std::chrono::nanoseconds              m_resolution;
+        uint64_t                              m_currentTick = 0;
+        size_t                                m_count       = 0;
+        std::vector<Timer>                    m_timers;
+        std::vector<int>                      m_slots;
+
+        /**
+         * @brief Converts a point in time into a tick of the wheel.
+         * @param t_time The point in time.
+         * @param t_roundUp Whether to round up to the next tick, which is used for deadlines so they never expire early.
+         * @return The tick.
+         * @version 1.0.0
+         */
+        uint64_t getTick(const std::chrono::steady_clock::time_point t_time, const bool t_roundUp) const;
+
+        /**
+         * @brief Links a timer into the slot that covers its expiry relative to the current tick.
+         * @param t_key The key of the timer.
+         * @version 1.0.0
+         */
+        void insert(const int t_key);
+
+        /**
+         * @brief Unlinks a timer from its slot.
+         * @param t_key The key of the timer.
+         * @version 1.0.0
+         */
+        void unlink(const int t_key);
+
+        /**
+         * @brief Moves all timers of a slot of a higher level down to the slots of the lower levels.
+         * @param t_level The level of the slot.
+         * @version 1.0.0
+         */
+        void cascade(const unsigned t_level);
+
+    public:
+        /**
+         * @brief Constructs a TimingWheel object.
+         * @param t_resolution The span of one tick. Deadlines are rounded up to it.
+         * @throws `InvalidArgumentException` If `t_resolution` is not positive.
+         * @version 1.0.0
+         */
+        explicit TimingWheel(const std::chrono::nanoseconds t_resolution = Constants::TIMING_WHEEL_RESOLUTION);
+
+        /**
+         * @brief Schedules the timer of a key, or moves it if it is already scheduled.
+         * @details Deadlines in the past expire on the next call of `advance()`.
+         * @param t_key The key of the timer.
+         * @param t_deadline The point in time at which the timer expires.
+         * @throws `InvalidArgumentException` If `t_key` is negative.
+         * @version 1.0.0
+         */
+        void schedule(const int t_key, const std::chrono::steady_clock::time_point t_deadline);
+
+        /**
+         * @brief Cancels the timer of a key. Does nothing if the timer is not scheduled.
+         * @param t_key The key of the timer.
+         * @version 1.0.0
+         */
+        void cancel(const int t_key);
+
+        /**
+         * @brief Checks whether the timer of a key is scheduled.
+         * @param t_key The key of the timer.
+         * @return true if the timer is scheduled, false otherwise.
+         * @version 1.0.0
+         */
+        bool isScheduled(const int t_key) const;
+
+        /**
+         * @brief Retrieves the number of scheduled timers.
+         * @return The number of scheduled timers.
+         * @version 1.0.0
+         */
+        size_t getCount() const;
+
+        /**
+         * @brief Advances the wheel to a point in time and collects the expired timers.
+         * @details The expired timers are unscheduled before they are returned.
+         * @param t_now The current point in time.
+         * @param t_expiredKeys The vector the keys of the expired timers are appended to.
+         * @return The number of expired timers.
+         * @version 1.0.0
+         */
+        size_t advance(const std::chrono::steady_clock::time_point t_now, std::vector<int> &t_expiredKeys);
+
+        /**
+         * @brief Retrieves the time until the next slot with timers is reached.
+         * @details The result is meant as the timeout of `epoll_wait` or `kevent`. It is a lower bound: a timer on a higher level may
+         * expire later than the returned time, in that case `advance()` moves it down and the next call returns the remaining time.
+         * @param t_now The current point in time.
+         * @return The time in milliseconds, rounded up, or -1 if no timer is scheduled.
+         * @version 1.0.0
+         */
+        int getMillisecondsUntilNextExpiry(const std::chrono::steady_clock::time_point t_now) const;
+    };
+}  // namespace FBNetwork
+
+#endif
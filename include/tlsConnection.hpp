@@ -0,0 +1,175 @@
+#ifndef FBNETWORK_TLS_CONNECTION_HPP
+#define FBNETWORK_TLS_CONNECTION_HPP
+
+#include "constants.hpp"
+#include "exceptions.hpp"
+#include "tlsContext.hpp"
+#include <algorithm>
+#include <errno.h>
+#include <memory>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <poll.h>
+#include <string>
+#include <sys/types.h>
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents the TLS session on one socket.
+     * @details The `TlsConnection` class wraps an OpenSSL `SSL` object on a connected socket. `handshake()`, `read()` and `write()`
+     * behave like the system calls they replace: they return -1 and set `errno`, and `EAGAIN` means that the socket has to become ready
+     * first. `getPollEvents()` tells whether that is for reading or writing, because a TLS read may have to write and the other way
+     * round. `read()` may leave decrypted data behind in OpenSSL that `poll` does not see, `getPendingBytes()` returns its size.
+     * @note The socket is not owned, the `TlsConnection` class does not close it.
+     * @version 1.0.0
+     */
+    class TlsConnection
+    {
+    private:
+        std::shared_ptr<TlsContext> m_context;
+        SSL                        *m_ssl             = nullptr;
+        std::string                 m_sessionKey      = "";
+        std::string                 m_lastError       = "";
+        bool                        m_isHandshakeDone = false;
+        short                       m_pollEvents      = 0;
+
+        /**
+         * @brief Translates the result of an OpenSSL call into the `errno` convention of the system calls.
+         * @param t_result The result of the OpenSSL call.
+         * @return -1, or 0 if the peer closed the connection.
+         * @version 1.0.0
+         */
+        ssize_t handleError(const int t_result);
+
+    public:
+        /**
+         * @brief Constructs a TlsConnection object.
+         * @details A client connection sends `t_serverName` as SNI, checks the certificate of the server against it if the context
+         * verifies the peer, and offers the stored session of `t_sessionKey`.
+         * @param t_context The context of the connection.
+         * @param t_fileDescriptor The connected socket.
+         * @param t_serverName The name of the server, only used by client connections.
+         * @param t_sessionKey The key of the stored session, only used by client connections.
+         * @throws `InvalidArgumentException` If `t_context` is nullptr.
+         * @throws `SystemRuntimeException` If OpenSSL could not create the connection.
+         * @version 1.0.0
+         */
+        TlsConnection(std::shared_ptr<TlsContext> t_context, const fileDescriptor t_fileDescriptor, const std::string &t_serverName = "",
+                      const std::string &t_sessionKey = "");
+
+        /**
+         * @brief Destructs a TlsConnection object.
+         * @version 1.0.0
+         */
+        ~TlsConnection();
+
+        TlsConnection(const TlsConnection &)            = delete;
+        TlsConnection &operator=(const TlsConnection &) = delete;
+
+        /**
+         * @brief Continues the handshake.
+         * @return 1 if the handshake is done, -1 otherwise. `errno` is `EAGAIN` if the socket has to become ready first, `EPROTO` if
+         * the handshake failed, `getLastError()` tells why.
+         * @version 1.0.0
+         */
+        int handshake();
+
+        /**
+         * @brief Reads decrypted data. The handshake is done first if necessary.
+         * @param t_buffer The buffer.
+         * @param t_size The size of the buffer.
+         * @return The number of bytes read, 0 if the peer closed the connection or -1 like `recv`.
+         * @version 1.0.0
+         */
+        ssize_t read(void *t_buffer, const size_t t_size);
+
+        /**
+         * @brief Encrypts and writes data. The handshake is done first if necessary.
+         * @details On `EAGAIN` the call has to be repeated with the same data.
+         * @param t_buffer The data.
+         * @param t_size The size of the data.
+         * @return The number of bytes written or -1 like `send`.
+         * @version 1.0.0
+         */
+        ssize_t write(const void *t_buffer, const size_t t_size);
+
+        /**
+         * @brief Sends a part of a file, encrypted by the kernel.
+         * @details This only works if `usesKernelTlsSend()` is true, then the kernel encrypts the data straight from the page cache.
+         * Otherwise the caller has to read the file and use `write()`.
+         * @param t_fileDescriptor The file, opened for reading.
+         * @param t_offset The offset in the file to start at.
+         * @param t_size The number of bytes to send.
+         * @return The number of bytes sent, 0 if `t_offset` is at the end of the file or -1 like `send`. `errno` is `ENOTSUP` without
+         * kernel TLS.
+         * @version 1.0.0
+         */
+        ssize_t sendFile(const fileDescriptor t_fileDescriptor, const off_t t_offset, const size_t t_size);
+
+        /**
+         * @brief Sends a close notify alert, if the socket accepts it without waiting.
+         * @version 1.0.0
+         */
+        void shutdown();
+
+        /**
+         * @brief Checks if the handshake is done.
+         * @return true if the handshake is done, false otherwise.
+         * @version 1.0.0
+         */
+        bool isHandshakeDone() const;
+
+        /**
+         * @brief Checks if the handshake resumed a session.
+         * @return true if the session was resumed, false otherwise.
+         * @version 1.0.0
+         */
+        bool isSessionReused() const;
+
+        /**
+         * @brief Checks if the kernel encrypts the data that is sent.
+         * @return true if kernel TLS is used for sending, false otherwise.
+         * @version 1.0.0
+         */
+        bool usesKernelTlsSend() const;
+
+        /**
+         * @brief Checks if the kernel decrypts the data that is received.
+         * @return true if kernel TLS is used for receiving, false otherwise.
+         * @version 1.0.0
+         */
+        bool usesKernelTlsReceive() const;
+
+        /**
+         * @brief Retrieves the number of decrypted bytes that can be read without waiting for the socket.
+         * @return The number of bytes.
+         * @version 1.0.0
+         */
+        size_t getPendingBytes() const;
+
+        /**
+         * @brief Retrieves the `poll` events to wait for after `EAGAIN`.
+         * @param t_events The events the caller would wait for without TLS.
+         * @return `POLLIN` or `POLLOUT` after `EAGAIN`, `t_events` otherwise.
+         * @version 1.0.0
+         */
+        short getPollEvents(const short t_events) const;
+
+        /**
+         * @brief Retrieves the negotiated protocol version, like "TLSv1.3".
+         * @return The protocol version.
+         * @version 1.0.0
+         */
+        std::string getProtocolVersion() const;
+
+        /**
+         * @brief Retrieves the OpenSSL error of the last failed call.
+         * @return The error.
+         * @version 1.0.0
+         */
+        std::string getLastError() const;
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef FBNETWORK_TLS_CONTEXT_HPP
+#define FBNETWORK_TLS_CONTEXT_HPP
+
+#include "constants.hpp"
+#include "exceptions.hpp"
+#include <atomic>
+#include <mutex>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <string>
+#include <unordered_map>
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents the side of a TLS connection.
+     * @details The `TlsRole` enum class decides whether a `TlsContext` accepts connections, like a `Server`, or opens them, like a
+     * `Client`.
+     * @version 1.0.0
+     */
+    enum class TlsRole
+    {
+        SERVER,
+        CLIENT
+    };
+
+    /**
+     * @brief Represents the shared TLS configuration of many connections.
+     * @details The `TlsContext` class wraps an OpenSSL `SSL_CTX` with the certificates, the peer verification and the session resumption
+     * of all connections of a `Server` or of any number of `Client` objects. A server context issues session tickets, so returning
+     * clients resume their session without a full handshake. A client context keeps the last session of every server it connected to,
+     * keyed by name and port, and offers it on the next connection. With kernel TLS, the kernel encrypts after the handshake, so data can
+     * be sent without another copy through OpenSSL.
+     * @note OpenSSL writes to the socket without `MSG_NOSIGNAL`, so applications using TLS should ignore `SIGPIPE`. The `TlsContext`
+     * class is thread-safe, it must outlive all connections that use it.
+     * @version 1.0.0
+     */
+    class TlsContext
+    {
+    private:
+        SSL_CTX                                       *m_context         = nullptr;
+        TlsRole                                        m_role            = TlsRole::SERVER;
+        bool                                           m_usesKernelTls   = false;
+        std::atomic<bool>                              m_resumesSessions{true};
+        std::mutex                                     m_sessionsMutex;
+        std::unordered_map<std::string, SSL_SESSION *> m_sessions;
+
+        /**
+         * @brief Stores a new session of a client connection.
+         * @details This function is the new session callback of OpenSSL. With TLS 1.3 the sessions arrive after the handshake, so they
+         * are stored whenever the server sends a ticket.
+         * @param t_ssl The connection that received the session.
+         * @param t_session The session.
+         * @return 1, because the context keeps the reference to the session.
+         * @version 1.0.0
+         */
+        static int storeSession(SSL *t_ssl, SSL_SESSION *t_session);
+
+    public:
+        /**
+         * @brief Retrieves the last OpenSSL errors of the calling thread as a string and clears them.
+         * @return The errors, or "Unknown error." if there are none.
+         * @version 1.0.0
+         */
+        static std::string getCurrentError();
+
+        /**
+         * @brief Constructs a TlsContext object.
+         * @details The context accepts TLS 1.2 and newer. A client context verifies the server against the default trust store of the
+         * system, a server context does not ask for client certificates.
+         * @param t_role Whether the context is used by a server or by clients.
+         * @throws `SystemRuntimeException` If OpenSSL could not create the context.
+         * @version 1.0.0
+         */
+        explicit TlsContext(const TlsRole t_role);
+
+        /**
+         * @brief Destructs a TlsContext object and frees the stored sessions.
+         * @version 1.0.0
+         */
+        ~TlsContext();
+
+        TlsContext(const TlsContext &)            = delete;
+        TlsContext &operator=(const TlsContext &) = delete;
+
+        /**
+         * @brief Loads the certificate chain and the private key.
+         * @details A server context needs a certificate, a client context only if the server asks for one.
+         * @param t_certificateChainPath The path of the PEM file with the certificate, followed by the intermediate certificates.
+         * @param t_privateKeyPath The path of the PEM file with the private key.
+         * @throws `InvalidArgumentException` If a file cannot be loaded or the key does not match the certificate.
+         * @version 1.0.0
+         */
+        void loadCertificate(const std::string &t_certificateChainPath, const std::string &t_privateKeyPath);
+
+        /**
+         * @brief Loads the certificates that are trusted to sign the certificate of the peer.
+         * @param t_certificateAuthorityPath The path of the PEM file with the trusted certificates.
+         * @throws `InvalidArgumentException` If the file cannot be loaded.
+         * @version 1.0.0
+         */
+        void loadTrustedCertificates(const std::string &t_certificateAuthorityPath);
+
+        /**
+         * @brief Sets whether the certificate of the peer is verified.
+         * @details A client context verifies the server by default, a server context with verification asks clients for a certificate
+         * and rejects clients without one.
+         * @param t_verifyPeer Whether the certificate of the peer is verified.
+         * @version 1.0.0
+         */
+        void setVerifyPeer(const bool t_verifyPeer);
+
+        /**
+         * @brief Sets whether sessions are resumed.
+         * @details Resumption is enabled by default. A server context issues session tickets and keeps a session cache for clients
+         * without ticket support, a client context offers the stored session of the server. Without resumption every connection does a
+         * full handshake.
+         * @param t_resumeSessions Whether sessions are resumed.
+         * @version 1.0.0
+         */
+        void setSessionResumption(const bool t_resumeSessions);
+
+        /**
+         * @brief Sets whether the record layer is offloaded to the kernel.
+         * @details Kernel TLS is used if OpenSSL, the kernel and the negotiated cipher support it, otherwise OpenSSL encrypts as usual.
+         * `TlsConnection::usesKernelTlsSend()` tells whether a connection uses it.
+         * @param t_useKernelTls Whether kernel TLS is used.
+         * @version 1.0.0
+         */
+        void setKernelTls(const bool t_useKernelTls);
+
+        /**
+         * @brief Retrieves the role of the context.
+         * @return The role of the context.
+         * @version 1.0.0
+         */
+        TlsRole getRole() const;
+
+        /**
+         * @brief Checks if kernel TLS is requested.
+         * @return true if kernel TLS is requested, false otherwise.
+         * @version 1.0.0
+         */
+        bool usesKernelTls() const;
+
+        /**
+         * @brief Retrieves the OpenSSL context, for settings the `TlsContext` class does not cover, like ALPN or cipher lists.
+         * @return The OpenSSL context.
+         * @version 1.0.0
+         */
+        SSL_CTX *getNativeHandle() const;
+
+        /**
+         * @brief Offers the stored session of a server on a new client connection.
+         * @param t_ssl The new connection.
+         * @param t_sessionKey The name and port of the server.
+         * @version 1.0.0
+         */
+        void resumeSession(SSL *t_ssl, const std::string &t_sessionKey);
+
+        /**
+         * @brief Forgets the stored session of a server, for example after the server rejected it.
+         * @param t_sessionKey The name and port of the server.
+         * @version 1.0.0
+         */
+        void removeSession(const std::string &t_sessionKey);
+    };
+}  // namespace FBNetwork
+
+#endif
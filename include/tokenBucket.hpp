@@ -0,0 +1,107 @@
+#ifndef FBNETWORK_TOKEN_BUCKET_HPP
+#define FBNETWORK_TOKEN_BUCKET_HPP
+
+#include <algorithm>
+#include <chrono>
+#include "exceptions.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents the rate limits of a server.
+     * @details A rate of 0 disables the limit. A burst of 0 allows one second worth of the rate at once. Bytes and messages are limited
+     * per client, where a message is one `EventType::CLIENT_WANTS_TO_SEND_DATA` event. Connections are limited per source IP address.
+     * @version 1.0.0
+     */
+    struct RateLimits
+    {
+        double bytesPerSecond       = 0;
+        double bytesBurst           = 0;
+        double messagesPerSecond    = 0;
+        double messagesBurst        = 0;
+        double connectionsPerSecond = 0;
+        double connectionsBurst     = 0;
+    };
+
+    /**
+     * @brief Represents a token bucket.
+     * @details The `TokenBucket` class refills at a constant rate up to its burst and starts full. `consume()` may take more tokens than
+     * there are, the debt is paid back by the next refills, so a large read is charged completely instead of being refused. A default
+     * constructed bucket has no limit: it never runs out of tokens.
+     * @note The `TokenBucket` class is not thread-safe, the owner has to lock it.
+     * @version 1.0.0
+     */
+    class TokenBucket
+    {
+    private:
+        double                                m_rate   = 0;
+        double                                m_burst  = 0;
+        double                                m_tokens = 0;
+        std::chrono::steady_clock::time_point m_updated;
+
+    public:
+        /**
+         * @brief Constructs a TokenBucket object without a limit.
+         * @version 1.0.0
+         */
+        TokenBucket() = default;
+
+        /**
+         * @brief Constructs a full TokenBucket object.
+         * @param t_rate The tokens added per second.
+         * @param t_burst The maximum number of tokens.
+         * @param t_now The current time.
+         * @throws `InvalidArgumentException` If the rate or the burst is not greater than 0.
+         * @version 1.0.0
+         */
+        TokenBucket(const double t_rate, const double t_burst, const std::chrono::steady_clock::time_point t_now);
+
+        /**
+         * @brief Adds the tokens of the time since the last refill.
+         * @param t_now The current time.
+         * @version 1.0.0
+         */
+        void refill(const std::chrono::steady_clock::time_point t_now);
+
+        /**
+         * @brief Takes tokens, even if there are not enough.
+         * @param t_tokens The number of tokens.
+         * @version 1.0.0
+         */
+        void consume(const double t_tokens);
+
+        /**
+         * @brief Takes tokens if there are enough.
+         * @param t_tokens The number of tokens.
+         * @param t_now The current time.
+         * @return true if the tokens were taken, false otherwise.
+         * @version 1.0.0
+         */
+        bool tryConsume(const double t_tokens, const std::chrono::steady_clock::time_point t_now);
+
+        /**
+         * @brief Retrieves when the bucket holds a number of tokens.
+         * @param t_tokens The number of tokens, at most the burst.
+         * @param t_now The current time, the bucket must be refilled at this time.
+         * @return The time, `t_now` if the tokens are already there.
+         * @version 1.0.0
+         */
+        std::chrono::steady_clock::time_point getTimeOf(const double t_tokens, const std::chrono::steady_clock::time_point t_now) const;
+
+        /**
+         * @brief Retrieves the number of tokens after the last refill, negative while in debt.
+         * @return The number of tokens.
+         * @version 1.0.0
+         */
+        double getTokens() const;
+
+        /**
+         * @brief Checks if the bucket is full.
+         * @return true if the bucket holds its burst, false otherwise.
+         * @version 1.0.0
+         */
+        bool isFull() const;
+    };
+}  // namespace FBNetwork
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef FBNETWORK_UDP_SERVER_HPP
+#define FBNETWORK_UDP_SERVER_HPP
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <string>
+#include <string_view>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+#include "constants.hpp"
+#include "datagramBatch.hpp"
+#include "eventQueue.hpp"
+#include "exceptions.hpp"
+#include "extendedSystem.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents a datagram server.
+     * @details The `UdpServer` class receives datagrams from any number of clients on a non-blocking socket. Datagrams are received and
+     * sent in batches of up to `batchSize` datagrams per `recvmmsg` or `sendmmsg` call. The socket is registered in an `EventQueue`, so
+     * the server can be driven by `getPendingEvents` like `Server`.
+     * @version 1.0.0
+     */
+    class UdpServer
+    {
+    private:
+        fileDescriptor                 m_serverFileDescriptor  = -1;
+        port                           m_port                  = 0;
+        int                            m_domain                = 0;
+        bool                           m_isServerOnline        = false;
+        std::string                    m_localServerSocketPath = "";
+        std::unique_ptr<DatagramBatch> m_batch                 = nullptr;
+        std::shared_ptr<EventQueue>    m_eventQueue            = nullptr;
+
+    public:
+        /**
+         * @brief Constructs an IP domain UdpServer object.
+         * @param t_domain The domain of the server, either `Domain::IPV4_DOMAIN` or `Domain::IPV6_DOMAIN`.
+         * @param t_port The port of the server.
+         * @param t_batchSize The maximum number of datagrams per system call.
+         * @param t_datagramSize The maximum size of a datagram in bytes.
+         * @throws `InvalidDomainException` If `t_domain` is invalid.
+         * @throws `InvalidArgumentException` If `t_batchSize` or `t_datagramSize` is invalid.
+         * @version 1.0.0
+         */
+        UdpServer(const domain t_domain, const port t_port, const size_t t_batchSize = Constants::UDP_BATCH_SIZE,
+                  const size_t t_datagramSize = Constants::UDP_DATAGRAM_SIZE);
+
+        /**
+         * @brief Constructs a Unix domain UdpServer object.
+         * @param t_socketPath The path of the server socket.
+         * @param t_batchSize The maximum number of datagrams per system call.
+         * @param t_datagramSize The maximum size of a datagram in bytes.
+         * @throws `InvalidArgumentException` If `t_socketPath` is empty or too long, or `t_batchSize` or `t_datagramSize` is invalid.
+         * @version 1.0.0
+         */
+        UdpServer(const std::string &t_socketPath, const size_t t_batchSize = Constants::UDP_BATCH_SIZE,
+                  const size_t t_datagramSize = Constants::UDP_DATAGRAM_SIZE);
+
+        /**
+         * @brief Destroys the UdpServer object.
+         * @details This destructor calls `stopServer()`.
+         * @version 1.0.0
+         */
+        ~UdpServer();
+
+        UdpServer(const UdpServer &)            = delete;
+        UdpServer &operator=(const UdpServer &) = delete;
+
+        /**
+         * @brief Starts the server.
+         * @details This function creates the non-blocking socket, binds it and registers it in the event queue.
+         * @throws `ServerCreationException` If an error occurs while creating the server.
+         * @version 1.0.0
+         */
+        void startServer();
+
+        /**
+         * @brief Stops the server.
+         * @details This function closes the socket. Calling it on a stopped server does nothing.
+         * @version 1.0.0
+         */
+        void stopServer();
+
+        /**
+         * @brief Gets the pending events. Waits indefinitely until an event is available.
+         * @details This function returns `EventType::CLIENT_WANTS_TO_SEND_DATA` when datagrams can be received and `EventType::ERROR` if
+         * the socket has an error. The client ID is always -1, the sender of each datagram is stored in `Datagram::address`.
+         * @return The pending events.
+         * @throws `ServerRuntimeException` If polling the event queue failed.
+         * @version 1.0.0
+         */
+        std::vector<eventTuple> getPendingEvents();
+
+        /**
+         * @brief Checks if datagrams are available within the given timeout.
+         * @param t_timeout The timeout value in seconds and microseconds.
+         * @return `true` if datagrams are available within the timeout, `false` otherwise.
+         * @throws `ServerRuntimeException` If an error occurred while checking for data availability.
+         * @version 1.0.0
+         */
+        bool isDataAvailable(const timeval *t_timeout);
+
+        /**
+         * @brief Receives datagrams.
+         * @details This function receives all pending datagrams, up to the batch size, with one `recvmmsg` call. It does not block.
+         * @return The number of received datagrams, 0 if no datagram is pending.
+         * @throws `ServerRuntimeException` If receiving failed.
+         * @version 1.0.0
+         */
+        size_t receiveDatagrams();
+
+        /**
+         * @brief Retrieves a received datagram.
+         * @details The datagram is valid until the next call of `receiveDatagrams`.
+         * @param t_index The index of the datagram.
+         * @return The datagram.
+         * @throws `std::out_of_range` If `t_index` is not less than the number of received datagrams.
+         * @version 1.0.0
+         */
+        const Datagram &getDatagram(const size_t t_index) const;
+
+        /**
+         * @brief Queues a datagram.
+         * @param t_data The payload of the datagram.
+         * @param t_address The destination address.
+         * @param t_addressLength The length of the destination address.
+         * @return `true` if the datagram was queued, `false` if the queue is full and has to be sent first.
+         * @throws `InvalidArgumentException` If `t_data` is larger than the datagram size or `t_address` is `nullptr`.
+         * @version 1.0.0
+         */
+        bool queueDatagram(const std::string_view t_data, const sockaddr *t_address, const socklen_t t_addressLength);
+
+        /**
+         * @brief Queues a reply to a received datagram.
+         * @param t_index The index of the received datagram.
+         * @param t_data The payload of the reply.
+         * @return `true` if the reply was queued, `false` if the queue is full and has to be sent first.
+         * @throws `InvalidArgumentException` If `t_data` is larger than the datagram size.
+         * @throws `std::out_of_range` If `t_index` is not less than the number of received datagrams.
+         * @version 1.0.0
+         */
+        bool queueReply(const size_t t_index, const std::string_view t_data);
+
+        /**
+         * @brief Sends the queued datagrams.
+         * @details This function sends the queued datagrams with as few `sendmmsg` calls as possible. If the socket buffer is full, the
+         * remaining datagrams stay queued and can be sent later.
+         * @return The number of sent datagrams.
+         * @throws `ServerRuntimeException` If sending failed.
+         * @version 1.0.0
+         */
+        size_t sendQueuedDatagrams();
+
+        /**
+         * @brief Enables or disables generic receive offload.
+         * @details With generic receive offload the kernel may coalesce consecutive datagrams of the same flow into one buffer. The size
+         * of the coalesced segments is reported in `Datagram::segmentSize`, so the datagram size should be 65535.
+         * @param t_enable Whether generic receive offload is enabled.
+         * @throws `ServerRuntimeException` If the option is not supported.
+         * @version 1.0.0
+         */
+        void setGenericReceiveOffload(const bool t_enable);
+
+        /**
+         * @brief Sets the segment size for generic segmentation offload.
+         * @details With a segment size set, every queued datagram is split into datagrams of `t_segmentSize` bytes.
+         * @param t_segmentSize The size of the segments in bytes, or 0 to disable segmentation.
+         * @throws `ServerRuntimeException` If the option is not supported.
+         * @version 1.0.0
+         */
+        void setSegmentSize(const uint16_t t_segmentSize);
+
+        /**
+         * @brief Retrieves the file descriptor of the server.
+         * @return The file descriptor of the server.
+         * @version 1.0.0
+         */
+        fileDescriptor getServerFileDescriptor() const;
+
+        /**
+         * @brief Returns the port number used by the server.
+         * @return The port number.
+         * @version 1.0.0
+         */
+        port getPort() const;
+
+        /**
+         * @brief Checks if the server is currently online.
+         * @return `true` if the server is online, `false` otherwise.
+         * @version 1.0.0
+         */
+        bool isServerOnline() const;
+    };
+}  // namespace FBNetwork
+
+#endif
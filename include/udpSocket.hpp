@@ -0,0 +1,193 @@
+#ifndef FBNETWORK_UDP_SOCKET_HPP
+#define FBNETWORK_UDP_SOCKET_HPP
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <memory>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <string>
+#include <string_view>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "constants.hpp"
+#include "datagramBatch.hpp"
+#include "exceptions.hpp"
+#include "extendedSystem.hpp"
+
+namespace FBNetwork
+{
+    /**
+     * @brief Represents a datagram client socket.
+     * @details The `UdpSocket` class sends datagrams to and receives datagrams from a single server. Datagrams are queued in preallocated
+     * buffers and moved with one `sendmmsg` or `recvmmsg` call per batch.
+     * @version 1.0.0
+     */
+    class UdpSocket
+    {
+    private:
+        fileDescriptor                 m_fileDescriptor    = -1;
+        int                            m_domain            = 0;
+        std::string                    m_localSocketPath   = "";
+        timeval                        m_timeout           = Constants::DEFAULT_TIMEOUT;
+        std::unique_ptr<DatagramBatch> m_batch             = nullptr;
+        sockaddr_storage               m_serverAddress     = {};
+        socklen_t                      m_serverAddressSize = 0;
+
+        /**
+         * @brief Creates the socket.
+         * @param t_domain The domain of the socket.
+         * @param t_batchSize The maximum number of datagrams per system call.
+         * @param t_datagramSize The maximum size of a datagram in bytes.
+         * @throws `ClientCreationException` If the socket could not be created.
+         * @version 1.0.0
+         */
+        void createSocket(const domain t_domain, const size_t t_batchSize, const size_t t_datagramSize);
+
+    public:
+        /**
+         * @brief Constructs an IP domain UdpSocket object.
+         * @param t_domain The domain of the socket, either `Domain::IPV4_DOMAIN` or `Domain::IPV6_DOMAIN`.
+         * @param t_batchSize The maximum number of datagrams per system call.
+         * @param t_datagramSize The maximum size of a datagram in bytes.
+         * @throws `InvalidDomainException` If `t_domain` is invalid.
+         * @throws `InvalidArgumentException` If `t_batchSize` or `t_datagramSize` is invalid.
+         * @throws `ClientCreationException` If the socket could not be created.
+         * @version 1.0.0
+         */
+        UdpSocket(const domain t_domain, const size_t t_batchSize = Constants::UDP_BATCH_SIZE,
+                  const size_t t_datagramSize = Constants::UDP_DATAGRAM_SIZE);
+
+        /**
+         * @brief Constructs a Unix domain UdpSocket object.
+         * @details This constructor binds the socket to `t_socketPath`, so the server can send datagrams back.
+         * @param t_socketPath The path the socket is bound to.
+         * @param t_batchSize The maximum number of datagrams per system call.
+         * @param t_datagramSize The maximum size of a datagram in bytes.
+         * @throws `InvalidArgumentException` If `t_socketPath` is empty or too long, or `t_batchSize` or `t_datagramSize` is invalid.
+         * @throws `ClientCreationException` If the socket could not be created or bound.
+         * @version 1.0.0
+         */
+        UdpSocket(const std::string &t_socketPath, const size_t t_batchSize = Constants::UDP_BATCH_SIZE,
+                  const size_t t_datagramSize = Constants::UDP_DATAGRAM_SIZE);
+
+        /**
+         * @brief Destroys the UdpSocket object.
+         * @details This destructor closes the socket and removes the socket file of a Unix domain socket.
+         * @version 1.0.0
+         */
+        ~UdpSocket();
+
+        UdpSocket(const UdpSocket &)            = delete;
+        UdpSocket &operator=(const UdpSocket &) = delete;
+
+        /**
+         * @brief Connects the socket to an IP domain server.
+         * @details This function sets the default destination of the socket. Afterwards only datagrams from the server are received.
+         * @param t_ipAddress The IP address of the server.
+         * @param t_port The port of the server.
+         * @throws `ClientCreationException` If the IP address is invalid or connecting failed.
+         * @version 1.0.0
+         */
+        void connectToServer(const std::string &t_ipAddress, const port t_port);
+
+        /**
+         * @brief Connects the socket to a Unix domain server.
+         * @param t_socketPath The path of the server socket.
+         * @throws `InvalidArgumentException` If `t_socketPath` is empty or too long.
+         * @throws `ClientCreationException` If connecting failed.
+         * @version 1.0.0
+         */
+        void connectToServer(const std::string &t_socketPath);
+
+        /**
+         * @brief Queues a datagram for the server.
+         * @param t_data The payload of the datagram.
+         * @return `true` if the datagram was queued, `false` if the queue is full and has to be sent first.
+         * @throws `InvalidArgumentException` If `t_data` is larger than the datagram size.
+         * @version 1.0.0
+         */
+        bool queueDatagram(const std::string_view t_data);
+
+        /**
+         * @brief Sends the queued datagrams.
+         * @details This function sends all queued datagrams with as few `sendmmsg` calls as possible.
+         * @return The number of sent datagrams.
+         * @throws `ClientRuntimeException` If sending failed.
+         * @version 1.0.0
+         */
+        size_t sendQueuedDatagrams();
+
+        /**
+         * @brief Sends a single datagram to the server.
+         * @param t_data The payload of the datagram.
+         * @throws `InvalidArgumentException` If `t_data` is larger than the datagram size.
+         * @throws `ClientRuntimeException` If sending failed.
+         * @version 1.0.0
+         */
+        void sendData(const std::string_view t_data);
+
+        /**
+         * @brief Receives datagrams.
+         * @details This function waits until a datagram arrives and then receives all pending datagrams, up to the batch size, with one
+         * `recvmmsg` call.
+         * @return The number of received datagrams.
+         * @throws `ClientTimeoutException` If no datagram arrived within the timeout.
+         * @throws `ClientRuntimeException` If receiving failed.
+         * @version 1.0.0
+         */
+        size_t receiveDatagrams();
+
+        /**
+         * @brief Retrieves a received datagram.
+         * @details The datagram is valid until the next call of `receiveDatagrams`.
+         * @param t_index The index of the datagram.
+         * @return The datagram.
+         * @throws `std::out_of_range` If `t_index` is not less than the number of received datagrams.
+         * @version 1.0.0
+         */
+        const Datagram &getDatagram(const size_t t_index) const;
+
+        /**
+         * @brief Enables or disables generic receive offload.
+         * @details With generic receive offload the kernel may coalesce consecutive datagrams of the same flow into one buffer. The size
+         * of the coalesced segments is reported in `Datagram::segmentSize`, so the datagram size should be 65535.
+         * @param t_enable Whether generic receive offload is enabled.
+         * @throws `ClientRuntimeException` If the option is not supported.
+         * @version 1.0.0
+         */
+        void setGenericReceiveOffload(const bool t_enable);
+
+        /**
+         * @brief Sets the segment size for generic segmentation offload.
+         * @details With a segment size set, every queued datagram is split by the kernel or the network card into datagrams of
+         * `t_segmentSize` bytes, so one queued buffer of up to 64 KiB becomes many datagrams on the wire.
+         * @param t_segmentSize The size of the segments in bytes, or 0 to disable segmentation.
+         * @throws `ClientRuntimeException` If the option is not supported.
+         * @version 1.0.0
+         */
+        void setSegmentSize(const uint16_t t_segmentSize);
+
+        /**
+         * @brief Sets the timeout.
+         * @details This function sets the timeout for `receiveDatagrams`.
+         * @param t_timeout The timeout value in seconds and microseconds.
+         * @throws `InvalidArgumentException` If tv_sec is negative, tv_usec is negative or tv_usec is greater than 999999.
+         * @version 1.0.0
+         */
+        void setTimeout(const timeval t_timeout);
+
+        /**
+         * @brief Retrieves the file descriptor of the socket.
+         * @return The file descriptor of the socket.
+         * @version 1.0.0
+         */
+        fileDescriptor getFileDescriptor() const;
+    };
+}  // namespace FBNetwork
+
+#endif
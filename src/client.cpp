@@ -222,7 +222,30 @@ FBNetwork::Client::~Client()
 
 void FBNetwork::Client::connectToServer()
 {
-    if (usesIpv4Domain())
+    openConnection(std::string());
+}
+
+void FBNetwork::Client::connectAndSend(const std::string &t_data)
+{
+    if (t_data.empty())
+    {
+        throw InvalidArgumentException("Invalid data.");
+    }
+    size_t bytesSent = openConnection(t_data);
+    if (bytesSent < t_data.size())
+    {
+        sendData(t_data.substr(bytesSent));
+    }
+}
+
+size_t FBNetwork::Client::openConnection(const std::string &t_firstData)
+{
+    ssize_t bytesSent = 0;
+    if (!usesLocalDomain() && usesHostName())
+    {
+        connectToHost();
+    }
+    else if (usesIpv4Domain())
     {
         std::shared_ptr<sockaddr_in> serverAddressIpv4    = std::make_shared<sockaddr_in>();
         fileDescriptor               serverFileDescriptor = -1;
@@ -242,7 +265,9 @@ void FBNetwork::Client::connectToServer()
         {
             throw ClientCreationException("Creating the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
         }
-        if (connect(serverFileDescriptor, reinterpret_cast<sockaddr *>(serverAddressIpv4.get()), sizeof(sockaddr_in)) == -1)
+        bytesSent = connectSocket(serverFileDescriptor, reinterpret_cast<sockaddr *>(serverAddressIpv4.get()), sizeof(sockaddr_in),
+                                  t_firstData);
+        if (bytesSent == -1)
         {
             throw ClientCreationException("Connecting the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
         }
@@ -268,7 +293,9 @@ void FBNetwork::Client::connectToServer()
         {
             throw ClientCreationException("Creating the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
         }
-        if (connect(serverFileDescriptor, reinterpret_cast<sockaddr *>(serverAddressIpv6.get()), sizeof(*serverAddressIpv6)) == -1)
+        bytesSent = connectSocket(serverFileDescriptor, reinterpret_cast<sockaddr *>(serverAddressIpv6.get()), sizeof(*serverAddressIpv6),
+                                  t_firstData);
+        if (bytesSent == -1)
         {
             throw ClientCreationException("Connecting the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
         }
@@ -280,7 +307,7 @@ void FBNetwork::Client::connectToServer()
         fileDescriptor               serverFileDescriptor = -1;
         *serverAddressLocal                               = {};
         serverAddressLocal->sun_family                    = Domain::LOCAL_DOMAIN;
-        strncpy(serverAddressLocal->sun_path, getServerSocketPath().c_str(), sizeof(getServerSocketPath()));
+        strncpy(serverAddressLocal->sun_path, getServerSocketPath().c_str(), sizeof(serverAddressLocal->sun_path) - 1);
         try
         {
             serverFileDescriptor = socket(Domain::LOCAL_DOMAIN, SOCK_STREAM, 0);
@@ -296,345 +323,903 @@ void FBNetwork::Client::connectToServer()
         }
         setServerAddressLocal(serverAddressLocal);
     }
+    try
+    {
+        m_socketOptions.applyToConnection(getServerFileDescriptor(), getServerDomain());
+    }
+    catch (const SystemRuntimeException &e)
+    {
+        throw ClientCreationException(e.what());
+    }
+    m_residualData.clear();
+    startTls();
+    return static_cast<size_t>(bytesSent);
 }
 
-void FBNetwork::Client::disconnectFromServer()
+ssize_t FBNetwork::Client::connectSocket(const fileDescriptor t_fileDescriptor, const sockaddr *t_address, const socklen_t t_addressLength,
+                                         const std::string &t_firstData)
 {
-    if (close(getServerFileDescriptor()) == -1)
+    if (t_firstData.empty())
     {
-        throw ClientRuntimeException("Closing the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        return connect(t_fileDescriptor, t_address, t_addressLength) == -1 ? -1 : 0;
     }
-}
+    if (SocketOptions::enableFastOpenConnect(t_fileDescriptor))
+    {
 
-void FBNetwork::Client::sendData(const std::string t_data)
-{
-    if (t_data.empty())
+        // The connect only records the address, the SYN leaves with the first write
+
+        return connect(t_fileDescriptor, t_address, t_addressLength) == -1 ? -1 : 0;
+    }
+#ifdef MSG_FASTOPEN
+#ifdef FBNETWORK_WITH_TLS
+    if (m_tlsContext == nullptr)
+#endif
     {
-        throw InvalidArgumentException("Invalid data.");
+        ssize_t bytesSent =
+            sendto(t_fileDescriptor, t_firstData.data(), t_firstData.size(), MSG_FASTOPEN | MSG_NOSIGNAL, t_address, t_addressLength);
+        if (bytesSent != -1 || (errno != EOPNOTSUPP && errno != EINVAL))
+        {
+            return bytesSent;
+        }
     }
-    fileDescriptor serverFileDescriptor = getServerFileDescriptor();
-    int            activity             = 0;
-    timeval        timeout              = getTimeout();
-    time_t         timeoutSeconds       = timeout.tv_sec;
-    suseconds_t    timeoutMicroseconds  = timeout.tv_usec;
-    fd_set         writeSet;
-    FD_ZERO(&writeSet);
-    FD_SET(serverFileDescriptor, &writeSet);
+#endif
 
-    // Wait for the socket to be ready for writing with the specified timeout
+    // Fast open is turned off on this system, so the data follows a normal handshake
 
-    activity = select(serverFileDescriptor + 1, NULL, &writeSet, NULL, &timeout);
+    return connect(t_fileDescriptor, t_address, t_addressLength) == -1 ? -1 : 0;
+}
 
-    int       error = 0;
-    socklen_t len   = sizeof(error);
-    if (getsockopt(serverFileDescriptor, SOL_SOCKET, SO_ERROR, &error, &len) < 0)
+bool FBNetwork::Client::usesHostName() const
+{
+    in6_addr address;
+    return inet_pton(Domain::IPV4_DOMAIN, getServerIpAddress().c_str(), &address) != 1 &&
+           inet_pton(Domain::IPV6_DOMAIN, getServerIpAddress().c_str(), &address) != 1;
+}
+
+void FBNetwork::Client::connectToHost()
+{
+    std::shared_ptr<Resolver> resolver = m_resolver != nullptr ? m_resolver : Resolver::getInstance();
+    addressList               addresses;
+    try
+    {
+        addresses = Resolver::interleaveFamilies(resolver->resolve(getServerIpAddress()), getServerDomain());
+    }
+    catch (const SystemRuntimeException &e)
     {
-        throw ClientRuntimeException("Error getting socket options: " + ExtendedSystem::getCurrentErrnoError());
+        throw ClientCreationException(e.what());
     }
-    if (activity < 0 && errno != EINTR)
+    for (sockaddr_storage &address : addresses)
     {
-        throw ClientRuntimeException("Error during select: " + ExtendedSystem::getCurrentErrnoError());
+        if (address.ss_family == Domain::IPV4_DOMAIN)
+        {
+            reinterpret_cast<sockaddr_in *>(&address)->sin_port = htons(getServerPort());
+        }
+        else
+        {
+            reinterpret_cast<sockaddr_in6 *>(&address)->sin6_port = htons(getServerPort());
+        }
     }
-    else if (activity == 0)
+    size_t         connectedAddress     = 0;
+    fileDescriptor serverFileDescriptor = -1;
+    try
+    {
+        serverFileDescriptor = connectToFirstAddress(addresses, connectedAddress);
+    }
+    catch (const ClientCreationException &e)
     {
 
-        // Timeout reached
+        // The addresses may be stale, the next connect looks the host up again
 
-        throw ClientTimeoutException("Timeout reached while sending data.");
+        resolver->removeFromCache(getServerIpAddress());
+        throw e;
+    }
+    setServerFileDescriptor(serverFileDescriptor);
+    const sockaddr_storage &address = addresses[connectedAddress];
+    setServerDomain(address.ss_family);
+    setUsesIpv4Domain(address.ss_family == Domain::IPV4_DOMAIN);
+    setUsesIpv6Domain(address.ss_family == Domain::IPV6_DOMAIN);
+    if (address.ss_family == Domain::IPV4_DOMAIN)
+    {
+        setServerAddressIpv4(std::make_shared<sockaddr_in>(*reinterpret_cast<const sockaddr_in *>(&address)));
     }
-    if (FD_ISSET(serverFileDescriptor, &writeSet))
+    else
     {
-        while (send(serverFileDescriptor, t_data.c_str(), t_data.size(), MSG_NOSIGNAL) == -1)
+        setServerAddressIpv6(std::make_shared<sockaddr_in6>(*reinterpret_cast<const sockaddr_in6 *>(&address)));
+    }
+}
+
+FBNetwork::fileDescriptor FBNetwork::Client::connectToFirstAddress(const addressList &t_addresses, size_t &t_connectedAddress)
+{
+    std::vector<pollfd>                   attempts;
+    std::vector<size_t>                   attemptAddresses;
+    size_t                                nextAddress = 0;
+    int                                   lastError   = EHOSTUNREACH;
+    timeval                               timeout     = getTimeout();
+    std::chrono::steady_clock::time_point now         = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point nextAttempt = now;
+    std::chrono::steady_clock::time_point deadline =
+        now + std::chrono::seconds(timeout.tv_sec) + std::chrono::microseconds(timeout.tv_usec);
+    while (true)
+    {
+        now = std::chrono::steady_clock::now();
+        if (nextAddress < t_addresses.size() && (now >= nextAttempt || attempts.empty()))
         {
-            if (errno == EINTR)
+            const sockaddr_storage &address       = t_addresses[nextAddress++];
+            socklen_t               addressLength = address.ss_family == Domain::IPV4_DOMAIN ? sizeof(sockaddr_in) : sizeof(sockaddr_in6);
+            fileDescriptor          attempt       = socket(address.ss_family, SOCK_STREAM, 0);
+            if (attempt == -1)
+            {
+                lastError = errno;
+                continue;
+            }
+            fcntl(attempt, F_SETFL, fcntl(attempt, F_GETFL, 0) | O_NONBLOCK);
+            if (connect(attempt, reinterpret_cast<const sockaddr *>(&address), addressLength) == -1 && errno != EINPROGRESS)
+            {
+
+                // Failed right away, for example without a route for the family, so the next address starts without delay
+
+                lastError = errno;
+                close(attempt);
+                continue;
+            }
+            attempts.push_back({attempt, POLLOUT, 0});
+            attemptAddresses.push_back(nextAddress - 1);
+            nextAttempt = now + Constants::CONNECTION_ATTEMPT_DELAY;
+        }
+        if (attempts.empty() || now >= deadline)
+        {
+            for (pollfd &attempt : attempts)
+            {
+                close(attempt.fd);
+            }
+            if (attempts.empty())
+            {
+                errno = lastError;
+                throw ClientCreationException("Connecting the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+            }
+            throw ClientCreationException("Timeout reached while connecting.");
+        }
+        std::chrono::steady_clock::time_point wakeUp = deadline;
+        if (nextAddress < t_addresses.size())
+        {
+            wakeUp = std::min(wakeUp, nextAttempt);
+        }
+        int activity = poll(attempts.data(), attempts.size(),
+                            static_cast<int>(std::max<int64_t>(std::chrono::ceil<std::chrono::milliseconds>(wakeUp - now).count(), 0)));
+        if (activity == -1 && errno != EINTR)
+        {
+            lastError = errno;
+            for (pollfd &attempt : attempts)
+            {
+                close(attempt.fd);
+            }
+            errno = lastError;
+            throw ClientCreationException("Waiting for the connection failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+        for (size_t i = 0; activity > 0 && i < attempts.size();)
+        {
+            if (attempts[i].revents == 0)
             {
+                i++;
                 continue;
             }
-            else
+            int       error       = 0;
+            socklen_t errorLength = sizeof(error);
+            if (getsockopt(attempts[i].fd, SOL_SOCKET, SO_ERROR, &error, &errorLength) == -1)
             {
-                throw ClientRuntimeException("Sending the data failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+                error = errno;
             }
+            if (error == 0)
+            {
+                fileDescriptor serverFileDescriptor = attempts[i].fd;
+                for (pollfd &attempt : attempts)
+                {
+                    if (attempt.fd != serverFileDescriptor)
+                    {
+                        close(attempt.fd);
+                    }
+                }
+                fcntl(serverFileDescriptor, F_SETFL, fcntl(serverFileDescriptor, F_GETFL, 0) & ~O_NONBLOCK);
+                t_connectedAddress = attemptAddresses[i];
+                return serverFileDescriptor;
+            }
+            lastError = error;
+            close(attempts[i].fd);
+            attempts.erase(attempts.begin() + static_cast<std::ptrdiff_t>(i));
+            attemptAddresses.erase(attemptAddresses.begin() + static_cast<std::ptrdiff_t>(i));
+            nextAttempt = now;
         }
     }
-    return;
 }
 
-void FBNetwork::Client::readXData(const ssize_t t_x)
+void FBNetwork::Client::disconnectFromServer()
 {
-    fd_set         readFds;
-    char           buffer[Constants::BUFFER_SIZE] = {0};
-    ssize_t        totalBytesRead                 = 0;
-    ssize_t        bytesRead                      = 0;
-    ssize_t        bytesToAdd                     = 0;
-    std::string    dataBuffer                     = "";
-    int            activity                       = 0;
-    timeval        timeout                        = getTimeout();
-    time_t         timeoutSeconds                 = timeout.tv_sec;
-    suseconds_t    timeoutMicroseconds            = timeout.tv_usec;
-    fileDescriptor serverFileDescriptor           = getServerFileDescriptor();
-    if (serverFileDescriptor == -1)
+#ifdef FBNETWORK_WITH_TLS
+    if (m_tlsConnection != nullptr)
     {
-        throw ClientRuntimeException("Invalid server file descriptor.");
+        m_tlsConnection->shutdown();
+        m_tlsConnection = nullptr;
     }
-    setData(std::string(""));
-    if (t_x <= 0)
+#endif
+    m_residualData.clear();
+    m_compressor = nullptr;
+    if (close(getServerFileDescriptor()) == -1)
     {
-        throw InvalidArgumentException("Invalid number of bytes to read.");
+        throw ClientRuntimeException("Closing the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
     }
-    while (true)
+}
+
+void FBNetwork::Client::sendData(const std::string t_data)
+{
+    std::error_code error;
+    sendData(t_data, error);
+    if (error == NetworkError::INVALID_ARGUMENT)
     {
-        FD_ZERO(&readFds);
-        FD_SET(serverFileDescriptor, &readFds);
+        throw InvalidArgumentException("Invalid data.");
+    }
+    else if (error)
+    {
+        throwError(error, "Sending the data failed.", "Timeout reached while sending data.");
+    }
+}
 
-        // Wait for data to be available with the specified timeout
+void FBNetwork::Client::sendData(const std::string &t_data, std::error_code &t_error)
+{
+    t_error.clear();
+    if (t_data.empty())
+    {
+        t_error = NetworkError::INVALID_ARGUMENT;
+        return;
+    }
+    fileDescriptor serverFileDescriptor = getServerFileDescriptor();
+    size_t         totalBytesWritten    = 0;
+    int            sendTimeout          = getPollTimeout();
+    if (serverFileDescriptor == -1)
+    {
+        t_error = std::make_error_code(std::errc::bad_file_descriptor);
+        return;
+    }
+    while (totalBytesWritten < t_data.size())
+    {
 
-        activity = select(serverFileDescriptor + 1, &readFds, NULL, NULL, &timeout);
+        // Wait for the socket to be ready for writing with the specified timeout
 
-        if (activity < 0 && errno != EINTR)
+        pollfd serverPollFileDescriptor = {serverFileDescriptor, getPollEvents(POLLOUT), 0};
+        int    activity                 = poll(&serverPollFileDescriptor, 1, sendTimeout);
+        if (activity < 0)
         {
-            throw ClientRuntimeException("Error during select: " + ExtendedSystem::getCurrentErrnoError());
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            t_error = std::error_code(errno, std::system_category());
+            return;
         }
         else if (activity == 0)
         {
-
-            // Timeout reached
-
-            throw ClientTimeoutException("Timeout reached while reading data.");
+            t_error = NetworkError::TIMEOUT;
+            return;
         }
+        ssize_t bytesWritten = transmit(t_data.data() + totalBytesWritten, t_data.size() - totalBytesWritten);
+        if (bytesWritten == -1)
+        {
+            if (errno == EINTR || errno == EAGAIN)
+            {
+                continue;
+            }
+            t_error = std::error_code(errno, std::system_category());
+            return;
+        }
+        totalBytesWritten += static_cast<size_t>(bytesWritten);
+    }
+}
 
-        // Check if data is ready to be read
+void FBNetwork::Client::sendFile(const std::string &t_filePath, const off_t t_offset, const size_t t_length)
+{
+    if (t_filePath.empty())
+    {
+        throw InvalidArgumentException("File path cannot be empty.");
+    }
+    fileDescriptor fileFileDescriptor = open(t_filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fileFileDescriptor == -1)
+    {
+        throw SystemRuntimeException("Opening the file failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    try
+    {
+        sendFile(fileFileDescriptor, t_offset, t_length);
+    }
+    catch (...)
+    {
+        close(fileFileDescriptor);
+        throw;
+    }
+    close(fileFileDescriptor);
+}
 
-        if (FD_ISSET(serverFileDescriptor, &readFds))
+void FBNetwork::Client::sendFile(const fileDescriptor t_fileDescriptor, const off_t t_offset, const size_t t_length)
+{
+    struct stat fileStatus;
+    if (fstat(t_fileDescriptor, &fileStatus) == -1)
+    {
+        throw SystemRuntimeException("Retrieving the file size failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    size_t fileSize = static_cast<size_t>(fileStatus.st_size);
+    if (t_offset < 0 || static_cast<size_t>(t_offset) > fileSize || t_length > fileSize - static_cast<size_t>(t_offset))
+    {
+        throw InvalidArgumentException("The range to send is not inside the file.");
+    }
+    fileDescriptor serverFileDescriptor = getServerFileDescriptor();
+    size_t         length               = t_length == 0 ? fileSize - static_cast<size_t>(t_offset) : t_length;
+    size_t         totalBytesWritten    = 0;
+    int            sendTimeout          = getPollTimeout();
+    while (totalBytesWritten < length)
+    {
+        ssize_t bytesWritten =
+            transmitFile(t_fileDescriptor, t_offset + static_cast<off_t>(totalBytesWritten), length - totalBytesWritten);
+        if (bytesWritten == -1)
         {
-            bytesRead = recv(serverFileDescriptor, buffer, sizeof(buffer), 0);
-            if (bytesRead == -1)
+            if (errno == EINTR)
             {
-                if (errno == EINTR)
-                {
-                    continue;
-                }
-                else
-                {
-                    throw ClientRuntimeException("Error reading data: " + ExtendedSystem::getCurrentErrnoError());
-                }
+                continue;
             }
-            else if (bytesRead == 0)
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
             {
-                throw ClientRuntimeException("Connection closed by client.");
+                throw ClientRuntimeException("Sending the file failed.", errno);
             }
-            bytesToAdd = std::min(bytesRead, t_x - totalBytesRead);
-            dataBuffer.append(buffer, bytesToAdd);
-            totalBytesRead += bytesToAdd;
-            memset(buffer, 0, Constants::BUFFER_SIZE);
-            if (totalBytesRead == t_x)
+            pollfd serverPollFileDescriptor = {serverFileDescriptor, getPollEvents(POLLOUT), 0};
+            int    activity                 = poll(&serverPollFileDescriptor, 1, sendTimeout);
+            if (activity == 0)
             {
-                setData(dataBuffer);
-                return;
+                throw ClientTimeoutException("Timeout reached while sending the file.", NetworkError::TIMEOUT);
             }
+            continue;
+        }
+        if (bytesWritten == 0)
+        {
+            throw ClientRuntimeException("The file got shorter while it was sent.");
+        }
+        totalBytesWritten += static_cast<size_t>(bytesWritten);
+    }
+}
 
-            // Reset the timeout
+void FBNetwork::Client::readXData(const ssize_t t_x)
+{
+    std::error_code error;
+    readXData(t_x, error);
+    if (error == NetworkError::INVALID_ARGUMENT)
+    {
+        throw InvalidArgumentException("Invalid number of bytes to read.");
+    }
+    else if (error)
+    {
+        throwError(error, "Reading the data failed.", "Timeout reached while reading data.");
+    }
+}
 
-            timeout.tv_sec  = timeoutSeconds;
-            timeout.tv_usec = timeoutMicroseconds;
+void FBNetwork::Client::readXData(const ssize_t t_x, std::error_code &t_error)
+{
+    char    buffer[Constants::BUFFER_SIZE];
+    ssize_t bytesRead = 0;
+    t_error.clear();
+    setData(std::string(""));
+    if (t_x <= 0)
+    {
+        t_error = NetworkError::INVALID_ARGUMENT;
+        return;
+    }
+    std::string dataBuffer = std::move(m_residualData);
+    m_residualData.clear();
+    while (static_cast<ssize_t>(dataBuffer.length()) < t_x)
+    {
+        bytesRead = receiveChunk(buffer, sizeof(buffer), t_error);
+        if (bytesRead == -1)
+        {
+            m_residualData = std::move(dataBuffer);
+            return;
         }
+        dataBuffer.append(buffer, bytesRead);
     }
+    setData(dataBuffer.substr(0, t_x));
+    m_residualData = dataBuffer.substr(t_x);
 }
 
 void FBNetwork::Client::readTillXData(const std::string t_x)
 {
-    fd_set         readFds;
-    char           buffer[Constants::BUFFER_SIZE] = {0};
-    ssize_t        bytesRead                      = 0;
-    std::string    dataBuffer                     = "";
-    size_t         pos                            = 0;
-    int            activity                       = 0;
-    timeval        timeout                        = getTimeout();
-    time_t         timeoutSeconds                 = timeout.tv_sec;
-    suseconds_t    timeoutMicroseconds            = timeout.tv_usec;
-    fileDescriptor serverFileDescriptor           = getServerFileDescriptor();
-    if (serverFileDescriptor == -1)
+    std::error_code error;
+    readTillXData(t_x, error);
+    if (error == NetworkError::INVALID_ARGUMENT)
     {
-        throw ClientRuntimeException("Invalid server file descriptor.");
+        throw InvalidArgumentException("Invalid string to read.");
     }
-    setData("");
+    else if (error)
+    {
+        throwError(error, "Reading the data failed.", "Timeout reached while reading data.");
+    }
+}
+
+void FBNetwork::Client::readTillXData(const std::string &t_x, std::error_code &t_error)
+{
+    char    buffer[Constants::BUFFER_SIZE];
+    ssize_t bytesRead = 0;
+    size_t  pos       = 0;
+    size_t  searchPos = 0;
+    t_error.clear();
+    setData(std::string(""));
     if (t_x.empty())
     {
-        throw InvalidArgumentException("Invalid string to read.");
+        t_error = NetworkError::INVALID_ARGUMENT;
+        return;
     }
-    while (true)
+    std::string dataBuffer = std::move(m_residualData);
+    m_residualData.clear();
+    while ((pos = dataBuffer.find(t_x, searchPos)) == std::string::npos)
     {
-        FD_ZERO(&readFds);
-        FD_SET(serverFileDescriptor, &readFds);
 
-        // Wait for data to be available with the specified timeout
+        // Only the last bytes can be the start of 'x', so the next search starts there instead of at the beginning
 
-        activity = select(serverFileDescriptor + 1, &readFds, NULL, NULL, &timeout);
+        searchPos = dataBuffer.length() < t_x.length() ? 0 : dataBuffer.length() - t_x.length() + 1;
+        bytesRead = receiveChunk(buffer, sizeof(buffer), t_error);
+        if (bytesRead == -1)
+        {
+            m_residualData = std::move(dataBuffer);
+            return;
+        }
+        dataBuffer.append(buffer, bytesRead);
+    }
+    setData(dataBuffer.substr(0, pos + t_x.length()));
+    m_residualData = dataBuffer.substr(pos + t_x.length());
+}
 
-        if (activity < 0 && errno != EINTR)
+void FBNetwork::Client::readTillXComesYTimesData(const std::string t_x, const int t_y)
+{
+    char            buffer[Constants::BUFFER_SIZE];
+    ssize_t         bytesRead = 0;
+    size_t          pos       = 0;
+    size_t          bufferPos = 0;
+    size_t          searchPos = 0;
+    int             count     = 0;
+    std::error_code error;
+    setData("");
+    if (t_x.empty())
+    {
+        throw InvalidArgumentException("Invalid string to read.");
+    }
+    if (t_y <= 0)
+    {
+        throw InvalidArgumentException("Invalid number of times to read.");
+    }
+    std::string dataBuffer = std::move(m_residualData);
+    m_residualData.clear();
+    while (true)
+    {
+        while ((pos = dataBuffer.find(t_x, std::max(bufferPos, searchPos))) != std::string::npos)
         {
-            throw ClientRuntimeException("Error during select: " + ExtendedSystem::getCurrentErrnoError());
+            count++;
+            bufferPos = pos + t_x.length();
+            if (count == t_y)
+            {
+                setData(dataBuffer.substr(0, bufferPos));
+                m_residualData = dataBuffer.substr(bufferPos);
+                return;
+            }
         }
-        else if (activity == 0)
+        searchPos = dataBuffer.length() < t_x.length() ? 0 : dataBuffer.length() - t_x.length() + 1;
+        bytesRead = receiveChunk(buffer, sizeof(buffer), error);
+        if (bytesRead == -1)
         {
+            m_residualData = std::move(dataBuffer);
+            throwError(error, "Reading the data failed.", "Timeout reached while reading data.");
+        }
+        dataBuffer.append(buffer, bytesRead);
+    }
+}
 
-            // Timeout reached
+bool FBNetwork::Client::isDataAvailable(const std::shared_ptr<timeval> t_timeout)
+{
+    int    result = -1;
+    fd_set readFds;
+    if (!m_residualData.empty())
+    {
+        return true;
+    }
+    FD_ZERO(&readFds);
+    FD_SET(getServerFileDescriptor(), &readFds);
+    timeval timeout = *t_timeout;
+    result          = select(getServerFileDescriptor() + 1, &readFds, NULL, NULL, &timeout);
+    if (result == -1)
+    {
+        throw ClientRuntimeException("Selecting the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    else if (result == 0)
+    {
+        return false;
+    }
+    else
+    {
+        return true;
+    }
+}
+
+void FBNetwork::Client::setResolver(std::shared_ptr<Resolver> t_resolver)
+{
+    m_resolver = t_resolver;
+}
+
+void FBNetwork::Client::setSocketOptions(const SocketOptions &t_socketOptions)
+{
+    m_socketOptions = t_socketOptions;
+}
 
-            throw ClientTimeoutException("Timeout reached while reading data.");
+void FBNetwork::Client::flush()
+{
+    if (!m_socketOptions.usesCork() || usesLocalDomain())
+    {
+        return;
+    }
+    try
+    {
+        SocketOptions::flushCork(getServerFileDescriptor());
+    }
+    catch (const SystemRuntimeException &e)
+    {
+        throw ClientRuntimeException(e.what());
+    }
+}
+
+void FBNetwork::Client::enableCompression(const CompressionOptions &t_options)
+{
+    std::shared_ptr<Compressor> compressor = std::make_shared<Compressor>(t_options);
+    sendData(compressor->createOffer());
+    readXData(static_cast<ssize_t>(Constants::COMPRESSION_FRAME_HEADER_SIZE));
+    std::string header = getData();
+    try
+    {
+        if (!Compressor::isOffer(header))
+        {
+            throw InvalidArgumentException("The server did not answer the compression offer.");
         }
+        readXData(static_cast<ssize_t>(Compressor::getPayloadSize(header)));
+        compressor->acceptAnswer(getData());
+    }
+    catch (InvalidArgumentException &e)
+    {
+        throw ClientRuntimeException(std::string("Negotiating the compression failed. Error: ") + e.what());
+    }
+    m_compressor = compressor;
+    setData("");
+}
 
-        // Check if data is ready to be read
+FBNetwork::CompressionCodec FBNetwork::Client::getCompressionCodec() const
+{
+    return m_compressor == nullptr ? CompressionCodec::NONE : m_compressor->getCodec();
+}
+
+void FBNetwork::Client::sendCompressedData(const std::string &t_data)
+{
+    if (t_data.empty())
+    {
+        throw InvalidArgumentException("Invalid data.");
+    }
+    if (m_compressor == nullptr)
+    {
+        m_compressor = std::make_shared<Compressor>();
+    }
+    std::string frame;
+    try
+    {
+        m_compressor->compress(t_data, frame);
+    }
+    catch (SystemRuntimeException &e)
+    {
+        throw ClientRuntimeException(e.what());
+    }
+    sendData(frame);
+}
 
-        if (FD_ISSET(serverFileDescriptor, &readFds))
+void FBNetwork::Client::readCompressedData()
+{
+    if (m_compressor == nullptr)
+    {
+        m_compressor = std::make_shared<Compressor>();
+    }
+    readXData(static_cast<ssize_t>(Constants::COMPRESSION_FRAME_HEADER_SIZE));
+    std::string header      = getData();
+    size_t      payloadSize = 0;
+    try
+    {
+        payloadSize = Compressor::getPayloadSize(header);
+    }
+    catch (InvalidArgumentException &e)
+    {
+        throw ClientRuntimeException(std::string("Reading the compressed data failed. Error: ") + e.what());
+    }
+    std::string payload;
+    if (payloadSize > 0)
+    {
+        std::error_code error;
+        readXData(static_cast<ssize_t>(payloadSize), error);
+        if (error == NetworkError::TIMEOUT)
         {
-            bytesRead = recv(serverFileDescriptor, buffer, sizeof(buffer), 0);
-            if (bytesRead == -1)
-            {
-                if (errno == EINTR)
-                {
-                    continue;
-                }
-                else
-                {
-                    throw ClientRuntimeException("Error reading data: " + ExtendedSystem::getCurrentErrnoError());
-                }
-            }
-            else if (bytesRead == 0)
-            {
-                throw ClientRuntimeException("Connection closed by client.");
-            }
-            dataBuffer.append(buffer, bytesRead);
-            pos = dataBuffer.find(t_x);
-            if (pos != std::string::npos)
-            {
-                setData(dataBuffer.substr(0, pos + t_x.length()));
-                return;
-            }
-            memset(buffer, 0, Constants::BUFFER_SIZE);
 
-            // Reset the timeout
+            // Put the header back in front of the part of the payload that arrived, so the next call reads the frame from its start
 
-            timeout.tv_sec  = timeoutSeconds;
-            timeout.tv_usec = timeoutMicroseconds;
+            m_residualData.insert(0, header);
         }
+        if (error)
+        {
+            throwError(error, "Reading the compressed data failed.", "Timeout reached while reading the compressed data.");
+        }
+        payload = getData();
     }
+    std::string message;
+    try
+    {
+        m_compressor->decompress(header, payload, message);
+    }
+    catch (InvalidArgumentException &e)
+    {
+        throw ClientRuntimeException(std::string("Reading the compressed data failed. Error: ") + e.what());
+    }
+    catch (SystemRuntimeException &e)
+    {
+        throw ClientRuntimeException(e.what());
+    }
+    setData(message);
 }
 
-void FBNetwork::Client::readTillXComesYTimesData(const std::string t_x, const int t_y)
+void FBNetwork::Client::sendFileDescriptor(const fileDescriptor t_fileDescriptor)
 {
-    fd_set         readFds;
-    char           buffer[Constants::BUFFER_SIZE] = {0};
-    ssize_t        bytesRead                      = 0;
-    std::string    dataBuffer                     = "";
-    size_t         pos                            = 0;
-    size_t         bufferPos                      = 0;
-    int            count                          = 0;
-    int            activity                       = 0;
-    timeval        timeout                        = getTimeout();
-    time_t         timeoutSeconds                 = timeout.tv_sec;
-    suseconds_t    timeoutMicroseconds            = timeout.tv_usec;
-    fileDescriptor serverFileDescriptor           = getServerFileDescriptor();
-    if (serverFileDescriptor == -1)
+    if (!usesLocalDomain())
     {
-        throw ClientRuntimeException("Invalid server file descriptor.");
+        throw InvalidArgumentException("File descriptors can only be sent over the local domain.");
     }
-    setData("");
-    if (t_x.empty())
+    if (t_fileDescriptor < 0)
     {
-        throw InvalidArgumentException("Invalid string to read.");
+        throw InvalidArgumentException("Invalid file descriptor.");
     }
-    if (t_y <= 0)
+
+    // One byte of data is required, an empty message does not carry the control message on every platform
+
+    char  data       = 0;
+    iovec dataVector = {&data, sizeof(data)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fileDescriptor))];
+    memset(control, 0, sizeof(control));
+    msghdr message                 = {};
+    message.msg_iov                = &dataVector;
+    message.msg_iovlen             = 1;
+    message.msg_control            = control;
+    message.msg_controllen         = sizeof(control);
+    cmsghdr *controlMessage        = CMSG_FIRSTHDR(&message);
+    controlMessage->cmsg_level     = SOL_SOCKET;
+    controlMessage->cmsg_type      = SCM_RIGHTS;
+    controlMessage->cmsg_len       = CMSG_LEN(sizeof(fileDescriptor));
+    memcpy(CMSG_DATA(controlMessage), &t_fileDescriptor, sizeof(fileDescriptor));
+    while (sendmsg(getServerFileDescriptor(), &message, 0) == -1)
     {
-        throw InvalidArgumentException("Invalid number of times to read.");
+        if (errno != EINTR)
+        {
+            throw ClientRuntimeException("Sending the file descriptor failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
     }
-    while (true)
+}
+
+void FBNetwork::Client::setTimeout(const timeval t_timeout)
+{
+    if (t_timeout.tv_sec < 0 || t_timeout.tv_usec < 0 || t_timeout.tv_usec > 999999)
     {
-        FD_ZERO(&readFds);
-        FD_SET(serverFileDescriptor, &readFds);
+        throw InvalidArgumentException("Invalid timeout.");
+    }
+    m_timeout = t_timeout;
+}
 
-        // Wait for data to be available with the specified timeout
+void FBNetwork::Client::startTls()
+{
+#ifdef FBNETWORK_WITH_TLS
+    m_tlsConnection = nullptr;
+    if (m_tlsContext == nullptr)
+    {
+        return;
+    }
+    fileDescriptor serverFileDescriptor = getServerFileDescriptor();
+    std::string    sessionKey           = (usesLocalDomain() ? getServerSocketPath() : getServerIpAddress()) + ":" +
+                                   std::to_string(getServerPort()) + "/" + m_tlsServerName;
+    std::shared_ptr<TlsConnection> tlsConnection;
+    try
+    {
+        tlsConnection = std::make_shared<TlsConnection>(m_tlsContext, serverFileDescriptor, m_tlsServerName, sessionKey);
+    }
+    catch (const SystemRuntimeException &e)
+    {
+        throw ClientCreationException(e.what());
+    }
 
-        activity = select(serverFileDescriptor + 1, &readFds, NULL, NULL, &timeout);
+    // The socket is blocking, make it non-blocking for the handshake so the timeout holds
 
-        if (activity < 0 && errno != EINTR)
+    int flags            = fcntl(serverFileDescriptor, F_GETFL, 0);
+    int handshakeTimeout = getPollTimeout();
+    fcntl(serverFileDescriptor, F_SETFL, flags | O_NONBLOCK);
+    while (tlsConnection->handshake() == -1)
+    {
+        if (errno != EAGAIN)
         {
-            throw ClientRuntimeException("Error during select: " + ExtendedSystem::getCurrentErrnoError());
+            fcntl(serverFileDescriptor, F_SETFL, flags);
+            throw ClientCreationException("The TLS handshake failed. Error: " + tlsConnection->getLastError());
         }
-        else if (activity == 0)
+        pollfd serverPollFileDescriptor = {serverFileDescriptor, tlsConnection->getPollEvents(POLLIN), 0};
+        int    activity                 = poll(&serverPollFileDescriptor, 1, handshakeTimeout);
+        if (activity == 0)
         {
+            fcntl(serverFileDescriptor, F_SETFL, flags);
+            throw ClientTimeoutException("Timeout reached during the TLS handshake.");
+        }
+        if (activity == -1 && errno != EINTR)
+        {
+            fcntl(serverFileDescriptor, F_SETFL, flags);
+            throw ClientCreationException("Error during poll: " + ExtendedSystem::getCurrentErrnoError());
+        }
+    }
+    fcntl(serverFileDescriptor, F_SETFL, flags);
+    m_tlsConnection = tlsConnection;
+#endif
+}
 
-            // Timeout reached
+bool FBNetwork::Client::hasBufferedData() const
+{
+#ifdef FBNETWORK_WITH_TLS
+    return m_tlsConnection != nullptr && m_tlsConnection->getPendingBytes() > 0;
+#else
+    return false;
+#endif
+}
 
-            throw ClientTimeoutException("Timeout reached while reading data.");
-        }
+short FBNetwork::Client::getPollEvents(const short t_events) const
+{
+#ifdef FBNETWORK_WITH_TLS
+    if (m_tlsConnection != nullptr)
+    {
+        return m_tlsConnection->getPollEvents(t_events);
+    }
+#endif
+    return t_events;
+}
+
+int FBNetwork::Client::getPollTimeout()
+{
+    timeval timeout = getTimeout();
+    return static_cast<int>(timeout.tv_sec * 1000 + (timeout.tv_usec + 999) / 1000);
+}
+
+ssize_t FBNetwork::Client::receiveChunk(char *t_buffer, const size_t t_size, std::error_code &t_error)
+{
+    fileDescriptor serverFileDescriptor = getServerFileDescriptor();
+    int            readTimeout          = getPollTimeout();
+    if (serverFileDescriptor == -1)
+    {
+        t_error = std::make_error_code(std::errc::bad_file_descriptor);
+        return -1;
+    }
+    while (true)
+    {
 
-        // Check if data is ready to be read
+        // Wait for data with poll, select can not watch file descriptors above FD_SETSIZE. Data that TLS already decrypted is not seen
+        // by poll, so do not wait for it
 
-        if (FD_ISSET(serverFileDescriptor, &readFds))
+        int activity = 1;
+        if (!hasBufferedData())
         {
-            bytesRead = recv(serverFileDescriptor, buffer, sizeof(buffer), 0);
-            if (bytesRead == -1)
-            {
-                if (errno == EINTR)
-                {
-                    continue;
-                }
-                else
-                {
-                    throw ClientRuntimeException("Error reading data: " + ExtendedSystem::getCurrentErrnoError());
-                }
-            }
-            else if (bytesRead == 0)
+            pollfd serverPollFileDescriptor = {serverFileDescriptor, getPollEvents(POLLIN), 0};
+            activity                        = poll(&serverPollFileDescriptor, 1, readTimeout);
+        }
+        if (activity < 0)
+        {
+            if (errno == EINTR)
             {
-                throw ClientRuntimeException("Connection closed by client.");
+                continue;
             }
-            dataBuffer.append(buffer, bytesRead);
-            while ((pos = dataBuffer.find(t_x, bufferPos)) != std::string::npos)
+            t_error = std::error_code(errno, std::system_category());
+            return -1;
+        }
+        else if (activity == 0)
+        {
+            t_error = NetworkError::TIMEOUT;
+            return -1;
+        }
+        ssize_t bytesRead = receive(t_buffer, t_size);
+        if (bytesRead == -1)
+        {
+            if (errno == EINTR || errno == EAGAIN)
             {
-                count++;
-                bufferPos = pos + t_x.length();
-                if (count == t_y)
-                {
-                    setData(dataBuffer.substr(0, bufferPos));
-                    return;
-                }
+                continue;
             }
-            memset(buffer, 0, Constants::BUFFER_SIZE);
-
-            // Reset the timeout
-
-            timeout.tv_sec  = timeoutSeconds;
-            timeout.tv_usec = timeoutMicroseconds;
+            t_error = std::error_code(errno, std::system_category());
+            return -1;
+        }
+        else if (bytesRead == 0)
+        {
+            t_error = NetworkError::CONNECTION_CLOSED;
+            return -1;
         }
+        return bytesRead;
     }
 }
 
-bool FBNetwork::Client::isDataAvailable(const std::shared_ptr<timeval> t_timeout)
+void FBNetwork::Client::throwError(const std::error_code &t_error, const char *t_context, const char *t_timeoutContext)
 {
-    int    result = -1;
-    fd_set readFds;
-    FD_ZERO(&readFds);
-    FD_SET(getServerFileDescriptor(), &readFds);
-    timeval timeout = *t_timeout;
-    result          = select(getServerFileDescriptor() + 1, &readFds, NULL, NULL, &timeout);
-    if (result == -1)
+    if (t_error == NetworkError::INVALID_ARGUMENT)
     {
-        throw ClientRuntimeException("Selecting the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        throw InvalidArgumentException(t_context);
     }
-    else if (result == 0)
+    if (t_error == NetworkError::TIMEOUT)
     {
-        return false;
+        throw ClientTimeoutException(t_timeoutContext, t_error);
     }
-    else
+    throw ClientRuntimeException(t_context, t_error);
+}
+
+ssize_t FBNetwork::Client::receive(char *t_buffer, const size_t t_size)
+{
+    if (m_socketOptions.usesQuickAck())
     {
-        return true;
+        SocketOptions::rearmQuickAck(getServerFileDescriptor());
     }
+#ifdef FBNETWORK_WITH_TLS
+    if (m_tlsConnection != nullptr)
+    {
+        return m_tlsConnection->read(t_buffer, t_size);
+    }
+#endif
+    return recv(getServerFileDescriptor(), t_buffer, t_size, 0);
 }
 
-void FBNetwork::Client::setTimeout(const timeval t_timeout)
+ssize_t FBNetwork::Client::transmit(const char *t_data, const size_t t_size)
 {
-    if (t_timeout.tv_sec < 0 || t_timeout.tv_usec < 0 || t_timeout.tv_usec > 999999)
+#ifdef FBNETWORK_WITH_TLS
+    if (m_tlsConnection != nullptr)
     {
-        throw InvalidArgumentException("Invalid timeout.");
+        return m_tlsConnection->write(t_data, t_size);
     }
-    m_timeout = t_timeout;
-}
\ No newline at end of file
+#endif
+    return send(getServerFileDescriptor(), t_data, t_size, MSG_NOSIGNAL);
+}
+
+ssize_t FBNetwork::Client::transmitFile(const fileDescriptor t_fileDescriptor, const off_t t_offset, const size_t t_size)
+{
+#ifdef FBNETWORK_WITH_TLS
+    if (m_tlsConnection != nullptr)
+    {
+        if (m_tlsConnection->usesKernelTlsSend())
+        {
+            return m_tlsConnection->sendFile(t_fileDescriptor, t_offset, t_size);
+        }
+
+        // OpenSSL encrypts in user space, so the file has to be read
+
+        char    buffer[Constants::TLS_RECORD_SIZE];
+        ssize_t bytesRead = pread(t_fileDescriptor, buffer, std::min(t_size, sizeof(buffer)), t_offset);
+        if (bytesRead <= 0)
+        {
+            return bytesRead;
+        }
+        return m_tlsConnection->write(buffer, static_cast<size_t>(bytesRead));
+    }
+#endif
+    return ExtendedSystem::sendFile(getServerFileDescriptor(), t_fileDescriptor, t_offset, t_size);
+}
+
+#ifdef FBNETWORK_WITH_TLS
+void FBNetwork::Client::setTlsContext(std::shared_ptr<TlsContext> t_tlsContext, const std::string &t_serverName)
+{
+    if (t_tlsContext != nullptr && t_tlsContext->getRole() != TlsRole::CLIENT)
+    {
+        throw InvalidArgumentException("The TLS context of a client must be created with TlsRole::CLIENT.");
+    }
+    m_tlsContext    = t_tlsContext;
+    m_tlsServerName = t_serverName;
+}
+
+std::shared_ptr<FBNetwork::TlsConnection> FBNetwork::Client::getTlsConnection() const
+{
+    return m_tlsConnection;
+}
+#endif
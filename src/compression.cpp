@@ -0,0 +1,440 @@
+#include "../include/compression.hpp"
+#include <algorithm>
+#include <cstring>
+#ifdef FBNETWORK_WITH_LZ4
+#include <lz4.h>
+#endif
+#ifdef FBNETWORK_WITH_ZSTD
+#include <zdict.h>
+#include <zstd.h>
+#include <zstd_errors.h>
+#endif
+
+// The codec byte of a negotiation frame, its payload is the codec of the sender, the mask of its codecs and the ID of its dictionary
+
+static const uint8_t OFFER_CODEC        = 0x80;
+static const size_t  OFFER_PAYLOAD_SIZE = 6;
+
+/**
+ * @brief Reads a 4 byte size in network byte order.
+ * @param t_data The first byte.
+ * @return The size.
+ * @version 1.0.0
+ */
+static uint32_t readSize(const char *t_data)
+{
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(t_data);
+    return static_cast<uint32_t>(data[0]) << 24 | static_cast<uint32_t>(data[1]) << 16 | static_cast<uint32_t>(data[2]) << 8 |
+           static_cast<uint32_t>(data[3]);
+}
+
+/**
+ * @brief Writes a 4 byte size in network byte order.
+ * @param t_data The first byte.
+ * @param t_size The size.
+ * @version 1.0.0
+ */
+static void writeSize(char *t_data, const uint32_t t_size)
+{
+    t_data[0] = static_cast<char>(t_size >> 24);
+    t_data[1] = static_cast<char>(t_size >> 16);
+    t_data[2] = static_cast<char>(t_size >> 8);
+    t_data[3] = static_cast<char>(t_size);
+}
+
+FBNetwork::CompressionDictionary::CompressionDictionary(const std::string &t_content) : m_content(t_content)
+{
+    if (t_content.empty())
+    {
+        throw InvalidArgumentException("The compression dictionary is empty.");
+    }
+#ifdef FBNETWORK_WITH_ZSTD
+    m_id = ZDICT_getDictID(m_content.data(), m_content.size());
+#endif
+
+    // Raw content has no ID of its own, so both sides compare a FNV-1a hash of it
+
+    if (m_id == 0)
+    {
+        m_id = 2166136261u;
+        for (char character : m_content)
+        {
+            m_id = (m_id ^ static_cast<unsigned char>(character)) * 16777619u;
+        }
+        m_id = m_id == 0 ? 1 : m_id;
+    }
+}
+
+FBNetwork::CompressionDictionary::~CompressionDictionary()
+{
+#ifdef FBNETWORK_WITH_ZSTD
+    for (std::pair<const int, ZSTD_CDict *> &compressionDictionary : m_compressionDictionaries)
+    {
+        ZSTD_freeCDict(compressionDictionary.second);
+    }
+    ZSTD_freeDDict(m_decompressionDictionary);
+#endif
+}
+
+std::shared_ptr<const FBNetwork::CompressionDictionary> FBNetwork::CompressionDictionary::train(const std::vector<std::string> &t_samples,
+                                                                                                const size_t                    t_capacity)
+{
+    if (t_samples.empty() || t_capacity == 0)
+    {
+        throw InvalidArgumentException("Training a compression dictionary needs samples and a capacity greater than 0.");
+    }
+#ifdef FBNETWORK_WITH_ZSTD
+    std::string         samples;
+    std::vector<size_t> sampleSizes;
+    sampleSizes.reserve(t_samples.size());
+    for (const std::string &sample : t_samples)
+    {
+        samples += sample;
+        sampleSizes.push_back(sample.size());
+    }
+    std::string content(t_capacity, '\0');
+    size_t      size = ZDICT_trainFromBuffer(&content[0], content.size(), samples.data(), sampleSizes.data(),
+                                             static_cast<unsigned>(sampleSizes.size()));
+    if (ZDICT_isError(size))
+    {
+        throw SystemRuntimeException(std::string("Training the compression dictionary failed. Error: ") + ZDICT_getErrorName(size));
+    }
+    content.resize(size);
+    return std::make_shared<const CompressionDictionary>(content);
+#else
+    throw SystemRuntimeException("Training a compression dictionary needs ZSTD, which was not found at build time.");
+#endif
+}
+
+uint32_t FBNetwork::CompressionDictionary::getId() const
+{
+    return m_id;
+}
+
+const std::string &FBNetwork::CompressionDictionary::getContent() const
+{
+    return m_content;
+}
+
+ZSTD_CDict_s *FBNetwork::CompressionDictionary::getCompressionDictionary(const int t_level) const
+{
+#ifdef FBNETWORK_WITH_ZSTD
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ZSTD_CDict                *&compressionDictionary = m_compressionDictionaries[t_level];
+    if (compressionDictionary == nullptr)
+    {
+        compressionDictionary = ZSTD_createCDict(m_content.data(), m_content.size(), t_level);
+        if (compressionDictionary == nullptr)
+        {
+            m_compressionDictionaries.erase(t_level);
+            throw SystemRuntimeException("Digesting the compression dictionary failed.");
+        }
+    }
+    return compressionDictionary;
+#else
+    (void)t_level;
+    throw SystemRuntimeException("Compression dictionaries need ZSTD, which was not found at build time.");
+#endif
+}
+
+ZSTD_DDict_s *FBNetwork::CompressionDictionary::getDecompressionDictionary() const
+{
+#ifdef FBNETWORK_WITH_ZSTD
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_decompressionDictionary == nullptr)
+    {
+        m_decompressionDictionary = ZSTD_createDDict(m_content.data(), m_content.size());
+        if (m_decompressionDictionary == nullptr)
+        {
+            throw SystemRuntimeException("Digesting the decompression dictionary failed.");
+        }
+    }
+    return m_decompressionDictionary;
+#else
+    throw SystemRuntimeException("Compression dictionaries need ZSTD, which was not found at build time.");
+#endif
+}
+
+FBNetwork::Compressor::Compressor(const CompressionOptions &t_options) : m_options(t_options)
+{
+    if (!isAvailable(t_options.codec))
+    {
+        throw InvalidArgumentException("The compression codec was not found at build time.");
+    }
+}
+
+FBNetwork::Compressor::~Compressor()
+{
+#ifdef FBNETWORK_WITH_ZSTD
+    ZSTD_freeCCtx(m_zstdCompressionContext);
+    ZSTD_freeDCtx(m_zstdDecompressionContext);
+#endif
+}
+
+bool FBNetwork::Compressor::isAvailable(const CompressionCodec t_codec)
+{
+    switch (t_codec)
+    {
+    case CompressionCodec::NONE:
+        return true;
+    case CompressionCodec::LZ4:
+#ifdef FBNETWORK_WITH_LZ4
+        return true;
+#else
+        return false;
+#endif
+    case CompressionCodec::ZSTD:
+#ifdef FBNETWORK_WITH_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+void FBNetwork::Compressor::writeHeader(std::string &t_frame, const uint8_t t_codec, const size_t t_payloadSize, const size_t t_messageSize)
+{
+    t_frame[0] = static_cast<char>(t_codec);
+    writeSize(&t_frame[1], static_cast<uint32_t>(t_payloadSize));
+    writeSize(&t_frame[5], static_cast<uint32_t>(t_messageSize));
+}
+
+size_t FBNetwork::Compressor::compressPayload(const char *t_message, const size_t t_size, std::string &t_frame)
+{
+
+    // The payload gets one byte less than the message, so a message that does not get shorter fails early instead of being stored
+    // larger than it is
+
+    char  *payload  = &t_frame[Constants::COMPRESSION_FRAME_HEADER_SIZE];
+    size_t capacity = t_size - 1;
+
+    // A negotiated level belongs to the configured codec, when the other side chose another one its default is used
+
+    int level = m_codec == m_options.codec ? m_options.level : 0;
+#ifdef FBNETWORK_WITH_LZ4
+    if (m_codec == CompressionCodec::LZ4)
+    {
+        if (m_lz4State.empty())
+        {
+            m_lz4State.resize(static_cast<size_t>(LZ4_sizeofState()));
+        }
+        int size = LZ4_compress_fast_extState(m_lz4State.data(), t_message, payload, static_cast<int>(t_size), static_cast<int>(capacity),
+                                              std::max(1, level));
+        return size > 0 ? static_cast<size_t>(size) : 0;
+    }
+#endif
+#ifdef FBNETWORK_WITH_ZSTD
+    if (m_codec == CompressionCodec::ZSTD)
+    {
+        if (m_zstdCompressionContext == nullptr)
+        {
+            m_zstdCompressionContext = ZSTD_createCCtx();
+            if (m_zstdCompressionContext == nullptr)
+            {
+                throw SystemRuntimeException("Creating the ZSTD compression context failed.");
+            }
+        }
+        level       = level == 0 ? ZSTD_CLEVEL_DEFAULT : level;
+        size_t size = m_usesDictionary ? ZSTD_compress_usingCDict(m_zstdCompressionContext, payload, capacity, t_message, t_size,
+                                                                  m_options.dictionary->getCompressionDictionary(level))
+                                       : ZSTD_compressCCtx(m_zstdCompressionContext, payload, capacity, t_message, t_size, level);
+        if (ZSTD_isError(size))
+        {
+            if (ZSTD_getErrorCode(size) == ZSTD_error_dstSize_tooSmall)
+            {
+                return 0;
+            }
+            throw SystemRuntimeException(std::string("Compressing the message failed. Error: ") + ZSTD_getErrorName(size));
+        }
+        return size;
+    }
+#endif
+    (void)t_message;
+    (void)payload;
+    (void)capacity;
+    (void)level;
+    return 0;
+}
+
+void FBNetwork::Compressor::compress(const std::string &t_message, std::string &t_frame)
+{
+    if (t_message.size() > Constants::COMPRESSION_MAXIMUM_FRAME_SIZE)
+    {
+        throw InvalidArgumentException("The message is larger than the maximum frame size.");
+    }
+    t_frame.resize(Constants::COMPRESSION_FRAME_HEADER_SIZE + t_message.size());
+    size_t payloadSize = 0;
+    if (m_codec != CompressionCodec::NONE && !t_message.empty() && t_message.size() >= m_options.minimumSize)
+    {
+        payloadSize = compressPayload(t_message.data(), t_message.size(), t_frame);
+    }
+    if (payloadSize == 0)
+    {
+        std::memcpy(&t_frame[Constants::COMPRESSION_FRAME_HEADER_SIZE], t_message.data(), t_message.size());
+        writeHeader(t_frame, static_cast<uint8_t>(CompressionCodec::NONE), t_message.size(), t_message.size());
+        return;
+    }
+    t_frame.resize(Constants::COMPRESSION_FRAME_HEADER_SIZE + payloadSize);
+    writeHeader(t_frame, static_cast<uint8_t>(m_codec), payloadSize, t_message.size());
+}
+
+size_t FBNetwork::Compressor::getPayloadSize(const std::string &t_header)
+{
+    if (t_header.size() != Constants::COMPRESSION_FRAME_HEADER_SIZE)
+    {
+        throw InvalidArgumentException("The compression frame header has the wrong size.");
+    }
+    uint8_t codec       = static_cast<uint8_t>(t_header[0]);
+    size_t  payloadSize = readSize(&t_header[1]);
+    size_t  messageSize = readSize(&t_header[5]);
+    if (codec == OFFER_CODEC)
+    {
+        if (payloadSize != OFFER_PAYLOAD_SIZE || messageSize != 0)
+        {
+            throw InvalidArgumentException("The compression negotiation frame is malformed.");
+        }
+        return payloadSize;
+    }
+    if (codec > static_cast<uint8_t>(CompressionCodec::ZSTD))
+    {
+        throw InvalidArgumentException("The compression frame names an unknown codec.");
+    }
+    if (payloadSize > Constants::COMPRESSION_MAXIMUM_FRAME_SIZE || messageSize > Constants::COMPRESSION_MAXIMUM_FRAME_SIZE)
+    {
+        throw InvalidArgumentException("The compression frame is larger than the maximum frame size.");
+    }
+    if (codec == static_cast<uint8_t>(CompressionCodec::NONE) && payloadSize != messageSize)
+    {
+        throw InvalidArgumentException("The uncompressed frame is malformed.");
+    }
+    return payloadSize;
+}
+
+bool FBNetwork::Compressor::isOffer(const std::string &t_header)
+{
+    return !t_header.empty() && static_cast<uint8_t>(t_header[0]) == OFFER_CODEC;
+}
+
+void FBNetwork::Compressor::decompress(const std::string &t_header, const std::string &t_payload, std::string &t_message)
+{
+    size_t payloadSize = getPayloadSize(t_header);
+    if (isOffer(t_header))
+    {
+        throw InvalidArgumentException("The frame is a compression negotiation frame.");
+    }
+    if (t_payload.size() != payloadSize)
+    {
+        throw InvalidArgumentException("The compression frame payload has the wrong size.");
+    }
+    CompressionCodec codec       = static_cast<CompressionCodec>(t_header[0]);
+    size_t           messageSize = readSize(&t_header[5]);
+    if (codec == CompressionCodec::NONE)
+    {
+        t_message.assign(t_payload);
+        return;
+    }
+    if (!isAvailable(codec))
+    {
+        throw InvalidArgumentException("The compression frame names a codec that was not found at build time.");
+    }
+    t_message.resize(messageSize);
+#ifdef FBNETWORK_WITH_LZ4
+    if (codec == CompressionCodec::LZ4)
+    {
+        int size = LZ4_decompress_safe(t_payload.data(), &t_message[0], static_cast<int>(payloadSize), static_cast<int>(messageSize));
+        if (size < 0 || static_cast<size_t>(size) != messageSize)
+        {
+            throw InvalidArgumentException("The LZ4 frame is corrupt.");
+        }
+        return;
+    }
+#endif
+#ifdef FBNETWORK_WITH_ZSTD
+    if (codec == CompressionCodec::ZSTD)
+    {
+        if (m_zstdDecompressionContext == nullptr)
+        {
+            m_zstdDecompressionContext = ZSTD_createDCtx();
+            if (m_zstdDecompressionContext == nullptr)
+            {
+                throw SystemRuntimeException("Creating the ZSTD decompression context failed.");
+            }
+        }
+        size_t size = m_usesDictionary ? ZSTD_decompress_usingDDict(m_zstdDecompressionContext, &t_message[0], messageSize, t_payload.data(),
+                                                                    payloadSize, m_options.dictionary->getDecompressionDictionary())
+                                       : ZSTD_decompressDCtx(m_zstdDecompressionContext, &t_message[0], messageSize, t_payload.data(),
+                                                             payloadSize);
+        if (ZSTD_isError(size) || size != messageSize)
+        {
+            throw InvalidArgumentException("The ZSTD frame is corrupt.");
+        }
+        return;
+    }
+#endif
+}
+
+std::string FBNetwork::Compressor::createOffer() const
+{
+    uint8_t mask = 0;
+    for (CompressionCodec codec : {CompressionCodec::LZ4, CompressionCodec::ZSTD})
+    {
+        mask |= isAvailable(codec) ? static_cast<uint8_t>(1 << static_cast<uint8_t>(codec)) : 0;
+    }
+    std::string frame(Constants::COMPRESSION_FRAME_HEADER_SIZE + OFFER_PAYLOAD_SIZE, '\0');
+    writeHeader(frame, OFFER_CODEC, OFFER_PAYLOAD_SIZE, 0);
+    frame[Constants::COMPRESSION_FRAME_HEADER_SIZE]     = static_cast<char>(m_options.codec);
+    frame[Constants::COMPRESSION_FRAME_HEADER_SIZE + 1] = static_cast<char>(mask);
+    writeSize(&frame[Constants::COMPRESSION_FRAME_HEADER_SIZE + 2], m_options.dictionary ? m_options.dictionary->getId() : 0);
+    return frame;
+}
+
+std::string FBNetwork::Compressor::answerOffer(const std::string &t_payload)
+{
+    if (t_payload.size() != OFFER_PAYLOAD_SIZE)
+    {
+        throw InvalidArgumentException("The compression offer is malformed.");
+    }
+    uint8_t  mask         = static_cast<uint8_t>(t_payload[1]);
+    uint32_t dictionaryId = readSize(&t_payload[2]);
+    bool     isOffered    = (mask & (1 << static_cast<uint8_t>(m_options.codec))) != 0;
+    m_codec               = isOffered ? m_options.codec : CompressionCodec::NONE;
+    m_usesDictionary      = m_codec == CompressionCodec::ZSTD && m_options.dictionary && m_options.dictionary->getId() == dictionaryId;
+
+    // The answer names the chosen codec and, only if it is used, the dictionary, so the other side cannot disagree
+
+    std::string frame = createOffer();
+    frame[Constants::COMPRESSION_FRAME_HEADER_SIZE] = static_cast<char>(m_codec);
+    writeSize(&frame[Constants::COMPRESSION_FRAME_HEADER_SIZE + 2], m_usesDictionary ? dictionaryId : 0);
+    return frame;
+}
+
+void FBNetwork::Compressor::acceptAnswer(const std::string &t_payload)
+{
+    if (t_payload.size() != OFFER_PAYLOAD_SIZE)
+    {
+        throw InvalidArgumentException("The compression answer is malformed.");
+    }
+    uint8_t  codec        = static_cast<uint8_t>(t_payload[0]);
+    uint32_t dictionaryId = readSize(&t_payload[2]);
+    if (codec > static_cast<uint8_t>(CompressionCodec::ZSTD) || !isAvailable(static_cast<CompressionCodec>(codec)))
+    {
+        throw InvalidArgumentException("The compression answer names a codec that was not found at build time.");
+    }
+    if (dictionaryId != 0 && (!m_options.dictionary || m_options.dictionary->getId() != dictionaryId))
+    {
+        throw InvalidArgumentException("The compression answer names a dictionary this side does not have.");
+    }
+    m_codec          = static_cast<CompressionCodec>(codec);
+    m_usesDictionary = dictionaryId != 0;
+}
+
+FBNetwork::CompressionCodec FBNetwork::Compressor::getCodec() const
+{
+    return m_codec;
+}
+
+bool FBNetwork::Compressor::usesDictionary() const
+{
+    return m_usesDictionary;
+}
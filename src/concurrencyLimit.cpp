@@ -0,0 +1,116 @@
+#include "../include/concurrencyLimit.hpp"
+
+FBNetwork::ConcurrencyLimit::ConcurrencyLimit(const ConcurrencyLimitOptions &t_options)
+    : m_options(t_options), m_limit(t_options.initialLimit)
+{
+    if (!(t_options.minimumLimit > 0) || !(t_options.minimumLimit <= t_options.initialLimit) ||
+        !(t_options.initialLimit <= t_options.maximumLimit))
+    {
+        throw InvalidArgumentException("The concurrency limits must be ordered as 0 < minimum <= initial <= maximum.");
+    }
+    if (t_options.latencyThreshold.count() <= 0 || !(t_options.backoffRatio > 0) || !(t_options.backoffRatio < 1) ||
+        !(t_options.tolerance >= 1) || !(t_options.smoothing > 0) || !(t_options.smoothing <= 1) || t_options.longWindow == 0)
+    {
+        throw InvalidArgumentException("An option of the concurrency limit is out of range.");
+    }
+}
+
+void FBNetwork::ConcurrencyLimit::updateAimd(const double t_latency, const bool t_isDropped)
+{
+    if (t_isDropped || t_latency > static_cast<double>(m_options.latencyThreshold.count()))
+    {
+        m_limit = std::max(m_options.minimumLimit, m_limit * m_options.backoffRatio);
+    }
+
+    // Only grow a limit that is used, otherwise a quiet period would leave it far above what the server can handle
+
+    else if (static_cast<double>(m_inFlight) * 2 >= m_limit)
+    {
+        m_limit = std::min(m_options.maximumLimit, m_limit + 1);
+    }
+}
+
+void FBNetwork::ConcurrencyLimit::updateGradient(const double t_latency, const bool t_isDropped)
+{
+    if (t_isDropped)
+    {
+        m_limit = std::max(m_options.minimumLimit, m_limit * 0.9);
+        return;
+    }
+
+    // The long-term latency is an average over the window, the first samples are averaged evenly until the window is filled
+
+    m_longSamples  = std::min(m_longSamples + 1, m_options.longWindow);
+    m_longLatency += (t_latency - m_longLatency) / static_cast<double>(m_longSamples);
+    if (m_longLatency > t_latency * 2)
+    {
+
+        // The latency has dropped for good, so let the average catch up instead of growing the limit for a whole window
+
+        m_longLatency *= 0.95;
+    }
+    double gradient = std::max(0.5, std::min(1.0, m_options.tolerance * m_longLatency / std::max(t_latency, 1.0)));
+    double newLimit = m_limit * gradient + std::sqrt(m_limit);
+    newLimit        = m_limit * (1 - m_options.smoothing) + newLimit * m_options.smoothing;
+
+    // Only grow a limit that is used, like AIMD does, but always let it shrink
+
+    if (newLimit > m_limit && static_cast<double>(m_inFlight) * 2 < m_limit)
+    {
+        return;
+    }
+    m_limit = std::max(m_options.minimumLimit, std::min(m_options.maximumLimit, newLimit));
+}
+
+void FBNetwork::ConcurrencyLimit::acquire()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_inFlight++;
+}
+
+bool FBNetwork::ConcurrencyLimit::tryAcquire()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (static_cast<double>(m_inFlight) >= std::floor(m_limit))
+    {
+        return false;
+    }
+    m_inFlight++;
+    return true;
+}
+
+void FBNetwork::ConcurrencyLimit::release(const std::chrono::nanoseconds t_latency, const bool t_isDropped)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    double                      latency = static_cast<double>(std::max<int64_t>(t_latency.count(), 0));
+    if (m_options.algorithm == ConcurrencyAlgorithm::AIMD)
+    {
+        updateAimd(latency, t_isDropped);
+    }
+    else
+    {
+        updateGradient(latency, t_isDropped);
+    }
+    if (m_inFlight > 0)
+    {
+        m_inFlight--;
+    }
+}
+
+bool FBNetwork::ConcurrencyLimit::isSaturated() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<double>(m_inFlight) >= std::floor(m_limit);
+}
+
+size_t FBNetwork::ConcurrencyLimit::getLimit() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<size_t>(m_limit);
+}
+
+size_t FBNetwork::ConcurrencyLimit::getInFlight() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_inFlight;
+}
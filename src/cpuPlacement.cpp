@@ -0,0 +1,257 @@
+#include "../include/cpuPlacement.hpp"
+#include "../include/extendedSystem.hpp"
+
+size_t FBNetwork::CpuPlacement::getCpuCount()
+{
+    long cpuCount = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpuCount < 1 ? 1 : static_cast<size_t>(cpuCount);
+}
+
+int FBNetwork::CpuPlacement::getCurrentCpu()
+{
+#ifdef __linux__
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+int FBNetwork::CpuPlacement::getNumaNodeOfCpu(const int t_cpu)
+{
+    if (t_cpu < 0)
+    {
+        return -1;
+    }
+
+    // The node of a CPU is the name of the node link in its sysfs directory, machines without NUMA support have none
+
+    DIR *directory = opendir(("/sys/devices/system/cpu/cpu" + std::to_string(t_cpu)).c_str());
+    if (directory == nullptr)
+    {
+        return -1;
+    }
+    int numaNode = -1;
+    for (dirent *entry = readdir(directory); entry != nullptr; entry = readdir(directory))
+    {
+        std::string name = entry->d_name;
+        if (name.size() > 4 && name.compare(0, 4, "node") == 0 && name.find_first_not_of("0123456789", 4) == std::string::npos)
+        {
+            numaNode = std::stoi(name.substr(4));
+            break;
+        }
+    }
+    closedir(directory);
+    if (numaNode == -1 && access("/sys/devices/system/node", F_OK) == -1)
+    {
+        return 0;
+    }
+    return numaNode;
+}
+
+std::vector<int> FBNetwork::CpuPlacement::getCpusOfNumaNode(const int t_numaNode)
+{
+    std::vector<int> cpus;
+    if (t_numaNode < 0)
+    {
+        return cpus;
+    }
+    std::ifstream cpuList("/sys/devices/system/node/node" + std::to_string(t_numaNode) + "/cpulist");
+    std::string   ranges;
+    if (!std::getline(cpuList, ranges))
+    {
+        if (t_numaNode == 0 && access("/sys/devices/system/node", F_OK) == -1)
+        {
+            for (size_t cpu = 0; cpu < getCpuCount(); cpu++)
+            {
+                cpus.push_back(static_cast<int>(cpu));
+            }
+        }
+        return cpus;
+    }
+
+    // The list has the form "0-3,8-11"
+
+    size_t start = 0;
+    while (start < ranges.size())
+    {
+        size_t      end   = ranges.find(',', start);
+        std::string range = ranges.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        size_t      dash  = range.find('-');
+        try
+        {
+            int first = std::stoi(range.substr(0, dash));
+            int last  = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            for (int cpu = first; cpu <= last; cpu++)
+            {
+                cpus.push_back(cpu);
+            }
+        }
+        catch (const std::exception &e)
+        {
+
+            // An empty list, a node with memory only
+
+        }
+        if (end == std::string::npos)
+        {
+            break;
+        }
+        start = end + 1;
+    }
+    return cpus;
+}
+
+FBNetwork::CpuPlacement FBNetwork::CpuPlacement::forLoop(const size_t t_loopIndex, const size_t t_loopCount)
+{
+    if (t_loopIndex >= t_loopCount)
+    {
+        throw InvalidArgumentException("The loop index must be less than the loop count.");
+    }
+    std::vector<int> cpus;
+    for (int numaNode = 0; cpus.size() < getCpuCount() && numaNode < Constants::MAXIMUM_NUMA_NODES; numaNode++)
+    {
+        std::vector<int> nodeCpus = getCpusOfNumaNode(numaNode);
+        cpus.insert(cpus.end(), nodeCpus.begin(), nodeCpus.end());
+    }
+    if (cpus.empty())
+    {
+        for (size_t cpu = 0; cpu < getCpuCount(); cpu++)
+        {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+    }
+    CpuPlacement placement;
+    placement.setCpus({cpus[(t_loopIndex * cpus.size() / t_loopCount) % cpus.size()]});
+    return placement;
+}
+
+void FBNetwork::CpuPlacement::setCpus(const std::vector<int> &t_cpus)
+{
+    for (int cpu : t_cpus)
+    {
+#ifdef __linux__
+        if (cpu < 0 || cpu >= CPU_SETSIZE)
+#else
+        if (cpu < 0)
+#endif
+        {
+            throw InvalidArgumentException("Invalid CPU " + std::to_string(cpu) + ".");
+        }
+    }
+    m_cpus = t_cpus;
+    std::sort(m_cpus.begin(), m_cpus.end());
+    m_cpus.erase(std::unique(m_cpus.begin(), m_cpus.end()), m_cpus.end());
+    m_numaNode = m_cpus.empty() ? -1 : getNumaNodeOfCpu(m_cpus.front());
+    for (int cpu : m_cpus)
+    {
+        if (getNumaNodeOfCpu(cpu) != m_numaNode)
+        {
+            m_numaNode = -1;
+            break;
+        }
+    }
+}
+
+void FBNetwork::CpuPlacement::setNumaNode(const int t_numaNode)
+{
+    std::vector<int> cpus = getCpusOfNumaNode(t_numaNode);
+    if (cpus.empty())
+    {
+        throw InvalidArgumentException("The NUMA node " + std::to_string(t_numaNode) + " has no online CPUs.");
+    }
+    m_cpus     = cpus;
+    m_numaNode = t_numaNode;
+}
+
+void FBNetwork::CpuPlacement::setBindsMemory(const bool t_bindsMemory)
+{
+    m_bindsMemory = t_bindsMemory;
+}
+
+const std::vector<int> &FBNetwork::CpuPlacement::getCpus() const
+{
+    return m_cpus;
+}
+
+int FBNetwork::CpuPlacement::getNumaNode() const
+{
+    return m_numaNode;
+}
+
+bool FBNetwork::CpuPlacement::isEmpty() const
+{
+    return m_cpus.empty();
+}
+
+void FBNetwork::CpuPlacement::applyToCurrentThread() const
+{
+    if (isEmpty())
+    {
+        return;
+    }
+#ifdef __linux__
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu : m_cpus)
+    {
+        CPU_SET(cpu, &cpuSet);
+    }
+    int error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    if (error != 0)
+    {
+        errno = error;
+        throw SystemRuntimeException("Setting the CPU affinity failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    if (!m_bindsMemory || m_numaNode < 0)
+    {
+        return;
+    }
+
+    // Preferred instead of bound, so the thread still gets memory from other nodes when its own node is full. The kernel ignores the
+    // highest bit of the mask length
+
+    std::vector<unsigned long> nodeMask(static_cast<size_t>(m_numaNode) / (8 * sizeof(unsigned long)) + 1, 0);
+    nodeMask[static_cast<size_t>(m_numaNode) / (8 * sizeof(unsigned long))] = 1UL << (m_numaNode % (8 * sizeof(unsigned long)));
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, nodeMask.data(), nodeMask.size() * 8 * sizeof(unsigned long) + 1) == -1 &&
+        errno != ENOSYS)
+    {
+        throw SystemRuntimeException("Setting the memory policy failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+#else
+    errno = ENOTSUP;
+    throw SystemRuntimeException("Setting the CPU affinity failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+#endif
+}
+
+void FBNetwork::CpuPlacement::applyToListener(const fileDescriptor t_fileDescriptor) const
+{
+    if (isEmpty())
+    {
+        return;
+    }
+#ifdef SO_INCOMING_CPU
+    int cpu = m_cpus.front();
+    if (setsockopt(t_fileDescriptor, SOL_SOCKET, SO_INCOMING_CPU, &cpu, sizeof(cpu)) == -1)
+    {
+        throw SystemRuntimeException("Setting SO_INCOMING_CPU failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+#else
+    errno = ENOPROTOOPT;
+    throw SystemRuntimeException("Setting SO_INCOMING_CPU failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+#endif
+}
+
+int FBNetwork::CpuPlacement::getIncomingCpu(const fileDescriptor t_fileDescriptor)
+{
+#ifdef SO_INCOMING_CPU
+    int       cpu       = -1;
+    socklen_t cpuLength = sizeof(cpu);
+    if (getsockopt(t_fileDescriptor, SOL_SOCKET, SO_INCOMING_CPU, &cpu, &cpuLength) == -1)
+    {
+        return -1;
+    }
+    return cpu;
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,192 @@
+#include "../include/datagramBatch.hpp"
+
+FBNetwork::DatagramBatch::DatagramBatch(const size_t t_batchSize, const size_t t_datagramSize)
+{
+    if (t_batchSize == 0)
+    {
+        throw InvalidArgumentException("Batch size must be greater than 0.");
+    }
+    if (t_datagramSize == 0 || t_datagramSize > 65535)
+    {
+        throw InvalidArgumentException("Datagram size must be between 1 and 65535.");
+    }
+    m_batchSize     = t_batchSize;
+    m_datagramSize  = t_datagramSize;
+    m_receiveBuffer = std::make_unique<char[]>(t_batchSize * t_datagramSize);
+    m_sendBuffer    = std::make_unique<char[]>(t_batchSize * t_datagramSize);
+    m_controlBuffer = std::make_unique<char[]>(t_batchSize * CONTROL_SIZE);
+    m_receiveVectors.resize(t_batchSize);
+    m_sendVectors.resize(t_batchSize);
+    m_receiveHeaders.resize(t_batchSize);
+    m_sendHeaders.resize(t_batchSize);
+    m_receiveAddresses.resize(t_batchSize);
+    m_sendAddresses.resize(t_batchSize);
+    m_datagrams.resize(t_batchSize);
+    for (size_t i = 0; i < t_batchSize; i++)
+    {
+        m_receiveVectors[i].iov_base           = m_receiveBuffer.get() + i * t_datagramSize;
+        m_sendVectors[i].iov_base              = m_sendBuffer.get() + i * t_datagramSize;
+        m_receiveHeaders[i]                    = {};
+        m_receiveHeaders[i].msg_hdr.msg_iov    = &m_receiveVectors[i];
+        m_receiveHeaders[i].msg_hdr.msg_iovlen = 1;
+        m_receiveHeaders[i].msg_hdr.msg_name   = &m_receiveAddresses[i];
+        m_sendHeaders[i]                       = {};
+        m_sendHeaders[i].msg_hdr.msg_iov       = &m_sendVectors[i];
+        m_sendHeaders[i].msg_hdr.msg_iovlen    = 1;
+    }
+}
+
+int FBNetwork::DatagramBatch::receive(const fileDescriptor t_fileDescriptor, const int t_flags)
+{
+    m_receivedCount = 0;
+
+    // The kernel overwrites the lengths, so they have to be reset before every call
+
+    for (size_t i = 0; i < m_batchSize; i++)
+    {
+        m_receiveVectors[i].iov_len                = m_datagramSize;
+        m_receiveHeaders[i].msg_hdr.msg_namelen    = sizeof(sockaddr_storage);
+        m_receiveHeaders[i].msg_hdr.msg_control    = m_controlBuffer.get() + i * CONTROL_SIZE;
+        m_receiveHeaders[i].msg_hdr.msg_controllen = CONTROL_SIZE;
+        m_receiveHeaders[i].msg_hdr.msg_flags      = 0;
+    }
+#ifdef __APPLE__
+    int count = 0;
+    while (static_cast<size_t>(count) < m_batchSize)
+    {
+        int     flags  = count == 0 ? t_flags : MSG_DONTWAIT;
+        ssize_t result = recvmsg(t_fileDescriptor, &m_receiveHeaders[count].msg_hdr, flags);
+        if (result == -1)
+        {
+            if (count == 0)
+            {
+                return -1;
+            }
+            break;
+        }
+        m_receiveHeaders[count].msg_len = static_cast<unsigned int>(result);
+        count++;
+    }
+#else
+    int count = recvmmsg(t_fileDescriptor, m_receiveHeaders.data(), static_cast<unsigned int>(m_batchSize), t_flags, nullptr);
+    if (count == -1)
+    {
+        return -1;
+    }
+#endif
+    for (int i = 0; i < count; i++)
+    {
+        msghdr   &header       = m_receiveHeaders[i].msg_hdr;
+        Datagram &datagram     = m_datagrams[i];
+        datagram.data          = std::string_view(static_cast<const char *>(m_receiveVectors[i].iov_base), m_receiveHeaders[i].msg_len);
+        datagram.address       = reinterpret_cast<const sockaddr *>(&m_receiveAddresses[i]);
+        datagram.addressLength = header.msg_namelen;
+        datagram.segmentSize   = 0;
+        datagram.isTruncated   = (header.msg_flags & MSG_TRUNC) != 0;
+#ifdef UDP_GRO
+        for (cmsghdr *control = CMSG_FIRSTHDR(&header); control != nullptr; control = CMSG_NXTHDR(&header, control))
+        {
+            if (control->cmsg_level == SOL_UDP && control->cmsg_type == UDP_GRO)
+            {
+                int segmentSize = 0;
+                memcpy(&segmentSize, CMSG_DATA(control), sizeof(segmentSize));
+                datagram.segmentSize = static_cast<uint16_t>(segmentSize);
+            }
+        }
+#endif
+    }
+    m_receivedCount = static_cast<size_t>(count);
+    return count;
+}
+
+size_t FBNetwork::DatagramBatch::getReceivedCount() const
+{
+    return m_receivedCount;
+}
+
+const FBNetwork::Datagram &FBNetwork::DatagramBatch::getDatagram(const size_t t_index) const
+{
+    if (t_index >= m_receivedCount)
+    {
+        throw std::out_of_range("Datagram index out of range.");
+    }
+    return m_datagrams[t_index];
+}
+
+bool FBNetwork::DatagramBatch::queue(const std::string_view t_data, const sockaddr *t_address, const socklen_t t_addressLength)
+{
+    if (t_data.length() > m_datagramSize)
+    {
+        throw InvalidArgumentException("Datagram is larger than the datagram size.");
+    }
+    if (m_queuedCount == m_batchSize)
+    {
+        return false;
+    }
+    msghdr &header = m_sendHeaders[m_queuedCount].msg_hdr;
+    memcpy(m_sendVectors[m_queuedCount].iov_base, t_data.data(), t_data.length());
+    m_sendVectors[m_queuedCount].iov_len = t_data.length();
+    if (t_address != nullptr)
+    {
+        memcpy(&m_sendAddresses[m_queuedCount], t_address, std::min<size_t>(t_addressLength, sizeof(sockaddr_storage)));
+        header.msg_name    = &m_sendAddresses[m_queuedCount];
+        header.msg_namelen = t_addressLength;
+    }
+    else
+    {
+        header.msg_name    = nullptr;
+        header.msg_namelen = 0;
+    }
+    m_queuedCount++;
+    return true;
+}
+
+size_t FBNetwork::DatagramBatch::getPendingCount() const
+{
+    return m_queuedCount - m_sentCount;
+}
+
+int FBNetwork::DatagramBatch::send(const fileDescriptor t_fileDescriptor)
+{
+    int sent = 0;
+    while (m_sentCount < m_queuedCount)
+    {
+#ifdef __APPLE__
+        int result = sendmsg(t_fileDescriptor, &m_sendHeaders[m_sentCount].msg_hdr, 0) == -1 ? -1 : 1;
+#else
+        int result = sendmmsg(t_fileDescriptor, &m_sendHeaders[m_sentCount], static_cast<unsigned int>(m_queuedCount - m_sentCount), 0);
+#endif
+        if (result == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (sent == 0)
+            {
+                return -1;
+            }
+            return sent;
+        }
+        m_sentCount += static_cast<size_t>(result);
+        sent += result;
+    }
+    clearQueue();
+    return sent;
+}
+
+void FBNetwork::DatagramBatch::clearQueue()
+{
+    m_queuedCount = 0;
+    m_sentCount   = 0;
+}
+
+size_t FBNetwork::DatagramBatch::getBatchSize() const
+{
+    return m_batchSize;
+}
+
+size_t FBNetwork::DatagramBatch::getDatagramSize() const
+{
+    return m_datagramSize;
+}
@@ -33,7 +33,7 @@ FBNetwork::EventQueue::EventQueue()
     fileDescriptor eventQueueFileDescriptor = kqueue();
     if (eventQueueFileDescriptor < 0)
     {
-        throw ServerRuntimeException("Creating the event queue file descriptor failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        throw ServerRuntimeException("Creating the event queue file descriptor failed.", errno);
     }
     setEventQueueFileDescriptor(eventQueueFileDescriptor);
 }
@@ -57,7 +57,7 @@ void FBNetwork::EventQueue::setServer(const FBNetwork::fileDescriptor t_serverFi
     EV_SET(&event, getServerFileDescriptor(), EVFILT_READ, EV_ADD | EV_ENABLE, 0, 0, NULL);
     if (kevent(getEventQueueFileDescriptor(), &event, 1, NULL, 0, NULL) == -1)
     {
-        throw ServerRuntimeException("Adding the event to the event queue failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        throw ServerRuntimeException("Adding the event to the event queue failed.", errno);
     }
 }
 
@@ -67,7 +67,7 @@ void FBNetwork::EventQueue::addClient(const FBNetwork::fileDescriptor t_clientFi
     EV_SET(&event, t_clientFileDescriptor, EVFILT_READ, EV_ADD | EV_ENABLE, 0, 0, NULL);
     if (kevent(getEventQueueFileDescriptor(), &event, 1, NULL, 0, NULL) == -1)
     {
-        throw ServerRuntimeException("Adding the event to the event queue failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        throw ServerRuntimeException("Adding the event to the event queue failed.", errno);
     }
 }
 
@@ -78,7 +78,28 @@ void FBNetwork::EventQueue::removeClient(const FBNetwork::fileDescriptor t_clien
 
     if (kevent(getEventQueueFileDescriptor(), &event, 1, NULL, 0, NULL) == -1 && errno != ENOENT)
     {
-        throw ServerRuntimeException("Removing the event from the event queue failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        throw ServerRuntimeException("Removing the event from the event queue failed.", errno);
+    }
+}
+
+void FBNetwork::EventQueue::setInterest(const FBNetwork::fileDescriptor t_clientFileDescriptor, const bool t_isReadable,
+                                        const bool t_isWritable)
+{
+    if (t_clientFileDescriptor < 0)
+    {
+        throw InvalidArgumentException("The client file descriptor is invalid.");
+    }
+    event readEvent;
+    EV_SET(&readEvent, t_clientFileDescriptor, EVFILT_READ, t_isReadable ? EV_ENABLE : EV_DISABLE, 0, 0, NULL);
+    if (kevent(getEventQueueFileDescriptor(), &readEvent, 1, NULL, 0, NULL) == -1)
+    {
+        throw ServerRuntimeException("Changing the event in the event queue failed.", errno);
+    }
+    event writeEvent;
+    EV_SET(&writeEvent, t_clientFileDescriptor, EVFILT_WRITE, t_isWritable ? EV_ADD | EV_ENABLE : EV_DELETE, 0, 0, NULL);
+    if (kevent(getEventQueueFileDescriptor(), &writeEvent, 1, NULL, 0, NULL) == -1 && (t_isWritable || errno != ENOENT))
+    {
+        throw ServerRuntimeException("Changing the event in the event queue failed.", errno);
     }
 }
 
@@ -88,7 +109,7 @@ FBNetwork::eventList FBNetwork::EventQueue::pollEvents()
     int                count = kevent(getEventQueueFileDescriptor(), NULL, 0, events.data(), Constants::MAX_EVENTS, NULL);
     if (count == Constants::EVENT_ERROR)
     {
-        throw ServerRuntimeException("Retrieving the events from the event queue failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        throw ServerRuntimeException("Retrieving the events from the event queue failed.", errno);
     }
     events.resize(count);
     std::vector<event> filteredEvents;
@@ -107,8 +128,7 @@ FBNetwork::eventList FBNetwork::EventQueue::pollEvents()
             {
                 if (errno != ENOENT)
                 {
-                    throw ServerRuntimeException("Removing the event from the event queue failed. Error: " +
-                                                 ExtendedSystem::getCurrentErrnoError());
+                    throw ServerRuntimeException("Removing the event from the event queue failed.", errno);
                 }
             }
         }
@@ -117,20 +137,37 @@ FBNetwork::eventList FBNetwork::EventQueue::pollEvents()
 }
 
 FBNetwork::eventList FBNetwork::EventQueue::pollEvents(const int t_timeout)
+{
+    std::error_code error;
+    eventList       events = pollEvents(t_timeout, error);
+    if (error == NetworkError::TIMEOUT)
+    {
+        throw ServerTimeoutException("Timeout reached while polling the events.", error);
+    }
+    else if (error)
+    {
+        throw ServerRuntimeException("Retrieving the events from the event queue failed.", error);
+    }
+    return events;
+}
+
+FBNetwork::eventList FBNetwork::EventQueue::pollEvents(const int t_timeout, std::error_code &t_error)
 {
     struct timespec timeout;
     timeout.tv_sec  = t_timeout / 1000;
     timeout.tv_nsec = (t_timeout % 1000) * 1000000;
-    std::vector<event> events;
-    events.reserve(Constants::MAX_EVENTS);
-    int count = kevent(getEventQueueFileDescriptor(), NULL, 0, events.data(), Constants::MAX_EVENTS, &timeout);
+    std::vector<event> events(Constants::MAX_EVENTS);
+    int                count = kevent(getEventQueueFileDescriptor(), NULL, 0, events.data(), Constants::MAX_EVENTS, &timeout);
+    t_error.clear();
     if (count == Constants::EVENT_ERROR)
     {
-        throw ServerRuntimeException("Retrieving the events from the event queue failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        t_error = std::error_code(errno, std::system_category());
+        return eventList();
     }
     else if (count == 0)
     {
-        throw ServerTimeoutException("Timeout reached while polling the events.");
+        t_error = NetworkError::TIMEOUT;
+        return eventList();
     }
     events.resize(count);
     std::vector<event> filteredEvents;
@@ -149,8 +186,8 @@ FBNetwork::eventList FBNetwork::EventQueue::pollEvents(const int t_timeout)
             {
                 if (errno != ENOENT)
                 {
-                    throw ServerRuntimeException("Removing the event from the event queue failed. Error: " +
-                                                 ExtendedSystem::getCurrentErrnoError());
+                    t_error = std::error_code(errno, std::system_category());
+                    return eventList();
                 }
             }
         }
@@ -163,6 +200,16 @@ bool FBNetwork::EventQueue::hasAnError(event *t_event) const
     return (t_event->flags & EV_ERROR) != 0;
 }
 
+bool FBNetwork::EventQueue::isReadableEvent(const event *t_event) const
+{
+    return t_event->filter == EVFILT_READ;
+}
+
+bool FBNetwork::EventQueue::isWritableEvent(const event *t_event) const
+{
+    return t_event->filter == EVFILT_WRITE;
+}
+
 bool FBNetwork::EventQueue::isServerEvent(event *t_event) const
 {
     return t_event->ident == getServerFileDescriptor();
@@ -185,7 +232,7 @@ FBNetwork::EventQueue::EventQueue()
     fileDescriptor eventQueueFileDescriptor = epoll_create1(0);
     if (eventQueueFileDescriptor < 0)
     {
-        throw ServerRuntimeException("Creating the event queue file descriptor failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        throw ServerRuntimeException("Creating the event queue file descriptor failed.", errno);
     }
     setEventQueueFileDescriptor(eventQueueFileDescriptor);
 }
@@ -210,7 +257,7 @@ void FBNetwork::EventQueue::setServer(const FBNetwork::fileDescriptor t_serverFi
     event.data.fd = getServerFileDescriptor();
     if (epoll_ctl(getEventQueueFileDescriptor(), EPOLL_CTL_ADD, getServerFileDescriptor(), &event) == -1)
     {
-        throw ServerRuntimeException("Adding the event to the event queue failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        throw ServerRuntimeException("Adding the event to the event queue failed.", errno);
     }
 }
 
@@ -221,7 +268,7 @@ void FBNetwork::EventQueue::addClient(const FBNetwork::fileDescriptor t_clientFi
     event.data.fd = t_clientFileDescriptor;
     if (epoll_ctl(getEventQueueFileDescriptor(), EPOLL_CTL_ADD, t_clientFileDescriptor, &event) == -1)
     {
-        throw ServerRuntimeException("Adding the event to the event queue failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        throw ServerRuntimeException("Adding the event to the event queue failed.", errno);
     }
 }
 
@@ -229,7 +276,23 @@ void FBNetwork::EventQueue::removeClient(const FBNetwork::fileDescriptor t_clien
 {
     if (epoll_ctl(getEventQueueFileDescriptor(), EPOLL_CTL_DEL, t_clientFileDescriptor, NULL) == -1 && errno != ENOENT)
     {
-        throw ServerRuntimeException("Removing the event from the event queue failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        throw ServerRuntimeException("Removing the event from the event queue failed.", errno);
+    }
+}
+
+void FBNetwork::EventQueue::setInterest(const FBNetwork::fileDescriptor t_clientFileDescriptor, const bool t_isReadable,
+                                        const bool t_isWritable)
+{
+    if (t_clientFileDescriptor < 0)
+    {
+        throw InvalidArgumentException("The client file descriptor is invalid.");
+    }
+    event event;
+    event.events  = (t_isReadable ? static_cast<uint32_t>(EPOLLIN) : 0U) | (t_isWritable ? static_cast<uint32_t>(EPOLLOUT) : 0U);
+    event.data.fd = t_clientFileDescriptor;
+    if (epoll_ctl(getEventQueueFileDescriptor(), EPOLL_CTL_MOD, t_clientFileDescriptor, &event) == -1)
+    {
+        throw ServerRuntimeException("Changing the event in the event queue failed.", errno);
     }
 }
 
@@ -239,12 +302,15 @@ FBNetwork::eventList FBNetwork::EventQueue::pollEvents()
     {
         std::vector<event> events(Constants::MAX_EVENTS);
         int                count = epoll_wait(getEventQueueFileDescriptor(), events.data(), Constants::MAX_EVENTS, -1);
-        events.resize(count);
         if (count == Constants::EVENT_ERROR)
         {
-            throw ServerRuntimeException("Retrieving the events from the event queue failed. Error: " +
-                                         ExtendedSystem::getCurrentErrnoError());
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw ServerRuntimeException("Retrieving the events from the event queue failed.", errno);
         }
+        events.resize(count);
         std::vector<event> filteredEvents;
         for (const auto &ev : events)
         {
@@ -261,8 +327,7 @@ FBNetwork::eventList FBNetwork::EventQueue::pollEvents()
                 {
                     if (errno != ENOENT)
                     {
-                        throw ServerRuntimeException("Removing the event from the event queue failed. Error: " +
-                                                     ExtendedSystem::getCurrentErrnoError());
+                        throw ServerRuntimeException("Removing the event from the event queue failed.", errno);
                     }
                 }
             }
@@ -276,36 +341,56 @@ FBNetwork::eventList FBNetwork::EventQueue::pollEvents()
 
 FBNetwork::eventList FBNetwork::EventQueue::pollEvents(const int t_timeout)
 {
-    auto               now     = std::chrono::steady_clock::now();
-    auto               timeout = now + std::chrono::milliseconds(t_timeout);
-    std::vector<event> filteredEvents;
-    while (now < timeout)
+    std::error_code error;
+    eventList       events = pollEvents(t_timeout, error);
+    if (error == NetworkError::TIMEOUT)
+    {
+        throw ServerTimeoutException("Timeout reached while polling the events.", error);
+    }
+    else if (error)
+    {
+        throw ServerRuntimeException("Retrieving the events from the event queue failed.", error);
+    }
+    return events;
+}
+
+FBNetwork::eventList FBNetwork::EventQueue::pollEvents(const int t_timeout, std::error_code &t_error)
+{
+    auto now     = std::chrono::steady_clock::now();
+    auto timeout = now + std::chrono::milliseconds(t_timeout);
+    t_error.clear();
+    while (true)
     {
         std::vector<event> events(Constants::MAX_EVENTS);
-        int                remainingTime = std::chrono::duration_cast<std::chrono::milliseconds>(timeout - now).count();
-        int                count         = epoll_wait(getEventQueueFileDescriptor(), events.data(), Constants::MAX_EVENTS, remainingTime);
-        events.resize(count);
-        if (count == Constants::EVENT_ERROR)
+        int remainingTime = static_cast<int>(std::max<int64_t>(std::chrono::ceil<std::chrono::milliseconds>(timeout - now).count(), 0));
+        int count         = epoll_wait(getEventQueueFileDescriptor(), events.data(), Constants::MAX_EVENTS, remainingTime);
+        if (count == Constants::EVENT_ERROR && errno != EINTR)
         {
-            throw ServerRuntimeException("Retrieving the events from the event queue failed. Error: " +
-                                         ExtendedSystem::getCurrentErrnoError());
+            t_error = std::error_code(errno, std::system_category());
+            return eventList();
         }
-        else if (remainingTime <= 0)
-        {
-            return events;
-        }
-        filteredEvents.clear();
-        filteredEvents.reserve(count);
-        for (const auto &ev : events)
+
+        // Return as soon as there are events, and only wait for the time that is left after an interrupt
+
+        std::vector<event> filteredEvents;
+        for (int i = 0; i < count; i++)
         {
-            if (ev.data.fd > 2)
+            if (events[i].data.fd > 2)
             {
-                filteredEvents.push_back(ev);
+                filteredEvents.push_back(events[i]);
             }
         }
+        if (!filteredEvents.empty())
+        {
+            return filteredEvents;
+        }
         now = std::chrono::steady_clock::now();
+        if (now >= timeout)
+        {
+            t_error = NetworkError::TIMEOUT;
+            return eventList();
+        }
     }
-    return filteredEvents;
 }
 
 bool FBNetwork::EventQueue::hasAnError(event *t_event) const
@@ -313,6 +398,16 @@ bool FBNetwork::EventQueue::hasAnError(event *t_event) const
     return (t_event->events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP)) != 0;
 }
 
+bool FBNetwork::EventQueue::isReadableEvent(const event *t_event) const
+{
+    return (t_event->events & EPOLLIN) != 0;
+}
+
+bool FBNetwork::EventQueue::isWritableEvent(const event *t_event) const
+{
+    return (t_event->events & EPOLLOUT) != 0;
+}
+
 bool FBNetwork::EventQueue::isServerEvent(event *t_event) const
 {
     return t_event->data.fd == m_serverFileDescriptor;
@@ -1,29 +1,128 @@
 #include "../include/extendedSystem.hpp"
 
+const FBNetwork::ExtendedSystem::TimeCache &FBNetwork::ExtendedSystem::getTimeCache()
+{
+    thread_local TimeCache timeCache;
+    time_t                 now = std::time(nullptr);
+    if (now != timeCache.second)
+    {
+        for (size_t i = 0; i < TIME_FORMAT_COUNT; i++)
+        {
+            timeCache.lengths[i] = formatTime(now, static_cast<TimeFormat>(i), timeCache.texts[i], TIME_BUFFER_SIZE);
+        }
+        timeCache.second = now;
+    }
+    return timeCache;
+}
+
+void FBNetwork::ExtendedSystem::writeDigits(char *t_buffer, int t_value, const int t_digits)
+{
+    for (int i = t_digits - 1; i >= 0; i--)
+    {
+        t_buffer[i] = static_cast<char>('0' + t_value % 10);
+        t_value /= 10;
+    }
+}
+
 std::string FBNetwork::ExtendedSystem::getCurrentDate()
 {
-    time_t     t        = std::time(nullptr);
-    struct tm *tmStruct = std::localtime(&t);
-    if (tmStruct == nullptr)
+    std::string_view date = getCachedTime(TimeFormat::DATE);
+    if (date.empty())
     {
         throw SystemRuntimeException("Could not get current date.");
     }
-    std::stringstream strStream;
-    strStream << std::put_time(tmStruct, "%d.%m.%Y");
-    return strStream.str();
+    return std::string(date);
 }
 
 std::string FBNetwork::ExtendedSystem::getCurrentTime()
 {
-    time_t     t        = std::time(nullptr);
-    struct tm *tmStruct = std::localtime(&t);
-    if (tmStruct == nullptr)
+    std::string_view time = getCachedTime(TimeFormat::TIME);
+    if (time.empty())
     {
         throw SystemRuntimeException("Could not get current time.");
     }
-    std::stringstream strStream;
-    strStream << std::put_time(tmStruct, "%H:%M:%S");
-    return strStream.str();
+    return std::string(time);
+}
+
+std::string_view FBNetwork::ExtendedSystem::getCachedTime(const TimeFormat t_format)
+{
+    const TimeCache &timeCache = getTimeCache();
+    size_t           index     = static_cast<size_t>(t_format);
+    return std::string_view(timeCache.texts[index], timeCache.lengths[index]);
+}
+
+size_t FBNetwork::ExtendedSystem::formatTime(const time_t t_time, const TimeFormat t_format, char *t_buffer, const size_t t_size)
+{
+    static const char *const WEEKDAYS[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    static const char *const MONTHS[]   = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    struct tm                tmStruct;
+    size_t                   length = 0;
+    if (t_buffer == nullptr)
+    {
+        return 0;
+    }
+    if ((t_format == TimeFormat::HTTP ? gmtime_r(&t_time, &tmStruct) : localtime_r(&t_time, &tmStruct)) == nullptr ||
+        tmStruct.tm_year + 1900 < 0 || tmStruct.tm_year + 1900 > 9999)
+    {
+        return 0;
+    }
+    switch (t_format)
+    {
+    case TimeFormat::DATE:
+        length = 10;
+        break;
+    case TimeFormat::TIME:
+        length = 8;
+        break;
+    case TimeFormat::DATE_TIME:
+        length = 19;
+        break;
+    case TimeFormat::HTTP:
+        length = 29;
+        break;
+    }
+    if (t_size <= length)
+    {
+        return 0;
+    }
+
+    // Layouts: "dd.mm.yyyy", "hh:mm:ss", "dd.mm.yyyy hh:mm:ss" and "Www, dd Mmm yyyy hh:mm:ss GMT"
+
+    char *time = t_buffer;
+    if (t_format == TimeFormat::DATE || t_format == TimeFormat::DATE_TIME)
+    {
+        writeDigits(t_buffer, tmStruct.tm_mday, 2);
+        t_buffer[2] = '.';
+        writeDigits(t_buffer + 3, tmStruct.tm_mon + 1, 2);
+        t_buffer[5] = '.';
+        writeDigits(t_buffer + 6, tmStruct.tm_year + 1900, 4);
+        t_buffer[10] = ' ';
+        time         = t_buffer + 11;
+    }
+    else if (t_format == TimeFormat::HTTP)
+    {
+        memcpy(t_buffer, WEEKDAYS[tmStruct.tm_wday], 3);
+        t_buffer[3] = ',';
+        t_buffer[4] = ' ';
+        writeDigits(t_buffer + 5, tmStruct.tm_mday, 2);
+        t_buffer[7] = ' ';
+        memcpy(t_buffer + 8, MONTHS[tmStruct.tm_mon], 3);
+        t_buffer[11] = ' ';
+        writeDigits(t_buffer + 12, tmStruct.tm_year + 1900, 4);
+        t_buffer[16] = ' ';
+        memcpy(t_buffer + 25, " GMT", 4);
+        time = t_buffer + 17;
+    }
+    if (t_format != TimeFormat::DATE)
+    {
+        writeDigits(time, tmStruct.tm_hour, 2);
+        time[2] = ':';
+        writeDigits(time + 3, tmStruct.tm_min, 2);
+        time[5] = ':';
+        writeDigits(time + 6, tmStruct.tm_sec, 2);
+    }
+    t_buffer[length] = '\0';
+    return length;
 }
 
 std::string FBNetwork::ExtendedSystem::getCurrentErrnoError()
@@ -56,21 +155,11 @@ std::string FBNetwork::ExtendedSystem::getCurrentErrnoError()
 
 std::string FBNetwork::ExtendedSystem::readFromFile(const std::string &t_filePath)
 {
-    if (t_filePath.empty())
-    {
-        throw InvalidArgumentException("File path cannot be empty.");
-    }
-    std::ifstream file(t_filePath);
-    if (!file.is_open())
-    {
-        throw SystemRuntimeException("File could not be opened.");
-    }
-    std::string fileData;
-    size_t      fileSize = getFileSize(t_filePath);
-    fileData.resize(fileSize);
-    file.read(&fileData[0], fileSize);
-    file.close();
-    return fileData;
+
+    // MappedFile throws InvalidArgumentException and SystemRuntimeException
+
+    MappedFile file(t_filePath);
+    return std::string(file.getView());
 }
 
 size_t FBNetwork::ExtendedSystem::getFileSize(const std::string &t_filePath)
@@ -79,15 +168,12 @@ size_t FBNetwork::ExtendedSystem::getFileSize(const std::string &t_filePath)
     {
         throw InvalidArgumentException("File path cannot be empty.");
     }
-    std::ifstream file(t_filePath);
-    if (!file.is_open())
+    struct stat fileStatus;
+    if (stat(t_filePath.c_str(), &fileStatus) == -1)
     {
-        throw SystemRuntimeException("File could not be opened.");
+        throw SystemRuntimeException("Retrieving the file size failed. Error: " + getCurrentErrnoError());
     }
-    file.seekg(0, file.end);
-    size_t fileSize = file.tellg();
-    file.close();
-    return fileSize;
+    return static_cast<size_t>(fileStatus.st_size);
 }
 
 void FBNetwork::ExtendedSystem::writeToFile(const std::string &t_filePath, const std::string &t_data)
@@ -109,30 +195,48 @@ void FBNetwork::ExtendedSystem::writeToFile(const std::string &t_filePath, const
     file.close();
 }
 
+ssize_t FBNetwork::ExtendedSystem::sendFile(const fileDescriptor t_socketFileDescriptor, const fileDescriptor t_fileFileDescriptor,
+                                            const off_t t_offset, const size_t t_size)
+{
+    size_t size = std::min(t_size, Constants::SENDFILE_CHUNK_SIZE);
+
+    // Handle sendfile based on the platform
+
+#ifdef __APPLE__
+    off_t length = static_cast<off_t>(size);
+    int   result = sendfile(t_fileFileDescriptor, t_socketFileDescriptor, t_offset, &length, nullptr, 0);
+    if (result == -1 && (length == 0 || (errno != EAGAIN && errno != EINTR)))
+    {
+        return -1;
+    }
+    return static_cast<ssize_t>(length);
+#elif __linux__
+    off_t offset = t_offset;
+    return sendfile(t_socketFileDescriptor, t_fileFileDescriptor, &offset, size);
+#endif
+}
+
 void FBNetwork::ExtendedSystem::loadEnvironmentVariables(const std::string &t_filePath)
 {
-    std::string fileData = "";
 
-    // readFromFile throws InvalidArgumentException and SystemRuntimeException
+    // MappedFile throws InvalidArgumentException and SystemRuntimeException
 
-    fileData = readFromFile(t_filePath);
-    std::istringstream fileStream(fileData);
-    std::string        line;
-    while (std::getline(fileStream, line))
+    MappedFile       file(t_filePath);
+    std::string_view fileData = file.getView();
+    while (!fileData.empty())
     {
-        std::istringstream lineStream(line);
-        std::string        key;
-        std::string        value;
-        std::getline(lineStream, key, '=');
-        if (key.empty())
-        {
-            continue;
-        }
-        std::getline(lineStream, value);
-        if (value.empty())
+        size_t           lineEnd = fileData.find('\n');
+        std::string_view line    = fileData.substr(0, lineEnd);
+        size_t           equals  = line.find('=');
+        std::string_view key     = line.substr(0, equals);
+        fileData.remove_prefix(lineEnd == std::string_view::npos ? fileData.size() : lineEnd + 1);
+        if (key.empty() || equals == std::string_view::npos || equals + 1 == line.size())
         {
             continue;
         }
-        setenv(key.c_str(), value.c_str(), 1);
+
+        // setenv needs null-terminated strings, so only the key and the value are copied
+
+        setenv(std::string(key).c_str(), std::string(line.substr(equals + 1)).c_str(), 1);
     }
-}
\ No newline at end of file
+}
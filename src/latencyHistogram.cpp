@@ -0,0 +1,98 @@
+#include "../include/latencyHistogram.hpp"
+
+uint64_t FBNetwork::HistogramSnapshot::getPercentile(const double t_percentile) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    double   percentile = std::min(std::max(t_percentile, 0.0), 100.0);
+    uint64_t rank       = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count) + 0.5);
+    uint64_t seen       = 0;
+    rank                = std::max<uint64_t>(rank, 1);
+    for (size_t i = 0; i < buckets.size(); i++)
+    {
+        seen += buckets[i];
+        if (seen >= rank)
+        {
+            return std::min(LatencyHistogram::getBucketUpperBound(i), maximum);
+        }
+    }
+    return maximum;
+}
+
+double FBNetwork::HistogramSnapshot::getMean() const
+{
+    if (count == 0)
+    {
+        return 0.0;
+    }
+    return static_cast<double>(sum) / static_cast<double>(count);
+}
+
+uint64_t FBNetwork::HistogramSnapshot::getCountAtOrBelow(const uint64_t t_bound) const
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < buckets.size() && LatencyHistogram::getBucketUpperBound(i) <= t_bound; i++)
+    {
+        result += buckets[i];
+    }
+    return result;
+}
+
+size_t FBNetwork::LatencyHistogram::getBucketIndex(const uint64_t t_nanoseconds)
+{
+    if (t_nanoseconds < SUB_BUCKET_COUNT)
+    {
+        return static_cast<size_t>(t_nanoseconds);
+    }
+    unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(t_nanoseconds));
+    if (exponent > MAXIMUM_EXPONENT)
+    {
+        return BUCKET_COUNT - 1;
+    }
+    size_t subBucket = static_cast<size_t>((t_nanoseconds >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1));
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + subBucket;
+}
+
+uint64_t FBNetwork::LatencyHistogram::getBucketUpperBound(const size_t t_index)
+{
+    if (t_index < SUB_BUCKET_COUNT)
+    {
+        return t_index;
+    }
+    unsigned exponent  = static_cast<unsigned>(t_index / SUB_BUCKET_COUNT) + SUB_BUCKET_BITS - 1;
+    uint64_t subBucket = t_index % SUB_BUCKET_COUNT;
+    uint64_t width     = 1ULL << (exponent - SUB_BUCKET_BITS);
+    return ((SUB_BUCKET_COUNT + subBucket) << (exponent - SUB_BUCKET_BITS)) + width - 1;
+}
+
+void FBNetwork::LatencyHistogram::record(const uint64_t t_nanoseconds)
+{
+    m_buckets[getBucketIndex(t_nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(t_nanoseconds, std::memory_order_relaxed);
+    uint64_t maximum = m_maximum.load(std::memory_order_relaxed);
+    while (t_nanoseconds > maximum && !m_maximum.compare_exchange_weak(maximum, t_nanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+void FBNetwork::LatencyHistogram::recordSince(const std::chrono::steady_clock::time_point t_start)
+{
+    auto elapsed = std::chrono::steady_clock::now() - t_start;
+    record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+}
+
+FBNetwork::HistogramSnapshot FBNetwork::LatencyHistogram::getSnapshot() const
+{
+    HistogramSnapshot snapshot;
+    snapshot.buckets.resize(BUCKET_COUNT);
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+        snapshot.count += snapshot.buckets[i];
+    }
+    snapshot.sum     = m_sum.load(std::memory_order_relaxed);
+    snapshot.maximum = m_maximum.load(std::memory_order_relaxed);
+    return snapshot;
+}
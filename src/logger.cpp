@@ -0,0 +1,328 @@
+#include "../include/logger.hpp"
+
+bool FBNetwork::Logger::isWithinRateLimit(const LogLevel t_level)
+{
+    RateLimit &rateLimit = m_rateLimits[static_cast<int>(t_level)];
+    int64_t    interval  = rateLimit.interval.load(std::memory_order_relaxed);
+    if (interval == 0)
+    {
+        return true;
+    }
+    int64_t now                    = std::chrono::steady_clock::now().time_since_epoch().count();
+    int64_t tolerance              = rateLimit.tolerance.load(std::memory_order_relaxed);
+    int64_t theoreticalArrivalTime = rateLimit.theoreticalArrivalTime.load(std::memory_order_relaxed);
+    int64_t nextArrivalTime        = 0;
+    do
+    {
+        int64_t earliest = std::max(theoreticalArrivalTime, now);
+        if (earliest - now > tolerance)
+        {
+            return false;
+        }
+        nextArrivalTime = earliest + interval;
+    } while (!rateLimit.theoreticalArrivalTime.compare_exchange_weak(theoreticalArrivalTime, nextArrivalTime, std::memory_order_relaxed));
+    return true;
+}
+
+void FBNetwork::Logger::drain()
+{
+    std::string           buffer         = "";
+    std::vector<LogEntry> entries;
+    time_t                prefixSecond   = -1;
+    char                  prefix[32]     = {0};
+    size_t                prefixLength   = 0;
+    bool                  hasDatabase    = false;
+    size_t                mask           = m_capacity - 1;
+    uint64_t              writtenEntries = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        hasDatabase = m_databaseWriter != nullptr;
+    }
+    while (true)
+    {
+        Slot    &slot     = m_slots[m_dequeuePosition & mask];
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != m_dequeuePosition + 1)
+        {
+            break;
+        }
+        time_t second      = static_cast<time_t>(slot.time / 1000000000);
+        int    millisecond = static_cast<int>((slot.time / 1000000) % 1000);
+
+        // Entries are drained in order, so the date only has to be formatted when the second changes
+
+        if (second != prefixSecond)
+        {
+            prefixLength = ExtendedSystem::formatTime(second, TimeFormat::DATE_TIME, prefix, sizeof(prefix));
+            prefixSecond = second;
+        }
+        const std::string &levelName = getLevelName(slot.level);
+        char               milliseconds[8];
+        snprintf(milliseconds, sizeof(milliseconds), ".%03d", millisecond);
+        buffer += '[';
+        buffer.append(prefix, prefixLength);
+        buffer += milliseconds;
+        buffer += "] [";
+        buffer += levelName;
+        buffer += "] [";
+        buffer.append(slot.source, slot.sourceLength);
+        buffer += "] ";
+        buffer.append(slot.message, slot.messageLength);
+        buffer += '\n';
+        if (hasDatabase)
+        {
+            entries.push_back(
+                LogEntry{levelName, std::string(slot.source, slot.sourceLength), std::string(slot.message, slot.messageLength), second});
+        }
+        slot.sequence.store(m_dequeuePosition + m_capacity, std::memory_order_release);
+        m_dequeuePosition++;
+        writtenEntries++;
+    }
+    if (writtenEntries == 0)
+    {
+        return;
+    }
+    if (m_fileDescriptor != -1)
+    {
+        size_t written = 0;
+        while (written < buffer.length())
+        {
+            ssize_t result = write(m_fileDescriptor, buffer.data() + written, buffer.length() - written);
+            if (result == -1)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                m_writeErrors.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+            written += static_cast<size_t>(result);
+        }
+    }
+    if (hasDatabase)
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        try
+        {
+            if (m_databaseWriter != nullptr)
+            {
+                m_databaseWriter(entries);
+            }
+        }
+        catch (...)
+        {
+
+            // The background thread must not die because the database is unavailable
+
+            m_writeErrors.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    m_written.fetch_add(writtenEntries, std::memory_order_relaxed);
+}
+
+void FBNetwork::Logger::run()
+{
+    while (true)
+    {
+        uint64_t requestedFlushes = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_wakeUpMutex);
+            m_wakeUp.wait_for(lock, m_flushInterval,
+                              [this]
+                              {
+                                  return !m_isRunning.load() || m_flushRequests.load() != m_flushedRequests.load();
+                              });
+            requestedFlushes = m_flushRequests.load();
+        }
+        if (!m_isRunning.load())
+        {
+            return;
+        }
+        drain();
+        {
+            std::lock_guard<std::mutex> lock(m_wakeUpMutex);
+            m_flushedRequests.store(requestedFlushes);
+        }
+        m_flushed.notify_all();
+    }
+}
+
+FBNetwork::Logger::Logger(const std::string &t_filePath, const size_t t_capacity)
+{
+    if (t_capacity == 0)
+    {
+        throw InvalidArgumentException("Capacity must be greater than 0.");
+    }
+    size_t capacity = 1;
+    while (capacity < t_capacity)
+    {
+        capacity <<= 1;
+    }
+    if (!t_filePath.empty())
+    {
+        m_fileDescriptor = open(t_filePath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (m_fileDescriptor == -1)
+        {
+            throw SystemRuntimeException("Log file could not be opened. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+    }
+    m_capacity = capacity;
+    m_slots    = std::make_unique<Slot[]>(capacity);
+    for (size_t i = 0; i < capacity; i++)
+    {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_isRunning.store(true);
+    m_thread = std::thread(&Logger::run, this);
+}
+
+FBNetwork::Logger::~Logger()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_wakeUpMutex);
+        m_isRunning.store(false);
+    }
+    m_wakeUp.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+    drain();
+    if (m_fileDescriptor != -1)
+    {
+        close(m_fileDescriptor);
+    }
+}
+
+bool FBNetwork::Logger::log(const LogLevel t_level, const std::string_view t_source, const std::string_view t_message)
+{
+    if (!isWithinRateLimit(t_level))
+    {
+        m_rateLimited.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    size_t   mask     = m_capacity - 1;
+    uint64_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+    Slot    *slot     = nullptr;
+    while (true)
+    {
+        slot                = &m_slots[position & mask];
+        uint64_t sequence   = slot->sequence.load(std::memory_order_acquire);
+        int64_t  difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+        if (difference == 0)
+        {
+            if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+
+            // The ring is full, the background thread has not caught up yet
+
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            position = m_enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+    auto   now           = std::chrono::system_clock::now().time_since_epoch();
+    size_t sourceLength  = std::min(t_source.length(), SOURCE_SIZE);
+    size_t messageLength = std::min(t_message.length(), MESSAGE_SIZE);
+    slot->time           = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+    slot->level          = t_level;
+    slot->sourceLength   = static_cast<uint16_t>(sourceLength);
+    slot->messageLength  = static_cast<uint16_t>(messageLength);
+    memcpy(slot->source, t_source.data(), sourceLength);
+    memcpy(slot->message, t_message.data(), messageLength);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool FBNetwork::Logger::info(const std::string_view t_source, const std::string_view t_message)
+{
+    return log(LogLevel::INFO, t_source, t_message);
+}
+
+bool FBNetwork::Logger::warning(const std::string_view t_source, const std::string_view t_message)
+{
+    return log(LogLevel::WARNING, t_source, t_message);
+}
+
+bool FBNetwork::Logger::error(const std::string_view t_source, const std::string_view t_message)
+{
+    return log(LogLevel::ERROR, t_source, t_message);
+}
+
+void FBNetwork::Logger::setRateLimit(const LogLevel t_level, const uint32_t t_entriesPerSecond, const uint32_t t_burst)
+{
+    RateLimit &rateLimit = m_rateLimits[static_cast<int>(t_level)];
+    if (t_entriesPerSecond == 0)
+    {
+        rateLimit.interval.store(0, std::memory_order_relaxed);
+        return;
+    }
+    if (t_burst == 0)
+    {
+        throw InvalidArgumentException("Burst must be greater than 0.");
+    }
+    int64_t ticksPerSecond = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::seconds(1)).count();
+    int64_t interval       = std::max<int64_t>(ticksPerSecond / t_entriesPerSecond, 1);
+    rateLimit.tolerance.store(interval * (static_cast<int64_t>(t_burst) - 1), std::memory_order_relaxed);
+    rateLimit.interval.store(interval, std::memory_order_relaxed);
+}
+
+void FBNetwork::Logger::setDatabaseWriter(std::function<void(const std::vector<LogEntry> &)> t_databaseWriter)
+{
+    std::lock_guard<std::mutex> lock(m_writerMutex);
+    m_databaseWriter = t_databaseWriter;
+}
+
+void FBNetwork::Logger::setFlushInterval(const std::chrono::milliseconds t_flushInterval)
+{
+    if (t_flushInterval.count() <= 0)
+    {
+        throw InvalidArgumentException("Flush interval must be greater than 0.");
+    }
+    std::lock_guard<std::mutex> lock(m_wakeUpMutex);
+    m_flushInterval = t_flushInterval;
+}
+
+void FBNetwork::Logger::flush()
+{
+    std::unique_lock<std::mutex> lock(m_wakeUpMutex);
+    uint64_t                     request = m_flushRequests.fetch_add(1) + 1;
+    m_wakeUp.notify_all();
+    m_flushed.wait(lock,
+                   [this, request]
+                   {
+                       return m_flushedRequests.load() >= request || !m_isRunning.load();
+                   });
+}
+
+FBNetwork::LoggerStatistics FBNetwork::Logger::getStatistics() const
+{
+    LoggerStatistics statistics;
+    statistics.written     = m_written.load(std::memory_order_relaxed);
+    statistics.dropped     = m_dropped.load(std::memory_order_relaxed);
+    statistics.rateLimited = m_rateLimited.load(std::memory_order_relaxed);
+    statistics.writeErrors = m_writeErrors.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+const std::string &FBNetwork::Logger::getLevelName(const LogLevel t_level)
+{
+    switch (t_level)
+    {
+    case LogLevel::WARNING:
+        return Log::WARNING;
+    case LogLevel::ERROR:
+        return Log::ERROR;
+    default:
+        return Log::INFO;
+    }
+}
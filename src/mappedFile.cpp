@@ -0,0 +1,75 @@
+#include "../include/mappedFile.hpp"
+#include "../include/extendedSystem.hpp"
+
+FBNetwork::MappedFile::MappedFile(const std::string &t_filePath, const MappedFileAccess t_access)
+{
+    if (t_filePath.empty())
+    {
+        throw InvalidArgumentException("File path cannot be empty.");
+    }
+    fileDescriptor fileFileDescriptor = open(t_filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fileFileDescriptor == -1)
+    {
+        throw SystemRuntimeException("File could not be opened. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    struct stat fileStatus;
+    if (fstat(fileFileDescriptor, &fileStatus) == -1)
+    {
+        std::string error = ExtendedSystem::getCurrentErrnoError();
+        close(fileFileDescriptor);
+        throw SystemRuntimeException("Retrieving the file size failed. Error: " + error);
+    }
+    if (!S_ISREG(fileStatus.st_mode))
+    {
+        close(fileFileDescriptor);
+        throw InvalidArgumentException("Only regular files can be mapped.");
+    }
+    m_size = static_cast<size_t>(fileStatus.st_size);
+    if (m_size == 0)
+    {
+        close(fileFileDescriptor);
+        return;
+    }
+    void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fileFileDescriptor, 0);
+    if (data == MAP_FAILED)
+    {
+        std::string error = ExtendedSystem::getCurrentErrnoError();
+        close(fileFileDescriptor);
+        throw SystemRuntimeException("Mapping the file failed. Error: " + error);
+    }
+
+    // The mapping keeps its own reference to the file, so the descriptor is not needed anymore
+
+    close(fileFileDescriptor);
+    m_data = data;
+
+    // The hint only changes read ahead, the mapping works the same if the kernel ignores it
+
+    madvise(m_data, m_size, t_access == MappedFileAccess::SEQUENTIAL ? MADV_SEQUENTIAL : MADV_RANDOM);
+    if (t_access == MappedFileAccess::SEQUENTIAL)
+    {
+        madvise(m_data, m_size, MADV_WILLNEED);
+    }
+}
+
+FBNetwork::MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+    {
+        munmap(m_data, m_size);
+    }
+}
+
+std::string_view FBNetwork::MappedFile::getView() const
+{
+    if (m_data == nullptr)
+    {
+        return std::string_view();
+    }
+    return std::string_view(static_cast<const char *>(m_data), m_size);
+}
+
+size_t FBNetwork::MappedFile::getSize() const
+{
+    return m_size;
+}
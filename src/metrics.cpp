@@ -0,0 +1,220 @@
+#include "../include/metrics.hpp"
+#include <iomanip>
+
+FBNetwork::ConnectionMetrics::ConnectionMetrics()
+{
+    m_connectedAt = time(0);
+}
+
+void FBNetwork::ConnectionMetrics::recordRead(const ssize_t t_bytes)
+{
+    m_reads.fetch_add(1, std::memory_order_relaxed);
+    m_bytesIn.fetch_add(static_cast<uint64_t>(t_bytes), std::memory_order_relaxed);
+}
+
+void FBNetwork::ConnectionMetrics::recordWrite(const ssize_t t_bytes)
+{
+    m_writes.fetch_add(1, std::memory_order_relaxed);
+    m_bytesOut.fetch_add(static_cast<uint64_t>(t_bytes), std::memory_order_relaxed);
+}
+
+void FBNetwork::ConnectionMetrics::recordTimeout()
+{
+    m_timeouts.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FBNetwork::ConnectionMetrics::recordWouldBlock()
+{
+    m_wouldBlocks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FBNetwork::ConnectionMetrics::recordError()
+{
+    m_errors.fetch_add(1, std::memory_order_relaxed);
+}
+
+FBNetwork::ConnectionMetricsSnapshot FBNetwork::ConnectionMetrics::getSnapshot() const
+{
+    ConnectionMetricsSnapshot snapshot;
+    snapshot.bytesIn     = m_bytesIn.load(std::memory_order_relaxed);
+    snapshot.bytesOut    = m_bytesOut.load(std::memory_order_relaxed);
+    snapshot.reads       = m_reads.load(std::memory_order_relaxed);
+    snapshot.writes      = m_writes.load(std::memory_order_relaxed);
+    snapshot.timeouts    = m_timeouts.load(std::memory_order_relaxed);
+    snapshot.wouldBlocks = m_wouldBlocks.load(std::memory_order_relaxed);
+    snapshot.errors      = m_errors.load(std::memory_order_relaxed);
+    snapshot.connectedAt = m_connectedAt;
+    return snapshot;
+}
+
+void FBNetwork::ServerMetrics::recordAccept()
+{
+    m_accepts.value.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FBNetwork::ServerMetrics::recordClose()
+{
+    m_closes.value.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FBNetwork::ServerMetrics::recordRead(const ssize_t t_bytes)
+{
+    m_reads.value.fetch_add(1, std::memory_order_relaxed);
+    m_bytesIn.value.fetch_add(static_cast<uint64_t>(t_bytes), std::memory_order_relaxed);
+}
+
+void FBNetwork::ServerMetrics::recordWrite(const ssize_t t_bytes)
+{
+    m_writes.value.fetch_add(1, std::memory_order_relaxed);
+    m_bytesOut.value.fetch_add(static_cast<uint64_t>(t_bytes), std::memory_order_relaxed);
+}
+
+void FBNetwork::ServerMetrics::recordTimeout()
+{
+    m_timeouts.value.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FBNetwork::ServerMetrics::recordWouldBlock()
+{
+    m_wouldBlocks.value.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FBNetwork::ServerMetrics::recordError()
+{
+    m_errors.value.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FBNetwork::ServerMetrics::recordDroppedMessage()
+{
+    m_droppedMessages.value.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FBNetwork::ServerMetrics::recordPausedRead()
+{
+    m_pausedReads.value.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FBNetwork::ServerMetrics::recordRejectedAccept()
+{
+    m_rejectedAccepts.value.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FBNetwork::ServerMetrics::recordShedConnection()
+{
+    m_shedConnections.value.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FBNetwork::ServerMetrics::recordShedRequest()
+{
+    m_shedRequests.value.fetch_add(1, std::memory_order_relaxed);
+}
+
+FBNetwork::LatencyHistogram &FBNetwork::ServerMetrics::getReadLatency()
+{
+    return m_readLatency;
+}
+
+FBNetwork::LatencyHistogram &FBNetwork::ServerMetrics::getFramingLatency()
+{
+    return m_framingLatency;
+}
+
+FBNetwork::LatencyHistogram &FBNetwork::ServerMetrics::getSendLatency()
+{
+    return m_sendLatency;
+}
+
+FBNetwork::ServerMetricsSnapshot FBNetwork::ServerMetrics::getSnapshot() const
+{
+    ServerMetricsSnapshot snapshot;
+    snapshot.accepts            = m_accepts.value.load(std::memory_order_relaxed);
+    snapshot.closes             = m_closes.value.load(std::memory_order_relaxed);
+    snapshot.bytesIn            = m_bytesIn.value.load(std::memory_order_relaxed);
+    snapshot.bytesOut           = m_bytesOut.value.load(std::memory_order_relaxed);
+    snapshot.reads              = m_reads.value.load(std::memory_order_relaxed);
+    snapshot.writes             = m_writes.value.load(std::memory_order_relaxed);
+    snapshot.timeouts           = m_timeouts.value.load(std::memory_order_relaxed);
+    snapshot.wouldBlocks        = m_wouldBlocks.value.load(std::memory_order_relaxed);
+    snapshot.errors             = m_errors.value.load(std::memory_order_relaxed);
+    snapshot.droppedMessages    = m_droppedMessages.value.load(std::memory_order_relaxed);
+    snapshot.pausedReads        = m_pausedReads.value.load(std::memory_order_relaxed);
+    snapshot.rejectedAccepts    = m_rejectedAccepts.value.load(std::memory_order_relaxed);
+    snapshot.shedConnections    = m_shedConnections.value.load(std::memory_order_relaxed);
+    snapshot.shedRequests       = m_shedRequests.value.load(std::memory_order_relaxed);
+    snapshot.currentConnections = static_cast<int64_t>(snapshot.accepts) - static_cast<int64_t>(snapshot.closes);
+    snapshot.readLatency        = m_readLatency.getSnapshot();
+    snapshot.framingLatency     = m_framingLatency.getSnapshot();
+    snapshot.sendLatency        = m_sendLatency.getSnapshot();
+    return snapshot;
+}
+
+std::string FBNetwork::ServerMetricsSnapshot::withLabels(const std::string &t_labels, const std::string &t_extraLabel)
+{
+    if (t_labels.empty() && t_extraLabel.empty())
+    {
+        return "";
+    }
+    if (t_labels.empty() || t_extraLabel.empty())
+    {
+        return "{" + t_labels + t_extraLabel + "}";
+    }
+    return "{" + t_labels + "," + t_extraLabel + "}";
+}
+
+void FBNetwork::ServerMetricsSnapshot::appendSample(std::ostringstream &t_stream, const std::string &t_name, const std::string &t_type,
+                                                    const std::string &t_help, const std::string &t_labels, const int64_t t_value)
+{
+    t_stream << "# HELP " << t_name << " " << t_help << "\n";
+    t_stream << "# TYPE " << t_name << " " << t_type << "\n";
+    t_stream << t_name << withLabels(t_labels, "") << " " << t_value << "\n";
+}
+
+void FBNetwork::ServerMetricsSnapshot::appendHistogram(std::ostringstream &t_stream, const std::string &t_name, const std::string &t_help,
+                                                       const std::string &t_labels, const HistogramSnapshot &t_histogram)
+{
+    static const uint64_t bucketBounds[] = {1000,      5000,      10000,      50000,      100000,     500000,     1000000,    5000000,
+                                            10000000,  50000000,  100000000,  500000000,  1000000000, 5000000000, 10000000000};
+    t_stream << "# HELP " << t_name << " " << t_help << "\n";
+    t_stream << "# TYPE " << t_name << " histogram\n";
+    for (uint64_t bound : bucketBounds)
+    {
+
+        // The bound is moved to the upper edge of the histogram bucket it falls into, so that bucket is counted completely
+
+        uint64_t           edge = LatencyHistogram::getBucketUpperBound(LatencyHistogram::getBucketIndex(bound));
+        std::ostringstream upperBound;
+        upperBound << std::setprecision(12) << static_cast<double>(edge) / 1e9;
+        t_stream << t_name << "_bucket" << withLabels(t_labels, "le=\"" + upperBound.str() + "\"") << " "
+                 << t_histogram.getCountAtOrBelow(edge) << "\n";
+    }
+    t_stream << t_name << "_bucket" << withLabels(t_labels, "le=\"+Inf\"") << " " << t_histogram.count << "\n";
+    t_stream << t_name << "_sum" << withLabels(t_labels, "") << " " << static_cast<double>(t_histogram.sum) / 1e9 << "\n";
+    t_stream << t_name << "_count" << withLabels(t_labels, "") << " " << t_histogram.count << "\n";
+}
+
+std::string FBNetwork::ServerMetricsSnapshot::toPrometheusText(const std::string &t_labels) const
+{
+    std::ostringstream stream;
+    appendSample(stream, "fbnetwork_accepts_total", "counter", "Accepted clients.", t_labels, accepts);
+    appendSample(stream, "fbnetwork_closes_total", "counter", "Closed clients.", t_labels, closes);
+    appendSample(stream, "fbnetwork_received_bytes_total", "counter", "Bytes read from clients.", t_labels, bytesIn);
+    appendSample(stream, "fbnetwork_sent_bytes_total", "counter", "Bytes written to clients.", t_labels, bytesOut);
+    appendSample(stream, "fbnetwork_reads_total", "counter", "Successful read calls.", t_labels, reads);
+    appendSample(stream, "fbnetwork_writes_total", "counter", "Successful write calls.", t_labels, writes);
+    appendSample(stream, "fbnetwork_timeouts_total", "counter", "Reads that timed out.", t_labels, timeouts);
+    appendSample(stream, "fbnetwork_would_blocks_total", "counter", "Reads and writes that returned EAGAIN.", t_labels, wouldBlocks);
+    appendSample(stream, "fbnetwork_errors_total", "counter", "Failed accept, read and write calls.", t_labels, errors);
+    appendSample(stream, "fbnetwork_dropped_messages_total", "counter", "Messages not queued for slow clients.", t_labels, droppedMessages);
+    appendSample(stream, "fbnetwork_paused_reads_total", "counter", "Clients paused by the rate limits.", t_labels, pausedReads);
+    appendSample(stream, "fbnetwork_rejected_accepts_total", "counter", "Connections closed by the rate limits.", t_labels, rejectedAccepts);
+    appendSample(stream, "fbnetwork_shed_connections_total", "counter", "Connections closed because the server was overloaded.", t_labels,
+                 shedConnections);
+    appendSample(stream, "fbnetwork_shed_requests_total", "counter", "Requests not run because the concurrency limit was reached.",
+                 t_labels, shedRequests);
+    appendSample(stream, "fbnetwork_current_connections", "gauge", "Currently open client connections.", t_labels, currentConnections);
+    appendSample(stream, "fbnetwork_lifetime_seconds", "gauge", "Seconds since the server was started.", t_labels, lifeTime);
+    appendHistogram(stream, "fbnetwork_read_latency_seconds", "Time until a read function returned.", t_labels, readLatency);
+    appendHistogram(stream, "fbnetwork_framing_latency_seconds", "Time spent searching delimiters.", t_labels, framingLatency);
+    appendHistogram(stream, "fbnetwork_send_latency_seconds", "Time spent in sendData.", t_labels, sendLatency);
+    return stream.str();
+}
@@ -0,0 +1,126 @@
+#include "../include/metricsExporter.hpp"
+
+void FBNetwork::MetricsExporter::answerClient(const int t_clientID)
+{
+    try
+    {
+        std::error_code error;
+        m_server->readTillXData(t_clientID, "\r\n\r\n", error);
+        if (error == NetworkError::TIMEOUT)
+        {
+
+            // The header is not complete yet, the part that arrived is kept and the read goes on with the next event
+
+            return;
+        }
+        else if (error)
+        {
+            throw ServerRuntimeException("Reading the request failed.", error);
+        }
+        std::string request         = m_server->getData(t_clientID);
+        std::string requestLine     = request.substr(0, request.find("\r\n"));
+        std::string expectedRequest = Http::RequestMethod::HTTP_GET + " " + Constants::METRICS_PATH + " ";
+        std::string status          = Http::ResponseStatus::HTTP_OK;
+        std::string body            = "";
+        if (requestLine.compare(0, expectedRequest.length(), expectedRequest) == 0)
+        {
+            body = getPrometheusText();
+        }
+        else
+        {
+            status = Http::ResponseStatus::HTTP_NOT_FOUND;
+            body   = status + "\n";
+        }
+        std::string response = Http::Version::HTTP_VERSION_1_1 + " " + status + "\r\n";
+        response += Http::ResponseHeaderFields::RFC9110::CONTENT_TYPE + ": " + Constants::METRICS_CONTENT_TYPE + "\r\n";
+        response += Http::ResponseHeaderFields::RFC9110::CONTENT_LENGTH + ": " + std::to_string(body.length()) + "\r\n";
+        response += Http::ResponseHeaderFields::RFC9110::CONNECTION + ": close\r\n\r\n";
+        response += body;
+        m_server->sendData(t_clientID, response);
+    }
+    catch (InvalidArgumentException &e)
+    {
+    }
+    catch (ServerRuntimeException &e)
+    {
+    }
+    catch (ServerTimeoutException &e)
+    {
+    }
+    try
+    {
+        m_server->closeClient(t_clientID);
+    }
+    catch (ServerRuntimeException &e)
+    {
+    }
+}
+
+void FBNetwork::MetricsExporter::run()
+{
+    while (m_isRunning.load())
+    {
+        std::vector<eventTuple> events;
+        try
+        {
+            events = m_server->getPendingEvents();
+        }
+        catch (ServerRuntimeException &e)
+        {
+            continue;
+        }
+        for (const eventTuple &event : events)
+        {
+            if (std::get<0>(event) == EventType::CLIENT_WANTS_TO_CONNECT)
+            {
+                try
+                {
+                    m_server->acceptAll();
+                }
+                catch (ServerRuntimeException &e)
+                {
+
+                    // Too many scrapers at once, the others are accepted when one of them is done
+
+                }
+            }
+            else if (std::get<0>(event) == EventType::CLIENT_WANTS_TO_SEND_DATA)
+            {
+                answerClient(std::get<1>(event));
+            }
+        }
+    }
+}
+
+FBNetwork::MetricsExporter::MetricsExporter(const Server &t_observedServer, const domain t_domain, const port t_port,
+                                            const std::string &t_labels)
+    : m_observedServer(t_observedServer)
+{
+    m_labels = t_labels;
+    m_server = std::make_unique<Server>(t_domain, t_port, Constants::METRICS_MAXIMUM_CONNECTIONS);
+    m_server->startServer();
+    m_server->setTimeout(Constants::METRICS_TIMEOUT);
+    m_server->setIdleTimeout(Constants::METRICS_REQUEST_TIMEOUT);
+    m_server->setReadTimeout(Constants::METRICS_REQUEST_TIMEOUT);
+    m_server->startListening();
+    m_isRunning.store(true);
+    m_thread = std::thread(&MetricsExporter::run, this);
+}
+
+FBNetwork::MetricsExporter::~MetricsExporter()
+{
+    m_isRunning.store(false);
+
+    // Wake the background thread up, it waits for events without a timeout
+
+    m_server->post([]() {});
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+std::string FBNetwork::MetricsExporter::getPrometheusText() const
+{
+    return m_observedServer.getMetrics().toPrometheusText(m_labels);
+}
@@ -94,6 +94,64 @@ FBNetwork::port FBNetwork::MySQL::getPort() const
     return m_port;
 }
 
+std::shared_ptr<FBNetwork::MySQLCache> FBNetwork::MySQL::getCache() const
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    return m_cache;
+}
+
+std::string FBNetwork::MySQL::createCacheKey(const std::string &t_operation, const std::string &t_table,
+                                             const std::vector<std::string> &t_columns, const std::vector<SQL::parameter> &t_values)
+{
+    std::string key = "";
+    key.reserve(64);
+    auto appendPart = [&key](const char t_type, const char *t_data, const size_t t_length)
+    {
+        key += t_type;
+        key += std::to_string(t_length);
+        key += ':';
+        key.append(t_data, t_length);
+    };
+    appendPart('o', t_operation.data(), t_operation.length());
+    appendPart('t', t_table.data(), t_table.length());
+    for (const std::string &column : t_columns)
+    {
+        appendPart('c', column.data(), column.length());
+    }
+    for (const SQL::parameter &value : t_values)
+    {
+        if (std::holds_alternative<std::string>(value))
+        {
+            const std::string &str = std::get<std::string>(value);
+            appendPart('s', str.data(), str.length());
+        }
+        else if (std::holds_alternative<int>(value))
+        {
+            std::string number = std::to_string(std::get<int>(value));
+            appendPart('i', number.data(), number.length());
+        }
+        else if (std::holds_alternative<double>(value))
+        {
+            double number = std::get<double>(value);
+            appendPart('d', reinterpret_cast<const char *>(&number), sizeof(number));
+        }
+        else if (std::holds_alternative<MYSQL_TIME>(value))
+        {
+            const MYSQL_TIME &time = std::get<MYSQL_TIME>(value);
+            std::string       date = std::to_string(time.year) + "-" + std::to_string(time.month) + "-" + std::to_string(time.day) + " " +
+                               std::to_string(time.hour) + ":" + std::to_string(time.minute) + ":" + std::to_string(time.second) + "." +
+                               std::to_string(time.second_part) + (time.neg ? "-" : "+");
+            appendPart('m', date.data(), date.length());
+        }
+        else if (std::holds_alternative<std::vector<char>>(value))
+        {
+            const std::vector<char> &blob = std::get<std::vector<char>>(value);
+            appendPart('b', blob.data(), blob.size());
+        }
+    }
+    return key;
+}
+
 std::shared_ptr<MYSQL_RES> FBNetwork::MySQL::executePreparedStatement(const std::string                 &t_query,
                                                                       const std::vector<SQL::parameter> &t_params) const
 {
@@ -293,9 +351,22 @@ bool FBNetwork::MySQL::has(const std::string &t_table, const std::string &t_colu
     {
         throw InvalidArgumentException("Column is empty.");
     }
-    std::shared_ptr<MYSQL_RES>  result = nullptr;
-    std::string                 query  = "SELECT * FROM " + t_table + " WHERE " + t_column + " = ?;";
-    std::vector<SQL::parameter> params = {t_value};
+    std::shared_ptr<MYSQL_RES>  result          = nullptr;
+    std::string                 query           = "SELECT * FROM " + t_table + " WHERE " + t_column + " = ?;";
+    std::vector<SQL::parameter> params          = {t_value};
+    std::shared_ptr<MySQLCache> cache           = getCache();
+    std::string                 cacheKey        = "";
+    uint64_t                    cacheGeneration = 0;
+    if (cache != nullptr)
+    {
+        cacheKey                                     = createCacheKey("has", t_table, {t_column}, params);
+        std::optional<MySQLCacheResult> cachedResult = cache->lookup(cacheKey);
+        if (cachedResult.has_value())
+        {
+            return cachedResult->found;
+        }
+        cacheGeneration = cache->getTableGeneration(t_table);
+    }
     try
     {
         result = executePreparedStatement(query, params);
@@ -308,6 +379,10 @@ bool FBNetwork::MySQL::has(const std::string &t_table, const std::string &t_colu
         }
         throw e;
     }
+    if (cache != nullptr)
+    {
+        cache->store(cacheKey, t_table, cacheGeneration, MySQLCacheResult{result != nullptr, {}});
+    }
     if (result == nullptr)
     {
         return false;
@@ -331,9 +406,22 @@ bool FBNetwork::MySQL::match(const std::string &t_table, const std::string &t_co
     {
         throw InvalidArgumentException("Column2 is empty.");
     }
-    std::shared_ptr<MYSQL_RES>  result = NULL;
-    std::string                 query  = "SELECT * FROM " + t_table + " WHERE " + t_column + " = ? AND " + t_column2 + " = ?;";
-    std::vector<SQL::parameter> params = {t_value, t_value2};
+    std::shared_ptr<MYSQL_RES>  result          = NULL;
+    std::string                 query           = "SELECT * FROM " + t_table + " WHERE " + t_column + " = ? AND " + t_column2 + " = ?;";
+    std::vector<SQL::parameter> params          = {t_value, t_value2};
+    std::shared_ptr<MySQLCache> cache           = getCache();
+    std::string                 cacheKey        = "";
+    uint64_t                    cacheGeneration = 0;
+    if (cache != nullptr)
+    {
+        cacheKey                                     = createCacheKey("match", t_table, {t_column, t_column2}, params);
+        std::optional<MySQLCacheResult> cachedResult = cache->lookup(cacheKey);
+        if (cachedResult.has_value())
+        {
+            return cachedResult->found;
+        }
+        cacheGeneration = cache->getTableGeneration(t_table);
+    }
     try
     {
         result = executePreparedStatement(query, params);
@@ -346,6 +434,10 @@ bool FBNetwork::MySQL::match(const std::string &t_table, const std::string &t_co
         }
         throw e;
     }
+    if (cache != nullptr)
+    {
+        cache->store(cacheKey, t_table, cacheGeneration, MySQLCacheResult{result != nullptr, {}});
+    }
     if (result == nullptr)
     {
         return false;
@@ -368,11 +460,24 @@ std::vector<std::string> FBNetwork::MySQL::getWhere(const std::string &t_table,
     {
         throw InvalidArgumentException("Column2 is empty.");
     }
-    std::string                 query  = "SELECT " + t_column + " FROM " + t_table + " WHERE " + t_column2 + " = ?;";
-    std::vector<SQL::parameter> params = {t_value2};
+    std::string                 query           = "SELECT " + t_column + " FROM " + t_table + " WHERE " + t_column2 + " = ?;";
+    std::vector<SQL::parameter> params          = {t_value2};
     std::vector<std::string>    resultString;
-    std::shared_ptr<MYSQL_RES>  result = NULL;
+    std::shared_ptr<MYSQL_RES>  result          = NULL;
     MYSQL_ROW                   row;
+    std::shared_ptr<MySQLCache> cache           = getCache();
+    std::string                 cacheKey        = "";
+    uint64_t                    cacheGeneration = 0;
+    if (cache != nullptr)
+    {
+        cacheKey                                     = createCacheKey("getWhere", t_table, {t_column, t_column2}, params);
+        std::optional<MySQLCacheResult> cachedResult = cache->lookup(cacheKey);
+        if (cachedResult.has_value())
+        {
+            return cachedResult->values;
+        }
+        cacheGeneration = cache->getTableGeneration(t_table);
+    }
     try
     {
         result = executePreparedStatement(query, params);
@@ -387,12 +492,20 @@ std::vector<std::string> FBNetwork::MySQL::getWhere(const std::string &t_table,
     }
     if (result == 0)
     {
+        if (cache != nullptr)
+        {
+            cache->store(cacheKey, t_table, cacheGeneration, MySQLCacheResult{false, SQL::EMPTY_RESULT});
+        }
         return SQL::EMPTY_RESULT;
     }
     while ((row = mysql_fetch_row(result.get())) != NULL)
     {
         resultString.push_back(row[0]);
     }
+    if (cache != nullptr)
+    {
+        cache->store(cacheKey, t_table, cacheGeneration, MySQLCacheResult{true, resultString});
+    }
     return resultString;
 }
 
@@ -471,8 +584,85 @@ void FBNetwork::MySQL::insert(const std::string &t_table, const std::vector<std:
     }
     catch (const MySQLRuntimeException &e)
     {
+        invalidateCache(t_table);
+        throw e;
+    }
+    invalidateCache(t_table);
+}
+
+void FBNetwork::MySQL::insertRows(const std::string &t_table, const std::vector<std::string> &t_columns,
+                                  const std::vector<std::vector<SQL::parameter>> &t_rows)
+{
+    if (t_table.empty())
+    {
+        throw InvalidArgumentException("Table is empty.");
+    }
+    if (t_columns.empty())
+    {
+        throw InvalidArgumentException("Columns are empty.");
+    }
+    for (const std::vector<SQL::parameter> &row : t_rows)
+    {
+        if (row.size() != t_columns.size())
+        {
+            throw InvalidArgumentException("Columns and values are not the same size.");
+        }
+    }
+    if (t_rows.empty())
+    {
+        return;
+    }
+    std::string queryPrefix = "INSERT INTO " + t_table + " (";
+    std::string placeholder = "(";
+    for (const std::string &column : t_columns)
+    {
+        queryPrefix += column + ",";
+        placeholder += "?,";
+    }
+    queryPrefix.back() = ')';
+    placeholder.back() = ')';
+    queryPrefix += " VALUES ";
+
+    // A prepared statement can bind at most 65535 parameters
+
+    size_t rowsPerStatement = std::max<size_t>(Constants::MYSQL_MAXIMUM_PARAMETERS / t_columns.size(), 1);
+    try
+    {
+        for (size_t first = 0; first < t_rows.size(); first += rowsPerStatement)
+        {
+            size_t                      last  = std::min(first + rowsPerStatement, t_rows.size());
+            std::string                 query = queryPrefix;
+            std::vector<SQL::parameter> params;
+            params.reserve((last - first) * t_columns.size());
+            for (size_t i = first; i < last; i++)
+            {
+                query += placeholder + ",";
+                params.insert(params.end(), t_rows[i].begin(), t_rows[i].end());
+            }
+            query.back() = ';';
+            executePreparedStatement(query, params);
+        }
+    }
+    catch (const MySQLRuntimeException &e)
+    {
+        invalidateCache(t_table);
         throw e;
     }
+    invalidateCache(t_table);
+}
+
+void FBNetwork::MySQL::insertLogEntries(const std::string &t_table, const std::vector<LogEntry> &t_entries)
+{
+    std::vector<std::vector<SQL::parameter>> rows;
+    rows.reserve(t_entries.size());
+    for (const LogEntry &entry : t_entries)
+    {
+        rows.push_back({entry.type, entry.source, entry.message});
+    }
+
+    // insertRows throws InvalidArgumentException and MySQLRuntimeException
+
+    insertRows(t_table, {Log::DATABASE_TYPE_NAME, Log::DATABASE_SOURCE_NAME, Log::DATABASE_MESSAGE_NAME}, rows);
 }
 
 void FBNetwork::MySQL::updateWhere(const std::string &t_table, const std::vector<std::string> t_columns,
@@ -513,8 +703,10 @@ void FBNetwork::MySQL::updateWhere(const std::string &t_table, const std::vector
     }
     catch (const MySQLRuntimeException &e)
     {
+        invalidateCache(t_table);
         throw e;
     }
+    invalidateCache(t_table);
 }
 
 void FBNetwork::MySQL::deleteWhere(const std::string &t_table, const std::string &t_column, const SQL::parameter t_value)
@@ -540,6 +732,51 @@ void FBNetwork::MySQL::deleteWhere(const std::string &t_table, const std::string
         {
             mysql_free_result(result.get());
         }
+        invalidateCache(t_table);
         throw e;
     }
+    invalidateCache(t_table);
+}
+
+void FBNetwork::MySQL::enableCache(const std::chrono::milliseconds t_timeToLive, const size_t t_maximumEntries)
+{
+
+    // The constructor of MySQLCache throws InvalidArgumentException
+
+    std::shared_ptr<MySQLCache> cache = std::make_shared<MySQLCache>(t_timeToLive, t_maximumEntries);
+
+    // The old cache is released after the lock, queries that still hold it finish with it
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_cache.swap(cache);
+}
+
+void FBNetwork::MySQL::disableCache()
+{
+    std::shared_ptr<MySQLCache> cache = nullptr;
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_cache.swap(cache);
+}
+
+void FBNetwork::MySQL::invalidateCache(const std::string &t_table)
+{
+    if (t_table.empty())
+    {
+        throw InvalidArgumentException("Table is empty.");
+    }
+    std::shared_ptr<MySQLCache> cache = getCache();
+    if (cache != nullptr)
+    {
+        cache->invalidateTable(t_table);
+    }
+}
+
+FBNetwork::MySQLCacheStatistics FBNetwork::MySQL::getCacheStatistics() const
+{
+    std::shared_ptr<MySQLCache> cache = getCache();
+    if (cache == nullptr)
+    {
+        return MySQLCacheStatistics();
+    }
+    return cache->getStatistics();
 }
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include "../include/mySQLCache.hpp"
+
+uint64_t FBNetwork::MySQLCache::getTableGenerationLocked(const std::string &t_table) const
+{
+    auto generation = m_tableGenerations.find(t_table);
+    if (generation == m_tableGenerations.end())
+    {
+        return 0;
+    }
+    return generation->second;
+}
+
+void FBNetwork::MySQLCache::eraseLocked(std::unordered_map<std::string, Entry>::iterator t_entry)
+{
+    m_leastRecentlyUsed.erase(t_entry->second.leastRecentlyUsedPosition);
+    m_entries.erase(t_entry);
+}
+
+FBNetwork::MySQLCache::MySQLCache(const std::chrono::milliseconds t_timeToLive, const size_t t_maximumEntries)
+{
+    if (t_timeToLive.count() <= 0)
+    {
+        throw InvalidArgumentException("Time to live must be greater than 0.");
+    }
+    if (t_maximumEntries == 0)
+    {
+        throw InvalidArgumentException("Maximum entries must be greater than 0.");
+    }
+    m_timeToLive     = t_timeToLive;
+    m_maximumEntries = t_maximumEntries;
+    m_entries.reserve(t_maximumEntries);
+}
+
+uint64_t FBNetwork::MySQLCache::getTableGeneration(const std::string &t_table) const
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    return getTableGenerationLocked(t_table);
+}
+
+std::optional<FBNetwork::MySQLCacheResult> FBNetwork::MySQLCache::lookup(const std::string &t_key)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    auto                        entry = m_entries.find(t_key);
+    if (entry == m_entries.end())
+    {
+        m_statistics.misses++;
+        return std::nullopt;
+    }
+    if (entry->second.generation != getTableGenerationLocked(entry->second.table))
+    {
+        eraseLocked(entry);
+        m_statistics.misses++;
+        return std::nullopt;
+    }
+    if (entry->second.expiresAt <= std::chrono::steady_clock::now())
+    {
+        eraseLocked(entry);
+        m_statistics.expirations++;
+        m_statistics.misses++;
+        return std::nullopt;
+    }
+    m_leastRecentlyUsed.splice(m_leastRecentlyUsed.begin(), m_leastRecentlyUsed, entry->second.leastRecentlyUsedPosition);
+    m_statistics.hits++;
+    return entry->second.result;
+}
+
+void FBNetwork::MySQLCache::store(const std::string &t_key, const std::string &t_table, const uint64_t t_generation,
+                                  const MySQLCacheResult &t_result)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+
+    // A write to the table finished while the query was running, so the result may already be stale
+
+    if (t_generation != getTableGenerationLocked(t_table))
+    {
+        return;
+    }
+    auto existing = m_entries.find(t_key);
+    if (existing != m_entries.end())
+    {
+        eraseLocked(existing);
+    }
+    while (m_entries.size() >= m_maximumEntries && !m_leastRecentlyUsed.empty())
+    {
+        eraseLocked(m_entries.find(m_leastRecentlyUsed.back()));
+        m_statistics.evictions++;
+    }
+    m_leastRecentlyUsed.push_front(t_key);
+    Entry &entry                    = m_entries[t_key];
+    entry.table                     = t_table;
+    entry.generation                = t_generation;
+    entry.expiresAt                 = std::chrono::steady_clock::now() + m_timeToLive;
+    entry.result                    = t_result;
+    entry.leastRecentlyUsedPosition = m_leastRecentlyUsed.begin();
+    m_statistics.insertions++;
+}
+
+void FBNetwork::MySQLCache::invalidateTable(const std::string &t_table)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_tableGenerations[t_table]++;
+    m_statistics.invalidations++;
+}
+
+void FBNetwork::MySQLCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_entries.clear();
+    m_leastRecentlyUsed.clear();
+}
+
+FBNetwork::MySQLCacheStatistics FBNetwork::MySQLCache::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    MySQLCacheStatistics        statistics = m_statistics;
+    uint64_t                    lookups    = statistics.hits + statistics.misses;
+    statistics.entries                     = m_entries.size();
+    statistics.hitRate                     = lookups == 0 ? 0.0 : static_cast<double>(statistics.hits) / static_cast<double>(lookups);
+    return statistics;
+}
@@ -0,0 +1,275 @@
+#include "../include/resolver.hpp"
+#include "../include/extendedSystem.hpp"
+
+void FBNetwork::Resolver::run()
+{
+    while (true)
+    {
+        std::unique_ptr<Lookup> lookup;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeUp.wait(lock,
+                          [this]
+                          {
+                              return !m_isRunning || !m_lookups.empty();
+                          });
+            if (!m_isRunning)
+            {
+                return;
+            }
+            lookup = std::move(m_lookups.front());
+            m_lookups.pop_front();
+        }
+        bool isResolved = false;
+        try
+        {
+            lookup->addresses.set_value(lookUp(lookup->hostName));
+            isResolved = true;
+        }
+        catch (SystemRuntimeException &e)
+        {
+            lookup->addresses.set_exception(std::current_exception());
+        }
+
+        // The entry may have been removed and looked up again meanwhile, then it belongs to the newer lookup
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        entry = m_cache.find(lookup->hostName);
+        if (entry != m_cache.end() && entry->second.lookupID == lookup->lookupID)
+        {
+            entry->second.expiresAt = std::chrono::steady_clock::now() + (isResolved ? m_cacheTtl : m_negativeCacheTtl);
+        }
+    }
+}
+
+FBNetwork::addressList FBNetwork::Resolver::lookUp(const std::string &t_hostName)
+{
+    addrinfo  hints  = {};
+    addrinfo *result = nullptr;
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    // Only ask for the families the host has addresses of, an IPv6 address on a host without IPv6 would only fail
+
+    hints.ai_flags = AI_ADDRCONFIG;
+    int error      = getaddrinfo(t_hostName.c_str(), nullptr, &hints, &result);
+    if (error != 0)
+    {
+        throw SystemRuntimeException("Resolving " + t_hostName + " failed. Error: " +
+                                     (error == EAI_SYSTEM ? ExtendedSystem::getCurrentErrnoError() : std::string(gai_strerror(error))));
+    }
+    addressList addresses;
+    for (addrinfo *entry = result; entry != nullptr; entry = entry->ai_next)
+    {
+        if (entry->ai_family != Domain::IPV4_DOMAIN && entry->ai_family != Domain::IPV6_DOMAIN)
+        {
+            continue;
+        }
+        sockaddr_storage address = {};
+        memcpy(&address, entry->ai_addr, entry->ai_addrlen);
+        addresses.push_back(address);
+    }
+    freeaddrinfo(result);
+    if (addresses.empty())
+    {
+        throw SystemRuntimeException("Resolving " + t_hostName + " failed. Error: No IPv4 or IPv6 address.");
+    }
+    return addresses;
+}
+
+bool FBNetwork::Resolver::parseIpAddress(const std::string &t_hostName, sockaddr_storage &t_address)
+{
+    t_address                 = {};
+    sockaddr_in  *addressIpv4 = reinterpret_cast<sockaddr_in *>(&t_address);
+    sockaddr_in6 *addressIpv6 = reinterpret_cast<sockaddr_in6 *>(&t_address);
+    if (inet_pton(Domain::IPV4_DOMAIN, t_hostName.c_str(), &addressIpv4->sin_addr) == 1)
+    {
+        addressIpv4->sin_family = Domain::IPV4_DOMAIN;
+        return true;
+    }
+    if (inet_pton(Domain::IPV6_DOMAIN, t_hostName.c_str(), &addressIpv6->sin6_addr) == 1)
+    {
+        addressIpv6->sin6_family = Domain::IPV6_DOMAIN;
+        return true;
+    }
+    return false;
+}
+
+void FBNetwork::Resolver::pruneCache()
+{
+    if (m_cache.size() < Constants::RESOLVER_CACHE_CAPACITY)
+    {
+        return;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (auto entry = m_cache.begin(); entry != m_cache.end();)
+    {
+        if (entry->second.expiresAt <= now)
+        {
+            entry = m_cache.erase(entry);
+        }
+        else
+        {
+            ++entry;
+        }
+    }
+    if (m_cache.size() < Constants::RESOLVER_CACHE_CAPACITY)
+    {
+        return;
+    }
+
+    // Every entry is still valid, drop the finished ones rather than growing without bound
+
+    for (auto entry = m_cache.begin(); entry != m_cache.end();)
+    {
+        if (entry->second.expiresAt != std::chrono::steady_clock::time_point::max())
+        {
+            entry = m_cache.erase(entry);
+        }
+        else
+        {
+            ++entry;
+        }
+    }
+}
+
+std::shared_ptr<FBNetwork::Resolver> FBNetwork::Resolver::getInstance()
+{
+    static std::shared_ptr<Resolver> instance = std::make_shared<Resolver>();
+    return instance;
+}
+
+FBNetwork::addressList FBNetwork::Resolver::interleaveFamilies(const addressList &t_addresses, const domain t_preferredFamily)
+{
+    if (t_addresses.empty())
+    {
+        return t_addresses;
+    }
+    domain firstFamily = t_addresses.front().ss_family;
+    for (const sockaddr_storage &address : t_addresses)
+    {
+        if (address.ss_family == t_preferredFamily)
+        {
+            firstFamily = t_preferredFamily;
+            break;
+        }
+    }
+    addressList firstAddresses;
+    addressList secondAddresses;
+    for (const sockaddr_storage &address : t_addresses)
+    {
+        if (address.ss_family == firstFamily)
+        {
+            firstAddresses.push_back(address);
+        }
+        else
+        {
+            secondAddresses.push_back(address);
+        }
+    }
+    addressList addresses;
+    addresses.reserve(t_addresses.size());
+    for (size_t i = 0; i < std::max(firstAddresses.size(), secondAddresses.size()); i++)
+    {
+        if (i < firstAddresses.size())
+        {
+            addresses.push_back(firstAddresses[i]);
+        }
+        if (i < secondAddresses.size())
+        {
+            addresses.push_back(secondAddresses[i]);
+        }
+    }
+    return addresses;
+}
+
+FBNetwork::Resolver::Resolver(const size_t t_threadCount)
+{
+    if (t_threadCount == 0)
+    {
+        throw InvalidArgumentException("The number of threads must be greater than 0.");
+    }
+    for (size_t i = 0; i < t_threadCount; i++)
+    {
+        m_threads.emplace_back(&Resolver::run, this);
+    }
+}
+
+FBNetwork::Resolver::~Resolver()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isRunning = false;
+    }
+    m_wakeUp.notify_all();
+    for (std::thread &thread : m_threads)
+    {
+        thread.join();
+    }
+    for (std::unique_ptr<Lookup> &lookup : m_lookups)
+    {
+        lookup->addresses.set_exception(
+            std::make_exception_ptr(SystemRuntimeException("Resolving " + lookup->hostName + " failed. Error: The resolver was destructed.")));
+    }
+}
+
+std::shared_future<FBNetwork::addressList> FBNetwork::Resolver::resolveAsync(const std::string &t_hostName)
+{
+    if (t_hostName.empty())
+    {
+        throw InvalidArgumentException("Invalid host name.");
+    }
+    sockaddr_storage address = {};
+    if (parseIpAddress(t_hostName, address))
+    {
+        std::promise<addressList> addresses;
+        addresses.set_value(addressList{address});
+        return addresses.get_future().share();
+    }
+    std::shared_future<addressList> addresses;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto                        entry = m_cache.find(t_hostName);
+        if (entry != m_cache.end() && std::chrono::steady_clock::now() < entry->second.expiresAt)
+        {
+            return entry->second.addresses;
+        }
+        pruneCache();
+        std::unique_ptr<Lookup> lookup = std::make_unique<Lookup>();
+        lookup->hostName               = t_hostName;
+        lookup->lookupID               = ++m_nextLookupID;
+        addresses                      = lookup->addresses.get_future().share();
+        m_cache[t_hostName]            = CacheEntry{addresses, std::chrono::steady_clock::time_point::max(), lookup->lookupID};
+        m_lookups.push_back(std::move(lookup));
+    }
+    m_wakeUp.notify_one();
+    return addresses;
+}
+
+FBNetwork::addressList FBNetwork::Resolver::resolve(const std::string &t_hostName)
+{
+    return resolveAsync(t_hostName).get();
+}
+
+void FBNetwork::Resolver::setCacheTtl(const std::chrono::seconds t_ttl, const std::chrono::seconds t_negativeTtl)
+{
+    if (t_ttl.count() < 0 || t_negativeTtl.count() < 0)
+    {
+        throw InvalidArgumentException("The cache TTL cannot be negative.");
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cacheTtl         = t_ttl;
+    m_negativeCacheTtl = t_negativeTtl;
+}
+
+void FBNetwork::Resolver::removeFromCache(const std::string &t_hostName)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache.erase(t_hostName);
+}
+
+void FBNetwork::Resolver::clearCache()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cache.clear();
+}
@@ -0,0 +1,324 @@
+#include "../include/rpc.hpp"
+#include <cstring>
+
+static const uint64_t SLOT_MASK = (uint64_t(1) << FBNetwork::Constants::RPC_SLOT_BITS) - 1;
+
+FBNetwork::RpcClient::RpcClient(std::shared_ptr<Client> t_client) : m_client(t_client)
+{
+    if (t_client == nullptr)
+    {
+        throw InvalidArgumentException("The client of an RPC client cannot be nullptr.");
+    }
+#ifdef FBNETWORK_WITH_TLS
+    if (t_client->getTlsConnection() != nullptr)
+    {
+        throw InvalidArgumentException("An RPC client cannot use a TLS connection.");
+    }
+#endif
+    m_reader = std::thread(&RpcClient::readResponses, this);
+}
+
+FBNetwork::RpcClient::~RpcClient()
+{
+    close();
+}
+
+void FBNetwork::RpcClient::complete(const rpcCallback &t_callback, const std::string &t_response, std::exception_ptr t_error)
+{
+    try
+    {
+        t_callback(t_response, t_error);
+    }
+    catch (...)
+    {
+    }
+}
+
+FBNetwork::rpcCallback FBNetwork::RpcClient::takeCall(const int t_slot)
+{
+    rpcCallback callback            = std::move(m_pendingCalls[t_slot].callback);
+    m_pendingCalls[t_slot].callback = nullptr;
+    m_deadlines.cancel(t_slot);
+    m_freeSlots.push_back(t_slot);
+    m_pendingCount--;
+    return callback;
+}
+
+void FBNetwork::RpcClient::readResponses()
+{
+    while (m_isRunning.load())
+    {
+        try
+        {
+
+            // Wake up for the next deadline, and at least every poll interval to notice `close()`
+
+            std::chrono::milliseconds wait = Constants::RPC_POLL_INTERVAL;
+            {
+                std::lock_guard<std::mutex> lock(m_pendingCallsMutex);
+                int                         nextExpiry = m_deadlines.getMillisecondsUntilNextExpiry(std::chrono::steady_clock::now());
+                if (nextExpiry >= 0)
+                {
+                    wait = std::min(wait, std::chrono::milliseconds(nextExpiry));
+                }
+            }
+            std::shared_ptr<timeval> timeout = std::make_shared<timeval>();
+            timeout->tv_sec                  = static_cast<time_t>(wait.count() / 1000);
+            timeout->tv_usec                 = static_cast<suseconds_t>(wait.count() % 1000 * 1000);
+            if (m_client->isDataAvailable(timeout))
+            {
+                readResponse();
+            }
+            expireDeadlines();
+        }
+        catch (const std::exception &e)
+        {
+
+            // A frame that was read only partly leaves the connection out of step, so every call fails
+
+            failPendingCalls(std::make_exception_ptr(ClientRuntimeException(std::string("The RPC connection failed. ") + e.what())));
+            return;
+        }
+    }
+}
+
+void FBNetwork::RpcClient::readResponse()
+{
+    m_client->readXData(static_cast<ssize_t>(Constants::RPC_FRAME_HEADER_SIZE));
+    RpcFrameHeader header;
+    try
+    {
+        header = decodeHeader(m_client->getData());
+    }
+    catch (const InvalidArgumentException &e)
+    {
+        throw ClientRuntimeException(e.what());
+    }
+    std::string payload;
+    if (header.payloadSize > 0)
+    {
+        m_client->readXData(static_cast<ssize_t>(header.payloadSize));
+        payload = m_client->getData();
+    }
+    if (header.type == RpcFrameType::REQUEST)
+    {
+        throw ClientRuntimeException("The server sent a request instead of a response.");
+    }
+    int         slot = static_cast<int>(header.correlationID & SLOT_MASK);
+    rpcCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingCallsMutex);
+        if (static_cast<size_t>(slot) < m_pendingCalls.size() && m_pendingCalls[slot].callback &&
+            m_pendingCalls[slot].correlationID == header.correlationID)
+        {
+            callback = takeCall(slot);
+        }
+    }
+
+    // The call timed out before, its response is dropped
+
+    if (!callback)
+    {
+        return;
+    }
+    if (header.type == RpcFrameType::ERROR)
+    {
+        complete(callback, "", std::make_exception_ptr(ClientRuntimeException(payload)));
+        return;
+    }
+    complete(callback, payload, nullptr);
+}
+
+void FBNetwork::RpcClient::expireDeadlines()
+{
+    std::vector<rpcCallback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingCallsMutex);
+        std::vector<int>            expiredSlots;
+        m_deadlines.advance(std::chrono::steady_clock::now(), expiredSlots);
+        for (int slot : expiredSlots)
+        {
+            callbacks.push_back(takeCall(slot));
+        }
+    }
+    for (const rpcCallback &callback : callbacks)
+    {
+        complete(callback, "", std::make_exception_ptr(ClientTimeoutException("The deadline of the call passed.")));
+    }
+}
+
+void FBNetwork::RpcClient::failPendingCalls(std::exception_ptr t_error)
+{
+    std::vector<rpcCallback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingCallsMutex);
+        if (m_error == nullptr)
+        {
+            m_error = t_error;
+        }
+        for (size_t slot = 0; slot < m_pendingCalls.size(); slot++)
+        {
+            if (m_pendingCalls[slot].callback)
+            {
+                callbacks.push_back(takeCall(static_cast<int>(slot)));
+            }
+        }
+    }
+    for (const rpcCallback &callback : callbacks)
+    {
+        complete(callback, "", t_error);
+    }
+}
+
+void FBNetwork::RpcClient::call(const std::string &t_request, rpcCallback t_callback, const std::chrono::milliseconds t_deadline)
+{
+    if (!t_callback)
+    {
+        throw InvalidArgumentException("The callback is empty.");
+    }
+    if (t_request.size() > Constants::RPC_MAXIMUM_FRAME_SIZE)
+    {
+        throw InvalidArgumentException("The request is larger than the maximum frame size.");
+    }
+    if (t_deadline.count() < 0)
+    {
+        throw InvalidArgumentException("The deadline cannot be negative.");
+    }
+    std::exception_ptr error         = nullptr;
+    uint64_t           correlationID = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_pendingCallsMutex);
+        if (m_error != nullptr)
+        {
+            error = m_error;
+        }
+        else if (m_pendingCount > SLOT_MASK)
+        {
+            error = std::make_exception_ptr(ClientRuntimeException("Too many calls are in flight."));
+        }
+        else
+        {
+            int slot = 0;
+            if (m_freeSlots.empty())
+            {
+                slot = static_cast<int>(m_pendingCalls.size());
+                m_pendingCalls.emplace_back();
+            }
+            else
+            {
+                slot = m_freeSlots.back();
+                m_freeSlots.pop_back();
+            }
+            correlationID        = ++m_sequence << Constants::RPC_SLOT_BITS | static_cast<uint64_t>(slot);
+            m_pendingCalls[slot] = {correlationID, std::move(t_callback)};
+            m_pendingCount++;
+            if (t_deadline.count() > 0)
+            {
+                m_deadlines.schedule(slot, std::chrono::steady_clock::now() + t_deadline);
+            }
+        }
+    }
+    if (error != nullptr)
+    {
+        complete(t_callback, "", error);
+        return;
+    }
+    std::string     frame = encodeFrame(RpcFrameType::REQUEST, correlationID, t_request);
+    std::error_code sendError;
+    {
+        std::lock_guard<std::mutex> lock(m_sendMutex);
+        m_client->sendData(frame, sendError);
+    }
+
+    // A frame that was sent only partly leaves the connection out of step, so every call fails, this one included
+
+    if (sendError)
+    {
+        failPendingCalls(std::make_exception_ptr(ClientRuntimeException("Sending the request failed. Error: " + sendError.message())));
+    }
+}
+
+std::future<std::string> FBNetwork::RpcClient::call(const std::string &t_request, const std::chrono::milliseconds t_deadline)
+{
+    std::shared_ptr<std::promise<std::string>> promise = std::make_shared<std::promise<std::string>>();
+    std::future<std::string>                   future  = promise->get_future();
+    call(
+        t_request,
+        [promise](const std::string &t_response, std::exception_ptr t_error)
+        {
+            if (t_error != nullptr)
+            {
+                promise->set_exception(t_error);
+            }
+            else
+            {
+                promise->set_value(t_response);
+            }
+        },
+        t_deadline);
+    return future;
+}
+
+size_t FBNetwork::RpcClient::getPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_pendingCallsMutex);
+    return m_pendingCount;
+}
+
+void FBNetwork::RpcClient::close()
+{
+    m_isRunning.store(false);
+    if (m_reader.joinable() && m_reader.get_id() != std::this_thread::get_id())
+    {
+        m_reader.join();
+    }
+    failPendingCalls(std::make_exception_ptr(ClientRuntimeException("The RPC client was closed.")));
+}
+
+std::string FBNetwork::RpcClient::encodeFrame(const RpcFrameType t_type, const uint64_t t_correlationID, const std::string &t_payload)
+{
+    if (t_payload.size() > Constants::RPC_MAXIMUM_FRAME_SIZE)
+    {
+        throw InvalidArgumentException("The payload is larger than the maximum frame size.");
+    }
+    std::string frame(Constants::RPC_FRAME_HEADER_SIZE + t_payload.size(), '\0');
+    frame[0] = static_cast<char>(t_type);
+    for (int i = 0; i < 8; i++)
+    {
+        frame[1 + i] = static_cast<char>(t_correlationID >> (56 - 8 * i));
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        frame[9 + i] = static_cast<char>(t_payload.size() >> (24 - 8 * i));
+    }
+    std::memcpy(&frame[Constants::RPC_FRAME_HEADER_SIZE], t_payload.data(), t_payload.size());
+    return frame;
+}
+
+FBNetwork::RpcFrameHeader FBNetwork::RpcClient::decodeHeader(const std::string &t_header)
+{
+    if (t_header.size() != Constants::RPC_FRAME_HEADER_SIZE)
+    {
+        throw InvalidArgumentException("The RPC frame header has the wrong size.");
+    }
+    const unsigned char *data = reinterpret_cast<const unsigned char *>(t_header.data());
+    if (data[0] > static_cast<uint8_t>(RpcFrameType::ERROR))
+    {
+        throw InvalidArgumentException("The RPC frame has an unknown type.");
+    }
+    RpcFrameHeader header;
+    header.type = static_cast<RpcFrameType>(data[0]);
+    for (int i = 0; i < 8; i++)
+    {
+        header.correlationID = header.correlationID << 8 | data[1 + i];
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        header.payloadSize = header.payloadSize << 8 | data[9 + i];
+    }
+    if (header.payloadSize > Constants::RPC_MAXIMUM_FRAME_SIZE)
+    {
+        throw InvalidArgumentException("The RPC frame is larger than the maximum frame size.");
+    }
+    return header;
+}
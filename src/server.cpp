@@ -34,6 +34,12 @@ void FBNetwork::Server::setIsServerOnline(const bool t_isServerOnline)
     m_isServerOnline = t_isServerOnline;
 }
 
+void FBNetwork::Server::setIsDraining(const bool t_isDraining)
+{
+    std::unique_lock<std::shared_mutex> lock(m_isDrainingMutex);
+    m_isDraining = t_isDraining;
+}
+
 void FBNetwork::Server::setLocalServerSocketPath(const std::string &t_localServerSocketPath)
 {
     std::unique_lock<std::shared_mutex> lock(m_localServerSocketPathMutex);
@@ -147,37 +153,57 @@ void FBNetwork::Server::setStartDate(const std::string &t_startDate)
 void FBNetwork::Server::setClientFileDescriptor(const int t_clientID, const fileDescriptor t_clientFileDescriptor)
 {
     std::unique_lock<std::shared_mutex> lock(m_clientFileDescriptorMutex);
-    m_clientFileDescriptor[t_clientID] = t_clientFileDescriptor;
+    swapClientFileDescriptor(t_clientID, t_clientFileDescriptor);
 }
 
-void FBNetwork::Server::setClientAddressIpv4(const int t_clientID, std::shared_ptr<sockaddr_in> t_clientAddressIpv4)
+FBNetwork::fileDescriptor FBNetwork::Server::takeClientFileDescriptor(const int t_clientID)
 {
-    std::unique_lock<std::shared_mutex> lock(m_clientAddressIpv4Mutex);
-    if (t_clientAddressIpv4 == nullptr)
+    std::unique_lock<std::shared_mutex> lock(m_clientFileDescriptorMutex);
+    if (thisClientDoesNotExist(t_clientID))
     {
-        throw InvalidArgumentException("Invalid client address.");
+        throw std::out_of_range("Client ID not found.");
     }
-    m_clientAddressIpv4[t_clientID] = t_clientAddressIpv4;
+    return swapClientFileDescriptor(t_clientID, -1);
 }
 
-void FBNetwork::Server::setClientAddressIpv6(const int t_clientID, std::shared_ptr<sockaddr_in6> t_clientAddressIpv6)
+FBNetwork::fileDescriptor FBNetwork::Server::swapClientFileDescriptor(const int t_clientID, const fileDescriptor t_clientFileDescriptor)
 {
-    std::unique_lock<std::shared_mutex> lock(m_clientAddressIpv6Mutex);
-    if (t_clientAddressIpv6 == nullptr)
+
+    // Keep the reverse index from file descriptor to ID in sync, unless the file descriptor already belongs to another ID
+
+    fileDescriptor previousFileDescriptor = -1;
+    auto           previous               = m_clientFileDescriptor.find(t_clientID);
+    if (previous != m_clientFileDescriptor.end() && previous->second != -1)
+    {
+        previousFileDescriptor = previous->second;
+        auto clientID          = m_clientIDs.find(previous->second);
+        if (clientID != m_clientIDs.end() && clientID->second == t_clientID)
+        {
+            m_clientIDs.erase(clientID);
+        }
+    }
+    m_clientFileDescriptor[t_clientID] = t_clientFileDescriptor;
+    if (t_clientFileDescriptor != -1)
     {
-        throw InvalidArgumentException("Invalid client address.");
+        m_clientIDs[t_clientFileDescriptor] = t_clientID;
     }
-    m_clientAddressIpv6[t_clientID] = t_clientAddressIpv6;
+    return previousFileDescriptor;
+}
+
+void FBNetwork::Server::setClientAddress(const int t_clientID, const sockaddr_storage &t_clientAddress)
+{
+    std::unique_lock<std::shared_mutex> lock(m_clientAddressMutex);
+    m_clientAddress[t_clientID] = t_clientAddress;
 }
 
-void FBNetwork::Server::setClientAddressLocal(const int t_clientID, std::shared_ptr<sockaddr_un> t_clientAddressLocal)
+void FBNetwork::Server::setConnectionMetrics(const int t_clientID, std::shared_ptr<ConnectionMetrics> t_clientMetrics)
 {
-    std::unique_lock<std::shared_mutex> lock(m_clientAddressLocalMutex);
-    if (t_clientAddressLocal == nullptr)
+    std::unique_lock<std::shared_mutex> lock(m_clientMetricsMutex);
+    if (t_clientMetrics == nullptr)
     {
-        throw InvalidArgumentException("Invalid client address.");
+        throw InvalidArgumentException("Invalid client metrics.");
     }
-    m_clientAddressLocal[t_clientID] = t_clientAddressLocal;
+    m_clientMetrics[t_clientID] = t_clientMetrics;
 }
 
 void FBNetwork::Server::setCurrentClientID(const int t_currentClientID)
@@ -279,44 +305,36 @@ int FBNetwork::Server::getClientID(const fileDescriptor t_clientFileDescriptor)
         throw InvalidArgumentException("Invalid client file descriptor.");
     }
     std::shared_lock<std::shared_mutex> lock(m_clientFileDescriptorMutex);
-    for (auto const &client : m_clientFileDescriptor)
+    auto                                client = m_clientIDs.find(t_clientFileDescriptor);
+    if (client == m_clientIDs.end())
     {
-        if (client.second == t_clientFileDescriptor)
-        {
-            return client.first;
-        }
+        throw std::out_of_range("Client file descriptor not found.");
     }
-    throw std::out_of_range("Client file descriptor not found.");
+    return client->second;
 }
 
-std::shared_ptr<sockaddr_in> FBNetwork::Server::getClientAddressIpv4(const int t_clientID)
+sockaddr_storage FBNetwork::Server::getClientAddress(const int t_clientID)
 {
-    std::shared_lock<std::shared_mutex> lock(m_clientAddressIpv4Mutex);
+    std::shared_lock<std::shared_mutex> lock(m_clientAddressMutex);
     if (thisClientDoesNotExist(t_clientID))
     {
         throw std::out_of_range("Client ID not found.");
     }
-    return m_clientAddressIpv4.at(t_clientID);
+    return m_clientAddress.at(t_clientID);
 }
 
-std::shared_ptr<sockaddr_in6> FBNetwork::Server::getClientAddressIpv6(const int t_clientID)
+std::shared_ptr<FBNetwork::ConnectionMetrics> FBNetwork::Server::getConnectionMetrics(const int t_clientID)
 {
-    std::shared_lock<std::shared_mutex> lock(m_clientAddressIpv6Mutex);
-    if (thisClientDoesNotExist(t_clientID))
+    std::shared_lock<std::shared_mutex> lock(m_clientMetricsMutex);
+    auto                                clientMetrics = m_clientMetrics.find(t_clientID);
+    if (clientMetrics != m_clientMetrics.end())
     {
-        throw std::out_of_range("Client ID not found.");
+        return clientMetrics->second;
     }
-    return m_clientAddressIpv6.at(t_clientID);
-}
 
-std::shared_ptr<sockaddr_un> FBNetwork::Server::getClientAddressLocal(const int t_clientID)
-{
-    std::shared_lock<std::shared_mutex> lock(m_clientAddressLocalMutex);
-    if (thisClientDoesNotExist(t_clientID))
-    {
-        throw std::out_of_range("Client ID not found.");
-    }
-    return m_clientAddressLocal.at(t_clientID);
+    // Counters of an unknown ID are recorded nowhere, so a bad ID cannot grow the map
+
+    return std::make_shared<ConnectionMetrics>();
 }
 
 int FBNetwork::Server::getCurrentClientID() const
@@ -330,596 +348,2964 @@ timeval FBNetwork::Server::getTimeout()
     return m_timeout;
 }
 
-void FBNetwork::Server::rearrangeClientIDs()
+int FBNetwork::Server::reserveClientID()
 {
-    closeDisconnectedClients();
-    int nextFreeIndex = 0;
-    for (int i = 0; i < getCurrentClientID(); i++)
+    std::unique_lock<std::shared_mutex> lock(m_freeClientIDsMutex);
+    if (!m_freeClientIDs.empty())
     {
-        if (getClientFileDescriptor(i) != -1)
-        {
-            if (i != nextFreeIndex)
-            {
-                setClientFileDescriptor(nextFreeIndex, getClientFileDescriptor(i));
-                if (usesIpv4Domain())
-                {
-                    setClientAddressIpv4(nextFreeIndex, getClientAddressIpv4(i));
-                }
-                else if (usesIpv6Domain())
-                {
-                    setClientAddressIpv6(nextFreeIndex, getClientAddressIpv6(i));
-                }
-                else if (usesLocalDomain())
-                {
-                    setClientAddressLocal(nextFreeIndex, getClientAddressLocal(i));
-                }
-            }
-            nextFreeIndex++;
-        }
+        int clientID = m_freeClientIDs.back();
+        m_freeClientIDs.pop_back();
+        return clientID;
+    }
+    int clientID = getCurrentClientID();
+    if (clientID >= getMaximumCurrentConnections())
+    {
+        return -1;
     }
-    setCurrentClientID(nextFreeIndex);
+    setCurrentClientID(clientID + 1);
+    setClientFileDescriptor(clientID, -1);
+    return clientID;
 }
 
-bool FBNetwork::Server::thisClientDoesNotExist(const int t_clientID) const
+void FBNetwork::Server::releaseClientID(const int t_clientID)
 {
-    return t_clientID > getCurrentClientID();
+    std::unique_lock<std::shared_mutex> lock(m_freeClientIDsMutex);
+    m_freeClientIDs.push_back(t_clientID);
 }
 
-bool FBNetwork::Server::isServerOnline()
+FBNetwork::fileDescriptor FBNetwork::Server::acceptConnection(const fileDescriptor t_serverFileDescriptor,
+                                                              sockaddr_storage    &t_clientAddress)
 {
-    std::shared_lock<std::shared_mutex> lock(m_isServerOnlineMutex);
-    return m_isServerOnline;
+    socklen_t clientAddressLength = sizeof(sockaddr_storage);
+    t_clientAddress               = {};
+#ifdef __APPLE__
+    fileDescriptor clientFileDescriptor =
+        accept(t_serverFileDescriptor, reinterpret_cast<sockaddr *>(&t_clientAddress), &clientAddressLength);
+    if (clientFileDescriptor != -1 &&
+        (fcntl(clientFileDescriptor, F_SETFL, fcntl(clientFileDescriptor, F_GETFL, 0) | O_NONBLOCK) == -1 ||
+         fcntl(clientFileDescriptor, F_SETFD, FD_CLOEXEC) == -1))
+    {
+        int error = errno;
+        close(clientFileDescriptor);
+        errno = error;
+        return -1;
+    }
+    return clientFileDescriptor;
+#else
+    return accept4(t_serverFileDescriptor, reinterpret_cast<sockaddr *>(&t_clientAddress), &clientAddressLength,
+                   SOCK_NONBLOCK | SOCK_CLOEXEC);
+#endif
 }
 
-FBNetwork::port FBNetwork::Server::getPort()
+void FBNetwork::Server::addClient(const int t_clientID, const fileDescriptor t_clientFileDescriptor,
+                                  const sockaddr_storage &t_clientAddress)
 {
-    std::shared_lock<std::shared_mutex> lock(m_portMutex);
-    return m_port;
+    setClientFileDescriptor(t_clientID, t_clientFileDescriptor);
+    setClientAddress(t_clientID, t_clientAddress);
+    setData(t_clientID, "");
+    setConnectionMetrics(t_clientID, std::make_shared<ConnectionMetrics>());
+    takeResidualData(t_clientID);
+    dropOutputQueue(t_clientID);
+    resetFlowControl(t_clientID);
+    resetCompression(t_clientID);
+    try
+    {
+        std::shared_lock<std::shared_mutex> lock(m_socketOptionsMutex);
+        m_socketOptions.applyToConnection(t_clientFileDescriptor, getDomain());
+    }
+    catch (SystemRuntimeException &e)
+    {
+        m_metrics.recordError();
+    }
+    startTls(t_clientID, t_clientFileDescriptor);
+    startClientDeadlines(t_clientID);
+    m_metrics.recordAccept();
 }
 
-std::string FBNetwork::Server::getData(const int t_clientID)
+int FBNetwork::Server::getOpenClientsCount()
 {
-    std::shared_lock<std::shared_mutex> lock(m_dataMutex);
-
-    return m_data.at(t_clientID);
+    std::shared_lock<std::shared_mutex> lock(m_freeClientIDsMutex);
+    return getCurrentClientID() - static_cast<int>(m_freeClientIDs.size());
 }
 
-std::string FBNetwork::Server::getStartDate()
+void FBNetwork::Server::startEventQueue()
 {
-    std::shared_lock<std::shared_mutex> lock(m_startDateMutex);
-    return m_startDate;
-}
+    try
+    {
+        std::shared_ptr<EventQueue> eventQueue = std::make_shared<EventQueue>();
+        eventQueue->setServer(getServerFileDescriptor());
+        if (m_wakeUpFileDescriptors[0] == -1)
+        {
 
-time_t FBNetwork::Server::getLifeTime()
-{
-    std::shared_lock<std::shared_mutex> lock(m_lifeTimeMutex);
-    return time(0) - getStartTime();
-}
+            // The pipe lets post() wake up getPendingEvents(), it lives as long as the server
 
-std::string FBNetwork::Server::getClientIpAddress(const int t_clientID)
-{
-    std::shared_lock<std::shared_mutex> lock(m_clientIpAddressMutex);
-    char                                ip[INET_ADDRSTRLEN];
-    char                                ip6[INET6_ADDRSTRLEN];
-    if (usesIpv4Domain() == true)
-    {
-        if (inet_ntop(AF_INET, &getClientAddressIpv4(t_clientID)->sin_addr, ip, sizeof(ip)) == nullptr)
+            if (pipe(m_wakeUpFileDescriptors) == -1)
+            {
+                throw ServerCreationException("Creating the wake-up pipe failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+            }
+            for (fileDescriptor wakeUpFileDescriptor : m_wakeUpFileDescriptors)
+            {
+                fcntl(wakeUpFileDescriptor, F_SETFL, fcntl(wakeUpFileDescriptor, F_GETFL, 0) | O_NONBLOCK);
+                fcntl(wakeUpFileDescriptor, F_SETFD, FD_CLOEXEC);
+            }
+        }
+        eventQueue->addClient(m_wakeUpFileDescriptors[0]);
+        if (m_reserveFileDescriptor == -1)
         {
-            throw ServerRuntimeException("Failed to convert IPv4 address to string. Error: " + ExtendedSystem::getCurrentErrnoError());
+
+            // Kept for shedWithReserveFileDescriptor(), a failure only costs that fallback
+
+            m_reserveFileDescriptor = open("/dev/null", O_RDONLY | O_CLOEXEC);
         }
-        return std::string(ip);
+        setEventQueue(eventQueue);
     }
-    else if (usesIpv6Domain() == true)
+    catch (ServerRuntimeException &e)
     {
-        if (inet_ntop(AF_INET6, &getClientAddressIpv6(t_clientID)->sin6_addr, ip6, sizeof(ip6)) == nullptr)
-        {
-            throw ServerRuntimeException("Failed to convert IPv6 address to string. Error: " + ExtendedSystem::getCurrentErrnoError());
-        }
-        return std::string(ip6);
+        throw ServerCreationException(e.what());
     }
-    else if (usesLocalDomain() == true)
+
+    setIsServerOnline(true);
+    setIsDraining(false);
+    setStartTime(time(0));
+    setStartDate(std::string(ExtendedSystem::getCachedTime(TimeFormat::DATE_TIME)));
+}
+
+bool FBNetwork::Server::thisClientDoesNotExist(const int t_clientID) const
+{
+    return t_clientID < 0 || t_clientID >= getCurrentClientID();
+}
+
+void FBNetwork::Server::scheduleClientTimer(const int t_clientID, ClientDeadlines &t_clientDeadlines)
+{
+    std::chrono::steady_clock::time_point deadline =
+        std::min({t_clientDeadlines.idle, t_clientDeadlines.read, t_clientDeadlines.write, t_clientDeadlines.drain, t_clientDeadlines.resume});
+    if (deadline == std::chrono::steady_clock::time_point::max())
     {
-        return "localhost";
+        m_timingWheel.cancel(t_clientID);
+        t_clientDeadlines.scheduled = deadline;
+        return;
     }
-    else
+    if (deadline < t_clientDeadlines.scheduled || !m_timingWheel.isScheduled(t_clientID))
     {
-        throw InvalidDomainException("You try to get the IP address of an invalid domain.");
+        m_timingWheel.schedule(t_clientID, deadline);
+        t_clientDeadlines.scheduled = deadline;
     }
 }
 
-int FBNetwork::Server::getCurrentlyConnectedClientsCount()
+void FBNetwork::Server::startClientDeadlines(const int t_clientID)
 {
-    std::shared_lock<std::shared_mutex> lock(m_clientsCountMutex);
-    int                                 count = 0;
-    for (int i = 0; i < getCurrentClientID(); i++)
+    if (!m_hasClientTimeouts.load(std::memory_order_relaxed))
     {
-        if (!isDisconnected(i))
-        {
-            count++;
-        }
+        return;
     }
-    return count;
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    ClientDeadlines            &clientDeadlines = m_clientDeadlines[t_clientID];
+    clientDeadlines                             = ClientDeadlines();
+    if (m_idleTimeout.count() > 0)
+    {
+        clientDeadlines.idle = std::chrono::steady_clock::now() + m_idleTimeout;
+    }
+    scheduleClientTimer(t_clientID, clientDeadlines);
 }
 
-FBNetwork::Server::Server(const int t_domain, const port t_port, const int t_maximumCurrentConnections)
+void FBNetwork::Server::refreshIdleDeadline(const int t_clientID)
 {
-    try
+    if (!m_hasClientTimeouts.load(std::memory_order_relaxed))
     {
-        setDomain(t_domain);
-        setPort(t_port);
-        setMaximumCurrentConnections(t_maximumCurrentConnections);
+        return;
     }
-    catch (InvalidArgumentException &e)
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    if (m_idleTimeout.count() <= 0)
     {
-        throw e;
+        return;
     }
-    if (getDomain() == Domain::IPV4_DOMAIN)
+    ClientDeadlines &clientDeadlines = m_clientDeadlines[t_clientID];
+    clientDeadlines.idle             = std::chrono::steady_clock::now() + m_idleTimeout;
+    scheduleClientTimer(t_clientID, clientDeadlines);
+}
+
+std::chrono::steady_clock::time_point FBNetwork::Server::armReadDeadline(const int t_clientID)
+{
+    if (!m_hasClientTimeouts.load(std::memory_order_relaxed))
     {
-        setUsesIpv4Domain(true);
-        setUsesIpv6Domain(false);
-        setUsesLocalDomain(false);
+        return std::chrono::steady_clock::time_point::max();
     }
-    else if (getDomain() == Domain::IPV6_DOMAIN)
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    if (m_readTimeout.count() <= 0)
     {
-        setUsesIpv4Domain(false);
-        setUsesIpv6Domain(true);
-        setUsesLocalDomain(false);
+        return std::chrono::steady_clock::time_point::max();
     }
-    else
+    ClientDeadlines &clientDeadlines = m_clientDeadlines[t_clientID];
+    if (clientDeadlines.read == std::chrono::steady_clock::time_point::max())
     {
-        throw InvalidDomainException("Please use either IPv4 or IPv6.");
+        clientDeadlines.read = std::chrono::steady_clock::now() + m_readTimeout;
+        scheduleClientTimer(t_clientID, clientDeadlines);
     }
-    setTimeout(FBNetwork::Constants::DEFAULT_TIMEOUT);
+    return clientDeadlines.read;
 }
 
-FBNetwork::Server::Server(std::string &t_socketPath, const port t_port, const int t_maximumCurrentConnections)
+std::chrono::steady_clock::time_point FBNetwork::Server::armWriteDeadline(const int t_clientID)
 {
-    setDomain(Domain::LOCAL_DOMAIN);
-    try
+    if (!m_hasClientTimeouts.load(std::memory_order_relaxed))
     {
-        setLocalServerSocketPath(t_socketPath);
-        setPort(t_port);
-        setMaximumCurrentConnections(t_maximumCurrentConnections);
+        return std::chrono::steady_clock::time_point::max();
     }
-    catch (InvalidArgumentException &e)
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    if (m_writeTimeout.count() <= 0)
     {
-        throw e;
+        return std::chrono::steady_clock::time_point::max();
     }
-    setUsesIpv4Domain(false);
-    setUsesIpv6Domain(false);
-    setUsesLocalDomain(true);
-    setTimeout(FBNetwork::Constants::DEFAULT_TIMEOUT);
+    ClientDeadlines &clientDeadlines = m_clientDeadlines[t_clientID];
+    if (clientDeadlines.write == std::chrono::steady_clock::time_point::max())
+    {
+        clientDeadlines.write = std::chrono::steady_clock::now() + m_writeTimeout;
+        scheduleClientTimer(t_clientID, clientDeadlines);
+    }
+    return clientDeadlines.write;
 }
 
-FBNetwork::Server::~Server()
+void FBNetwork::Server::disarmReadDeadline(const int t_clientID)
 {
-    stopServer();
+    if (!m_hasClientTimeouts.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    auto                        clientDeadlines = m_clientDeadlines.find(t_clientID);
+    if (clientDeadlines != m_clientDeadlines.end())
+    {
+
+        // Leave the timer where it is, it is scheduled again for the remaining deadlines when it expires
+
+        clientDeadlines->second.read = std::chrono::steady_clock::time_point::max();
+    }
 }
 
-void FBNetwork::Server::startServer()
+void FBNetwork::Server::disarmWriteDeadline(const int t_clientID)
 {
-    try
+    if (!m_hasClientTimeouts.load(std::memory_order_relaxed))
     {
-        setServerFileDescriptor(socket(getDomain(), SOCK_STREAM, 0));
+        return;
     }
-    catch (InvalidArgumentException &e)
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    auto                        clientDeadlines = m_clientDeadlines.find(t_clientID);
+    if (clientDeadlines != m_clientDeadlines.end())
     {
-        throw ServerCreationException("Creating the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        clientDeadlines->second.write = std::chrono::steady_clock::time_point::max();
     }
+}
 
-    int opt = 1;
-    if (setsockopt(getServerFileDescriptor(), SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) == -1)
+void FBNetwork::Server::cancelClientDeadlines(const int t_clientID)
+{
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    m_clientDeadlines.erase(t_clientID);
+    m_timingWheel.cancel(t_clientID);
+}
+
+std::vector<int> FBNetwork::Server::expireClientDeadlines(std::vector<int> &t_resumedClientIDs)
+{
+    std::vector<int>            expiredClientIDs;
+    std::vector<int>            timedOutClientIDs;
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    if (m_timingWheel.getCount() == 0)
     {
-        close(getServerFileDescriptor());
-        throw ServerCreationException("Setting socket options failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        return timedOutClientIDs;
     }
-    if (usesIpv4Domain())
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    m_timingWheel.advance(now, expiredClientIDs);
+    for (int clientID : expiredClientIDs)
     {
-        std::shared_ptr<sockaddr_in> serverAddressIpv4 = std::make_shared<sockaddr_in>();
-        *serverAddressIpv4                             = {};
-        serverAddressIpv4->sin_family                  = getDomain();
-        serverAddressIpv4->sin_addr.s_addr             = INADDR_ANY;
-        serverAddressIpv4->sin_port                    = htons(getPort());
-        if (bind(getServerFileDescriptor(), reinterpret_cast<sockaddr *>(serverAddressIpv4.get()), sizeof(sockaddr_in)) == -1)
+        auto clientDeadlines = m_clientDeadlines.find(clientID);
+        if (clientDeadlines == m_clientDeadlines.end())
         {
-            close(getServerFileDescriptor());
-            throw ServerCreationException("Binding the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+            continue;
         }
-
-        // Do not catch InvalidArgumentException here, because it is not possible to throw it. See that we have already checked if
-        // serverAddressIpv4 is nullptr.
-
-        setServerAddressIpv4(serverAddressIpv4);
-    }
-    else if (usesIpv6Domain())
-    {
-        std::shared_ptr<sockaddr_in6> serverAddressIpv6 = std::make_shared<sockaddr_in6>();
-        *serverAddressIpv6                              = {};
-        serverAddressIpv6->sin6_family                  = getDomain();
-        serverAddressIpv6->sin6_addr                    = in6addr_any;
-        serverAddressIpv6->sin6_port                    = htons(getPort());
-        if (bind(getServerFileDescriptor(), reinterpret_cast<sockaddr *>(serverAddressIpv6.get()), sizeof(sockaddr_in6)) == -1)
+        ClientDeadlines &deadlines = clientDeadlines->second;
+        deadlines.scheduled        = std::chrono::steady_clock::time_point::max();
+        if (deadlines.resume <= now)
         {
-            close(getServerFileDescriptor());
-            throw ServerCreationException("Binding the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+            t_resumedClientIDs.push_back(clientID);
+            deadlines.resume = std::chrono::steady_clock::time_point::max();
         }
-
-        // Do not catch InvalidArgumentException here, because it is not possible to throw it. See that we have already checked if
-        // serverAddressIpv6 is nullptr.
-
-        setServerAddressIpv6(serverAddressIpv6);
-    }
-    else if (usesLocalDomain())
-    {
-        std::shared_ptr<sockaddr_un> serverAddressLocal = std::make_shared<sockaddr_un>();
-        *serverAddressLocal                             = {};
-        serverAddressLocal->sun_family                  = getDomain();
-        strncpy(serverAddressLocal->sun_path, getLocalServerSocketPath().c_str(), sizeof(getLocalServerSocketPath()));
-        if (unlink(getLocalServerSocketPath().c_str()) == -1 && errno != ENOENT)
+        if (std::min({deadlines.idle, deadlines.read, deadlines.write, deadlines.drain}) <= now)
         {
-            throw ServerCreationException("Removing the existing socket file failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+            timedOutClientIDs.push_back(clientID);
+            m_clientDeadlines.erase(clientDeadlines);
         }
-        if (bind(getServerFileDescriptor(), reinterpret_cast<sockaddr *>(serverAddressLocal.get()), sizeof(sockaddr_un)) == -1)
+        else
         {
-            throw ServerCreationException("Binding the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+            scheduleClientTimer(clientID, deadlines);
         }
+    }
+    return timedOutClientIDs;
+}
 
-        // Do not catch InvalidArgumentException here, because it is not possible to throw it. See that we have already checked if
-        // serverAddressLocal is nullptr.
+int FBNetwork::Server::getMillisecondsUntilNextDeadline()
+{
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    return m_timingWheel.getMillisecondsUntilNextExpiry(std::chrono::steady_clock::now());
+}
 
-        setServerAddressLocal(serverAddressLocal);
+int FBNetwork::Server::getPollTimeout(const timeval &t_timeout, const std::chrono::steady_clock::time_point t_deadline)
+{
+    int64_t timeout = static_cast<int64_t>(t_timeout.tv_sec) * 1000 + (t_timeout.tv_usec + 999) / 1000;
+    if (t_deadline != std::chrono::steady_clock::time_point::max())
+    {
+        int64_t remainingTime =
+            std::chrono::ceil<std::chrono::milliseconds>(t_deadline - std::chrono::steady_clock::now()).count();
+        timeout = std::min(timeout, std::max<int64_t>(remainingTime, 0));
+    }
+    return static_cast<int>(std::min<int64_t>(timeout, std::numeric_limits<int>::max()));
+}
+
+void FBNetwork::Server::startTls(const int t_clientID, const fileDescriptor t_clientFileDescriptor)
+{
+#ifdef FBNETWORK_WITH_TLS
+    std::unique_lock<std::shared_mutex> lock(m_tlsMutex);
+    m_tlsBufferedClientIDs.erase(t_clientID);
+    if (m_tlsContext == nullptr)
+    {
+        m_tlsConnections.erase(t_clientID);
+        return;
     }
     try
     {
-        std::shared_ptr<EventQueue> eventQueue = std::make_shared<EventQueue>();
-        eventQueue->setServer(getServerFileDescriptor());
-        setEventQueue(eventQueue);
+        m_tlsConnections[t_clientID] = std::make_shared<TlsConnection>(m_tlsContext, t_clientFileDescriptor);
     }
-    catch (ServerRuntimeException &e)
+    catch (SystemRuntimeException &e)
     {
-        throw ServerCreationException(e.what());
+        m_tlsConnections.erase(t_clientID);
+        throw ServerRuntimeException(e.what());
     }
-
-    setIsServerOnline(true);
-    setStartTime(time(0));
-    setStartDate(ExtendedSystem::getCurrentDate() + " " + ExtendedSystem::getCurrentTime());
+#endif
 }
 
-void FBNetwork::Server::startListening()
+void FBNetwork::Server::stopTls(const int t_clientID)
 {
-    if (listen(getServerFileDescriptor(), getMaximumCurrentConnections()) == -1)
+#ifdef FBNETWORK_WITH_TLS
+    std::unique_lock<std::shared_mutex> lock(m_tlsMutex);
+    auto                                tlsConnection = m_tlsConnections.find(t_clientID);
+    if (tlsConnection != m_tlsConnections.end())
     {
-        throw ServerRuntimeException("Listening on the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        tlsConnection->second->shutdown();
+        m_tlsConnections.erase(tlsConnection);
     }
+    m_tlsBufferedClientIDs.erase(t_clientID);
+#endif
 }
 
-void FBNetwork::Server::stopServer()
+bool FBNetwork::Server::completeTlsHandshake(const int t_clientID)
 {
-    try
+#ifdef FBNETWORK_WITH_TLS
+    std::shared_ptr<TlsConnection> tlsConnection = getTlsConnection(t_clientID);
+    if (tlsConnection == nullptr || tlsConnection->isHandshakeDone())
     {
-        for (int i = 0; i < getCurrentClientID(); i++)
-        {
-            if (!isDisconnected(i))
-            {
-                close(getClientFileDescriptor(i));
-            }
-        }
+        return true;
     }
-    catch (ServerRuntimeException &e)
+    fileDescriptor clientFileDescriptor = getClientFileDescriptor(t_clientID);
+    while (tlsConnection->handshake() == -1)
     {
-        throw e;
+        if (errno == EAGAIN && tlsConnection->getPollEvents(POLLIN) == POLLIN)
+        {
+
+            // The next flight of the client is not there yet, the event queue reports it
+
+            return false;
+        }
+        if (errno == EAGAIN)
+        {
+
+            // The event queue only watches for reading, wait for the rare full send buffer here
+
+            pollfd clientPollFileDescriptor = {clientFileDescriptor, POLLOUT, 0};
+            if (poll(&clientPollFileDescriptor, 1, getPollTimeout(getTimeout(), std::chrono::steady_clock::time_point::max())) > 0)
+            {
+                continue;
+            }
+        }
+        m_metrics.recordError();
+        getConnectionMetrics(t_clientID)->recordError();
+        try
+        {
+            closeClient(t_clientID);
+        }
+        catch (ServerRuntimeException &e)
+        {
+        }
+        return false;
+    }
+
+    // The client may send its first request together with the end of the handshake
+
+    pollfd clientPollFileDescriptor = {clientFileDescriptor, POLLIN, 0};
+    return tlsConnection->getPendingBytes() > 0 || poll(&clientPollFileDescriptor, 1, 0) > 0;
+#else
+    return true;
+#endif
+}
+
+std::vector<int> FBNetwork::Server::getTlsBufferedClientIDs()
+{
+#ifdef FBNETWORK_WITH_TLS
+    std::shared_lock<std::shared_mutex> lock(m_tlsMutex);
+    return std::vector<int>(m_tlsBufferedClientIDs.begin(), m_tlsBufferedClientIDs.end());
+#else
+    return std::vector<int>();
+#endif
+}
+
+bool FBNetwork::Server::hasBufferedData(const int t_clientID)
+{
+#ifdef FBNETWORK_WITH_TLS
+    std::shared_lock<std::shared_mutex> lock(m_tlsMutex);
+    return m_tlsBufferedClientIDs.count(t_clientID) > 0;
+#else
+    return false;
+#endif
+}
+
+std::string FBNetwork::Server::takeResidualData(const int t_clientID)
+{
+    std::unique_lock<std::shared_mutex> lock(m_residualDataMutex);
+    auto                                residualData = m_residualData.find(t_clientID);
+    if (residualData == m_residualData.end())
+    {
+        return std::string();
+    }
+    std::string data = std::move(residualData->second);
+    m_residualData.erase(residualData);
+    m_residualClientIDs.erase(t_clientID);
+    return data;
+}
+
+void FBNetwork::Server::storeResidualData(const int t_clientID, std::string &&t_residualData, const bool t_isReady)
+{
+    if (t_residualData.empty())
+    {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(m_residualDataMutex);
+    m_residualData[t_clientID] = std::move(t_residualData);
+    if (t_isReady)
+    {
+        m_residualClientIDs.insert(t_clientID);
+    }
+}
+
+void FBNetwork::Server::suspendRead(const int t_clientID, std::string &&t_partialMessage)
+{
+    if (t_partialMessage.empty())
+    {
+        disarmReadDeadline(t_clientID);
+        return;
+    }
+    storeResidualData(t_clientID, std::move(t_partialMessage), false);
+}
+
+void FBNetwork::Server::suspendFrame(const int t_clientID, const std::string &t_header)
+{
+    armReadDeadline(t_clientID);
+    storeResidualData(t_clientID, t_header + takeResidualData(t_clientID), false);
+}
+
+std::vector<int> FBNetwork::Server::takeResidualClientIDs()
+{
+    std::unique_lock<std::shared_mutex> lock(m_residualDataMutex);
+    std::vector<int>                    clientIDs(m_residualClientIDs.begin(), m_residualClientIDs.end());
+    m_residualClientIDs.clear();
+    return clientIDs;
+}
+
+bool FBNetwork::Server::hasResidualData(const int t_clientID)
+{
+    std::shared_lock<std::shared_mutex> lock(m_residualDataMutex);
+    return m_residualData.count(t_clientID) > 0;
+}
+
+bool FBNetwork::Server::queuePayload(const int t_clientID, const sharedPayload &t_payload)
+{
+    size_t           outputQueueLimit = 0;
+    SlowClientPolicy slowClientPolicy = SlowClientPolicy::DROP_MESSAGE;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_slowClientPolicyMutex);
+        outputQueueLimit = m_outputQueueLimit;
+        slowClientPolicy = m_slowClientPolicy;
+    }
+    bool isQueued = true;
+    {
+        std::unique_lock<std::shared_mutex> lock(m_outputQueuesMutex);
+        if (thisClientDoesNotExist(t_clientID) || getClientFileDescriptor(t_clientID) == -1)
+        {
+            return false;
+        }
+        OutputQueue &outputQueue = m_outputQueues[t_clientID];
+        if (!outputQueue.payloads.empty() && outputQueue.queuedBytes + t_payload->size() > outputQueueLimit)
+        {
+            m_metrics.recordDroppedMessage();
+            if (slowClientPolicy == SlowClientPolicy::DROP_MESSAGE)
+            {
+                return false;
+            }
+            isQueued = false;
+        }
+        else
+        {
+            outputQueue.payloads.push_back(t_payload);
+            outputQueue.queuedBytes += t_payload->size();
+
+            // A client that has more queued waits for room in its socket buffer and one that is written to gets the payload from its
+            // writer, either way the new payload goes after the others
+
+            if (outputQueue.payloads.size() > 1 || outputQueue.isWriting)
+            {
+                return true;
+            }
+        }
+    }
+    if (isQueued && writeOutputQueue(t_clientID))
+    {
+        return true;
+    }
+    closeClient(t_clientID);
+    return isQueued;
+}
+
+bool FBNetwork::Server::writeOutputQueue(const int t_clientID)
+{
+    fileDescriptor                     clientFileDescriptor = getClientFileDescriptor(t_clientID);
+    std::shared_ptr<ConnectionMetrics> connectionMetrics    = getConnectionMetrics(t_clientID);
+    bool                               usesTls              = false;
+#ifdef FBNETWORK_WITH_TLS
+    usesTls = getTlsConnection(t_clientID) != nullptr;
+#endif
+    std::unique_lock<std::shared_mutex> lock(m_outputQueuesMutex);
+    auto                                outputQueue = m_outputQueues.find(t_clientID);
+    if (outputQueue == m_outputQueues.end() || outputQueue->second.isWriting)
+    {
+        return true;
+    }
+
+    // Own the socket while the lock is released for the writes, other threads queue behind and this loop picks their payloads up
+
+    outputQueue->second.isWriting = true;
+    bool          isWritten       = true;
+    sharedPayload batch[Constants::OUTPUT_QUEUE_BATCH_SIZE];
+    while (!outputQueue->second.payloads.empty())
+    {
+        size_t batchSize = usesTls ? 1 : std::min(outputQueue->second.payloads.size(), Constants::OUTPUT_QUEUE_BATCH_SIZE);
+        size_t offset    = outputQueue->second.offset;
+        std::copy_n(outputQueue->second.payloads.begin(), batchSize, batch);
+        lock.unlock();
+        ssize_t bytesWritten = -1;
+        if (usesTls)
+        {
+            bytesWritten = transmit(t_clientID, clientFileDescriptor, batch[0]->data() + offset, batch[0]->size() - offset);
+        }
+        else
+        {
+
+            // Hand several payloads to the kernel with one call, straight from the shared buffers
+
+            iovec vectors[Constants::OUTPUT_QUEUE_BATCH_SIZE];
+            for (size_t i = 0; i < batchSize; i++)
+            {
+                vectors[i].iov_base = const_cast<char *>(batch[i]->data() + (i == 0 ? offset : 0));
+                vectors[i].iov_len  = batch[i]->size() - (i == 0 ? offset : 0);
+            }
+            msghdr message     = {};
+            message.msg_iov    = vectors;
+            message.msg_iovlen = batchSize;
+            bytesWritten       = sendmsg(clientFileDescriptor, &message, MSG_NOSIGNAL);
+        }
+        int error = errno;
+        if (bytesWritten == -1 && error != EINTR && error != EAGAIN && error != EWOULDBLOCK)
+        {
+            m_metrics.recordError();
+            connectionMetrics->recordError();
+        }
+        else if (bytesWritten == -1 && error != EINTR)
+        {
+            m_metrics.recordWouldBlock();
+            connectionMetrics->recordWouldBlock();
+        }
+        else if (bytesWritten != -1)
+        {
+            m_metrics.recordWrite(bytesWritten);
+            connectionMetrics->recordWrite(bytesWritten);
+            refreshIdleDeadline(t_clientID);
+        }
+        lock.lock();
+        outputQueue = m_outputQueues.find(t_clientID);
+        if (outputQueue == m_outputQueues.end())
+        {
+
+            // The client was closed while the lock was released, there is nothing left to write
+
+            m_outputQueueWritten.notify_all();
+            return true;
+        }
+        if (bytesWritten == -1)
+        {
+            if (error == EINTR)
+            {
+                continue;
+            }
+            isWritten = error == EAGAIN || error == EWOULDBLOCK;
+            break;
+        }
+        size_t bytesLeft = static_cast<size_t>(bytesWritten);
+        outputQueue->second.queuedBytes -= bytesLeft;
+        while (bytesLeft > 0)
+        {
+            size_t payloadBytesLeft = outputQueue->second.payloads.front()->size() - outputQueue->second.offset;
+            if (bytesLeft < payloadBytesLeft)
+            {
+                outputQueue->second.offset += bytesLeft;
+                break;
+            }
+            bytesLeft -= payloadBytesLeft;
+            outputQueue->second.payloads.pop_front();
+            outputQueue->second.offset = 0;
+        }
+    }
+
+    // The write interest is changed under the lock of the output queues, so a payload queued by another thread cannot lose it
+
+    try
+    {
+        watchWritable(t_clientID, isWritten && !outputQueue->second.payloads.empty());
+    }
+    catch (ServerRuntimeException &e)
+    {
+        m_metrics.recordError();
+        isWritten = false;
+    }
+    outputQueue->second.isWriting = false;
+    m_outputQueueWritten.notify_all();
+    return isWritten;
+}
+
+void FBNetwork::Server::flushOutputQueue(const int t_clientID)
+{
+    if (!writeOutputQueue(t_clientID))
+    {
+        closeClient(t_clientID);
+    }
+}
+
+void FBNetwork::Server::acquireOutput(const int t_clientID, const fileDescriptor t_clientFileDescriptor,
+                                      const std::chrono::steady_clock::time_point t_deadline, std::error_code &t_error)
+{
+    t_error.clear();
+    bool                                isBlocked = false;
+    std::unique_lock<std::shared_mutex> lock(m_outputQueuesMutex);
+    while (true)
+    {
+        if (getClientFileDescriptor(t_clientID) == -1)
+        {
+            t_error = NetworkError::CONNECTION_CLOSED;
+            return;
+        }
+        OutputQueue &outputQueue = m_outputQueues[t_clientID];
+        if (!outputQueue.isWriting && outputQueue.payloads.empty())
+        {
+            outputQueue.isWriting = true;
+            return;
+        }
+        if (outputQueue.isWriting)
+        {
+            if (m_outputQueueWritten.wait_until(lock, t_deadline) == std::cv_status::timeout)
+            {
+                t_error = NetworkError::TIMEOUT;
+                return;
+            }
+            continue;
+        }
+        lock.unlock();
+        if (isBlocked)
+        {
+            pollfd clientPollFileDescriptor = {t_clientFileDescriptor, getPollEvents(t_clientID, POLLOUT), 0};
+            if (poll(&clientPollFileDescriptor, 1, getPollTimeout(getTimeout(), t_deadline)) == 0)
+            {
+                t_error = NetworkError::TIMEOUT;
+                return;
+            }
+        }
+        if (!writeOutputQueue(t_clientID))
+        {
+            t_error = NetworkError::CONNECTION_CLOSED;
+            return;
+        }
+        isBlocked = true;
+        lock.lock();
+    }
+}
+
+void FBNetwork::Server::releaseOutput(const int t_clientID, const bool t_isComplete)
+{
+    bool hasQueuedPayloads = false;
+    {
+        std::unique_lock<std::shared_mutex> lock(m_outputQueuesMutex);
+        auto                                outputQueue = m_outputQueues.find(t_clientID);
+        if (outputQueue != m_outputQueues.end())
+        {
+            outputQueue->second.isWriting = false;
+            hasQueuedPayloads             = !outputQueue->second.payloads.empty();
+        }
+        m_outputQueueWritten.notify_all();
+    }
+    if (hasQueuedPayloads && t_isComplete)
+    {
+        flushOutputQueue(t_clientID);
+    }
+}
+
+void FBNetwork::Server::dropOutputQueue(const int t_clientID)
+{
+    {
+        std::unique_lock<std::shared_mutex> lock(m_outputQueuesMutex);
+        m_outputQueues.erase(t_clientID);
+
+        // A thread waiting for the writer of the client finds the client closed
+
+        m_outputQueueWritten.notify_all();
+    }
+    std::unique_lock<std::shared_mutex> lock(m_topicsMutex);
+    for (auto topic = m_topics.begin(); topic != m_topics.end();)
+    {
+        topic->second.erase(t_clientID);
+        topic = topic->second.empty() ? m_topics.erase(topic) : std::next(topic);
+    }
+}
+
+void FBNetwork::Server::watchWritable(const int t_clientID, const bool t_isWritable)
+{
+    std::lock_guard<std::mutex> lock(m_clientInterestsMutex);
+    ClientInterest             &clientInterest = m_clientInterests[t_clientID];
+    if (clientInterest.isWritable == t_isWritable)
+    {
+        return;
+    }
+    getEventQueue()->setInterest(getClientFileDescriptor(t_clientID), clientInterest.isReadable, t_isWritable);
+    clientInterest.isWritable = t_isWritable;
+}
+
+void FBNetwork::Server::pauseReading(const int t_clientID)
+{
+    std::lock_guard<std::mutex> lock(m_clientInterestsMutex);
+    ClientInterest             &clientInterest = m_clientInterests[t_clientID];
+    if (!clientInterest.isReadable)
+    {
+        return;
+    }
+    getEventQueue()->setInterest(getClientFileDescriptor(t_clientID), false, clientInterest.isWritable);
+    clientInterest.isReadable = false;
+}
+
+bool FBNetwork::Server::resumeReading(const int t_clientID)
+{
+    std::lock_guard<std::mutex> lock(m_clientInterestsMutex);
+    auto                        clientInterest = m_clientInterests.find(t_clientID);
+    if (clientInterest == m_clientInterests.end() || clientInterest->second.isReadable)
+    {
+        return false;
+    }
+    getEventQueue()->setInterest(getClientFileDescriptor(t_clientID), true, clientInterest->second.isWritable);
+    clientInterest->second.isReadable = true;
+    bool hasPendingData               = clientInterest->second.hasPendingData;
+    clientInterest->second.hasPendingData = false;
+    return hasPendingData;
+}
+
+bool FBNetwork::Server::isReadingPaused(const int t_clientID)
+{
+    std::lock_guard<std::mutex> lock(m_clientInterestsMutex);
+    auto                        clientInterest = m_clientInterests.find(t_clientID);
+    return clientInterest != m_clientInterests.end() && !clientInterest->second.isReadable;
+}
+
+bool FBNetwork::Server::deferIfPaused(const int t_clientID)
+{
+    std::lock_guard<std::mutex> lock(m_clientInterestsMutex);
+    auto                        clientInterest = m_clientInterests.find(t_clientID);
+    if (clientInterest == m_clientInterests.end() || clientInterest->second.isReadable)
+    {
+        return false;
+    }
+    clientInterest->second.hasPendingData = true;
+    return true;
+}
+
+FBNetwork::ClientRateLimit &FBNetwork::Server::getClientRateLimit(const int t_clientID, const std::chrono::steady_clock::time_point t_now)
+{
+    auto clientRateLimit = m_clientRateLimits.find(t_clientID);
+    if (clientRateLimit != m_clientRateLimits.end())
+    {
+        return clientRateLimit->second;
+    }
+    ClientRateLimit newRateLimit;
+    if (m_rateLimits.bytesPerSecond > 0)
+    {
+        double burst       = m_rateLimits.bytesBurst > 0 ? m_rateLimits.bytesBurst : m_rateLimits.bytesPerSecond;
+        newRateLimit.bytes = TokenBucket(m_rateLimits.bytesPerSecond, burst, t_now);
+    }
+    if (m_rateLimits.messagesPerSecond > 0)
+    {
+        double burst          = m_rateLimits.messagesBurst > 0 ? m_rateLimits.messagesBurst : m_rateLimits.messagesPerSecond;
+        newRateLimit.messages = TokenBucket(m_rateLimits.messagesPerSecond, burst, t_now);
+    }
+    return m_clientRateLimits.emplace(t_clientID, newRateLimit).first->second;
+}
+
+bool FBNetwork::Server::admitClientEvent(const int t_clientID)
+{
+    if (!m_hasRateLimits.load(std::memory_order_relaxed))
+    {
+        return true;
+    }
+    if (isReadingPaused(t_clientID))
+    {
+        return false;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point resume;
+    {
+        std::lock_guard<std::mutex> lock(m_rateLimitsMutex);
+        ClientRateLimit            &clientRateLimit = getClientRateLimit(t_clientID, now);
+        clientRateLimit.bytes.refill(now);
+        if (clientRateLimit.bytes.getTokens() >= 0 && clientRateLimit.messages.tryConsume(1, now))
+        {
+            return true;
+        }
+        resume = std::max(clientRateLimit.bytes.getTimeOf(0, now), clientRateLimit.messages.getTimeOf(1, now));
+    }
+
+    // Leave the data in the socket buffer until the buckets have refilled, the timing wheel resumes the client
+
+    try
+    {
+        pauseReading(t_clientID);
+    }
+    catch (ServerRuntimeException &e)
+    {
+        m_metrics.recordError();
+        return true;
+    }
+    m_metrics.recordPausedRead();
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    ClientDeadlines            &clientDeadlines = m_clientDeadlines[t_clientID];
+    clientDeadlines.resume                      = resume;
+    scheduleClientTimer(t_clientID, clientDeadlines);
+    return false;
+}
+
+void FBNetwork::Server::chargeReceivedBytes(const int t_clientID, const ssize_t t_bytes)
+{
+    if (!m_hasRateLimits.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex>           lock(m_rateLimitsMutex);
+    ClientRateLimit                      &clientRateLimit = getClientRateLimit(t_clientID, now);
+    clientRateLimit.bytes.refill(now);
+    clientRateLimit.bytes.consume(static_cast<double>(t_bytes));
+}
+
+bool FBNetwork::Server::admitConnection(const sockaddr_storage &t_clientAddress)
+{
+    if (!m_hasRateLimits.load(std::memory_order_relaxed))
+    {
+        return true;
+    }
+    std::string source;
+    if (t_clientAddress.ss_family == AF_INET)
+    {
+        const sockaddr_in *address = reinterpret_cast<const sockaddr_in *>(&t_clientAddress);
+        source.assign(reinterpret_cast<const char *>(&address->sin_addr), sizeof(address->sin_addr));
+    }
+    else if (t_clientAddress.ss_family == AF_INET6)
+    {
+        const sockaddr_in6 *address = reinterpret_cast<const sockaddr_in6 *>(&t_clientAddress);
+        source.assign(reinterpret_cast<const char *>(&address->sin6_addr), sizeof(address->sin6_addr));
+    }
+    else
+    {
+        return true;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex>           lock(m_rateLimitsMutex);
+    if (!(m_rateLimits.connectionsPerSecond > 0))
+    {
+        return true;
+    }
+    auto sourceRateLimit = m_sourceRateLimits.find(source);
+    if (sourceRateLimit == m_sourceRateLimits.end())
+    {
+        if (m_sourceRateLimits.size() >= Constants::RATE_LIMIT_MAXIMUM_SOURCES)
+        {
+
+            // A full bucket is the same as no bucket, so forget those. If every source is still limited, forget them all
+
+            for (auto bucket = m_sourceRateLimits.begin(); bucket != m_sourceRateLimits.end();)
+            {
+                bucket->second.refill(now);
+                bucket = bucket->second.isFull() ? m_sourceRateLimits.erase(bucket) : std::next(bucket);
+            }
+            if (m_sourceRateLimits.size() >= Constants::RATE_LIMIT_MAXIMUM_SOURCES)
+            {
+                m_sourceRateLimits.clear();
+            }
+        }
+        double burst    = m_rateLimits.connectionsBurst > 0 ? m_rateLimits.connectionsBurst : m_rateLimits.connectionsPerSecond;
+        sourceRateLimit = m_sourceRateLimits.emplace(source, TokenBucket(m_rateLimits.connectionsPerSecond, burst, now)).first;
+    }
+    return sourceRateLimit->second.tryConsume(1, now);
+}
+
+void FBNetwork::Server::resetFlowControl(const int t_clientID)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_clientInterestsMutex);
+        m_clientInterests.erase(t_clientID);
+    }
+    std::lock_guard<std::mutex> lock(m_rateLimitsMutex);
+    m_clientRateLimits.erase(t_clientID);
+}
+
+std::shared_ptr<FBNetwork::Compressor> FBNetwork::Server::getCompressor(const int t_clientID)
+{
+    if (t_clientID < 0 || thisClientDoesNotExist(t_clientID) || getClientFileDescriptor(t_clientID) == -1)
+    {
+        throw InvalidArgumentException("Invalid client ID.");
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(m_compressorsMutex);
+        auto                                compressor = m_compressors.find(t_clientID);
+        if (compressor != m_compressors.end())
+        {
+            return compressor->second;
+        }
+    }
+    std::shared_ptr<Compressor>         compressor = std::make_shared<Compressor>(getCompression());
+    std::unique_lock<std::shared_mutex> lock(m_compressorsMutex);
+    return m_compressors.emplace(t_clientID, compressor).first->second;
+}
+
+void FBNetwork::Server::resetCompression(const int t_clientID)
+{
+    std::unique_lock<std::shared_mutex> lock(m_compressorsMutex);
+    m_compressors.erase(t_clientID);
+}
+
+short FBNetwork::Server::getPollEvents(const int t_clientID, const short t_events)
+{
+#ifdef FBNETWORK_WITH_TLS
+    std::shared_ptr<TlsConnection> tlsConnection = getTlsConnection(t_clientID);
+    if (tlsConnection != nullptr)
+    {
+        return tlsConnection->getPollEvents(t_events);
+    }
+#endif
+    return t_events;
+}
+
+ssize_t FBNetwork::Server::receive(const int t_clientID, const fileDescriptor t_clientFileDescriptor, char *t_buffer,
+                                   const size_t t_size)
+{
+    if (m_usesQuickAck.load(std::memory_order_relaxed))
+    {
+        SocketOptions::rearmQuickAck(t_clientFileDescriptor);
+    }
+#ifdef FBNETWORK_WITH_TLS
+    std::shared_ptr<TlsConnection> tlsConnection = getTlsConnection(t_clientID);
+    if (tlsConnection != nullptr)
+    {
+        ssize_t                             bytesRead = tlsConnection->read(t_buffer, t_size);
+        int                                 error     = errno;
+        std::unique_lock<std::shared_mutex> lock(m_tlsMutex);
+        if (bytesRead > 0 && tlsConnection->getPendingBytes() > 0)
+        {
+            m_tlsBufferedClientIDs.insert(t_clientID);
+        }
+        else
+        {
+            m_tlsBufferedClientIDs.erase(t_clientID);
+        }
+        errno = error;
+        return bytesRead;
+    }
+#endif
+    return recv(t_clientFileDescriptor, t_buffer, t_size, 0);
+}
+
+ssize_t FBNetwork::Server::transmit(const int t_clientID, const fileDescriptor t_clientFileDescriptor, const char *t_data,
+                                    const size_t t_size)
+{
+#ifdef FBNETWORK_WITH_TLS
+    std::shared_ptr<TlsConnection> tlsConnection = getTlsConnection(t_clientID);
+    if (tlsConnection != nullptr)
+    {
+        return tlsConnection->write(t_data, t_size);
+    }
+#endif
+    return send(t_clientFileDescriptor, t_data, t_size, MSG_NOSIGNAL);
+}
+
+ssize_t FBNetwork::Server::transmitFile(const int t_clientID, const fileDescriptor t_clientFileDescriptor,
+                                        const fileDescriptor t_fileFileDescriptor, const off_t t_offset, const size_t t_size)
+{
+#ifdef FBNETWORK_WITH_TLS
+    std::shared_ptr<TlsConnection> tlsConnection = getTlsConnection(t_clientID);
+    if (tlsConnection != nullptr)
+    {
+        if (tlsConnection->usesKernelTlsSend())
+        {
+            return tlsConnection->sendFile(t_fileFileDescriptor, t_offset, t_size);
+        }
+
+        // OpenSSL encrypts in user space, so the file has to be read. After EAGAIN the same record is read and written again
+
+        char    buffer[Constants::TLS_RECORD_SIZE];
+        ssize_t bytesRead = pread(t_fileFileDescriptor, buffer, std::min(t_size, sizeof(buffer)), t_offset);
+        if (bytesRead <= 0)
+        {
+            return bytesRead;
+        }
+        return tlsConnection->write(buffer, static_cast<size_t>(bytesRead));
+    }
+#endif
+    return ExtendedSystem::sendFile(t_clientFileDescriptor, t_fileFileDescriptor, t_offset, t_size);
+}
+
+ssize_t FBNetwork::Server::receiveChunk(const int t_clientID, const fileDescriptor t_clientFileDescriptor, char *t_buffer,
+                                        const size_t t_size, const std::chrono::steady_clock::time_point t_deadline,
+                                        ConnectionMetrics &t_connectionMetrics, std::error_code &t_error)
+{
+    timeval timeout = getTimeout();
+    while (true)
+    {
+
+        // Wait for data with poll, select can not watch file descriptors above FD_SETSIZE. Data that TLS already decrypted is not seen
+        // by poll, so do not wait for it
+
+        pollfd clientPollFileDescriptor = {t_clientFileDescriptor, getPollEvents(t_clientID, POLLIN), 0};
+        int    activity                 = 1;
+        if (!hasBufferedData(t_clientID))
+        {
+            activity = poll(&clientPollFileDescriptor, 1, getPollTimeout(timeout, t_deadline));
+        }
+        if (activity < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            m_metrics.recordError();
+            t_connectionMetrics.recordError();
+            t_error = std::error_code(errno, std::system_category());
+            return -1;
+        }
+        else if (activity == 0)
+        {
+
+            // Timeout reached
+
+            m_metrics.recordTimeout();
+            t_connectionMetrics.recordTimeout();
+            t_error = NetworkError::TIMEOUT;
+            return -1;
+        }
+        ssize_t bytesRead = receive(t_clientID, t_clientFileDescriptor, t_buffer, t_size);
+        if (bytesRead == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+
+                // Spurious wakeup, wait for the next readiness notification
+
+                m_metrics.recordWouldBlock();
+                t_connectionMetrics.recordWouldBlock();
+                continue;
+            }
+            m_metrics.recordError();
+            t_connectionMetrics.recordError();
+            t_error = std::error_code(errno, std::system_category());
+            return -1;
+        }
+        else if (bytesRead == 0)
+        {
+            t_error = NetworkError::CONNECTION_CLOSED;
+            return -1;
+        }
+        m_metrics.recordRead(bytesRead);
+        t_connectionMetrics.recordRead(bytesRead);
+        refreshIdleDeadline(t_clientID);
+        chargeReceivedBytes(t_clientID, bytesRead);
+        return bytesRead;
+    }
+}
+
+void FBNetwork::Server::throwError(const std::error_code &t_error, const char *t_context, const char *t_timeoutContext)
+{
+    if (t_error == NetworkError::INVALID_CLIENT)
+    {
+        throw InvalidArgumentException("Invalid client ID.");
+    }
+    if (t_error == NetworkError::INVALID_ARGUMENT)
+    {
+        throw InvalidArgumentException(t_context);
+    }
+    if (t_error == NetworkError::TIMEOUT)
+    {
+        throw ServerTimeoutException(t_timeoutContext, t_error);
+    }
+    throw ServerRuntimeException(t_context, t_error);
+}
+
+bool FBNetwork::Server::isServerOnline()
+{
+    std::shared_lock<std::shared_mutex> lock(m_isServerOnlineMutex);
+    return m_isServerOnline;
+}
+
+bool FBNetwork::Server::isDraining()
+{
+    std::shared_lock<std::shared_mutex> lock(m_isDrainingMutex);
+    return m_isDraining;
+}
+
+bool FBNetwork::Server::isDrained()
+{
+    return isDraining() && getOpenClientsCount() == 0;
+}
+
+FBNetwork::port FBNetwork::Server::getPort()
+{
+    std::shared_lock<std::shared_mutex> lock(m_portMutex);
+    return m_port;
+}
+
+std::string FBNetwork::Server::getData(const int t_clientID)
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataMutex);
+
+    return m_data.at(t_clientID);
+}
+
+std::string FBNetwork::Server::getStartDate()
+{
+    std::shared_lock<std::shared_mutex> lock(m_startDateMutex);
+    return m_startDate;
+}
+
+time_t FBNetwork::Server::getLifeTime()
+{
+    std::shared_lock<std::shared_mutex> lock(m_lifeTimeMutex);
+    return time(0) - getStartTime();
+}
+
+std::string FBNetwork::Server::getClientIpAddress(const int t_clientID)
+{
+    std::shared_lock<std::shared_mutex> lock(m_clientIpAddressMutex);
+    char                                ip[INET_ADDRSTRLEN];
+    char                                ip6[INET6_ADDRSTRLEN];
+    sockaddr_storage                    clientAddress = getClientAddress(t_clientID);
+    if (usesIpv4Domain() == true)
+    {
+        if (inet_ntop(AF_INET, &reinterpret_cast<sockaddr_in *>(&clientAddress)->sin_addr, ip, sizeof(ip)) == nullptr)
+        {
+            throw ServerRuntimeException("Failed to convert IPv4 address to string. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+        return std::string(ip);
+    }
+    else if (usesIpv6Domain() == true)
+    {
+        if (inet_ntop(AF_INET6, &reinterpret_cast<sockaddr_in6 *>(&clientAddress)->sin6_addr, ip6, sizeof(ip6)) == nullptr)
+        {
+            throw ServerRuntimeException("Failed to convert IPv6 address to string. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+        return std::string(ip6);
+    }
+    else if (usesLocalDomain() == true)
+    {
+        return "localhost";
+    }
+    else
+    {
+        throw InvalidDomainException("You try to get the IP address of an invalid domain.");
+    }
+}
+
+int FBNetwork::Server::getCurrentlyConnectedClientsCount()
+{
+    std::shared_lock<std::shared_mutex> lock(m_clientsCountMutex);
+    int                                 count = 0;
+    for (int i = 0; i < getCurrentClientID(); i++)
+    {
+        if (!isDisconnected(i))
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+FBNetwork::ServerMetricsSnapshot FBNetwork::Server::getMetrics() const
+{
+    ServerMetricsSnapshot snapshot = m_metrics.getSnapshot();
+    time_t                startTime = getStartTime();
+    snapshot.lifeTime               = startTime == 0 ? 0 : time(0) - startTime;
+    return snapshot;
+}
+
+FBNetwork::ConnectionMetricsSnapshot FBNetwork::Server::getClientMetrics(const int t_clientID) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_clientMetricsMutex);
+    auto                                clientMetrics = m_clientMetrics.find(t_clientID);
+    if (thisClientDoesNotExist(t_clientID) || clientMetrics == m_clientMetrics.end())
+    {
+        throw std::out_of_range("Client ID not found.");
+    }
+    return clientMetrics->second->getSnapshot();
+}
+
+FBNetwork::Server::Server(const int t_domain, const port t_port, const int t_maximumCurrentConnections)
+{
+    try
+    {
+        setDomain(t_domain);
+        setPort(t_port);
+        setMaximumCurrentConnections(t_maximumCurrentConnections);
+    }
+    catch (InvalidArgumentException &e)
+    {
+        throw e;
+    }
+    if (getDomain() == Domain::IPV4_DOMAIN)
+    {
+        setUsesIpv4Domain(true);
+        setUsesIpv6Domain(false);
+        setUsesLocalDomain(false);
+    }
+    else if (getDomain() == Domain::IPV6_DOMAIN)
+    {
+        setUsesIpv4Domain(false);
+        setUsesIpv6Domain(true);
+        setUsesLocalDomain(false);
+    }
+    else
+    {
+        throw InvalidDomainException("Please use either IPv4 or IPv6.");
+    }
+    setTimeout(FBNetwork::Constants::DEFAULT_TIMEOUT);
+}
+
+FBNetwork::Server::Server(std::string &t_socketPath, const port t_port, const int t_maximumCurrentConnections)
+{
+    setDomain(Domain::LOCAL_DOMAIN);
+    try
+    {
+        setLocalServerSocketPath(t_socketPath);
+        setPort(t_port);
+        setMaximumCurrentConnections(t_maximumCurrentConnections);
+    }
+    catch (InvalidArgumentException &e)
+    {
+        throw e;
+    }
+    setUsesIpv4Domain(false);
+    setUsesIpv6Domain(false);
+    setUsesLocalDomain(true);
+    setTimeout(FBNetwork::Constants::DEFAULT_TIMEOUT);
+}
+
+FBNetwork::Server::~Server()
+{
+    stopServer();
+    for (fileDescriptor wakeUpFileDescriptor : m_wakeUpFileDescriptors)
+    {
+        if (wakeUpFileDescriptor != -1)
+        {
+            close(wakeUpFileDescriptor);
+        }
+    }
+    if (m_reserveFileDescriptor != -1)
+    {
+        close(m_reserveFileDescriptor);
+    }
+}
+
+void FBNetwork::Server::startServer()
+{
+    try
+    {
+        setServerFileDescriptor(socket(getDomain(), SOCK_STREAM, 0));
+    }
+    catch (InvalidArgumentException &e)
+    {
+        throw ServerCreationException("Creating the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+
+    // The listening socket is non-blocking, so acceptAll can drain the backlog until EAGAIN
+
+    if (fcntl(getServerFileDescriptor(), F_SETFL, fcntl(getServerFileDescriptor(), F_GETFL, 0) | O_NONBLOCK) == -1 ||
+        fcntl(getServerFileDescriptor(), F_SETFD, FD_CLOEXEC) == -1)
+    {
+        close(getServerFileDescriptor());
+        throw ServerCreationException("Setting the socket flags failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    int opt = 1;
+    if (setsockopt(getServerFileDescriptor(), SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) == -1)
+    {
+        close(getServerFileDescriptor());
+        throw ServerCreationException("Setting socket options failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    try
+    {
+        getSocketOptions().applyToListener(getServerFileDescriptor(), getDomain());
+        if (!usesLocalDomain())
+        {
+            getCpuPlacement().applyToListener(getServerFileDescriptor());
+        }
+    }
+    catch (SystemRuntimeException &e)
+    {
+        close(getServerFileDescriptor());
+        throw ServerCreationException(e.what());
+    }
+    if (usesIpv4Domain())
+    {
+        std::shared_ptr<sockaddr_in> serverAddressIpv4 = std::make_shared<sockaddr_in>();
+        *serverAddressIpv4                             = {};
+        serverAddressIpv4->sin_family                  = getDomain();
+        serverAddressIpv4->sin_addr.s_addr             = INADDR_ANY;
+        serverAddressIpv4->sin_port                    = htons(getPort());
+        if (bind(getServerFileDescriptor(), reinterpret_cast<sockaddr *>(serverAddressIpv4.get()), sizeof(sockaddr_in)) == -1)
+        {
+            close(getServerFileDescriptor());
+            throw ServerCreationException("Binding the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+
+        // Do not catch InvalidArgumentException here, because it is not possible to throw it. See that we have already checked if
+        // serverAddressIpv4 is nullptr.
+
+        setServerAddressIpv4(serverAddressIpv4);
+    }
+    else if (usesIpv6Domain())
+    {
+        std::shared_ptr<sockaddr_in6> serverAddressIpv6 = std::make_shared<sockaddr_in6>();
+        *serverAddressIpv6                              = {};
+        serverAddressIpv6->sin6_family                  = getDomain();
+        serverAddressIpv6->sin6_addr                    = in6addr_any;
+        serverAddressIpv6->sin6_port                    = htons(getPort());
+        if (bind(getServerFileDescriptor(), reinterpret_cast<sockaddr *>(serverAddressIpv6.get()), sizeof(sockaddr_in6)) == -1)
+        {
+            close(getServerFileDescriptor());
+            throw ServerCreationException("Binding the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+
+        // Do not catch InvalidArgumentException here, because it is not possible to throw it. See that we have already checked if
+        // serverAddressIpv6 is nullptr.
+
+        setServerAddressIpv6(serverAddressIpv6);
+    }
+    else if (usesLocalDomain())
+    {
+        std::shared_ptr<sockaddr_un> serverAddressLocal = std::make_shared<sockaddr_un>();
+        *serverAddressLocal                             = {};
+        serverAddressLocal->sun_family                  = getDomain();
+        strncpy(serverAddressLocal->sun_path, getLocalServerSocketPath().c_str(), sizeof(serverAddressLocal->sun_path) - 1);
+        if (unlink(getLocalServerSocketPath().c_str()) == -1 && errno != ENOENT)
+        {
+            throw ServerCreationException("Removing the existing socket file failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+        if (bind(getServerFileDescriptor(), reinterpret_cast<sockaddr *>(serverAddressLocal.get()), sizeof(sockaddr_un)) == -1)
+        {
+            throw ServerCreationException("Binding the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+
+        // Do not catch InvalidArgumentException here, because it is not possible to throw it. See that we have already checked if
+        // serverAddressLocal is nullptr.
+
+        setServerAddressLocal(serverAddressLocal);
+    }
+    startEventQueue();
+}
+
+void FBNetwork::Server::takeOverListener(const std::string &t_socketPath)
+{
+    if (isServerOnline())
+    {
+        throw ServerCreationException("The server is already online.");
+    }
+    fileDescriptor serverFileDescriptor = -1;
+    std::string    socketPath           = t_socketPath;
+    try
+    {
+        Server handOffServer(socketPath, 0, 1);
+        handOffServer.setTimeout(getTimeout());
+        handOffServer.startServer();
+        handOffServer.startListening();
+        int clientID         = handOffServer.acceptClient();
+        serverFileDescriptor = handOffServer.receiveFileDescriptor(clientID);
+        handOffServer.stopServer();
+    }
+    catch (InvalidArgumentException &e)
+    {
+        throw ServerCreationException(e.what());
+    }
+    catch (ServerRuntimeException &e)
+    {
+        unlink(socketPath.c_str());
+        throw e;
+    }
+    catch (ServerTimeoutException &e)
+    {
+        unlink(socketPath.c_str());
+        throw e;
+    }
+    unlink(socketPath.c_str());
+
+    // The socket is already bound and listening, only check that it matches the domain and take over its address
+
+    sockaddr_storage serverAddress       = {};
+    socklen_t        serverAddressLength = sizeof(serverAddress);
+    if (getsockname(serverFileDescriptor, reinterpret_cast<sockaddr *>(&serverAddress), &serverAddressLength) == -1 ||
+        serverAddress.ss_family != getDomain())
+    {
+        close(serverFileDescriptor);
+        throw ServerCreationException("The received socket does not match the domain of the server.");
+    }
+    if (fcntl(serverFileDescriptor, F_SETFL, fcntl(serverFileDescriptor, F_GETFL, 0) | O_NONBLOCK) == -1 ||
+        fcntl(serverFileDescriptor, F_SETFD, FD_CLOEXEC) == -1)
+    {
+        close(serverFileDescriptor);
+        throw ServerCreationException("Setting the socket flags failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    setServerFileDescriptor(serverFileDescriptor);
+    if (usesIpv4Domain())
+    {
+        std::shared_ptr<sockaddr_in> serverAddressIpv4 = std::make_shared<sockaddr_in>();
+        *serverAddressIpv4                             = *reinterpret_cast<sockaddr_in *>(&serverAddress);
+        setPort(ntohs(serverAddressIpv4->sin_port));
+        setServerAddressIpv4(serverAddressIpv4);
+    }
+    else if (usesIpv6Domain())
+    {
+        std::shared_ptr<sockaddr_in6> serverAddressIpv6 = std::make_shared<sockaddr_in6>();
+        *serverAddressIpv6                              = *reinterpret_cast<sockaddr_in6 *>(&serverAddress);
+        setPort(ntohs(serverAddressIpv6->sin6_port));
+        setServerAddressIpv6(serverAddressIpv6);
+    }
+    else if (usesLocalDomain())
+    {
+        std::shared_ptr<sockaddr_un> serverAddressLocal = std::make_shared<sockaddr_un>();
+        *serverAddressLocal                             = *reinterpret_cast<sockaddr_un *>(&serverAddress);
+        setServerAddressLocal(serverAddressLocal);
+    }
+    startEventQueue();
+}
+
+void FBNetwork::Server::startListening()
+{
+    if (listen(getServerFileDescriptor(), getListenBacklog()) == -1)
+    {
+        throw ServerRuntimeException("Listening on the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+}
+
+void FBNetwork::Server::stopServer()
+{
+    if (!isServerOnline())
+    {
+        return;
+    }
+    try
+    {
+        for (int i = 0; i < getCurrentClientID(); i++)
+        {
+            takeResidualData(i);
+            if (!isDisconnected(i))
+            {
+                stopTls(i);
+                close(getClientFileDescriptor(i));
+                m_metrics.recordClose();
+            }
+        }
+    }
+    catch (ServerRuntimeException &e)
+    {
+        throw e;
+    }
+
+    // A draining server already closed its listening socket
+
+    if (!isDraining() && close(getServerFileDescriptor()) == -1)
+    {
+        throw ServerRuntimeException("Closing the server socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    setIsServerOnline(false);
+    setIsDraining(false);
+    setStartTime(0);
+}
+
+void FBNetwork::Server::drain(const std::chrono::milliseconds t_timeout)
+{
+    if (t_timeout.count() < 0)
+    {
+        throw InvalidArgumentException("The drain timeout cannot be negative.");
+    }
+    if (!isServerOnline())
+    {
+        throw ServerRuntimeException("The server is not online.");
+    }
+    if (isDraining())
+    {
+        return;
+    }
+    try
+    {
+        getEventQueue()->removeClient(getServerFileDescriptor());
+    }
+    catch (InvalidArgumentException &e)
+    {
+    }
+    catch (ServerRuntimeException &e)
+    {
+    }
+
+    // Connections in the backlog are reset unless another process shares the listening socket
+
+    close(getServerFileDescriptor());
+    setIsDraining(true);
+    std::lock_guard<std::mutex>           lock(m_timingWheelMutex);
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + t_timeout;
+    for (int i = 0; i < getCurrentClientID(); i++)
+    {
+        if (getClientFileDescriptor(i) == -1)
+        {
+            continue;
+        }
+        ClientDeadlines &clientDeadlines = m_clientDeadlines[i];
+        clientDeadlines.drain            = deadline;
+        scheduleClientTimer(i, clientDeadlines);
+    }
+}
+
+void FBNetwork::Server::handOffListener(const std::string &t_socketPath)
+{
+    if (!isServerOnline() || isDraining())
+    {
+        throw ServerRuntimeException("The server has no listening socket to hand off.");
+    }
+    try
+    {
+        Client client(t_socketPath, 0);
+        client.connectToServer();
+        client.sendFileDescriptor(getServerFileDescriptor());
+        client.disconnectFromServer();
+    }
+    catch (const std::exception &e)
+    {
+        throw ServerRuntimeException(std::string("Handing off the listening socket failed. ") + e.what());
+    }
+}
+
+FBNetwork::fileDescriptor FBNetwork::Server::receiveFileDescriptor(const int t_clientID)
+{
+    fileDescriptor clientFileDescriptor = getClientFileDescriptor(t_clientID);
+    char           data                 = 0;
+    iovec          dataVector           = {&data, sizeof(data)};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(fileDescriptor))];
+    msghdr message         = {};
+    message.msg_iov        = &dataVector;
+    message.msg_iovlen     = 1;
+    message.msg_control    = control;
+    message.msg_controllen = sizeof(control);
+#ifdef MSG_CMSG_CLOEXEC
+    int flags = MSG_CMSG_CLOEXEC;
+#else
+    int flags = 0;
+#endif
+    ssize_t bytesRead = -1;
+    while ((bytesRead = recvmsg(clientFileDescriptor, &message, flags)) == -1)
+    {
+        if (errno == EINTR)
+        {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            throw ServerRuntimeException("Receiving the file descriptor failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+        pollfd clientPollFileDescriptor = {clientFileDescriptor, POLLIN, 0};
+        int    activity = poll(&clientPollFileDescriptor, 1, getPollTimeout(getTimeout(), std::chrono::steady_clock::time_point::max()));
+        if (activity == 0)
+        {
+            throw ServerTimeoutException("Timeout reached while receiving the file descriptor.");
+        }
+        if (activity == -1 && errno != EINTR)
+        {
+            throw ServerRuntimeException("Error during poll: " + ExtendedSystem::getCurrentErrnoError());
+        }
+    }
+    if (bytesRead == 0)
+    {
+        throw ServerRuntimeException("Connection closed by client.");
+    }
+    cmsghdr *controlMessage = CMSG_FIRSTHDR(&message);
+    if (controlMessage == nullptr || controlMessage->cmsg_level != SOL_SOCKET || controlMessage->cmsg_type != SCM_RIGHTS ||
+        controlMessage->cmsg_len != CMSG_LEN(sizeof(fileDescriptor)))
+    {
+        throw ServerRuntimeException("The client did not send a file descriptor.");
+    }
+    fileDescriptor receivedFileDescriptor = -1;
+    memcpy(&receivedFileDescriptor, CMSG_DATA(controlMessage), sizeof(receivedFileDescriptor));
+#ifndef MSG_CMSG_CLOEXEC
+    fcntl(receivedFileDescriptor, F_SETFD, FD_CLOEXEC);
+#endif
+    return receivedFileDescriptor;
+}
+
+void FBNetwork::Server::setServerKeepAlive(const bool t_keepAlive)
+{
+    int keepAlive = t_keepAlive ? 1 : 0;
+    if (setsockopt(getServerFileDescriptor(), SOL_SOCKET, SO_KEEPALIVE, &keepAlive, sizeof(keepAlive)) == -1)
+    {
+        throw ServerRuntimeException("Setting the keep alive option failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+}
+
+void FBNetwork::Server::setSocketOptions(const SocketOptions &t_socketOptions)
+{
+    {
+        std::unique_lock<std::shared_mutex> lock(m_socketOptionsMutex);
+        m_socketOptions = t_socketOptions;
+        m_usesQuickAck.store(t_socketOptions.usesQuickAck());
+    }
+    if (!isServerOnline())
+    {
+        return;
+    }
+    try
+    {
+        t_socketOptions.applyToListener(getServerFileDescriptor(), getDomain());
+    }
+    catch (SystemRuntimeException &e)
+    {
+        throw ServerRuntimeException(e.what());
+    }
+}
+
+FBNetwork::SocketOptions FBNetwork::Server::getSocketOptions()
+{
+    std::shared_lock<std::shared_mutex> lock(m_socketOptionsMutex);
+    return m_socketOptions;
+}
+
+void FBNetwork::Server::flush(const int t_clientID)
+{
+    if (t_clientID < 0 || thisClientDoesNotExist(t_clientID) || getClientFileDescriptor(t_clientID) == -1)
+    {
+        throw InvalidArgumentException("Invalid client ID.");
+    }
+    if (!getSocketOptions().usesCork() || usesLocalDomain())
+    {
+        return;
+    }
+    try
+    {
+        SocketOptions::flushCork(getClientFileDescriptor(t_clientID));
+    }
+    catch (SystemRuntimeException &e)
+    {
+        throw ServerRuntimeException(e.what());
+    }
+}
+
+void FBNetwork::Server::setCpuPlacement(const CpuPlacement &t_cpuPlacement)
+{
+    {
+        std::unique_lock<std::shared_mutex> lock(m_cpuPlacementMutex);
+        m_cpuPlacement = t_cpuPlacement;
+        m_isCpuPlacementPending.store(!t_cpuPlacement.isEmpty());
+    }
+    if (!isServerOnline() || usesLocalDomain())
+    {
+        return;
+    }
+    try
+    {
+        t_cpuPlacement.applyToListener(getServerFileDescriptor());
+    }
+    catch (SystemRuntimeException &e)
+    {
+        throw ServerRuntimeException(e.what());
+    }
+}
+
+FBNetwork::CpuPlacement FBNetwork::Server::getCpuPlacement()
+{
+    std::shared_lock<std::shared_mutex> lock(m_cpuPlacementMutex);
+    return m_cpuPlacement;
+}
+
+int FBNetwork::Server::getClientIncomingCpu(const int t_clientID)
+{
+    if (t_clientID < 0 || thisClientDoesNotExist(t_clientID) || getClientFileDescriptor(t_clientID) == -1)
+    {
+        throw InvalidArgumentException("Invalid client ID.");
+    }
+    return CpuPlacement::getIncomingCpu(getClientFileDescriptor(t_clientID));
+}
+
+void FBNetwork::Server::post(std::function<void()> t_task)
+{
+    if (!t_task)
+    {
+        throw InvalidArgumentException("The task is empty.");
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_postedTasksMutex);
+        m_postedTasks.push_back(std::move(t_task));
+    }
+
+    // One byte per wake-up is enough, the event loop takes all posted functions at once
+
+    if (!m_isWakeUpPending.exchange(true) && m_wakeUpFileDescriptors[1] != -1)
+    {
+        char wakeUp = 1;
+        if (write(m_wakeUpFileDescriptors[1], &wakeUp, 1) == -1)
+        {
+            m_isWakeUpPending.store(false);
+        }
+    }
+}
+
+void FBNetwork::Server::runPostedTasks()
+{
+    char buffer[64];
+    while (read(m_wakeUpFileDescriptors[0], buffer, sizeof(buffer)) > 0)
+    {
+    }
+    m_isWakeUpPending.store(false);
+    std::vector<std::function<void()>> postedTasks;
+    {
+        std::lock_guard<std::mutex> lock(m_postedTasksMutex);
+        postedTasks.swap(m_postedTasks);
+    }
+    for (std::function<void()> &postedTask : postedTasks)
+    {
+        try
+        {
+            postedTask();
+        }
+        catch (const std::exception &)
+        {
+            m_metrics.recordError();
+        }
+    }
+}
+
+void FBNetwork::Server::dispatch(TaskPool &t_taskPool, const int t_clientID, std::function<std::string()> t_handler)
+{
+    if (t_clientID < 0 || thisClientDoesNotExist(t_clientID) || getClientFileDescriptor(t_clientID) == -1)
+    {
+        throw InvalidArgumentException("Invalid client ID.");
+    }
+    if (!t_handler)
+    {
+        throw InvalidArgumentException("The handler is empty.");
+    }
+
+    // The metrics object exists once per connection, so it tells a reused client ID apart and orders the handlers of one connection
+
+    std::shared_ptr<ConnectionMetrics>    connection       = getConnectionMetrics(t_clientID);
+    std::shared_ptr<ConcurrencyLimit>     concurrencyLimit = getConcurrencyLimit();
+    std::chrono::steady_clock::time_point start            = std::chrono::steady_clock::now();
+    if (concurrencyLimit && !concurrencyLimit->tryAcquire())
+    {
+        m_metrics.recordShedRequest();
+        throw ServerRuntimeException("The concurrency limit is reached.");
+    }
+    try
+    {
+        t_taskPool.submit(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(connection.get())),
+                          [this, t_clientID, connection, concurrencyLimit, start, handler = std::move(t_handler)]()
+                          {
+                              std::string response;
+                              bool        hasFailed = false;
+                              try
+                              {
+                                  response = handler();
+                              }
+                              catch (...)
+                              {
+
+                                  // Whatever the handler throws, its slot in the concurrency limit must be released
+
+                                  hasFailed = true;
+                              }
+                              if (concurrencyLimit)
+                              {
+                                  concurrencyLimit->release(std::chrono::steady_clock::now() - start, hasFailed);
+                              }
+                              post(
+                                  [this, t_clientID, connection, response = std::move(response), hasFailed]()
+                                  {
+                                      try
+                                      {
+                                          if (getClientFileDescriptor(t_clientID) == -1 || getConnectionMetrics(t_clientID) != connection)
+                                          {
+                                              return;
+                                          }
+                                          if (hasFailed)
+                                          {
+                                              throw ServerRuntimeException("The handler failed.");
+                                          }
+
+                                          // The event loop must not wait for a slow client, so the response goes through its output queue
+
+                                          if (!response.empty() && !queuePayload(t_clientID, std::make_shared<const std::string>(response)))
+                                          {
+                                              throw ServerRuntimeException("The response was dropped.");
+                                          }
+                                      }
+                                      catch (const std::out_of_range &)
+                                      {
+
+                                          // The client ID does not exist anymore
+
+                                      }
+                                      catch (const std::exception &)
+                                      {
+                                          m_metrics.recordError();
+                                          closeClient(t_clientID);
+                                      }
+                                  });
+                          });
+    }
+    catch (...)
+    {
+
+        // A handler that never runs must not keep its slot in the concurrency limit
+
+        if (concurrencyLimit)
+        {
+            concurrencyLimit->release(std::chrono::steady_clock::now() - start, true);
+        }
+        throw;
+    }
+}
+
+void FBNetwork::Server::dispatchRpc(TaskPool &t_taskPool, const int t_clientID, const uint64_t t_correlationID,
+                                    std::function<std::string()> t_handler)
+{
+    if (t_clientID < 0 || thisClientDoesNotExist(t_clientID) || getClientFileDescriptor(t_clientID) == -1)
+    {
+        throw InvalidArgumentException("Invalid client ID.");
+    }
+    if (!t_handler)
+    {
+        throw InvalidArgumentException("The handler is empty.");
+    }
+    std::shared_ptr<ConnectionMetrics>    connection       = getConnectionMetrics(t_clientID);
+    std::shared_ptr<ConcurrencyLimit>     concurrencyLimit = getConcurrencyLimit();
+    std::chrono::steady_clock::time_point start            = std::chrono::steady_clock::now();
+    if (concurrencyLimit && !concurrencyLimit->tryAcquire())
+    {
+
+        // The correlation ID tells the RpcClient which call failed, so the call is rejected without touching the other calls
+
+        m_metrics.recordShedRequest();
+        if (!queuePayload(t_clientID, std::make_shared<const std::string>(
+                                          RpcClient::encodeFrame(RpcFrameType::ERROR, t_correlationID, "The server is overloaded."))))
+        {
+            closeClient(t_clientID);
+        }
+        return;
+    }
+
+    // No key, so the handlers of one client run in parallel and each response leaves as soon as it is ready
+
+    try
+    {
+        t_taskPool.submit(
+            [this, t_clientID, t_correlationID, connection, concurrencyLimit, start, handler = std::move(t_handler)]()
+            {
+                std::string response;
+                bool        hasFailed = false;
+                try
+                {
+                    response = handler();
+                }
+                catch (const std::exception &e)
+                {
+                    hasFailed = true;
+                    response  = e.what();
+                }
+                catch (...)
+                {
+                    hasFailed = true;
+                    response  = "The handler failed.";
+                }
+                if (concurrencyLimit)
+                {
+                    concurrencyLimit->release(std::chrono::steady_clock::now() - start, hasFailed);
+                }
+                post(
+                    [this, t_clientID, t_correlationID, connection, response = std::move(response), hasFailed]()
+                    {
+                        try
+                        {
+                            if (getClientFileDescriptor(t_clientID) == -1 || getConnectionMetrics(t_clientID) != connection)
+                            {
+                                return;
+                            }
+
+                            // The event loop must not wait for a slow client, so the frame goes through its output queue
+
+                            RpcFrameType frameType = hasFailed ? RpcFrameType::ERROR : RpcFrameType::RESPONSE;
+                            if (!queuePayload(t_clientID, std::make_shared<const std::string>(
+                                                              RpcClient::encodeFrame(frameType, t_correlationID, response))))
+                            {
+                                throw ServerRuntimeException("The response was dropped.");
+                            }
+                        }
+                        catch (const std::out_of_range &)
+                        {
+
+                            // The client ID does not exist anymore
+
+                        }
+                        catch (const std::exception &)
+                        {
+                            m_metrics.recordError();
+                            closeClient(t_clientID);
+                        }
+                    });
+            });
+    }
+    catch (...)
+    {
+
+        // A handler that never runs must not keep its slot in the concurrency limit
+
+        if (concurrencyLimit)
+        {
+            concurrencyLimit->release(std::chrono::steady_clock::now() - start, true);
+        }
+        throw;
+    }
+}
+
+size_t FBNetwork::Server::broadcast(const sharedPayload &t_payload, const std::function<bool(const int)> &t_filter)
+{
+    if (t_payload == nullptr || t_payload->empty())
+    {
+        throw InvalidArgumentException("The payload cannot be empty.");
+    }
+    size_t queuedClients = 0;
+    for (int i = 0; i < getCurrentClientID(); i++)
+    {
+        if (getClientFileDescriptor(i) != -1 && (!t_filter || t_filter(i)) && queuePayload(i, t_payload))
+        {
+            queuedClients++;
+        }
+    }
+    return queuedClients;
+}
+
+void FBNetwork::Server::subscribe(const int t_clientID, const std::string &t_topic)
+{
+    if (t_clientID < 0 || thisClientDoesNotExist(t_clientID) || getClientFileDescriptor(t_clientID) == -1)
+    {
+        throw InvalidArgumentException("Invalid client ID.");
+    }
+    if (t_topic.empty())
+    {
+        throw InvalidArgumentException("The topic cannot be empty.");
+    }
+    std::unique_lock<std::shared_mutex> lock(m_topicsMutex);
+    m_topics[t_topic].insert(t_clientID);
+}
+
+void FBNetwork::Server::unsubscribe(const int t_clientID, const std::string &t_topic)
+{
+    std::unique_lock<std::shared_mutex> lock(m_topicsMutex);
+    auto                                topic = m_topics.find(t_topic);
+    if (topic == m_topics.end())
+    {
+        return;
+    }
+    topic->second.erase(t_clientID);
+    if (topic->second.empty())
+    {
+        m_topics.erase(topic);
+    }
+}
+
+size_t FBNetwork::Server::publish(const std::string &t_topic, const sharedPayload &t_payload)
+{
+    if (t_payload == nullptr || t_payload->empty())
+    {
+        throw InvalidArgumentException("The payload cannot be empty.");
+    }
+
+    // Copy the subscribers, a client that is closed for being slow unsubscribes itself
+
+    std::vector<int> subscribers;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_topicsMutex);
+        auto                                topic = m_topics.find(t_topic);
+        if (topic == m_topics.end())
+        {
+            return 0;
+        }
+        subscribers.assign(topic->second.begin(), topic->second.end());
+    }
+    size_t queuedClients = 0;
+    for (int clientID : subscribers)
+    {
+        if (queuePayload(clientID, t_payload))
+        {
+            queuedClients++;
+        }
+    }
+    return queuedClients;
+}
+
+void FBNetwork::Server::setOutputQueueLimit(const size_t t_limit, const SlowClientPolicy t_policy)
+{
+    if (t_limit == 0)
+    {
+        throw InvalidArgumentException("The output queue limit must be greater than 0.");
+    }
+    std::unique_lock<std::shared_mutex> lock(m_slowClientPolicyMutex);
+    m_outputQueueLimit = t_limit;
+    m_slowClientPolicy = t_policy;
+}
+
+size_t FBNetwork::Server::getQueuedBytes(const int t_clientID)
+{
+    if (t_clientID < 0 || thisClientDoesNotExist(t_clientID) || getClientFileDescriptor(t_clientID) == -1)
+    {
+        throw InvalidArgumentException("Invalid client ID.");
+    }
+    std::shared_lock<std::shared_mutex> lock(m_outputQueuesMutex);
+    auto                                outputQueue = m_outputQueues.find(t_clientID);
+    return outputQueue == m_outputQueues.end() ? 0 : outputQueue->second.queuedBytes;
+}
+
+void FBNetwork::Server::setRateLimits(const RateLimits &t_rateLimits)
+{
+    if (!(t_rateLimits.bytesPerSecond >= 0) || !(t_rateLimits.bytesBurst >= 0) || !(t_rateLimits.messagesPerSecond >= 0) ||
+        !(t_rateLimits.messagesBurst >= 0) || !(t_rateLimits.connectionsPerSecond >= 0) || !(t_rateLimits.connectionsBurst >= 0))
+    {
+        throw InvalidArgumentException("Rate limits cannot be negative.");
+    }
+    std::lock_guard<std::mutex> lock(m_rateLimitsMutex);
+    m_rateLimits = t_rateLimits;
+    m_clientRateLimits.clear();
+    m_sourceRateLimits.clear();
+    m_hasRateLimits.store(t_rateLimits.bytesPerSecond > 0 || t_rateLimits.messagesPerSecond > 0 || t_rateLimits.connectionsPerSecond > 0);
+}
+
+FBNetwork::RateLimits FBNetwork::Server::getRateLimits()
+{
+    std::lock_guard<std::mutex> lock(m_rateLimitsMutex);
+    return m_rateLimits;
+}
+
+bool FBNetwork::Server::isConcurrencyLimitReached()
+{
+    std::shared_ptr<ConcurrencyLimit> concurrencyLimit = getConcurrencyLimit();
+    return concurrencyLimit && concurrencyLimit->isSaturated();
+}
+
+bool FBNetwork::Server::isOverloaded()
+{
+    return isConcurrencyLimitReached() || getOpenClientsCount() >= getMaximumCurrentConnections();
+}
+
+void FBNetwork::Server::handleOverload(const bool t_hasAcceptedClients)
+{
+    OverloadPolicy overloadPolicy = getOverloadPolicy();
+    if (overloadPolicy == OverloadPolicy::PAUSE_ACCEPTING)
+    {
+        pauseAccepting();
+    }
+    else if (overloadPolicy == OverloadPolicy::ACCEPT_AND_CLOSE)
+    {
+        shedPendingConnections();
+    }
+    else if (!t_hasAcceptedClients)
+    {
+        throw ServerRuntimeException("Maximum number of current connections reached.");
+    }
+}
+
+void FBNetwork::Server::pauseAccepting()
+{
+    if (m_isAcceptingPaused.exchange(true))
+    {
+        return;
+    }
+    try
+    {
+        getEventQueue()->setInterest(getServerFileDescriptor(), false, false);
     }
-    if (close(getServerFileDescriptor()) == -1)
+    catch (ServerRuntimeException &e)
+    {
+        m_isAcceptingPaused.store(false);
+        m_metrics.recordError();
+    }
+}
+
+void FBNetwork::Server::resumeAccepting()
+{
+    if (!m_isAcceptingPaused.exchange(false))
+    {
+        return;
+    }
+    try
+    {
+        getEventQueue()->setInterest(getServerFileDescriptor(), true, false);
+    }
+    catch (ServerRuntimeException &e)
+    {
+        m_isAcceptingPaused.store(true);
+        m_metrics.recordError();
+    }
+}
+
+void FBNetwork::Server::shedConnection(const fileDescriptor t_clientFileDescriptor)
+{
+    std::string overloadResponse;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_overloadMutex);
+        overloadResponse = m_overloadResponse;
+    }
+#ifdef FBNETWORK_WITH_TLS
+    {
+        std::shared_lock<std::shared_mutex> lock(m_tlsMutex);
+        if (m_tlsContext != nullptr)
+        {
+            overloadResponse.clear();
+        }
+    }
+#endif
+    if (!overloadResponse.empty())
+    {
+
+        // The socket buffer of a new connection is empty, so the response fits unless it is huge, and a shed client is not waited for
+
+        send(t_clientFileDescriptor, overloadResponse.data(), overloadResponse.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+    }
+    close(t_clientFileDescriptor);
+    m_metrics.recordShedConnection();
+}
+
+void FBNetwork::Server::shedPendingConnections()
+{
+    fileDescriptor serverFileDescriptor = getServerFileDescriptor();
+    while (true)
+    {
+        sockaddr_storage clientAddress;
+        fileDescriptor   clientFileDescriptor = acceptConnection(serverFileDescriptor, clientAddress);
+        if (clientFileDescriptor != -1)
+        {
+            shedConnection(clientFileDescriptor);
+            continue;
+        }
+        if (errno == EINTR || errno == ECONNABORTED)
+        {
+            continue;
+        }
+        if ((errno == EMFILE || errno == ENFILE) && shedWithReserveFileDescriptor())
+        {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+        {
+            m_metrics.recordError();
+        }
+        return;
+    }
+}
+
+bool FBNetwork::Server::shedWithReserveFileDescriptor()
+{
+    if (m_reserveFileDescriptor == -1)
+    {
+        return false;
+    }
+    close(m_reserveFileDescriptor);
+    m_reserveFileDescriptor = -1;
+    sockaddr_storage clientAddress;
+    fileDescriptor   clientFileDescriptor = acceptConnection(getServerFileDescriptor(), clientAddress);
+    if (clientFileDescriptor != -1)
+    {
+        shedConnection(clientFileDescriptor);
+    }
+    m_reserveFileDescriptor = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    return clientFileDescriptor != -1;
+}
+
+void FBNetwork::Server::setOverloadPolicy(const OverloadPolicy t_overloadPolicy, const std::string &t_overloadResponse)
+{
+    {
+        std::unique_lock<std::shared_mutex> lock(m_overloadMutex);
+        m_overloadPolicy   = t_overloadPolicy;
+        m_overloadResponse = t_overloadResponse;
+    }
+    if (t_overloadPolicy != OverloadPolicy::PAUSE_ACCEPTING && isServerOnline())
+    {
+        resumeAccepting();
+    }
+}
+
+FBNetwork::OverloadPolicy FBNetwork::Server::getOverloadPolicy()
+{
+    std::shared_lock<std::shared_mutex> lock(m_overloadMutex);
+    return m_overloadPolicy;
+}
+
+void FBNetwork::Server::setConcurrencyLimit(std::shared_ptr<ConcurrencyLimit> t_concurrencyLimit)
+{
+    std::unique_lock<std::shared_mutex> lock(m_overloadMutex);
+    m_concurrencyLimit = std::move(t_concurrencyLimit);
+}
+
+std::shared_ptr<FBNetwork::ConcurrencyLimit> FBNetwork::Server::getConcurrencyLimit()
+{
+    std::shared_lock<std::shared_mutex> lock(m_overloadMutex);
+    return m_concurrencyLimit;
+}
+
+void FBNetwork::Server::setListenBacklog(const int t_listenBacklog)
+{
+    if (t_listenBacklog <= 0)
     {
-        throw ServerRuntimeException("Closing the server socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        throw InvalidArgumentException("The listen backlog must be greater than 0.");
     }
-    setIsServerOnline(false);
-    setStartTime(0);
+    m_listenBacklog.store(t_listenBacklog);
 }
 
-void FBNetwork::Server::setServerKeepAlive(const bool t_keepAlive)
+int FBNetwork::Server::getListenBacklog()
 {
-    int keepAlive = t_keepAlive ? 1 : 0;
-    if (setsockopt(getServerFileDescriptor(), SOL_SOCKET, SO_KEEPALIVE, &keepAlive, sizeof(keepAlive)) == -1)
+    return m_listenBacklog.load();
+}
+
+bool FBNetwork::Server::isAcceptingPaused()
+{
+    return m_isAcceptingPaused.load();
+}
+
+void FBNetwork::Server::setCompression(const CompressionOptions &t_compressionOptions)
+{
+    if (!Compressor::isAvailable(t_compressionOptions.codec))
     {
-        throw ServerRuntimeException("Setting the keep alive option failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        throw InvalidArgumentException("The compression codec was not found at build time.");
     }
+    std::unique_lock<std::shared_mutex> lock(m_compressionMutex);
+    m_compressionOptions = t_compressionOptions;
+}
+
+FBNetwork::CompressionOptions FBNetwork::Server::getCompression()
+{
+    std::shared_lock<std::shared_mutex> lock(m_compressionMutex);
+    return m_compressionOptions;
+}
+
+FBNetwork::CompressionCodec FBNetwork::Server::getCompressionCodec(const int t_clientID)
+{
+    return getCompressor(t_clientID)->getCodec();
 }
 
 int FBNetwork::Server::acceptClient()
 {
-    rearrangeClientIDs();
-    int currentClientID = getCurrentClientID();
-    if (currentClientID >= getMaximumCurrentConnections())
+    if (isDraining())
     {
-        throw ServerRuntimeException("Maximum number of current connections reached.");
+        throw ServerRuntimeException("The server is draining and does not accept clients.");
     }
-    int serverFileDescriptor = getServerFileDescriptor();
-    if (usesIpv4Domain() == true)
+    int clientID = -1;
+    if (!isConcurrencyLimitReached())
     {
-        try
+        clientID = reserveClientID();
+        if (clientID == -1)
         {
-            socklen_t                    clientAddressLength = sizeof(sockaddr_in);
-            std::shared_ptr<sockaddr_in> clientAddressIpv4   = std::make_shared<sockaddr_in>();
-            *clientAddressIpv4                               = {};
-            int clientFileDescriptor =
-                accept(serverFileDescriptor, reinterpret_cast<sockaddr *>(clientAddressIpv4.get()), &clientAddressLength);
-            setClientFileDescriptor(currentClientID, clientFileDescriptor);
-            setClientAddressIpv4(currentClientID, clientAddressIpv4);
+
+            // Only look for disconnected clients when the server is full, it costs one system call per client
+
+            closeDisconnectedClients();
+            clientID = reserveClientID();
         }
-        catch (InvalidArgumentException &e)
+    }
+    if (clientID == -1)
+    {
+        handleOverload(true);
+        throw ServerRuntimeException("Maximum number of current connections reached.");
+    }
+    fileDescriptor                        serverFileDescriptor = getServerFileDescriptor();
+    fileDescriptor                        clientFileDescriptor = -1;
+    sockaddr_storage                      clientAddress;
+    timeval                               timeout  = getTimeout();
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(timeout.tv_sec) +
+                                                     std::chrono::microseconds(timeout.tv_usec);
+    bool                                  mayWait  = true;
+    while (true)
+    {
+        while ((clientFileDescriptor = acceptConnection(serverFileDescriptor, clientAddress)) == -1)
         {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == ECONNABORTED || ((errno == EMFILE || errno == ENFILE) && shedWithReserveFileDescriptor()))
+            {
+                mayWait = false;
+                continue;
+            }
+            if ((errno == EAGAIN || errno == EWOULDBLOCK) && !mayWait)
+            {
+
+                // The connections that were pending are gone, so give up instead of blocking an event loop that called on its event
+
+                releaseClientID(clientID);
+                throw ServerRuntimeException("No client left to accept, the pending connections were rejected or aborted.");
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
 
-            // The accept function failed.
+                // The listening socket is non-blocking, so wait for the next connection, but not longer than the timeout
 
+                pollfd serverPollFileDescriptor = {serverFileDescriptor, POLLIN, 0};
+                int    activity                 = poll(&serverPollFileDescriptor, 1, getPollTimeout(timeout, deadline));
+                if (activity == 0)
+                {
+                    releaseClientID(clientID);
+                    m_metrics.recordTimeout();
+                    throw ServerTimeoutException("No client connected within the timeout.");
+                }
+                if (activity > 0 || errno == EINTR)
+                {
+                    continue;
+                }
+            }
+            int error = errno;
+            releaseClientID(clientID);
+            m_metrics.recordError();
+            errno = error;
             throw ServerRuntimeException("Accepting the client failed. Error: " + ExtendedSystem::getCurrentErrnoError());
         }
+        if (admitConnection(clientAddress))
+        {
+            break;
+        }
+
+        // The source connects faster than its rate limit allows, so close the connection and take the next pending one, if any
+
+        close(clientFileDescriptor);
+        m_metrics.recordRejectedAccept();
+        mayWait = false;
     }
-    else if (usesIpv6Domain() == true)
+    addClient(clientID, clientFileDescriptor, clientAddress);
+    try
+    {
+        getEventQueue()->addClient(clientFileDescriptor);
+    }
+    catch (ServerRuntimeException &e)
+    {
+        closeClient(clientID);
+        throw ServerRuntimeException("Setting the server file descriptor for the event queue failed.");
+    }
+    return clientID;
+}
+
+std::vector<int> FBNetwork::Server::acceptAll()
+{
+    std::vector<int> clientIDs;
+    if (isDraining())
+    {
+        return clientIDs;
+    }
+    fileDescriptor   serverFileDescriptor      = getServerFileDescriptor();
+    bool             closedDisconnectedClients = false;
+    while (true)
+    {
+        bool isLimited = isConcurrencyLimitReached();
+        int  clientID  = isLimited ? -1 : reserveClientID();
+        if (clientID == -1 && !isLimited && !closedDisconnectedClients)
+        {
+            closeDisconnectedClients();
+            closedDisconnectedClients = true;
+            clientID                  = reserveClientID();
+        }
+        if (clientID == -1)
+        {
+            handleOverload(!clientIDs.empty());
+            break;
+        }
+        sockaddr_storage clientAddress;
+        fileDescriptor   clientFileDescriptor = acceptConnection(serverFileDescriptor, clientAddress);
+        if (clientFileDescriptor == -1)
+        {
+            int error = errno;
+            releaseClientID(clientID);
+            if (error == EINTR || error == ECONNABORTED)
+            {
+                continue;
+            }
+            if (error == EAGAIN || error == EWOULDBLOCK)
+            {
+                break;
+            }
+            if ((error == EMFILE || error == ENFILE) && shedWithReserveFileDescriptor())
+            {
+                continue;
+            }
+            m_metrics.recordError();
+            if (clientIDs.empty())
+            {
+                errno = error;
+                throw ServerRuntimeException("Accepting the client failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+            }
+            break;
+        }
+        if (!admitConnection(clientAddress))
+        {
+            close(clientFileDescriptor);
+            m_metrics.recordRejectedAccept();
+            releaseClientID(clientID);
+            continue;
+        }
+        addClient(clientID, clientFileDescriptor, clientAddress);
+        clientIDs.push_back(clientID);
+    }
+
+    // Register the whole burst in one pass after the backlog is drained
+
+    std::vector<int> registeredClientIDs;
+    registeredClientIDs.reserve(clientIDs.size());
+    for (int clientID : clientIDs)
     {
         try
         {
-            socklen_t                     clientAddressLength = sizeof(sockaddr_in6);
-            std::shared_ptr<sockaddr_in6> clientAddressIpv6   = std::make_shared<sockaddr_in6>();
-            *clientAddressIpv6                                = {};
-            int clientFileDescriptor =
-                accept(serverFileDescriptor, reinterpret_cast<sockaddr *>(clientAddressIpv6.get()), &clientAddressLength);
-            setClientFileDescriptor(currentClientID, clientFileDescriptor);
-            setClientAddressIpv6(currentClientID, clientAddressIpv6);
+            getEventQueue()->addClient(getClientFileDescriptor(clientID));
+            registeredClientIDs.push_back(clientID);
+        }
+        catch (ServerRuntimeException &e)
+        {
+            closeClient(clientID);
+        }
+    }
+    return registeredClientIDs;
+}
+
+void FBNetwork::Server::closeDisconnectedClients()
+{
+    for (int i = 0; i < getCurrentClientID(); i++)
+    {
+
+        // A client that pipelined its last messages and closed is kept until the application read them
+
+        if (getClientFileDescriptor(i) != -1 && !hasResidualData(i) && isDisconnected(i))
+        {
+            try
+            {
+                closeClient(i);
+            }
+            catch (ServerRuntimeException &e)
+            {
+            }
+        }
+    }
+}
+
+void FBNetwork::Server::sendData(const int t_clientID, const std::string &t_data)
+{
+    std::error_code error;
+    sendData(t_clientID, t_data, error);
+    if (error == NetworkError::INVALID_ARGUMENT)
+    {
+        throw InvalidArgumentException("Data to send cannot be empty.");
+    }
+    else if (error)
+    {
+        throwError(error, "Writing the data failed.", "Timeout reached while writing data.");
+    }
+}
+
+void FBNetwork::Server::sendData(const int t_clientID, const std::string &t_data, std::error_code &t_error)
+{
+    t_error.clear();
+    if (t_data.empty())
+    {
+        t_error = NetworkError::INVALID_ARGUMENT;
+        return;
+    }
+    fileDescriptor clientFileDescriptor = t_clientID < 0 || thisClientDoesNotExist(t_clientID) ? -1 : getClientFileDescriptor(t_clientID);
+    if (clientFileDescriptor == -1)
+    {
+        t_error = NetworkError::INVALID_CLIENT;
+        return;
+    }
+    bool mustQueue = false;
+    {
+        std::unique_lock<std::shared_mutex> lock(m_outputQueuesMutex);
+        if (getClientFileDescriptor(t_clientID) == -1)
+        {
+            t_error = NetworkError::INVALID_CLIENT;
+            return;
+        }
+        OutputQueue &outputQueue    = m_outputQueues[t_clientID];
+        mustQueue                   = outputQueue.isWriting || !outputQueue.payloads.empty();
+        outputQueue.isWriting       = !mustQueue;
+    }
+    if (mustQueue)
+    {
+
+        // Writing now would interleave the data with the payloads before it, so it goes behind them
+
+        if (!queuePayload(t_clientID, std::make_shared<const std::string>(t_data)))
+        {
+            t_error = getClientFileDescriptor(t_clientID) == -1 ? std::error_code(NetworkError::CONNECTION_CLOSED)
+                                                                 : std::make_error_code(std::errc::no_buffer_space);
+        }
+        return;
+    }
+    std::shared_ptr<ConnectionMetrics>    connectionMetrics = getConnectionMetrics(t_clientID);
+    std::chrono::steady_clock::time_point sendStart         = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point writeDeadline     = std::chrono::steady_clock::time_point::max();
+    size_t                                totalBytesWritten = 0;
+    timeval                               timeout           = getTimeout();
+    while (totalBytesWritten < t_data.length())
+    {
+        ssize_t bytesWritten =
+            transmit(t_clientID, clientFileDescriptor, t_data.data() + totalBytesWritten, t_data.length() - totalBytesWritten);
+        if (bytesWritten == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+
+                // The client socket is non-blocking, so wait until the client has read enough to make room
+
+                m_metrics.recordWouldBlock();
+                connectionMetrics->recordWouldBlock();
+                writeDeadline                   = armWriteDeadline(t_clientID);
+                pollfd clientPollFileDescriptor = {clientFileDescriptor, getPollEvents(t_clientID, POLLOUT), 0};
+                int    result                   = poll(&clientPollFileDescriptor, 1, getPollTimeout(timeout, writeDeadline));
+                if (result == 0)
+                {
+                    m_metrics.recordTimeout();
+                    connectionMetrics->recordTimeout();
+                    t_error = NetworkError::TIMEOUT;
+                    releaseOutput(t_clientID, totalBytesWritten == 0);
+                    return;
+                }
+                continue;
+            }
+            m_metrics.recordError();
+            connectionMetrics->recordError();
+            t_error = std::error_code(errno, std::system_category());
+            releaseOutput(t_clientID, totalBytesWritten == 0);
+            return;
+        }
+        totalBytesWritten += static_cast<size_t>(bytesWritten);
+        m_metrics.recordWrite(bytesWritten);
+        connectionMetrics->recordWrite(bytesWritten);
+        refreshIdleDeadline(t_clientID);
+    }
+    if (writeDeadline != std::chrono::steady_clock::time_point::max())
+    {
+        disarmWriteDeadline(t_clientID);
+    }
+    releaseOutput(t_clientID, true);
+    m_metrics.getSendLatency().recordSince(sendStart);
+}
+
+void FBNetwork::Server::sendCompressedData(const int t_clientID, const std::string &t_data)
+{
+    if (t_data.empty())
+    {
+        throw InvalidArgumentException("Data to send cannot be empty.");
+    }
+    std::string frame;
+    try
+    {
+        getCompressor(t_clientID)->compress(t_data, frame);
+    }
+    catch (SystemRuntimeException &e)
+    {
+        throw ServerRuntimeException(e.what());
+    }
+    sendData(t_clientID, frame);
+}
+
+void FBNetwork::Server::sendRpcResponse(const int t_clientID, const uint64_t t_correlationID, const std::string &t_response)
+{
+    sendData(t_clientID, RpcClient::encodeFrame(RpcFrameType::RESPONSE, t_correlationID, t_response));
+}
+
+void FBNetwork::Server::sendRpcError(const int t_clientID, const uint64_t t_correlationID, const std::string &t_message)
+{
+    sendData(t_clientID, RpcClient::encodeFrame(RpcFrameType::ERROR, t_correlationID, t_message));
+}
+
+void FBNetwork::Server::sendFile(const int t_clientID, const std::string &t_filePath, const off_t t_offset, const size_t t_length)
+{
+    if (t_filePath.empty())
+    {
+        throw InvalidArgumentException("File path cannot be empty.");
+    }
+    fileDescriptor fileFileDescriptor = open(t_filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fileFileDescriptor == -1)
+    {
+        throw SystemRuntimeException("Opening the file failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    try
+    {
+        sendFile(t_clientID, fileFileDescriptor, t_offset, t_length);
+    }
+    catch (...)
+    {
+        close(fileFileDescriptor);
+        throw;
+    }
+    close(fileFileDescriptor);
+}
+
+void FBNetwork::Server::sendFile(const int t_clientID, const fileDescriptor t_fileDescriptor, const off_t t_offset, const size_t t_length)
+{
+    struct stat fileStatus;
+    if (fstat(t_fileDescriptor, &fileStatus) == -1)
+    {
+        throw SystemRuntimeException("Retrieving the file size failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    size_t fileSize = static_cast<size_t>(fileStatus.st_size);
+    if (t_offset < 0 || static_cast<size_t>(t_offset) > fileSize || t_length > fileSize - static_cast<size_t>(t_offset))
+    {
+        throw InvalidArgumentException("The range to send is not inside the file.");
+    }
+    size_t length = t_length == 0 ? fileSize - static_cast<size_t>(t_offset) : t_length;
+    if (length == 0)
+    {
+        return;
+    }
+    std::shared_ptr<ConnectionMetrics>    connectionMetrics    = getConnectionMetrics(t_clientID);
+    std::chrono::steady_clock::time_point sendStart            = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point writeDeadline        = std::chrono::steady_clock::time_point::max();
+    fileDescriptor                        clientFileDescriptor = getClientFileDescriptor(t_clientID);
+    size_t                                totalBytesWritten    = 0;
+    timeval                               timeout              = getTimeout();
+    std::chrono::steady_clock::time_point queueDeadline =
+        sendStart + std::chrono::seconds(timeout.tv_sec) + std::chrono::microseconds(timeout.tv_usec);
+    std::error_code error;
+    acquireOutput(t_clientID, clientFileDescriptor, queueDeadline, error);
+    if (error)
+    {
+        throwError(error, "Writing the queued data failed.", "Timeout reached while writing the queued data.");
+    }
+    try
+    {
+        while (totalBytesWritten < length)
+        {
+            ssize_t bytesWritten = transmitFile(t_clientID, clientFileDescriptor, t_fileDescriptor,
+                                                t_offset + static_cast<off_t>(totalBytesWritten), length - totalBytesWritten);
+            if (bytesWritten == -1)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+
+                    // The client socket is non-blocking, so wait until the client has read enough to make room
+
+                    m_metrics.recordWouldBlock();
+                    connectionMetrics->recordWouldBlock();
+                    writeDeadline                   = armWriteDeadline(t_clientID);
+                    pollfd clientPollFileDescriptor = {clientFileDescriptor, getPollEvents(t_clientID, POLLOUT), 0};
+                    int    result                   = poll(&clientPollFileDescriptor, 1, getPollTimeout(timeout, writeDeadline));
+                    if (result == 0)
+                    {
+                        m_metrics.recordTimeout();
+                        connectionMetrics->recordTimeout();
+                        throw ServerTimeoutException("Timeout reached while writing the file.", NetworkError::TIMEOUT);
+                    }
+                    continue;
+                }
+                m_metrics.recordError();
+                connectionMetrics->recordError();
+                throw ServerRuntimeException("Writing the file failed.", errno);
+            }
+            if (bytesWritten == 0)
+            {
+                m_metrics.recordError();
+                connectionMetrics->recordError();
+                throw ServerRuntimeException("The file got shorter while it was sent.");
+            }
+            totalBytesWritten += static_cast<size_t>(bytesWritten);
+            m_metrics.recordWrite(bytesWritten);
+            connectionMetrics->recordWrite(bytesWritten);
+            refreshIdleDeadline(t_clientID);
+        }
+        if (writeDeadline != std::chrono::steady_clock::time_point::max())
+        {
+            disarmWriteDeadline(t_clientID);
+        }
+    }
+    catch (...)
+    {
+        releaseOutput(t_clientID, totalBytesWritten == 0);
+        throw;
+    }
+    releaseOutput(t_clientID, true);
+    m_metrics.getSendLatency().recordSince(sendStart);
+}
+
+void FBNetwork::Server::readXData(const int t_clientID, const ssize_t t_x)
+{
+    std::error_code error;
+    readXData(t_clientID, t_x, error);
+    if (error == NetworkError::INVALID_ARGUMENT)
+    {
+        throw InvalidArgumentException("Invalid number of bytes to read.");
+    }
+    else if (error)
+    {
+        throwError(error, "Reading the data failed.", "Timeout reached while reading data.");
+    }
+}
+
+void FBNetwork::Server::readXData(const int t_clientID, const ssize_t t_x, std::error_code &t_error)
+{
+    char           buffer[Constants::BUFFER_SIZE];
+    ssize_t        bytesRead            = 0;
+    fileDescriptor clientFileDescriptor = -1;
+    t_error.clear();
+    if (t_clientID >= 0 && !thisClientDoesNotExist(t_clientID))
+    {
+        clientFileDescriptor = getClientFileDescriptor(t_clientID);
+    }
+    if (clientFileDescriptor == -1)
+    {
+        t_error = NetworkError::INVALID_CLIENT;
+        return;
+    }
+    setData(t_clientID, std::string(""));
+    if (t_x <= 0)
+    {
+        t_error = NetworkError::INVALID_ARGUMENT;
+        return;
+    }
+    std::shared_ptr<ConnectionMetrics>    connectionMetrics = getConnectionMetrics(t_clientID);
+    std::chrono::steady_clock::time_point readStart         = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point readDeadline      = armReadDeadline(t_clientID);
+    std::string                           dataBuffer        = takeResidualData(t_clientID);
+    while (static_cast<ssize_t>(dataBuffer.length()) < t_x)
+    {
+        bytesRead = receiveChunk(t_clientID, clientFileDescriptor, buffer, sizeof(buffer), readDeadline, *connectionMetrics, t_error);
+        if (bytesRead == -1)
+        {
+            suspendRead(t_clientID, std::move(dataBuffer));
+            return;
+        }
+        dataBuffer.append(buffer, bytesRead);
+    }
+    std::chrono::steady_clock::time_point framingStart = std::chrono::steady_clock::now();
+    setData(t_clientID, dataBuffer.substr(0, t_x));
+    dataBuffer.erase(0, t_x);
+    storeResidualData(t_clientID, std::move(dataBuffer), true);
+    m_metrics.getFramingLatency().recordSince(framingStart);
+    disarmReadDeadline(t_clientID);
+    m_metrics.getReadLatency().recordSince(readStart);
+}
+
+void FBNetwork::Server::readCompressedData(const int t_clientID)
+{
+    std::shared_ptr<Compressor> compressor = getCompressor(t_clientID);
+    readXData(t_clientID, static_cast<ssize_t>(Constants::COMPRESSION_FRAME_HEADER_SIZE));
+    std::string header      = getData(t_clientID);
+    size_t      payloadSize = 0;
+    try
+    {
+        payloadSize = Compressor::getPayloadSize(header);
+    }
+    catch (InvalidArgumentException &e)
+    {
+        throw ServerRuntimeException(std::string("Reading the compressed data failed. Error: ") + e.what());
+    }
+    std::string payload;
+    if (payloadSize > 0)
+    {
+        std::error_code error;
+        readXData(t_clientID, static_cast<ssize_t>(payloadSize), error);
+        if (error == NetworkError::TIMEOUT)
+        {
+            suspendFrame(t_clientID, header);
         }
-        catch (InvalidArgumentException &e)
+        if (error)
         {
-
-            // The accept function failed.
-
-            throw ServerRuntimeException("Accepting the client failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+            throwError(error, "Reading the compressed data failed.", "Timeout reached while reading the compressed data.");
         }
+        payload = getData(t_clientID);
     }
-    else if (usesLocalDomain() == true)
+    std::string message;
+    std::string answer;
+    try
     {
-        try
+        if (Compressor::isOffer(header))
         {
-            socklen_t                    clientAddressLength = sizeof(sockaddr_un);
-            std::shared_ptr<sockaddr_un> clientAddressLocal  = std::make_shared<sockaddr_un>();
-            *clientAddressLocal                              = {};
-            int clientFileDescriptor =
-                accept(serverFileDescriptor, reinterpret_cast<sockaddr *>(clientAddressLocal.get()), &clientAddressLength);
-            setClientFileDescriptor(currentClientID, clientFileDescriptor);
-            setClientAddressLocal(currentClientID, clientAddressLocal);
+            answer = compressor->answerOffer(payload);
         }
-        catch (InvalidArgumentException &e)
+        else
         {
-
-            // The accept function failed.
-
-            throw ServerRuntimeException("Accepting the client failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+            compressor->decompress(header, payload, message);
         }
     }
-    try
+    catch (InvalidArgumentException &e)
     {
-        getEventQueue()->addClient(getClientFileDescriptor(currentClientID));
+        throw ServerRuntimeException(std::string("Reading the compressed data failed. Error: ") + e.what());
     }
-    catch (ServerRuntimeException &e)
+    catch (SystemRuntimeException &e)
     {
-        throw ServerRuntimeException("Setting the server file descriptor for the event queue failed.");
+        throw ServerRuntimeException(e.what());
     }
-    setCurrentClientID(currentClientID + 1);
-    return currentClientID;
-}
-
-void FBNetwork::Server::closeDisconnectedClients()
-{
-    for (int i = 0; i < getCurrentClientID(); i++)
+    setData(t_clientID, message);
+    if (!answer.empty())
     {
-        if (isDisconnected(i))
-        {
-            try
-            {
-                getEventQueue()->removeClient(getClientFileDescriptor(i));
-            }
-            catch (InvalidArgumentException &e)
-            {
-            }
-            catch (ServerRuntimeException &e)
-            {
-            }
-            int result = close(getClientFileDescriptor(i));
-            setClientFileDescriptor(i, -1);
-        }
+        sendData(t_clientID, answer);
     }
 }
 
-void FBNetwork::Server::sendData(const int t_clientID, const std::string &t_data)
+uint64_t FBNetwork::Server::readRpcRequest(const int t_clientID)
 {
-    if (t_data.empty())
-    {
-        throw InvalidArgumentException("Data to send cannot be empty.");
-    }
-    if (write(getClientFileDescriptor(t_clientID), t_data.c_str(), t_data.length()) == -1)
+    readXData(t_clientID, static_cast<ssize_t>(Constants::RPC_FRAME_HEADER_SIZE));
+    std::string    rawHeader = getData(t_clientID);
+    RpcFrameHeader header;
+    try
     {
-        throw ServerRuntimeException("Writing the data failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        header = RpcClient::decodeHeader(rawHeader);
     }
-}
-
-void FBNetwork::Server::readXData(const int t_clientID, const ssize_t t_x)
-{
-    char           buffer[Constants::BUFFER_SIZE] = {0};
-    ssize_t        totalBytesRead                 = 0;
-    ssize_t        bytesRead                      = 0;
-    ssize_t        bytesToAdd                     = 0;
-    std::string    dataBuffer                     = "";
-    fileDescriptor clientFileDescriptor           = getClientFileDescriptor(t_clientID);
-    if (clientFileDescriptor == -1)
+    catch (InvalidArgumentException &e)
     {
-        throw InvalidArgumentException("Invalid client ID.");
+        throw ServerRuntimeException(std::string("Reading the RPC request failed. Error: ") + e.what());
     }
-    int         activity = 0;
-    fd_set      readfds;
-    timeval     timeout             = getTimeout();
-    time_t      timeoutSeconds      = timeout.tv_sec;
-    suseconds_t timeoutMicroseconds = timeout.tv_usec;
-    setData(t_clientID, std::string(""));
-    if (t_x <= 0)
+    if (header.type != RpcFrameType::REQUEST)
     {
-        throw InvalidArgumentException("Invalid number of bytes to read.");
+        throw ServerRuntimeException("Reading the RPC request failed. Error: The frame is not a request.");
     }
-    while (true)
+    if (header.payloadSize > 0)
     {
-        FD_ZERO(&readfds);
-        FD_SET(clientFileDescriptor, &readfds);
-
-        // Wait for data to be available with the specified timeout
-
-        activity = select(clientFileDescriptor + 1, &readfds, nullptr, nullptr, &timeout);
-
-        if (activity < 0 && errno != EINTR)
-        {
-            throw ServerRuntimeException("Error during select: " + ExtendedSystem::getCurrentErrnoError());
-        }
-        else if (activity == 0)
+        std::error_code error;
+        readXData(t_clientID, static_cast<ssize_t>(header.payloadSize), error);
+        if (error == NetworkError::TIMEOUT)
         {
-
-            // Timeout reached
-
-            throw ServerTimeoutException("Timeout reached while reading data.");
+            suspendFrame(t_clientID, rawHeader);
         }
-
-        // Check if data is ready to be read
-
-        if (FD_ISSET(clientFileDescriptor, &readfds))
+        if (error)
         {
-            bytesRead = recv(clientFileDescriptor, buffer, sizeof(buffer), 0);
-            if (bytesRead == -1)
-            {
-                if (errno == EINTR)
-                {
-                    continue;
-                }
-                else
-                {
-                    throw ServerRuntimeException("Error reading data: " + ExtendedSystem::getCurrentErrnoError());
-                }
-            }
-            else if (bytesRead == 0)
-            {
-                throw ServerRuntimeException("Connection closed by client.");
-            }
-            bytesToAdd = std::min(bytesRead, t_x - totalBytesRead);
-            dataBuffer.append(buffer, bytesToAdd);
-            totalBytesRead += bytesToAdd;
-            memset(buffer, 0, Constants::BUFFER_SIZE);
-            if (totalBytesRead == t_x)
-            {
-                setData(t_clientID, dataBuffer);
-                return;
-            }
-
-            // Reset the timeout
-
-            timeout.tv_sec  = timeoutSeconds;
-            timeout.tv_usec = timeoutMicroseconds;
+            throwError(error, "Reading the RPC request failed.", "Timeout reached while reading the RPC request.");
         }
     }
+    else
+    {
+        setData(t_clientID, "");
+    }
+    return header.correlationID;
 }
 
 void FBNetwork::Server::readTillXData(const int t_clientID, const std::string &t_x)
 {
-    char           buffer[Constants::BUFFER_SIZE] = {0};
-    ssize_t        bytesRead                      = 0;
-    std::string    dataBuffer                     = "";
-    size_t         pos                            = 0;
-    fileDescriptor clientFileDescriptor           = getClientFileDescriptor(t_clientID);
+    std::error_code error;
+    readTillXData(t_clientID, t_x, error);
+    if (error == NetworkError::INVALID_ARGUMENT)
+    {
+        throw InvalidArgumentException("Invalid string to read.");
+    }
+    else if (error)
+    {
+        throwError(error, "Reading the data failed.", "Timeout reached while reading data.");
+    }
+}
+
+void FBNetwork::Server::readTillXData(const int t_clientID, const std::string &t_x, std::error_code &t_error)
+{
+    char           buffer[Constants::BUFFER_SIZE];
+    ssize_t        bytesRead            = 0;
+    size_t         pos                  = 0;
+    size_t         searchPos            = 0;
+    fileDescriptor clientFileDescriptor = -1;
+    t_error.clear();
+    if (t_clientID >= 0 && !thisClientDoesNotExist(t_clientID))
+    {
+        clientFileDescriptor = getClientFileDescriptor(t_clientID);
+    }
     if (clientFileDescriptor == -1)
     {
-        throw InvalidArgumentException("Invalid client ID.");
+        t_error = NetworkError::INVALID_CLIENT;
+        return;
     }
-    int         activity = 0;
-    fd_set      readfds;
-    timeval     timeout             = getTimeout();
-    time_t      timeoutSeconds      = timeout.tv_sec;
-    suseconds_t timeoutMicroseconds = timeout.tv_usec;
     setData(t_clientID, std::string(""));
     if (t_x.empty())
     {
-        throw InvalidArgumentException("Invalid string to read.");
+        t_error = NetworkError::INVALID_ARGUMENT;
+        return;
     }
-    while (true)
+    std::shared_ptr<ConnectionMetrics>    connectionMetrics = getConnectionMetrics(t_clientID);
+    std::chrono::steady_clock::time_point readStart         = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point readDeadline      = armReadDeadline(t_clientID);
+    std::string                           dataBuffer        = takeResidualData(t_clientID);
+    std::chrono::steady_clock::time_point framingStart      = std::chrono::steady_clock::now();
+    while ((pos = dataBuffer.find(t_x, searchPos)) == std::string::npos)
     {
-        FD_ZERO(&readfds);
-        FD_SET(clientFileDescriptor, &readfds);
-
-        // Wait for data to be available with the specified timeout
-
-        int activity = select(clientFileDescriptor + 1, &readfds, NULL, NULL, &timeout);
-
-        if (activity < 0 && errno != EINTR)
-        {
-            throw ServerRuntimeException("Error during select: " + ExtendedSystem::getCurrentErrnoError());
-        }
-        else if (activity == 0)
-        {
-
-            // Timeout reached
-
-            throw ServerTimeoutException("Timeout reached while reading data.");
-        }
 
-        // Check if data is ready to be read
+        // Only the last bytes can be the start of 'x', so the next search starts there instead of at the beginning
 
-        if (FD_ISSET(clientFileDescriptor, &readfds))
+        searchPos = dataBuffer.length() < t_x.length() ? 0 : dataBuffer.length() - t_x.length() + 1;
+        m_metrics.getFramingLatency().recordSince(framingStart);
+        bytesRead = receiveChunk(t_clientID, clientFileDescriptor, buffer, sizeof(buffer), readDeadline, *connectionMetrics, t_error);
+        if (bytesRead == -1)
         {
-            bytesRead = recv(clientFileDescriptor, buffer, sizeof(buffer), 0);
-            if (bytesRead == -1)
-            {
-                if (errno == EINTR)
-                {
-                    continue;
-                }
-                else
-                {
-                    throw ServerRuntimeException("Error reading data: " + ExtendedSystem::getCurrentErrnoError());
-                }
-            }
-            else if (bytesRead == 0)
-            {
-                throw ServerRuntimeException("Connection closed by client.");
-            }
-
-            dataBuffer.append(buffer, bytesRead);
-            pos = dataBuffer.find(t_x);
-            if (pos != std::string::npos)
-            {
-                setData(t_clientID, dataBuffer.substr(0, pos + t_x.length()));
-                return;
-            }
-            memset(buffer, 0, Constants::BUFFER_SIZE);
-
-            // Reset the timeout
-
-            timeout.tv_sec  = timeoutSeconds;
-            timeout.tv_usec = timeoutMicroseconds;
+            suspendRead(t_clientID, std::move(dataBuffer));
+            return;
         }
+        framingStart = std::chrono::steady_clock::now();
+        dataBuffer.append(buffer, bytesRead);
     }
+    setData(t_clientID, dataBuffer.substr(0, pos + t_x.length()));
+    dataBuffer.erase(0, pos + t_x.length());
+    storeResidualData(t_clientID, std::move(dataBuffer), true);
+    m_metrics.getFramingLatency().recordSince(framingStart);
+    disarmReadDeadline(t_clientID);
+    m_metrics.getReadLatency().recordSince(readStart);
 }
 
 void FBNetwork::Server::readTillXComesYTimesData(const int t_clientID, const std::string &t_x, const int t_y)
 {
-    char           buffer[Constants::BUFFER_SIZE] = {0};
-    ssize_t        bytesRead                      = 0;
-    std::string    dataBuffer                     = "";
-    size_t         pos                            = 0;
-    size_t         bufferPos                      = 0;
-    int            count                          = 0;
-    fileDescriptor clientFileDescriptor           = getClientFileDescriptor(t_clientID);
+    char           buffer[Constants::BUFFER_SIZE];
+    ssize_t        bytesRead            = 0;
+    size_t         pos                  = 0;
+    size_t         bufferPos            = 0;
+    size_t         searchPos            = 0;
+    int            count                = 0;
+    fileDescriptor clientFileDescriptor = getClientFileDescriptor(t_clientID);
     if (clientFileDescriptor == -1)
     {
         throw InvalidArgumentException("Invalid client ID.");
     }
-    int         activity = 0;
-    fd_set      readfds;
-    timeval     timeout             = getTimeout();
-    time_t      timeoutSeconds      = timeout.tv_sec;
-    suseconds_t timeoutMicroseconds = timeout.tv_usec;
     setData(t_clientID, std::string(""));
     if (t_x.empty())
     {
@@ -929,86 +3315,200 @@ void FBNetwork::Server::readTillXComesYTimesData(const int t_clientID, const std
     {
         throw InvalidArgumentException("Invalid number of times to read.");
     }
+    std::shared_ptr<ConnectionMetrics>    connectionMetrics = getConnectionMetrics(t_clientID);
+    std::chrono::steady_clock::time_point readStart         = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point readDeadline      = armReadDeadline(t_clientID);
+    std::string                           dataBuffer        = takeResidualData(t_clientID);
+    std::error_code                       error;
     while (true)
     {
-        FD_ZERO(&readfds);
-        FD_SET(clientFileDescriptor, &readfds);
+        std::chrono::steady_clock::time_point framingStart = std::chrono::steady_clock::now();
+        while ((pos = dataBuffer.find(t_x, std::max(bufferPos, searchPos))) != std::string::npos)
+        {
+            count++;
+            bufferPos = pos + t_x.length();
+            if (count == t_y)
+            {
+                setData(t_clientID, dataBuffer.substr(0, bufferPos));
+                dataBuffer.erase(0, bufferPos);
+                storeResidualData(t_clientID, std::move(dataBuffer), true);
+                disarmReadDeadline(t_clientID);
+                m_metrics.getFramingLatency().recordSince(framingStart);
+                m_metrics.getReadLatency().recordSince(readStart);
+                return;
+            }
+        }
+        searchPos = dataBuffer.length() < t_x.length() ? 0 : dataBuffer.length() - t_x.length() + 1;
+        m_metrics.getFramingLatency().recordSince(framingStart);
+        bytesRead = receiveChunk(t_clientID, clientFileDescriptor, buffer, sizeof(buffer), readDeadline, *connectionMetrics, error);
+        if (bytesRead == -1)
+        {
+            suspendRead(t_clientID, std::move(dataBuffer));
+            throwError(error, "Reading the data failed.", "Timeout reached while reading data.");
+        }
+        dataBuffer.append(buffer, bytesRead);
+    }
+}
 
-        // Wait for data to be available with the specified timeout
+std::vector<FBNetwork::eventTuple> FBNetwork::Server::getPendingEvents()
+{
+    std::vector<FBNetwork::eventTuple> returnEvents;
+    if (m_isCpuPlacementPending.exchange(false))
+    {
 
-        int activity = select(clientFileDescriptor + 1, &readfds, NULL, NULL, &timeout);
+        // The thread that polls the events is the event loop, so it takes the placement before it touches any buffer
 
-        if (activity < 0 && errno != EINTR)
+        try
         {
-            throw ServerRuntimeException("Error during select: " + ExtendedSystem::getCurrentErrnoError());
+            getCpuPlacement().applyToCurrentThread();
         }
-        else if (activity == 0)
+        catch (SystemRuntimeException &e)
+        {
+            throw ServerRuntimeException(e.what());
+        }
+    }
+    while (returnEvents.empty())
+    {
+        if (isDrained())
+        {
+            break;
+        }
+        if (m_isAcceptingPaused.load() && !isOverloaded())
+        {
+            resumeAccepting();
+        }
+
+        // Without deadlines wait indefinitely, otherwise only until the next deadline may pass. Clients with decrypted data or with
+        // pipelined data left by the last read are not seen by the event queue, they are ready right away
+
+        FBNetwork::eventList pendingEvents;
+        std::vector<int>     bufferedClientIDs = getTlsBufferedClientIDs();
+        std::vector<int>     residualClientIDs = takeResidualClientIDs();
+        if (m_hasRateLimits.load(std::memory_order_relaxed))
         {
 
-            // Timeout reached
+            // A paused client must not wake the loop up. Its decrypted data is found again later, its pipelined data is remembered
 
-            throw ServerTimeoutException("Timeout reached while reading data.");
+            bufferedClientIDs.erase(std::remove_if(bufferedClientIDs.begin(), bufferedClientIDs.end(),
+                                                   [this](const int t_clientID) { return isReadingPaused(t_clientID); }),
+                                    bufferedClientIDs.end());
+            residualClientIDs.erase(std::remove_if(residualClientIDs.begin(), residualClientIDs.end(),
+                                                   [this](const int t_clientID) { return deferIfPaused(t_clientID); }),
+                                    residualClientIDs.end());
         }
+        bufferedClientIDs.insert(bufferedClientIDs.end(), residualClientIDs.begin(), residualClientIDs.end());
+        std::sort(bufferedClientIDs.begin(), bufferedClientIDs.end());
+        bufferedClientIDs.erase(std::unique(bufferedClientIDs.begin(), bufferedClientIDs.end()), bufferedClientIDs.end());
+        int timeout = bufferedClientIDs.empty() ? getMillisecondsUntilNextDeadline() : 0;
+        if (timeout == -1)
+        {
+            pendingEvents = getEventQueue()->pollEvents();
+        }
+        else
+        {
 
-        // Check if data is ready to be read
+            // Reaching the timeout is the normal case when waiting for a deadline, so it must not throw
 
-        if (FD_ISSET(clientFileDescriptor, &readfds))
+            std::error_code error;
+            pendingEvents = getEventQueue()->pollEvents(timeout, error);
+            if (error && error != NetworkError::TIMEOUT)
+            {
+                throw ServerRuntimeException("Retrieving the events from the event queue failed.", error);
+            }
+        }
+        std::vector<int> resumedClientIDs;
+        for (int clientID : expireClientDeadlines(resumedClientIDs))
         {
-            bytesRead = recv(clientFileDescriptor, buffer, sizeof(buffer), 0);
-            if (bytesRead == -1)
+            m_metrics.recordTimeout();
+            getConnectionMetrics(clientID)->recordTimeout();
+            try
+            {
+                closeClient(clientID);
+            }
+            catch (ServerRuntimeException &e)
             {
-                if (errno == EINTR)
-                {
-                    continue;
-                }
-                else
-                {
-                    throw ServerRuntimeException("Error reading data: " + ExtendedSystem::getCurrentErrnoError());
-                }
             }
-            else if (bytesRead == 0)
+            returnEvents.push_back(std::make_tuple(EventType::CLIENT_TIMED_OUT, clientID));
+        }
+        for (int clientID : resumedClientIDs)
+        {
+            if (thisClientDoesNotExist(clientID) || getClientFileDescriptor(clientID) == -1)
             {
-                throw ServerRuntimeException("Connection closed by client.");
+                continue;
             }
-            dataBuffer.append(buffer, bytesRead);
-            while ((pos = dataBuffer.find(t_x, bufferPos)) != std::string::npos)
+            try
             {
-                count++;
-                bufferPos = pos + t_x.length();
-                if (count == t_y)
+                if (resumeReading(clientID) && hasResidualData(clientID) && admitClientEvent(clientID))
                 {
-                    setData(t_clientID, dataBuffer.substr(0, bufferPos));
-                    return;
+                    returnEvents.push_back(std::make_tuple(EventType::CLIENT_WANTS_TO_SEND_DATA, clientID));
                 }
             }
-            memset(buffer, 0, Constants::BUFFER_SIZE);
-
-            // Reset the timeout
-
-            timeout.tv_sec  = timeoutSeconds;
-            timeout.tv_usec = timeoutMicroseconds;
-        }
-    }
-}
-
-std::vector<FBNetwork::eventTuple> FBNetwork::Server::getPendingEvents()
-{
-    FBNetwork::eventList               pendingEvents = getEventQueue()->pollEvents();
-    std::vector<FBNetwork::eventTuple> returnEvents;
-    for (event e : pendingEvents)
-    {
-        if (getEventQueue()->hasAnError(&e))
-        {
-            returnEvents.push_back(std::make_tuple(EventType::ERROR, -1));
+            catch (ServerRuntimeException &e)
+            {
+                m_metrics.recordError();
+            }
         }
-        else if (getEventQueue()->isServerEvent(&e))
+        for (int clientID : bufferedClientIDs)
         {
-            returnEvents.push_back(std::make_tuple(EventType::CLIENT_WANTS_TO_CONNECT, -1));
+            if (getClientFileDescriptor(clientID) == -1)
+            {
+                continue;
+            }
+            if (admitClientEvent(clientID))
+            {
+                returnEvents.push_back(std::make_tuple(EventType::CLIENT_WANTS_TO_SEND_DATA, clientID));
+            }
+            else
+            {
+                deferIfPaused(clientID);
+            }
         }
-        else
+        for (event e : pendingEvents)
         {
-            returnEvents.push_back(
-                std::make_tuple(EventType::CLIENT_WANTS_TO_SEND_DATA, getClientID(getEventQueue()->getClientFileDescriptor(&e))));
+            if (getEventQueue()->hasAnError(&e) && (getEventQueue()->isServerEvent(&e) || !getEventQueue()->isReadableEvent(&e)))
+            {
+
+                // A reset client is also readable, it is reported as a client so the failing read closes it, otherwise it is reported
+                // again on every call
+
+                returnEvents.push_back(std::make_tuple(EventType::ERROR, -1));
+            }
+            else if (getEventQueue()->isServerEvent(&e))
+            {
+                returnEvents.push_back(std::make_tuple(EventType::CLIENT_WANTS_TO_CONNECT, -1));
+            }
+            else if (getEventQueue()->getClientFileDescriptor(&e) == m_wakeUpFileDescriptors[0])
+            {
+                runPostedTasks();
+            }
+            else
+            {
+                int clientID = -1;
+                try
+                {
+                    clientID = getClientID(getEventQueue()->getClientFileDescriptor(&e));
+                }
+                catch (std::out_of_range &e)
+                {
+
+                    // The client timed out in this round and is already closed
+
+                    continue;
+                }
+                if (getEventQueue()->isWritableEvent(&e))
+                {
+                    flushOutputQueue(clientID);
+                    if (!getEventQueue()->isReadableEvent(&e))
+                    {
+                        continue;
+                    }
+                }
+                if (std::find(bufferedClientIDs.begin(), bufferedClientIDs.end(), clientID) == bufferedClientIDs.end() &&
+                    completeTlsHandshake(clientID) && admitClientEvent(clientID))
+                {
+                    returnEvents.push_back(std::make_tuple(EventType::CLIENT_WANTS_TO_SEND_DATA, clientID));
+                }
+            }
         }
     }
     return returnEvents;
@@ -1046,10 +3546,17 @@ bool FBNetwork::Server::isDisconnected(const int t_clientID)
         }
         if (bytesRead == -1)
         {
-            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            if (errno == EINTR)
             {
                 continue;
             }
+            else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+
+                // No data pending, but the connection is still open
+
+                return false;
+            }
             else
             {
                 return true;
@@ -1061,7 +3568,33 @@ bool FBNetwork::Server::isDisconnected(const int t_clientID)
 
 void FBNetwork::Server::closeClient(const int t_clientID)
 {
-    if (close(getClientFileDescriptor(t_clientID)) == -1)
+
+    // Only the thread that takes the file descriptor tears the client down, so its ID is released and its file descriptor closed once
+
+    fileDescriptor clientFileDescriptor = takeClientFileDescriptor(t_clientID);
+    if (clientFileDescriptor == -1)
+    {
+        return;
+    }
+    try
+    {
+        getEventQueue()->removeClient(clientFileDescriptor);
+    }
+    catch (InvalidArgumentException &e)
+    {
+    }
+    catch (ServerRuntimeException &e)
+    {
+    }
+    stopTls(t_clientID);
+    takeResidualData(t_clientID);
+    dropOutputQueue(t_clientID);
+    resetFlowControl(t_clientID);
+    resetCompression(t_clientID);
+    cancelClientDeadlines(t_clientID);
+    releaseClientID(t_clientID);
+    m_metrics.recordClose();
+    if (close(clientFileDescriptor) == -1)
     {
         if (errno != EBADF)
         {
@@ -1077,4 +3610,60 @@ void FBNetwork::Server::setTimeout(const timeval t_timeout)
         throw InvalidArgumentException("Invalid timeout.");
     }
     m_timeout = t_timeout;
-}
\ No newline at end of file
+}
+
+void FBNetwork::Server::setIdleTimeout(const std::chrono::milliseconds t_idleTimeout)
+{
+    if (t_idleTimeout.count() < 0)
+    {
+        throw InvalidArgumentException("Idle timeout cannot be negative.");
+    }
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    m_idleTimeout = t_idleTimeout;
+    m_hasClientTimeouts.store(m_idleTimeout.count() > 0 || m_readTimeout.count() > 0 || m_writeTimeout.count() > 0);
+}
+
+void FBNetwork::Server::setReadTimeout(const std::chrono::milliseconds t_readTimeout)
+{
+    if (t_readTimeout.count() < 0)
+    {
+        throw InvalidArgumentException("Read timeout cannot be negative.");
+    }
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    m_readTimeout = t_readTimeout;
+    m_hasClientTimeouts.store(m_idleTimeout.count() > 0 || m_readTimeout.count() > 0 || m_writeTimeout.count() > 0);
+}
+
+void FBNetwork::Server::setWriteTimeout(const std::chrono::milliseconds t_writeTimeout)
+{
+    if (t_writeTimeout.count() < 0)
+    {
+        throw InvalidArgumentException("Write timeout cannot be negative.");
+    }
+    std::lock_guard<std::mutex> lock(m_timingWheelMutex);
+    m_writeTimeout = t_writeTimeout;
+    m_hasClientTimeouts.store(m_idleTimeout.count() > 0 || m_readTimeout.count() > 0 || m_writeTimeout.count() > 0);
+}
+
+#ifdef FBNETWORK_WITH_TLS
+void FBNetwork::Server::setTlsContext(std::shared_ptr<TlsContext> t_tlsContext)
+{
+    if (t_tlsContext != nullptr && t_tlsContext->getRole() != TlsRole::SERVER)
+    {
+        throw InvalidArgumentException("The TLS context of a server must be created with TlsRole::SERVER.");
+    }
+    std::unique_lock<std::shared_mutex> lock(m_tlsMutex);
+    m_tlsContext = t_tlsContext;
+}
+
+std::shared_ptr<FBNetwork::TlsConnection> FBNetwork::Server::getTlsConnection(const int t_clientID)
+{
+    std::shared_lock<std::shared_mutex> lock(m_tlsMutex);
+    auto                                tlsConnection = m_tlsConnections.find(t_clientID);
+    if (tlsConnection == m_tlsConnections.end())
+    {
+        return nullptr;
+    }
+    return tlsConnection->second;
+}
+#endif
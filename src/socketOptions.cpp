@@ -0,0 +1,259 @@
+#include "../include/socketOptions.hpp"
+#include "../include/extendedSystem.hpp"
+
+void FBNetwork::SocketOptions::setOption(const fileDescriptor t_fileDescriptor, const int t_level, const int t_name, const int t_value,
+                                         const char *t_optionName)
+{
+    if (setsockopt(t_fileDescriptor, t_level, t_name, &t_value, sizeof(t_value)) == -1)
+    {
+        throw SystemRuntimeException("Setting " + std::string(t_optionName) + " failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+}
+
+void FBNetwork::SocketOptions::throwUnsupported(const char *t_optionName)
+{
+    errno = ENOPROTOOPT;
+    throw SystemRuntimeException("Setting " + std::string(t_optionName) + " failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+}
+
+void FBNetwork::SocketOptions::setNoDelay(const bool t_noDelay)
+{
+    m_noDelay = t_noDelay;
+}
+
+void FBNetwork::SocketOptions::setCork(const bool t_cork)
+{
+    m_cork = t_cork;
+}
+
+void FBNetwork::SocketOptions::setQuickAck(const bool t_quickAck)
+{
+    m_quickAck = t_quickAck;
+}
+
+void FBNetwork::SocketOptions::setNotSentLowWatermark(const int t_bytes)
+{
+    if (t_bytes < 0)
+    {
+        throw InvalidArgumentException("The not sent low watermark cannot be negative.");
+    }
+    m_notSentLowWatermark = t_bytes;
+}
+
+void FBNetwork::SocketOptions::setDeferAcceptTimeout(const int t_timeout)
+{
+    if (t_timeout < 0)
+    {
+        throw InvalidArgumentException("The defer accept timeout cannot be negative.");
+    }
+    m_deferAcceptTimeout = t_timeout;
+}
+
+void FBNetwork::SocketOptions::setFastOpen(const int t_queueLength)
+{
+    if (t_queueLength < 0)
+    {
+        throw InvalidArgumentException("The fast open queue length cannot be negative.");
+    }
+    m_fastOpenQueueLength = t_queueLength;
+}
+
+void FBNetwork::SocketOptions::setReusePort(const bool t_reusePort)
+{
+    m_reusePort = t_reusePort;
+}
+
+void FBNetwork::SocketOptions::setKeepAlive(const int t_idleTime, const int t_interval, const int t_count)
+{
+    if (t_idleTime < 1 || t_interval < 1 || t_count < 1)
+    {
+        throw InvalidArgumentException("The keep alive times and count must be greater than 0.");
+    }
+    m_keepAliveIdleTime = t_idleTime;
+    m_keepAliveInterval = t_interval;
+    m_keepAliveCount    = t_count;
+}
+
+void FBNetwork::SocketOptions::setBufferSizes(const int t_receiveBufferSize, const int t_sendBufferSize)
+{
+    if (t_receiveBufferSize < 0 || t_sendBufferSize < 0)
+    {
+        throw InvalidArgumentException("The buffer sizes cannot be negative.");
+    }
+    m_receiveBufferSize.reset();
+    m_sendBufferSize.reset();
+    if (t_receiveBufferSize > 0)
+    {
+        m_receiveBufferSize = t_receiveBufferSize;
+    }
+    if (t_sendBufferSize > 0)
+    {
+        m_sendBufferSize = t_sendBufferSize;
+    }
+}
+
+void FBNetwork::SocketOptions::setTypeOfService(const int t_typeOfService)
+{
+    if (t_typeOfService < 0 || t_typeOfService > 255)
+    {
+        throw InvalidArgumentException("The type of service must be between 0 and 255.");
+    }
+    m_typeOfService = t_typeOfService;
+}
+
+bool FBNetwork::SocketOptions::usesCork() const
+{
+    return m_cork.value_or(false);
+}
+
+bool FBNetwork::SocketOptions::usesQuickAck() const
+{
+    return m_quickAck.value_or(false);
+}
+
+void FBNetwork::SocketOptions::applyToListener(const fileDescriptor t_fileDescriptor, const domain t_domain) const
+{
+    if (m_receiveBufferSize.has_value())
+    {
+        setOption(t_fileDescriptor, SOL_SOCKET, SO_RCVBUF, *m_receiveBufferSize, "SO_RCVBUF");
+    }
+    if (m_sendBufferSize.has_value())
+    {
+        setOption(t_fileDescriptor, SOL_SOCKET, SO_SNDBUF, *m_sendBufferSize, "SO_SNDBUF");
+    }
+    if (t_domain == Domain::LOCAL_DOMAIN)
+    {
+        return;
+    }
+    if (m_reusePort.has_value())
+    {
+#ifdef SO_REUSEPORT
+        setOption(t_fileDescriptor, SOL_SOCKET, SO_REUSEPORT, *m_reusePort ? 1 : 0, "SO_REUSEPORT");
+#else
+        throwUnsupported("SO_REUSEPORT");
+#endif
+    }
+    if (m_deferAcceptTimeout.has_value())
+    {
+#ifdef TCP_DEFER_ACCEPT
+        setOption(t_fileDescriptor, IPPROTO_TCP, TCP_DEFER_ACCEPT, *m_deferAcceptTimeout, "TCP_DEFER_ACCEPT");
+#else
+        throwUnsupported("TCP_DEFER_ACCEPT");
+#endif
+    }
+    if (m_fastOpenQueueLength.has_value())
+    {
+#if defined(__APPLE__) && defined(TCP_FASTOPEN)
+
+        // macOS takes a flag instead of a queue length
+
+        setOption(t_fileDescriptor, IPPROTO_TCP, TCP_FASTOPEN, *m_fastOpenQueueLength > 0 ? 1 : 0, "TCP_FASTOPEN");
+#elif defined(TCP_FASTOPEN)
+        setOption(t_fileDescriptor, IPPROTO_TCP, TCP_FASTOPEN, *m_fastOpenQueueLength, "TCP_FASTOPEN");
+#else
+        throwUnsupported("TCP_FASTOPEN");
+#endif
+    }
+}
+
+bool FBNetwork::SocketOptions::enableFastOpenConnect(const fileDescriptor t_fileDescriptor)
+{
+#ifdef TCP_FASTOPEN_CONNECT
+    int fastOpenConnect = 1;
+    return setsockopt(t_fileDescriptor, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &fastOpenConnect, sizeof(fastOpenConnect)) == 0;
+#else
+    return false;
+#endif
+}
+
+void FBNetwork::SocketOptions::applyToConnection(const fileDescriptor t_fileDescriptor, const domain t_domain) const
+{
+    if (m_receiveBufferSize.has_value())
+    {
+        setOption(t_fileDescriptor, SOL_SOCKET, SO_RCVBUF, *m_receiveBufferSize, "SO_RCVBUF");
+    }
+    if (m_sendBufferSize.has_value())
+    {
+        setOption(t_fileDescriptor, SOL_SOCKET, SO_SNDBUF, *m_sendBufferSize, "SO_SNDBUF");
+    }
+    if (t_domain == Domain::LOCAL_DOMAIN)
+    {
+        return;
+    }
+    if (m_noDelay.has_value())
+    {
+        setOption(t_fileDescriptor, IPPROTO_TCP, TCP_NODELAY, *m_noDelay ? 1 : 0, "TCP_NODELAY");
+    }
+    if (m_cork.has_value())
+    {
+#if defined(TCP_CORK)
+        setOption(t_fileDescriptor, IPPROTO_TCP, TCP_CORK, *m_cork ? 1 : 0, "TCP_CORK");
+#elif defined(TCP_NOPUSH)
+        setOption(t_fileDescriptor, IPPROTO_TCP, TCP_NOPUSH, *m_cork ? 1 : 0, "TCP_NOPUSH");
+#else
+        throwUnsupported("TCP_CORK");
+#endif
+    }
+    if (m_quickAck.has_value())
+    {
+#ifdef TCP_QUICKACK
+        setOption(t_fileDescriptor, IPPROTO_TCP, TCP_QUICKACK, *m_quickAck ? 1 : 0, "TCP_QUICKACK");
+#else
+        throwUnsupported("TCP_QUICKACK");
+#endif
+    }
+    if (m_notSentLowWatermark.has_value())
+    {
+#ifdef TCP_NOTSENT_LOWAT
+        setOption(t_fileDescriptor, IPPROTO_TCP, TCP_NOTSENT_LOWAT, *m_notSentLowWatermark, "TCP_NOTSENT_LOWAT");
+#else
+        throwUnsupported("TCP_NOTSENT_LOWAT");
+#endif
+    }
+    if (m_keepAliveIdleTime.has_value())
+    {
+        setOption(t_fileDescriptor, SOL_SOCKET, SO_KEEPALIVE, 1, "SO_KEEPALIVE");
+#ifdef TCP_KEEPIDLE
+        setOption(t_fileDescriptor, IPPROTO_TCP, TCP_KEEPIDLE, *m_keepAliveIdleTime, "TCP_KEEPIDLE");
+#else
+        setOption(t_fileDescriptor, IPPROTO_TCP, TCP_KEEPALIVE, *m_keepAliveIdleTime, "TCP_KEEPALIVE");
+#endif
+        setOption(t_fileDescriptor, IPPROTO_TCP, TCP_KEEPINTVL, *m_keepAliveInterval, "TCP_KEEPINTVL");
+        setOption(t_fileDescriptor, IPPROTO_TCP, TCP_KEEPCNT, *m_keepAliveCount, "TCP_KEEPCNT");
+    }
+    if (m_typeOfService.has_value())
+    {
+        if (t_domain == Domain::IPV6_DOMAIN)
+        {
+            setOption(t_fileDescriptor, IPPROTO_IPV6, IPV6_TCLASS, *m_typeOfService, "IPV6_TCLASS");
+        }
+        else
+        {
+            setOption(t_fileDescriptor, IPPROTO_IP, IP_TOS, *m_typeOfService, "IP_TOS");
+        }
+    }
+}
+
+void FBNetwork::SocketOptions::flushCork(const fileDescriptor t_fileDescriptor)
+{
+
+    // Taking the cork out sends the partial frame, putting it back holds the next message again
+
+#if defined(TCP_CORK)
+    setOption(t_fileDescriptor, IPPROTO_TCP, TCP_CORK, 0, "TCP_CORK");
+    setOption(t_fileDescriptor, IPPROTO_TCP, TCP_CORK, 1, "TCP_CORK");
+#elif defined(TCP_NOPUSH)
+    setOption(t_fileDescriptor, IPPROTO_TCP, TCP_NOPUSH, 0, "TCP_NOPUSH");
+    setOption(t_fileDescriptor, IPPROTO_TCP, TCP_NOPUSH, 1, "TCP_NOPUSH");
+#else
+    throwUnsupported("TCP_CORK");
+#endif
+}
+
+void FBNetwork::SocketOptions::rearmQuickAck(const fileDescriptor t_fileDescriptor)
+{
+#ifdef TCP_QUICKACK
+    int quickAck = 1;
+    setsockopt(t_fileDescriptor, IPPROTO_TCP, TCP_QUICKACK, &quickAck, sizeof(quickAck));
+#endif
+}
@@ -0,0 +1,221 @@
+#include "../include/taskPool.hpp"
+
+namespace
+{
+    thread_local const FBNetwork::TaskPool *currentPool        = nullptr;
+    thread_local size_t                     currentWorkerIndex = 0;
+}  // namespace
+
+FBNetwork::TaskPool::TaskPool(const size_t t_threadCount)
+{
+    size_t threadCount = t_threadCount;
+    if (threadCount == 0)
+    {
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t i = 0; i < threadCount; i++)
+    {
+        m_threads.emplace_back(&TaskPool::run, this, i);
+    }
+}
+
+FBNetwork::TaskPool::~TaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_isRunning = false;
+    }
+    m_wakeUp.notify_all();
+    for (std::thread &thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void FBNetwork::TaskPool::run(const size_t t_workerIndex)
+{
+    currentPool        = this;
+    currentWorkerIndex = t_workerIndex;
+    uint32_t seed      = static_cast<uint32_t>(t_workerIndex) * 2654435761U + 1;
+    while (true)
+    {
+        task nextTask;
+        if (takeTask(t_workerIndex, nextTask) || stealTask(t_workerIndex, seed, nextTask))
+        {
+            execute(nextTask);
+            continue;
+        }
+
+        // Running tasks of a key can still schedule the next one, so a worker only stops when nothing is queued and nothing runs
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_wakeUp.wait(lock, [this] { return m_queuedTasks.load() > 0 || (!m_isRunning && m_outstandingTasks.load() == 0); });
+        if (!m_isRunning && m_queuedTasks.load() == 0 && m_outstandingTasks.load() == 0)
+        {
+            return;
+        }
+    }
+}
+
+void FBNetwork::TaskPool::schedule(task &&t_task)
+{
+    size_t workerIndex = currentPool == this ? currentWorkerIndex : m_nextWorker.fetch_add(1) % m_workers.size();
+    {
+        std::lock_guard<std::mutex> lock(m_workers[workerIndex]->mutex);
+        m_workers[workerIndex]->tasks.push_back(std::move(t_task));
+    }
+    m_queuedTasks.fetch_add(1);
+
+    // Taking the mutex orders the counter before the check of a worker that is about to sleep, so the notification is not lost
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_wakeUp.notify_one();
+}
+
+bool FBNetwork::TaskPool::takeTask(const size_t t_workerIndex, task &t_task)
+{
+    Worker                     &worker = *m_workers[t_workerIndex];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty())
+    {
+        return false;
+    }
+    t_task = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    m_queuedTasks.fetch_sub(1);
+    return true;
+}
+
+bool FBNetwork::TaskPool::stealTask(const size_t t_workerIndex, uint32_t &t_seed, task &t_task)
+{
+    if (m_workers.size() < 2 || m_queuedTasks.load() == 0)
+    {
+        return false;
+    }
+    t_seed ^= t_seed << 13;
+    t_seed ^= t_seed >> 17;
+    t_seed ^= t_seed << 5;
+    size_t start = t_seed % m_workers.size();
+    for (size_t i = 0; i < m_workers.size(); i++)
+    {
+        size_t victimIndex = (start + i) % m_workers.size();
+        if (victimIndex == t_workerIndex)
+        {
+            continue;
+        }
+        Worker                     &victim = *m_workers[victimIndex];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty())
+        {
+            continue;
+        }
+        t_task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        m_queuedTasks.fetch_sub(1);
+        m_stolenTasks.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void FBNetwork::TaskPool::execute(task &t_task)
+{
+    try
+    {
+        t_task();
+    }
+    catch (...)
+    {
+        m_failedTasks.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (m_outstandingTasks.fetch_sub(1) == 1)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+        }
+        m_idle.notify_all();
+        m_wakeUp.notify_all();
+    }
+}
+
+void FBNetwork::TaskPool::runInOrder(const uint64_t t_key, task &t_task)
+{
+    try
+    {
+        t_task();
+    }
+    catch (...)
+    {
+        m_failedTasks.fetch_add(1, std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lock(m_strandsMutex);
+    std::deque<task>           &waitingTasks = m_strands[t_key];
+    if (waitingTasks.empty())
+    {
+        m_strands.erase(t_key);
+        return;
+    }
+    task nextTask = std::move(waitingTasks.front());
+    waitingTasks.pop_front();
+    schedule([this, t_key, nextTask = std::move(nextTask)]() mutable { runInOrder(t_key, nextTask); });
+}
+
+void FBNetwork::TaskPool::submit(task t_task)
+{
+    if (!t_task)
+    {
+        throw InvalidArgumentException("The task is empty.");
+    }
+    m_outstandingTasks.fetch_add(1);
+    schedule(std::move(t_task));
+}
+
+void FBNetwork::TaskPool::submit(const uint64_t t_key, task t_task)
+{
+    if (!t_task)
+    {
+        throw InvalidArgumentException("The task is empty.");
+    }
+    m_outstandingTasks.fetch_add(1);
+    {
+
+        // A key that has an entry has a task queued or running, the new task waits behind it
+
+        std::lock_guard<std::mutex> lock(m_strandsMutex);
+        auto                        strand = m_strands.find(t_key);
+        if (strand != m_strands.end())
+        {
+            strand->second.push_back(std::move(t_task));
+            return;
+        }
+        m_strands[t_key];
+    }
+    schedule([this, t_key, t_task = std::move(t_task)]() mutable { runInOrder(t_key, t_task); });
+}
+
+void FBNetwork::TaskPool::waitUntilIdle()
+{
+    std::unique_lock<std::mutex> lock(m_sleepMutex);
+    m_idle.wait(lock, [this] { return m_outstandingTasks.load() == 0; });
+}
+
+size_t FBNetwork::TaskPool::getThreadCount() const
+{
+    return m_workers.size();
+}
+
+uint64_t FBNetwork::TaskPool::getStolenTaskCount() const
+{
+    return m_stolenTasks.load(std::memory_order_relaxed);
+}
+
+uint64_t FBNetwork::TaskPool::getFailedTaskCount() const
+{
+    return m_failedTasks.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,196 @@
+#include "../include/timingWheel.hpp"
+
+FBNetwork::TimingWheel::TimingWheel(const std::chrono::nanoseconds t_resolution)
+{
+    if (t_resolution.count() <= 0)
+    {
+        throw InvalidArgumentException("The resolution of the timing wheel must be positive.");
+    }
+    m_start      = std::chrono::steady_clock::now();
+    m_resolution = t_resolution;
+    m_slots.assign(LEVEL_COUNT * SLOT_COUNT, -1);
+}
+
+uint64_t FBNetwork::TimingWheel::getTick(const std::chrono::steady_clock::time_point t_time, const bool t_roundUp) const
+{
+    if (t_time <= m_start)
+    {
+        return 0;
+    }
+    uint64_t elapsed    = static_cast<uint64_t>((t_time - m_start).count());
+    uint64_t resolution = static_cast<uint64_t>(m_resolution.count());
+    return t_roundUp ? (elapsed + resolution - 1) / resolution : elapsed / resolution;
+}
+
+void FBNetwork::TimingWheel::insert(const int t_key)
+{
+    Timer   &timer = m_timers[t_key];
+    unsigned level = 0;
+    while (level < LEVEL_COUNT - 1 && (timer.expiry >> (SLOT_BITS * (level + 1))) != (m_currentTick >> (SLOT_BITS * (level + 1))))
+    {
+        level++;
+    }
+    uint64_t block = timer.expiry >> (SLOT_BITS * level);
+    if (level == LEVEL_COUNT - 1 && block - (m_currentTick >> (SLOT_BITS * level)) >= SLOT_COUNT)
+    {
+
+        // Beyond the span of the wheel, park the timer in the top slot that is reached last and place it again when it cascades
+
+        block = (m_currentTick >> (SLOT_BITS * level)) + SLOT_COUNT - 1;
+    }
+    timer.slot = static_cast<int>(level * SLOT_COUNT + (block & (SLOT_COUNT - 1)));
+    timer.previous = -1;
+    timer.next     = m_slots[timer.slot];
+    if (timer.next != -1)
+    {
+        m_timers[timer.next].previous = t_key;
+    }
+    m_slots[timer.slot] = t_key;
+}
+
+void FBNetwork::TimingWheel::unlink(const int t_key)
+{
+    Timer &timer = m_timers[t_key];
+    if (timer.previous != -1)
+    {
+        m_timers[timer.previous].next = timer.next;
+    }
+    else
+    {
+        m_slots[timer.slot] = timer.next;
+    }
+    if (timer.next != -1)
+    {
+        m_timers[timer.next].previous = timer.previous;
+    }
+    timer.previous = -1;
+    timer.next     = -1;
+    timer.slot     = -1;
+}
+
+void FBNetwork::TimingWheel::cascade(const unsigned t_level)
+{
+    int slot = static_cast<int>(t_level * SLOT_COUNT + ((m_currentTick >> (SLOT_BITS * t_level)) & (SLOT_COUNT - 1)));
+    int key  = m_slots[slot];
+    m_slots[slot] = -1;
+    while (key != -1)
+    {
+        int next = m_timers[key].next;
+        insert(key);
+        key = next;
+    }
+}
+
+void FBNetwork::TimingWheel::schedule(const int t_key, const std::chrono::steady_clock::time_point t_deadline)
+{
+    if (t_key < 0)
+    {
+        throw InvalidArgumentException("The key of a timer cannot be negative.");
+    }
+    if (static_cast<size_t>(t_key) >= m_timers.size())
+    {
+        m_timers.resize(static_cast<size_t>(t_key) + 1);
+    }
+    if (m_timers[t_key].slot != -1)
+    {
+        unlink(t_key);
+    }
+    else
+    {
+        m_count++;
+    }
+
+    // The current tick was already handled, so a deadline in the past expires on the next tick
+
+    m_timers[t_key].expiry = std::max(getTick(t_deadline, true), m_currentTick + 1);
+    insert(t_key);
+}
+
+void FBNetwork::TimingWheel::cancel(const int t_key)
+{
+    if (!isScheduled(t_key))
+    {
+        return;
+    }
+    unlink(t_key);
+    m_count--;
+}
+
+bool FBNetwork::TimingWheel::isScheduled(const int t_key) const
+{
+    return t_key >= 0 && static_cast<size_t>(t_key) < m_timers.size() && m_timers[t_key].slot != -1;
+}
+
+size_t FBNetwork::TimingWheel::getCount() const
+{
+    return m_count;
+}
+
+size_t FBNetwork::TimingWheel::advance(const std::chrono::steady_clock::time_point t_now, std::vector<int> &t_expiredKeys)
+{
+    uint64_t targetTick   = getTick(t_now, false);
+    size_t   expiredCount = 0;
+    while (m_currentTick < targetTick)
+    {
+        if (m_count == 0)
+        {
+            m_currentTick = targetTick;
+            break;
+        }
+        m_currentTick++;
+        for (unsigned level = LEVEL_COUNT - 1; level > 0; level--)
+        {
+            if ((m_currentTick & ((uint64_t{1} << (SLOT_BITS * level)) - 1)) == 0)
+            {
+                cascade(level);
+            }
+        }
+        int slot = static_cast<int>(m_currentTick & (SLOT_COUNT - 1));
+        int key  = m_slots[slot];
+        m_slots[slot] = -1;
+        while (key != -1)
+        {
+            Timer &timer   = m_timers[key];
+            int    next    = timer.next;
+            timer.previous = -1;
+            timer.next     = -1;
+            timer.slot     = -1;
+            t_expiredKeys.push_back(key);
+            m_count--;
+            expiredCount++;
+            key = next;
+        }
+    }
+    return expiredCount;
+}
+
+int FBNetwork::TimingWheel::getMillisecondsUntilNextExpiry(const std::chrono::steady_clock::time_point t_now) const
+{
+    if (m_count == 0)
+    {
+        return -1;
+    }
+
+    // Slots of lower levels always expire before the slots of higher levels, so the first slot with timers gives the bound
+
+    for (unsigned level = 0; level < LEVEL_COUNT; level++)
+    {
+        unsigned shift = SLOT_BITS * level;
+        for (uint64_t i = 1; i < SLOT_COUNT; i++)
+        {
+            uint64_t block = (m_currentTick >> shift) + i;
+            if (m_slots[level * SLOT_COUNT + (block & (SLOT_COUNT - 1))] == -1)
+            {
+                continue;
+            }
+            std::chrono::steady_clock::time_point expiry = m_start + m_resolution * static_cast<int64_t>(block << shift);
+            if (expiry <= t_now)
+            {
+                return 0;
+            }
+            return static_cast<int>(std::min<int64_t>(std::chrono::ceil<std::chrono::milliseconds>(expiry - t_now).count(),
+                                                      std::numeric_limits<int>::max()));
+        }
+    }
+    return -1;
+}
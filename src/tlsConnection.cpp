@@ -0,0 +1,227 @@
+#include "../include/tlsConnection.hpp"
+
+ssize_t FBNetwork::TlsConnection::handleError(const int t_result)
+{
+    int error = SSL_get_error(m_ssl, t_result);
+    switch (error)
+    {
+        case SSL_ERROR_WANT_READ:
+            m_pollEvents = POLLIN;
+            errno        = EAGAIN;
+            return -1;
+        case SSL_ERROR_WANT_WRITE:
+            m_pollEvents = POLLOUT;
+            errno        = EAGAIN;
+            return -1;
+        case SSL_ERROR_ZERO_RETURN:
+            return 0;
+        case SSL_ERROR_SYSCALL:
+            ERR_clear_error();
+            if (errno == 0)
+            {
+
+                // The peer closed the socket without a close notify alert
+
+                return 0;
+            }
+            return -1;
+        default:
+            m_lastError = TlsContext::getCurrentError();
+            errno       = EPROTO;
+            return -1;
+    }
+}
+
+FBNetwork::TlsConnection::TlsConnection(std::shared_ptr<TlsContext> t_context, const fileDescriptor t_fileDescriptor,
+                                        const std::string &t_serverName, const std::string &t_sessionKey)
+{
+    if (t_context == nullptr)
+    {
+        throw InvalidArgumentException("The TLS context cannot be nullptr.");
+    }
+    m_context    = t_context;
+    m_sessionKey = t_sessionKey;
+    m_ssl        = SSL_new(t_context->getNativeHandle());
+    if (m_ssl == nullptr || SSL_set_fd(m_ssl, t_fileDescriptor) != 1)
+    {
+        SSL_free(m_ssl);
+        throw SystemRuntimeException("Creating the TLS connection failed. Error: " + TlsContext::getCurrentError());
+    }
+    if (t_context->getRole() == TlsRole::SERVER)
+    {
+        SSL_set_accept_state(m_ssl);
+        return;
+    }
+    SSL_set_connect_state(m_ssl);
+    if (!t_serverName.empty())
+    {
+        SSL_set_tlsext_host_name(m_ssl, t_serverName.c_str());
+        SSL_set1_host(m_ssl, t_serverName.c_str());
+    }
+
+    // The new session callback of the context finds the key through the application data
+
+    SSL_set_app_data(m_ssl, &m_sessionKey);
+    if (!m_sessionKey.empty())
+    {
+        t_context->resumeSession(m_ssl, m_sessionKey);
+    }
+}
+
+FBNetwork::TlsConnection::~TlsConnection()
+{
+    SSL_free(m_ssl);
+}
+
+int FBNetwork::TlsConnection::handshake()
+{
+    if (m_isHandshakeDone)
+    {
+        return 1;
+    }
+    ERR_clear_error();
+    errno      = 0;
+    int result = SSL_do_handshake(m_ssl);
+    if (result == 1)
+    {
+        m_isHandshakeDone = true;
+        m_pollEvents      = 0;
+        return 1;
+    }
+    if (handleError(result) == 0)
+    {
+        m_lastError = "Connection closed during the handshake.";
+        errno       = ECONNRESET;
+    }
+    else if (errno == EPROTO && !m_sessionKey.empty())
+    {
+        m_context->removeSession(m_sessionKey);
+    }
+    return -1;
+}
+
+ssize_t FBNetwork::TlsConnection::read(void *t_buffer, const size_t t_size)
+{
+    ERR_clear_error();
+    errno            = 0;
+    size_t bytesRead = 0;
+    int    result    = SSL_read_ex(m_ssl, t_buffer, t_size, &bytesRead);
+    if (result == 1)
+    {
+        m_isHandshakeDone = true;
+        m_pollEvents      = 0;
+        return static_cast<ssize_t>(bytesRead);
+    }
+    return handleError(result);
+}
+
+ssize_t FBNetwork::TlsConnection::write(const void *t_buffer, const size_t t_size)
+{
+    ERR_clear_error();
+    errno               = 0;
+    size_t bytesWritten = 0;
+    int    result       = SSL_write_ex(m_ssl, t_buffer, t_size, &bytesWritten);
+    if (result == 1)
+    {
+        m_isHandshakeDone = true;
+        m_pollEvents      = 0;
+        return static_cast<ssize_t>(bytesWritten);
+    }
+    if (handleError(result) == 0)
+    {
+        errno = EPIPE;
+    }
+    return -1;
+}
+
+ssize_t FBNetwork::TlsConnection::sendFile(const fileDescriptor t_fileDescriptor, const off_t t_offset, const size_t t_size)
+{
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L && !defined(OPENSSL_NO_KTLS)
+    if (usesKernelTlsSend())
+    {
+        ERR_clear_error();
+        errno               = 0;
+        ossl_ssize_t result = SSL_sendfile(m_ssl, t_fileDescriptor, t_offset, std::min(t_size, Constants::SENDFILE_CHUNK_SIZE), 0);
+        if (result >= 0)
+        {
+            m_pollEvents = 0;
+            return static_cast<ssize_t>(result);
+        }
+
+        // SSL_sendfile leaves errno of the sendfile call, EAGAIN only means that the socket buffer is full
+
+        int error = errno;
+        if (error == EAGAIN || error == EWOULDBLOCK || error == EINTR)
+        {
+            m_pollEvents = POLLOUT;
+        }
+        else
+        {
+            m_lastError = TlsContext::getCurrentError();
+        }
+        ERR_clear_error();
+        errno = error == 0 ? EIO : error;
+        return -1;
+    }
+#endif
+    errno = ENOTSUP;
+    return -1;
+}
+
+void FBNetwork::TlsConnection::shutdown()
+{
+    if (m_isHandshakeDone)
+    {
+        ERR_clear_error();
+        SSL_shutdown(m_ssl);
+        ERR_clear_error();
+    }
+}
+
+bool FBNetwork::TlsConnection::isHandshakeDone() const
+{
+    return m_isHandshakeDone;
+}
+
+bool FBNetwork::TlsConnection::isSessionReused() const
+{
+    return SSL_session_reused(m_ssl) == 1;
+}
+
+bool FBNetwork::TlsConnection::usesKernelTlsSend() const
+{
+#ifdef SSL_OP_ENABLE_KTLS
+    return BIO_get_ktls_send(SSL_get_wbio(m_ssl)) == 1;
+#else
+    return false;
+#endif
+}
+
+bool FBNetwork::TlsConnection::usesKernelTlsReceive() const
+{
+#ifdef SSL_OP_ENABLE_KTLS
+    return BIO_get_ktls_recv(SSL_get_rbio(m_ssl)) == 1;
+#else
+    return false;
+#endif
+}
+
+size_t FBNetwork::TlsConnection::getPendingBytes() const
+{
+    return static_cast<size_t>(SSL_pending(m_ssl));
+}
+
+short FBNetwork::TlsConnection::getPollEvents(const short t_events) const
+{
+    return m_pollEvents != 0 ? m_pollEvents : t_events;
+}
+
+std::string FBNetwork::TlsConnection::getProtocolVersion() const
+{
+    return SSL_get_version(m_ssl);
+}
+
+std::string FBNetwork::TlsConnection::getLastError() const
+{
+    return m_lastError;
+}
@@ -0,0 +1,200 @@
+#include "../include/tlsContext.hpp"
+
+int FBNetwork::TlsContext::storeSession(SSL *t_ssl, SSL_SESSION *t_session)
+{
+    TlsContext        *context    = static_cast<TlsContext *>(SSL_CTX_get_app_data(SSL_get_SSL_CTX(t_ssl)));
+    const std::string *sessionKey = static_cast<const std::string *>(SSL_get_app_data(t_ssl));
+    if (context == nullptr || sessionKey == nullptr || sessionKey->empty() || !context->m_resumesSessions.load())
+    {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(context->m_sessionsMutex);
+    SSL_SESSION               *&storedSession = context->m_sessions[*sessionKey];
+    if (storedSession != nullptr)
+    {
+        SSL_SESSION_free(storedSession);
+    }
+    storedSession = t_session;
+    return 1;
+}
+
+std::string FBNetwork::TlsContext::getCurrentError()
+{
+    std::string   errors;
+    unsigned long error = 0;
+    char          errorBuffer[256];
+    while ((error = ERR_get_error()) != 0)
+    {
+        ERR_error_string_n(error, errorBuffer, sizeof(errorBuffer));
+        if (!errors.empty())
+        {
+            errors += "; ";
+        }
+        errors += errorBuffer;
+    }
+    return errors.empty() ? "Unknown error." : errors;
+}
+
+FBNetwork::TlsContext::TlsContext(const TlsRole t_role)
+{
+    m_role    = t_role;
+    m_context = SSL_CTX_new(t_role == TlsRole::SERVER ? TLS_server_method() : TLS_client_method());
+    if (m_context == nullptr)
+    {
+        throw SystemRuntimeException("Creating the TLS context failed. Error: " + getCurrentError());
+    }
+    SSL_CTX_set_app_data(m_context, this);
+    SSL_CTX_set_min_proto_version(m_context, TLS1_2_VERSION);
+#ifdef SSL_OP_IGNORE_UNEXPECTED_EOF
+
+    // Many peers close the socket without a close notify alert, treat it like the end of the stream as before OpenSSL 3.0
+
+    SSL_CTX_set_options(m_context, SSL_OP_IGNORE_UNEXPECTED_EOF);
+#endif
+    if (t_role == TlsRole::SERVER)
+    {
+
+        // Server sockets are non-blocking, so writes may stop halfway like send does
+
+        SSL_CTX_set_mode(m_context, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+        SSL_CTX_set_session_cache_mode(m_context, SSL_SESS_CACHE_SERVER);
+        SSL_CTX_set_session_id_context(m_context, reinterpret_cast<const unsigned char *>("FBNetwork"), 9);
+
+        // One ticket per handshake is enough, a client only keeps the last session
+
+        SSL_CTX_set_num_tickets(m_context, 1);
+    }
+    else
+    {
+
+        // Without auto retry a read that only consumed a session ticket returns, so the read timeout of the client still holds
+
+        SSL_CTX_clear_mode(m_context, SSL_MODE_AUTO_RETRY);
+        SSL_CTX_set_session_cache_mode(m_context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(m_context, storeSession);
+        SSL_CTX_set_verify(m_context, SSL_VERIFY_PEER, nullptr);
+        SSL_CTX_set_default_verify_paths(m_context);
+    }
+}
+
+FBNetwork::TlsContext::~TlsContext()
+{
+    for (auto &session : m_sessions)
+    {
+        SSL_SESSION_free(session.second);
+    }
+    SSL_CTX_free(m_context);
+}
+
+void FBNetwork::TlsContext::loadCertificate(const std::string &t_certificateChainPath, const std::string &t_privateKeyPath)
+{
+    if (SSL_CTX_use_certificate_chain_file(m_context, t_certificateChainPath.c_str()) != 1)
+    {
+        throw InvalidArgumentException("Loading the certificate failed. Error: " + getCurrentError());
+    }
+    if (SSL_CTX_use_PrivateKey_file(m_context, t_privateKeyPath.c_str(), SSL_FILETYPE_PEM) != 1)
+    {
+        throw InvalidArgumentException("Loading the private key failed. Error: " + getCurrentError());
+    }
+    if (SSL_CTX_check_private_key(m_context) != 1)
+    {
+        throw InvalidArgumentException("The private key does not match the certificate. Error: " + getCurrentError());
+    }
+}
+
+void FBNetwork::TlsContext::loadTrustedCertificates(const std::string &t_certificateAuthorityPath)
+{
+    if (SSL_CTX_load_verify_locations(m_context, t_certificateAuthorityPath.c_str(), nullptr) != 1)
+    {
+        throw InvalidArgumentException("Loading the trusted certificates failed. Error: " + getCurrentError());
+    }
+}
+
+void FBNetwork::TlsContext::setVerifyPeer(const bool t_verifyPeer)
+{
+    int mode = SSL_VERIFY_NONE;
+    if (t_verifyPeer)
+    {
+        mode = m_role == TlsRole::SERVER ? SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT : SSL_VERIFY_PEER;
+    }
+    SSL_CTX_set_verify(m_context, mode, nullptr);
+}
+
+void FBNetwork::TlsContext::setSessionResumption(const bool t_resumeSessions)
+{
+    m_resumesSessions.store(t_resumeSessions);
+    if (m_role == TlsRole::CLIENT)
+    {
+        return;
+    }
+    if (t_resumeSessions)
+    {
+        SSL_CTX_clear_options(m_context, SSL_OP_NO_TICKET);
+        SSL_CTX_set_session_cache_mode(m_context, SSL_SESS_CACHE_SERVER);
+    }
+    else
+    {
+        SSL_CTX_set_options(m_context, SSL_OP_NO_TICKET);
+        SSL_CTX_set_session_cache_mode(m_context, SSL_SESS_CACHE_OFF);
+    }
+}
+
+void FBNetwork::TlsContext::setKernelTls(const bool t_useKernelTls)
+{
+#ifdef SSL_OP_ENABLE_KTLS
+    if (t_useKernelTls)
+    {
+        SSL_CTX_set_options(m_context, SSL_OP_ENABLE_KTLS);
+    }
+    else
+    {
+        SSL_CTX_clear_options(m_context, SSL_OP_ENABLE_KTLS);
+    }
+    m_usesKernelTls = t_useKernelTls;
+#else
+
+    // OpenSSL older than 3.0 has no kernel TLS, the record layer stays in user space
+
+    m_usesKernelTls = false;
+#endif
+}
+
+FBNetwork::TlsRole FBNetwork::TlsContext::getRole() const
+{
+    return m_role;
+}
+
+bool FBNetwork::TlsContext::usesKernelTls() const
+{
+    return m_usesKernelTls;
+}
+
+SSL_CTX *FBNetwork::TlsContext::getNativeHandle() const
+{
+    return m_context;
+}
+
+void FBNetwork::TlsContext::resumeSession(SSL *t_ssl, const std::string &t_sessionKey)
+{
+    if (!m_resumesSessions.load())
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    auto                        session = m_sessions.find(t_sessionKey);
+    if (session != m_sessions.end())
+    {
+        SSL_set_session(t_ssl, session->second);
+    }
+}
+
+void FBNetwork::TlsContext::removeSession(const std::string &t_sessionKey)
+{
+    std::lock_guard<std::mutex> lock(m_sessionsMutex);
+    auto                        session = m_sessions.find(t_sessionKey);
+    if (session != m_sessions.end())
+    {
+        SSL_SESSION_free(session->second);
+        m_sessions.erase(session);
+    }
+}
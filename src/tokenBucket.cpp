@@ -0,0 +1,61 @@
+#include "../include/tokenBucket.hpp"
+
+FBNetwork::TokenBucket::TokenBucket(const double t_rate, const double t_burst, const std::chrono::steady_clock::time_point t_now)
+    : m_rate(t_rate), m_burst(t_burst), m_tokens(t_burst), m_updated(t_now)
+{
+    if (!(t_rate > 0) || !(t_burst > 0))
+    {
+        throw InvalidArgumentException("The rate and the burst of a token bucket must be greater than 0.");
+    }
+}
+
+void FBNetwork::TokenBucket::refill(const std::chrono::steady_clock::time_point t_now)
+{
+    if (m_rate == 0 || t_now <= m_updated)
+    {
+        return;
+    }
+    double elapsed = std::chrono::duration<double>(t_now - m_updated).count();
+    m_tokens       = std::min(m_burst, m_tokens + elapsed * m_rate);
+    m_updated      = t_now;
+}
+
+void FBNetwork::TokenBucket::consume(const double t_tokens)
+{
+    if (m_rate > 0)
+    {
+        m_tokens -= t_tokens;
+    }
+}
+
+bool FBNetwork::TokenBucket::tryConsume(const double t_tokens, const std::chrono::steady_clock::time_point t_now)
+{
+    refill(t_now);
+    if (m_rate > 0 && m_tokens < t_tokens)
+    {
+        return false;
+    }
+    consume(t_tokens);
+    return true;
+}
+
+std::chrono::steady_clock::time_point FBNetwork::TokenBucket::getTimeOf(const double t_tokens,
+                                                                        const std::chrono::steady_clock::time_point t_now) const
+{
+    if (m_rate == 0 || m_tokens >= t_tokens)
+    {
+        return t_now;
+    }
+    std::chrono::duration<double> wait((t_tokens - m_tokens) / m_rate);
+    return t_now + std::chrono::ceil<std::chrono::steady_clock::duration>(wait);
+}
+
+double FBNetwork::TokenBucket::getTokens() const
+{
+    return m_tokens;
+}
+
+bool FBNetwork::TokenBucket::isFull() const
+{
+    return m_rate == 0 || m_tokens >= m_burst;
+}
@@ -0,0 +1,249 @@
+#include "../include/udpServer.hpp"
+
+FBNetwork::UdpServer::UdpServer(const domain t_domain, const port t_port, const size_t t_batchSize, const size_t t_datagramSize)
+{
+    if (t_domain != Domain::IPV4_DOMAIN && t_domain != Domain::IPV6_DOMAIN)
+    {
+        throw InvalidDomainException("Please use either IPv4 or IPv6.");
+    }
+    m_batch  = std::make_unique<DatagramBatch>(t_batchSize, t_datagramSize);
+    m_domain = t_domain;
+    m_port   = t_port;
+}
+
+FBNetwork::UdpServer::UdpServer(const std::string &t_socketPath, const size_t t_batchSize, const size_t t_datagramSize)
+{
+    if (t_socketPath.empty() || t_socketPath.length() >= sizeof(sockaddr_un::sun_path))
+    {
+        throw InvalidArgumentException("Invalid socket path.");
+    }
+    m_batch                 = std::make_unique<DatagramBatch>(t_batchSize, t_datagramSize);
+    m_domain                = Domain::LOCAL_DOMAIN;
+    m_localServerSocketPath = t_socketPath;
+}
+
+FBNetwork::UdpServer::~UdpServer()
+{
+    stopServer();
+}
+
+void FBNetwork::UdpServer::startServer()
+{
+    sockaddr_storage serverAddress     = {};
+    socklen_t        serverAddressSize = 0;
+    int              opt               = 1;
+    m_serverFileDescriptor             = socket(m_domain, SOCK_DGRAM, 0);
+    if (m_serverFileDescriptor == -1)
+    {
+        throw ServerCreationException("Creating the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    if (fcntl(m_serverFileDescriptor, F_SETFL, fcntl(m_serverFileDescriptor, F_GETFL, 0) | O_NONBLOCK) == -1 ||
+        fcntl(m_serverFileDescriptor, F_SETFD, FD_CLOEXEC) == -1)
+    {
+        close(m_serverFileDescriptor);
+        throw ServerCreationException("Setting the socket flags failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    if (m_domain == Domain::IPV4_DOMAIN)
+    {
+        sockaddr_in *serverAddressIpv4     = reinterpret_cast<sockaddr_in *>(&serverAddress);
+        serverAddressIpv4->sin_family      = Domain::IPV4_DOMAIN;
+        serverAddressIpv4->sin_addr.s_addr = INADDR_ANY;
+        serverAddressIpv4->sin_port        = htons(m_port);
+        serverAddressSize                  = sizeof(sockaddr_in);
+    }
+    else if (m_domain == Domain::IPV6_DOMAIN)
+    {
+        sockaddr_in6 *serverAddressIpv6 = reinterpret_cast<sockaddr_in6 *>(&serverAddress);
+        serverAddressIpv6->sin6_family  = Domain::IPV6_DOMAIN;
+        serverAddressIpv6->sin6_addr    = in6addr_any;
+        serverAddressIpv6->sin6_port    = htons(m_port);
+        serverAddressSize               = sizeof(sockaddr_in6);
+    }
+    else
+    {
+        sockaddr_un *serverAddressLocal = reinterpret_cast<sockaddr_un *>(&serverAddress);
+        serverAddressLocal->sun_family  = Domain::LOCAL_DOMAIN;
+        strncpy(serverAddressLocal->sun_path, m_localServerSocketPath.c_str(), sizeof(serverAddressLocal->sun_path) - 1);
+        serverAddressSize = sizeof(sockaddr_un);
+        if (unlink(m_localServerSocketPath.c_str()) == -1 && errno != ENOENT)
+        {
+            close(m_serverFileDescriptor);
+            throw ServerCreationException("Removing the existing socket file failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+    }
+    if (m_domain != Domain::LOCAL_DOMAIN && setsockopt(m_serverFileDescriptor, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) == -1)
+    {
+        close(m_serverFileDescriptor);
+        throw ServerCreationException("Setting socket options failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    if (bind(m_serverFileDescriptor, reinterpret_cast<sockaddr *>(&serverAddress), serverAddressSize) == -1)
+    {
+        close(m_serverFileDescriptor);
+        throw ServerCreationException("Binding the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+
+    // With port 0 the kernel chooses a free port, so read it back
+
+    if (m_domain != Domain::LOCAL_DOMAIN && getsockname(m_serverFileDescriptor, reinterpret_cast<sockaddr *>(&serverAddress),
+                                                        &serverAddressSize) == 0)
+    {
+        m_port = ntohs(m_domain == Domain::IPV4_DOMAIN ? reinterpret_cast<sockaddr_in *>(&serverAddress)->sin_port
+                                                       : reinterpret_cast<sockaddr_in6 *>(&serverAddress)->sin6_port);
+    }
+    try
+    {
+        m_eventQueue = std::make_shared<EventQueue>();
+        m_eventQueue->setServer(m_serverFileDescriptor);
+    }
+    catch (ServerRuntimeException &e)
+    {
+        close(m_serverFileDescriptor);
+        throw ServerCreationException(e.what());
+    }
+    m_isServerOnline = true;
+}
+
+void FBNetwork::UdpServer::stopServer()
+{
+    if (!m_isServerOnline)
+    {
+        return;
+    }
+    m_eventQueue     = nullptr;
+    m_isServerOnline = false;
+    close(m_serverFileDescriptor);
+    m_serverFileDescriptor = -1;
+    if (!m_localServerSocketPath.empty())
+    {
+        unlink(m_localServerSocketPath.c_str());
+    }
+}
+
+std::vector<FBNetwork::eventTuple> FBNetwork::UdpServer::getPendingEvents()
+{
+    FBNetwork::eventList               pendingEvents = m_eventQueue->pollEvents();
+    std::vector<FBNetwork::eventTuple> returnEvents;
+    for (event e : pendingEvents)
+    {
+        if (m_eventQueue->hasAnError(&e))
+        {
+            returnEvents.push_back(std::make_tuple(EventType::ERROR, -1));
+        }
+        else
+        {
+            returnEvents.push_back(std::make_tuple(EventType::CLIENT_WANTS_TO_SEND_DATA, -1));
+        }
+    }
+    return returnEvents;
+}
+
+bool FBNetwork::UdpServer::isDataAvailable(const timeval *t_timeout)
+{
+    fd_set readFds;
+    FD_ZERO(&readFds);
+    FD_SET(m_serverFileDescriptor, &readFds);
+    timeval timeout = *t_timeout;
+    int     result  = select(m_serverFileDescriptor + 1, &readFds, nullptr, nullptr, &timeout);
+    if (result == -1)
+    {
+        throw ServerRuntimeException("Selecting the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    return result > 0 && FD_ISSET(m_serverFileDescriptor, &readFds);
+}
+
+size_t FBNetwork::UdpServer::receiveDatagrams()
+{
+    while (true)
+    {
+        int count = m_batch->receive(m_serverFileDescriptor, MSG_DONTWAIT);
+        if (count == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                return 0;
+            }
+            throw ServerRuntimeException("Receiving the datagrams failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+        return static_cast<size_t>(count);
+    }
+}
+
+const FBNetwork::Datagram &FBNetwork::UdpServer::getDatagram(const size_t t_index) const
+{
+    return m_batch->getDatagram(t_index);
+}
+
+bool FBNetwork::UdpServer::queueDatagram(const std::string_view t_data, const sockaddr *t_address, const socklen_t t_addressLength)
+{
+    if (t_address == nullptr)
+    {
+        throw InvalidArgumentException("Invalid destination address.");
+    }
+    return m_batch->queue(t_data, t_address, t_addressLength);
+}
+
+bool FBNetwork::UdpServer::queueReply(const size_t t_index, const std::string_view t_data)
+{
+    const Datagram &datagram = m_batch->getDatagram(t_index);
+    return queueDatagram(t_data, datagram.address, datagram.addressLength);
+}
+
+size_t FBNetwork::UdpServer::sendQueuedDatagrams()
+{
+    int result = m_batch->send(m_serverFileDescriptor);
+    if (result == -1)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            return 0;
+        }
+        m_batch->clearQueue();
+        throw ServerRuntimeException("Sending the datagrams failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    return static_cast<size_t>(result);
+}
+
+void FBNetwork::UdpServer::setGenericReceiveOffload(const bool t_enable)
+{
+#ifdef UDP_GRO
+    int enable = t_enable ? 1 : 0;
+    if (setsockopt(m_serverFileDescriptor, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) == -1)
+    {
+        throw ServerRuntimeException("Setting generic receive offload failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+#else
+    throw ServerRuntimeException("Generic receive offload is not supported on this platform.");
+#endif
+}
+
+void FBNetwork::UdpServer::setSegmentSize(const uint16_t t_segmentSize)
+{
+#ifdef UDP_SEGMENT
+    int segmentSize = t_segmentSize;
+    if (setsockopt(m_serverFileDescriptor, SOL_UDP, UDP_SEGMENT, &segmentSize, sizeof(segmentSize)) == -1)
+    {
+        throw ServerRuntimeException("Setting the segment size failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+#else
+    throw ServerRuntimeException("Generic segmentation offload is not supported on this platform.");
+#endif
+}
+
+FBNetwork::fileDescriptor FBNetwork::UdpServer::getServerFileDescriptor() const
+{
+    return m_serverFileDescriptor;
+}
+
+FBNetwork::port FBNetwork::UdpServer::getPort() const
+{
+    return m_port;
+}
+
+bool FBNetwork::UdpServer::isServerOnline() const
+{
+    return m_isServerOnline;
+}
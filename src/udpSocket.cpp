@@ -0,0 +1,229 @@
+#include "../include/udpSocket.hpp"
+
+void FBNetwork::UdpSocket::createSocket(const domain t_domain, const size_t t_batchSize, const size_t t_datagramSize)
+{
+    m_batch          = std::make_unique<DatagramBatch>(t_batchSize, t_datagramSize);
+    m_domain         = t_domain;
+    m_fileDescriptor = socket(t_domain, SOCK_DGRAM, 0);
+    if (m_fileDescriptor == -1)
+    {
+        throw ClientCreationException("Creating the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    fcntl(m_fileDescriptor, F_SETFD, FD_CLOEXEC);
+}
+
+FBNetwork::UdpSocket::UdpSocket(const domain t_domain, const size_t t_batchSize, const size_t t_datagramSize)
+{
+    if (t_domain != Domain::IPV4_DOMAIN && t_domain != Domain::IPV6_DOMAIN)
+    {
+        throw InvalidDomainException("Please use either IPv4 or IPv6.");
+    }
+    createSocket(t_domain, t_batchSize, t_datagramSize);
+}
+
+FBNetwork::UdpSocket::UdpSocket(const std::string &t_socketPath, const size_t t_batchSize, const size_t t_datagramSize)
+{
+    sockaddr_un localAddress = {};
+    if (t_socketPath.empty() || t_socketPath.length() >= sizeof(localAddress.sun_path))
+    {
+        throw InvalidArgumentException("Invalid socket path.");
+    }
+    createSocket(Domain::LOCAL_DOMAIN, t_batchSize, t_datagramSize);
+    localAddress.sun_family = Domain::LOCAL_DOMAIN;
+    strncpy(localAddress.sun_path, t_socketPath.c_str(), sizeof(localAddress.sun_path) - 1);
+    if (unlink(t_socketPath.c_str()) == -1 && errno != ENOENT)
+    {
+        close(m_fileDescriptor);
+        throw ClientCreationException("Removing the existing socket file failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    if (bind(m_fileDescriptor, reinterpret_cast<sockaddr *>(&localAddress), sizeof(sockaddr_un)) == -1)
+    {
+        close(m_fileDescriptor);
+        throw ClientCreationException("Binding the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+    m_localSocketPath = t_socketPath;
+}
+
+FBNetwork::UdpSocket::~UdpSocket()
+{
+    if (m_fileDescriptor != -1)
+    {
+        close(m_fileDescriptor);
+    }
+    if (!m_localSocketPath.empty())
+    {
+        unlink(m_localSocketPath.c_str());
+    }
+}
+
+void FBNetwork::UdpSocket::connectToServer(const std::string &t_ipAddress, const port t_port)
+{
+    m_serverAddress = {};
+    if (m_domain == Domain::IPV4_DOMAIN)
+    {
+        sockaddr_in *serverAddressIpv4 = reinterpret_cast<sockaddr_in *>(&m_serverAddress);
+        serverAddressIpv4->sin_family  = Domain::IPV4_DOMAIN;
+        serverAddressIpv4->sin_port    = htons(t_port);
+        if (inet_pton(Domain::IPV4_DOMAIN, t_ipAddress.c_str(), &serverAddressIpv4->sin_addr) != 1)
+        {
+            throw ClientCreationException("Invalid IP address.");
+        }
+        m_serverAddressSize = sizeof(sockaddr_in);
+    }
+    else if (m_domain == Domain::IPV6_DOMAIN)
+    {
+        sockaddr_in6 *serverAddressIpv6 = reinterpret_cast<sockaddr_in6 *>(&m_serverAddress);
+        serverAddressIpv6->sin6_family  = Domain::IPV6_DOMAIN;
+        serverAddressIpv6->sin6_port    = htons(t_port);
+        if (inet_pton(Domain::IPV6_DOMAIN, t_ipAddress.c_str(), &serverAddressIpv6->sin6_addr) != 1)
+        {
+            throw ClientCreationException("Invalid IP address.");
+        }
+        m_serverAddressSize = sizeof(sockaddr_in6);
+    }
+    else
+    {
+        throw ClientCreationException("A Unix domain socket has to be connected to a socket path.");
+    }
+    if (connect(m_fileDescriptor, reinterpret_cast<sockaddr *>(&m_serverAddress), m_serverAddressSize) == -1)
+    {
+        throw ClientCreationException("Connecting the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+}
+
+void FBNetwork::UdpSocket::connectToServer(const std::string &t_socketPath)
+{
+    sockaddr_un *serverAddressLocal = reinterpret_cast<sockaddr_un *>(&m_serverAddress);
+    if (m_domain != Domain::LOCAL_DOMAIN)
+    {
+        throw ClientCreationException("An IP domain socket has to be connected to an IP address.");
+    }
+    if (t_socketPath.empty() || t_socketPath.length() >= sizeof(serverAddressLocal->sun_path))
+    {
+        throw InvalidArgumentException("Invalid socket path.");
+    }
+    m_serverAddress                = {};
+    serverAddressLocal->sun_family = Domain::LOCAL_DOMAIN;
+    strncpy(serverAddressLocal->sun_path, t_socketPath.c_str(), sizeof(serverAddressLocal->sun_path) - 1);
+    m_serverAddressSize = sizeof(sockaddr_un);
+    if (connect(m_fileDescriptor, reinterpret_cast<sockaddr *>(&m_serverAddress), m_serverAddressSize) == -1)
+    {
+        throw ClientCreationException("Connecting the socket failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+}
+
+bool FBNetwork::UdpSocket::queueDatagram(const std::string_view t_data)
+{
+
+    // The socket is connected, so the datagrams do not need a destination address
+
+    return m_batch->queue(t_data, nullptr, 0);
+}
+
+size_t FBNetwork::UdpSocket::sendQueuedDatagrams()
+{
+    size_t sent = 0;
+    while (m_batch->getPendingCount() > 0)
+    {
+        int result = m_batch->send(m_fileDescriptor);
+        if (result == -1)
+        {
+            m_batch->clearQueue();
+            throw ClientRuntimeException("Sending the datagrams failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+        sent += static_cast<size_t>(result);
+    }
+    return sent;
+}
+
+void FBNetwork::UdpSocket::sendData(const std::string_view t_data)
+{
+    if (!queueDatagram(t_data))
+    {
+        sendQueuedDatagrams();
+        queueDatagram(t_data);
+    }
+    sendQueuedDatagrams();
+}
+
+size_t FBNetwork::UdpSocket::receiveDatagrams()
+{
+    while (true)
+    {
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(m_fileDescriptor, &readfds);
+        timeval timeout  = m_timeout;
+        int     activity = select(m_fileDescriptor + 1, &readfds, nullptr, nullptr, &timeout);
+        if (activity == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            throw ClientRuntimeException("Error during select: " + ExtendedSystem::getCurrentErrnoError());
+        }
+        else if (activity == 0)
+        {
+
+            // Timeout reached
+
+            throw ClientTimeoutException("Timeout reached while receiving datagrams.");
+        }
+        int count = m_batch->receive(m_fileDescriptor, MSG_DONTWAIT);
+        if (count == -1)
+        {
+            if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                continue;
+            }
+            throw ClientRuntimeException("Receiving the datagrams failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+        }
+        return static_cast<size_t>(count);
+    }
+}
+
+const FBNetwork::Datagram &FBNetwork::UdpSocket::getDatagram(const size_t t_index) const
+{
+    return m_batch->getDatagram(t_index);
+}
+
+void FBNetwork::UdpSocket::setGenericReceiveOffload(const bool t_enable)
+{
+#ifdef UDP_GRO
+    int enable = t_enable ? 1 : 0;
+    if (setsockopt(m_fileDescriptor, SOL_UDP, UDP_GRO, &enable, sizeof(enable)) == -1)
+    {
+        throw ClientRuntimeException("Setting generic receive offload failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+#else
+    throw ClientRuntimeException("Generic receive offload is not supported on this platform.");
+#endif
+}
+
+void FBNetwork::UdpSocket::setSegmentSize(const uint16_t t_segmentSize)
+{
+#ifdef UDP_SEGMENT
+    int segmentSize = t_segmentSize;
+    if (setsockopt(m_fileDescriptor, SOL_UDP, UDP_SEGMENT, &segmentSize, sizeof(segmentSize)) == -1)
+    {
+        throw ClientRuntimeException("Setting the segment size failed. Error: " + ExtendedSystem::getCurrentErrnoError());
+    }
+#else
+    throw ClientRuntimeException("Generic segmentation offload is not supported on this platform.");
+#endif
+}
+
+void FBNetwork::UdpSocket::setTimeout(const timeval t_timeout)
+{
+    if (t_timeout.tv_sec < 0 || t_timeout.tv_usec < 0 || t_timeout.tv_usec > 999999)
+    {
+        throw InvalidArgumentException("Invalid timeout.");
+    }
+    m_timeout = t_timeout;
+}
+
+FBNetwork::fileDescriptor FBNetwork::UdpSocket::getFileDescriptor() const
+{
+    return m_fileDescriptor;
+}
@@ -0,0 +1,190 @@
+#include "../include/compression.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+using FBNetwork::CompressionCodec;
+using FBNetwork::CompressionOptions;
+using FBNetwork::Compressor;
+
+static const size_t HEADER_SIZE = FBNetwork::Constants::COMPRESSION_FRAME_HEADER_SIZE;
+
+/**
+ * @brief Creates a message that every codec compresses well.
+ * @param t_size The size of the message.
+ * @return The message.
+ * @version 1.0.0
+ */
+static std::string getCompressibleMessage(const size_t t_size)
+{
+    std::string message;
+    while (message.size() < t_size)
+    {
+        message += "{\"id\":" + std::to_string(message.size() % 97) + ",\"status\":\"ok\",\"items\":[1,2,3]}";
+    }
+    message.resize(t_size);
+    return message;
+}
+
+/**
+ * @brief Turns a frame back into its message like a reader does, header and payload separately.
+ * @param t_compressor The compressor of the reading side.
+ * @param t_frame The frame.
+ * @return The message.
+ * @version 1.0.0
+ */
+static std::string readFrame(Compressor &t_compressor, const std::string &t_frame)
+{
+    std::string header = t_frame.substr(0, HEADER_SIZE);
+    EXPECT_EQ(Compressor::getPayloadSize(header), t_frame.size() - HEADER_SIZE);
+    std::string message;
+    t_compressor.decompress(header, t_frame.substr(HEADER_SIZE), message);
+    return message;
+}
+
+/**
+ * @brief Runs the negotiation between two compressors, `t_client` offers and `t_server` answers.
+ * @param t_client The offering side.
+ * @param t_server The answering side.
+ * @param t_offeredMask If not negative, replaces the codecs the offer lists, as if the offering side had been built with those only.
+ * @version 1.0.0
+ */
+static void negotiate(Compressor &t_client, Compressor &t_server, const int t_offeredMask = -1)
+{
+    std::string offer = t_client.createOffer();
+    ASSERT_TRUE(Compressor::isOffer(offer.substr(0, HEADER_SIZE)));
+    ASSERT_EQ(Compressor::getPayloadSize(offer.substr(0, HEADER_SIZE)), offer.size() - HEADER_SIZE);
+    if (t_offeredMask >= 0)
+    {
+        offer[HEADER_SIZE + 1] = static_cast<char>(t_offeredMask);
+    }
+    std::string answer = t_server.answerOffer(offer.substr(HEADER_SIZE));
+    ASSERT_TRUE(Compressor::isOffer(answer.substr(0, HEADER_SIZE)));
+    t_client.acceptAnswer(answer.substr(HEADER_SIZE));
+}
+
+/**
+ * @brief Runs the tests that depend on a codec once for every codec.
+ * @version 1.0.0
+ */
+class CodecTest : public ::testing::TestWithParam<CompressionCodec>
+{
+protected:
+    void SetUp() override
+    {
+        if (!Compressor::isAvailable(GetParam()))
+        {
+            GTEST_SKIP() << "The codec was not found at build time.";
+        }
+    }
+};
+
+TEST(Compression, UncompressedFramesRoundTrip)
+{
+    Compressor client;
+    Compressor server;
+    negotiate(client, server);
+    EXPECT_EQ(client.getCodec(), CompressionCodec::NONE);
+    EXPECT_EQ(server.getCodec(), CompressionCodec::NONE);
+    for (const std::string &message : {std::string(""), std::string("short"), getCompressibleMessage(4096)})
+    {
+        std::string frame;
+        client.compress(message, frame);
+        EXPECT_EQ(frame.size(), HEADER_SIZE + message.size());
+        EXPECT_EQ(readFrame(server, frame), message);
+    }
+}
+
+TEST_P(CodecTest, CompressedFramesRoundTrip)
+{
+    CompressionOptions options;
+    options.codec = GetParam();
+    Compressor client(options);
+    Compressor server(options);
+    negotiate(client, server);
+    ASSERT_EQ(client.getCodec(), GetParam());
+    ASSERT_EQ(server.getCodec(), GetParam());
+    std::string frame;
+    for (size_t size : {size_t{1}, size_t{63}, size_t{64}, size_t{4096}, size_t{1} << 20})
+    {
+        std::string message = getCompressibleMessage(size);
+        client.compress(message, frame);
+        if (size >= 4096)
+        {
+            EXPECT_LT(frame.size(), message.size() / 2) << "size " << size;
+        }
+        EXPECT_EQ(readFrame(server, frame), message) << "size " << size;
+        server.compress(message, frame);
+        EXPECT_EQ(readFrame(client, frame), message) << "size " << size;
+    }
+}
+
+TEST_P(CodecTest, FallsBackWhenTheOtherSideLacksTheCodec)
+{
+    CompressionOptions options;
+    options.codec = GetParam();
+    Compressor client(options);
+    Compressor server(options);
+    negotiate(client, server, 0);
+    EXPECT_EQ(client.getCodec(), CompressionCodec::NONE);
+    EXPECT_EQ(server.getCodec(), CompressionCodec::NONE);
+    std::string message = getCompressibleMessage(4096);
+    std::string frame;
+    client.compress(message, frame);
+    EXPECT_EQ(frame.size(), HEADER_SIZE + message.size());
+    EXPECT_EQ(readFrame(server, frame), message);
+    server.compress(message, frame);
+    EXPECT_EQ(readFrame(client, frame), message);
+}
+
+TEST(Compression, FallsBackWhenTheAnsweringSideWantsNoCompression)
+{
+    CompressionOptions options;
+    options.codec = Compressor::isAvailable(CompressionCodec::ZSTD) ? CompressionCodec::ZSTD : CompressionCodec::NONE;
+    Compressor client(options);
+    Compressor server;
+    negotiate(client, server);
+    EXPECT_EQ(client.getCodec(), CompressionCodec::NONE);
+    EXPECT_EQ(server.getCodec(), CompressionCodec::NONE);
+}
+
+TEST(Compression, RejectsMissingCodecs)
+{
+    for (CompressionCodec codec : {CompressionCodec::LZ4, CompressionCodec::ZSTD})
+    {
+        if (Compressor::isAvailable(codec))
+        {
+            continue;
+        }
+        CompressionOptions options;
+        options.codec = codec;
+        EXPECT_THROW(Compressor{options}, FBNetwork::InvalidArgumentException);
+
+        // An answer or a frame of a codec this build lacks is refused instead of being misread
+
+        Compressor  compressor;
+        std::string answer = compressor.createOffer().substr(HEADER_SIZE);
+        answer[0]          = static_cast<char>(codec);
+        EXPECT_THROW(compressor.acceptAnswer(answer), FBNetwork::InvalidArgumentException);
+        std::string frame;
+        compressor.compress("message", frame);
+        frame[0] = static_cast<char>(codec);
+        std::string message;
+        EXPECT_THROW(compressor.decompress(frame.substr(0, HEADER_SIZE), frame.substr(HEADER_SIZE), message),
+                     FBNetwork::InvalidArgumentException);
+    }
+}
+
+TEST(Compression, RejectsMalformedFrames)
+{
+    Compressor compressor;
+    EXPECT_THROW(Compressor::getPayloadSize("short"), FBNetwork::InvalidArgumentException);
+    EXPECT_THROW(Compressor::getPayloadSize(std::string(HEADER_SIZE, '\x7f')), FBNetwork::InvalidArgumentException);
+    EXPECT_THROW(compressor.answerOffer("x"), FBNetwork::InvalidArgumentException);
+    std::string answer = compressor.createOffer().substr(HEADER_SIZE);
+    answer[5]          = 7;
+    EXPECT_THROW(compressor.acceptAnswer(answer), FBNetwork::InvalidArgumentException);
+}
+
+INSTANTIATE_TEST_SUITE_P(Codecs, CodecTest, ::testing::Values(CompressionCodec::LZ4, CompressionCodec::ZSTD),
+                         [](const ::testing::TestParamInfo<CompressionCodec> &t_info)
+                         { return t_info.param == CompressionCodec::LZ4 ? "LZ4" : "ZSTD"; });
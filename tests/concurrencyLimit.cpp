@@ -0,0 +1,120 @@
+#include "../include/concurrencyLimit.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+
+using FBNetwork::ConcurrencyAlgorithm;
+using FBNetwork::ConcurrencyLimit;
+using FBNetwork::ConcurrencyLimitOptions;
+using std::chrono::milliseconds;
+
+/**
+ * @brief Creates the options of an AIMD limit with a latency threshold of 10 ms.
+ * @param t_initialLimit The initial limit.
+ * @return The options.
+ * @version 1.0.0
+ */
+static ConcurrencyLimitOptions getAimdOptions(const double t_initialLimit)
+{
+    ConcurrencyLimitOptions options;
+    options.algorithm        = ConcurrencyAlgorithm::AIMD;
+    options.initialLimit     = t_initialLimit;
+    options.latencyThreshold = milliseconds(10);
+    return options;
+}
+
+TEST(ConcurrencyLimit, TryAcquireStopsAtTheLimit)
+{
+    ConcurrencyLimit limit(getAimdOptions(4));
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(limit.tryAcquire()) << "request " << i;
+    }
+    EXPECT_TRUE(limit.isSaturated());
+    EXPECT_FALSE(limit.tryAcquire());
+    EXPECT_EQ(limit.getInFlight(), 4U);
+    limit.release(milliseconds(1));
+    EXPECT_TRUE(limit.tryAcquire());
+}
+
+TEST(ConcurrencyLimit, AimdGrowsOnlyWhileTheLimitIsUsed)
+{
+    ConcurrencyLimit limit(getAimdOptions(10));
+    limit.acquire();
+    limit.release(milliseconds(1));
+    EXPECT_EQ(limit.getLimit(), 10U);
+    for (int i = 0; i < 7; i++)
+    {
+        limit.acquire();
+    }
+    limit.release(milliseconds(1));
+    EXPECT_EQ(limit.getLimit(), 11U);
+    limit.release(milliseconds(1));
+    EXPECT_EQ(limit.getLimit(), 12U);
+}
+
+TEST(ConcurrencyLimit, AimdBacksOffOnSlowOrDroppedRequests)
+{
+    ConcurrencyLimit limit(getAimdOptions(10));
+    limit.acquire();
+    limit.release(milliseconds(20));
+    EXPECT_EQ(limit.getLimit(), 9U);
+    limit.acquire();
+    limit.release(milliseconds(1), true);
+    EXPECT_EQ(limit.getLimit(), 8U);
+    for (int i = 0; i < 100; i++)
+    {
+        limit.acquire();
+        limit.release(milliseconds(1), true);
+    }
+    EXPECT_EQ(limit.getLimit(), 1U);
+    EXPECT_EQ(limit.getInFlight(), 0U);
+}
+
+TEST(ConcurrencyLimit, GradientShrinksWhenTheLatencyRises)
+{
+    ConcurrencyLimit limit;
+    for (int i = 0; i < 100; i++)
+    {
+        limit.acquire();
+        limit.release(milliseconds(1));
+    }
+    EXPECT_EQ(limit.getLimit(), 20U);
+    size_t previousLimit = limit.getLimit();
+    for (int i = 0; i < 20; i++)
+    {
+        limit.acquire();
+        limit.release(milliseconds(10));
+        EXPECT_LE(limit.getLimit(), previousLimit) << "sample " << i;
+        previousLimit = limit.getLimit();
+    }
+    EXPECT_LT(limit.getLimit(), 12U);
+}
+
+TEST(ConcurrencyLimit, GradientGrowsWhileUsedAtAStableLatency)
+{
+    ConcurrencyLimit limit;
+    for (int i = 0; i < 20; i++)
+    {
+        limit.acquire();
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        limit.acquire();
+        limit.release(milliseconds(1));
+    }
+    EXPECT_GT(limit.getLimit(), 20U);
+    EXPECT_EQ(limit.getInFlight(), 20U);
+}
+
+TEST(ConcurrencyLimit, RejectsInvalidOptions)
+{
+    ConcurrencyLimitOptions options;
+    options.minimumLimit = 0;
+    EXPECT_THROW(ConcurrencyLimit{options}, FBNetwork::InvalidArgumentException);
+    options              = ConcurrencyLimitOptions();
+    options.initialLimit = 2000;
+    EXPECT_THROW(ConcurrencyLimit{options}, FBNetwork::InvalidArgumentException);
+    options              = ConcurrencyLimitOptions();
+    options.backoffRatio = 1;
+    EXPECT_THROW(ConcurrencyLimit{options}, FBNetwork::InvalidArgumentException);
+}
@@ -0,0 +1,75 @@
+#include "../include/latencyHistogram.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+
+using FBNetwork::LatencyHistogram;
+
+TEST(LatencyHistogram, SmallValuesHaveTheirOwnBucket)
+{
+    for (uint64_t value = 0; value < LatencyHistogram::SUB_BUCKET_COUNT; value++)
+    {
+        EXPECT_EQ(LatencyHistogram::getBucketIndex(value), value);
+        EXPECT_EQ(LatencyHistogram::getBucketUpperBound(value), value);
+    }
+}
+
+TEST(LatencyHistogram, BucketsAreContiguous)
+{
+
+    // Every bucket starts right after the upper bound of the one before, so no value falls between two buckets
+
+    for (size_t index = 0; index + 1 < LatencyHistogram::BUCKET_COUNT - 1; index++)
+    {
+        uint64_t upperBound = LatencyHistogram::getBucketUpperBound(index);
+        EXPECT_EQ(LatencyHistogram::getBucketIndex(upperBound), index) << "index " << index;
+        EXPECT_EQ(LatencyHistogram::getBucketIndex(upperBound + 1), index + 1) << "index " << index;
+    }
+}
+
+TEST(LatencyHistogram, RelativeErrorIsBounded)
+{
+    for (uint64_t value = 1; value < (uint64_t{1} << 40); value = value * 3 / 2 + 1)
+    {
+        uint64_t upperBound = LatencyHistogram::getBucketUpperBound(LatencyHistogram::getBucketIndex(value));
+        EXPECT_GE(upperBound, value);
+        EXPECT_LT(static_cast<double>(upperBound - value) / static_cast<double>(value), 1.0 / LatencyHistogram::SUB_BUCKET_COUNT);
+    }
+}
+
+TEST(LatencyHistogram, HugeValuesGoToTheLastBucket)
+{
+    EXPECT_EQ(LatencyHistogram::getBucketIndex(uint64_t{1} << 50), LatencyHistogram::BUCKET_COUNT - 1);
+    EXPECT_EQ(LatencyHistogram::getBucketIndex(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyHistogram, SnapshotCountsAndPercentiles)
+{
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 1000; value++)
+    {
+        histogram.record(value * 1000);
+    }
+    FBNetwork::HistogramSnapshot snapshot = histogram.getSnapshot();
+    EXPECT_EQ(snapshot.count, 1000U);
+    EXPECT_EQ(snapshot.maximum, 1000000U);
+    EXPECT_DOUBLE_EQ(snapshot.getMean(), 500500.0);
+    EXPECT_NEAR(static_cast<double>(snapshot.getPercentile(50)), 500000.0, 500000.0 / LatencyHistogram::SUB_BUCKET_COUNT);
+    EXPECT_NEAR(static_cast<double>(snapshot.getPercentile(99)), 990000.0, 990000.0 / LatencyHistogram::SUB_BUCKET_COUNT);
+    EXPECT_EQ(snapshot.getPercentile(100), 1000000U);
+    EXPECT_EQ(FBNetwork::HistogramSnapshot().getPercentile(50), 0U);
+}
+
+TEST(LatencyHistogram, CountAtOrBelowIsExactAtBucketEdges)
+{
+    LatencyHistogram histogram;
+    for (uint64_t value : {999, 1000, 1005, 1007, 1008})
+    {
+        histogram.record(value);
+    }
+    FBNetwork::HistogramSnapshot snapshot = histogram.getSnapshot();
+    uint64_t                     edge     = LatencyHistogram::getBucketUpperBound(LatencyHistogram::getBucketIndex(1000));
+    EXPECT_EQ(edge, 1007U);
+    EXPECT_EQ(snapshot.getCountAtOrBelow(edge), 4U);
+    EXPECT_EQ(snapshot.getCountAtOrBelow(edge + 1), 4U);
+    EXPECT_EQ(snapshot.getCountAtOrBelow(UINT64_MAX), 5U);
+}
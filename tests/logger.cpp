@@ -0,0 +1,111 @@
+#include "../include/logger.hpp"
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using FBNetwork::LogEntry;
+using FBNetwork::Logger;
+using FBNetwork::LogLevel;
+
+/**
+ * @brief Represents a logger without a file whose entries are collected in memory.
+ * @version 1.0.0
+ */
+class LoggerFixture : public ::testing::Test
+{
+protected:
+    std::mutex              mutex;
+    std::vector<LogEntry>   entries;
+    std::unique_ptr<Logger> logger;
+
+    /**
+     * @brief Creates the logger.
+     * @param t_capacity The capacity of its ring.
+     * @version 1.0.0
+     */
+    void createLogger(const size_t t_capacity)
+    {
+        logger = std::make_unique<Logger>("", t_capacity);
+        logger->setDatabaseWriter(
+            [this](const std::vector<LogEntry> &t_entries)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                entries.insert(entries.end(), t_entries.begin(), t_entries.end());
+            });
+    }
+};
+
+TEST_F(LoggerFixture, WritesEntriesInOrder)
+{
+    createLogger(64);
+    EXPECT_TRUE(logger->info("test", "first"));
+    EXPECT_TRUE(logger->warning("test", "second"));
+    EXPECT_TRUE(logger->error("other", "third"));
+    logger->flush();
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(entries.size(), 3U);
+    EXPECT_EQ(entries[0].type, Logger::getLevelName(LogLevel::INFO));
+    EXPECT_EQ(entries[0].message, "first");
+    EXPECT_EQ(entries[1].type, Logger::getLevelName(LogLevel::WARNING));
+    EXPECT_EQ(entries[2].source, "other");
+    EXPECT_EQ(entries[2].message, "third");
+    EXPECT_EQ(logger->getStatistics().written, 3U);
+}
+
+TEST_F(LoggerFixture, CountsDroppedEntriesWhenTheRingIsFull)
+{
+
+    // The background thread drains concurrently, so how many entries fit varies, but every entry is either written or dropped
+
+    createLogger(2);
+    uint64_t accepted = 0;
+    uint64_t refused  = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        (logger->info("test", std::to_string(i)) ? accepted : refused)++;
+    }
+    logger->flush();
+    FBNetwork::LoggerStatistics statistics = logger->getStatistics();
+    EXPECT_GT(refused, 0U);
+    EXPECT_EQ(statistics.dropped, refused);
+    EXPECT_EQ(statistics.written, accepted);
+    EXPECT_EQ(statistics.rateLimited, 0U);
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(entries.size(), accepted);
+}
+
+TEST_F(LoggerFixture, CountsRateLimitedEntriesPerLevel)
+{
+    createLogger(64);
+    logger->setRateLimit(LogLevel::INFO, 1, 3);
+    int accepted = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        accepted += logger->info("test", "limited") ? 1 : 0;
+    }
+    EXPECT_EQ(accepted, 3);
+    EXPECT_TRUE(logger->error("test", "not limited"));
+    logger->flush();
+    FBNetwork::LoggerStatistics statistics = logger->getStatistics();
+    EXPECT_EQ(statistics.rateLimited, 7U);
+    EXPECT_EQ(statistics.written, 4U);
+    EXPECT_EQ(statistics.dropped, 0U);
+}
+
+TEST_F(LoggerFixture, CountsFailedWrites)
+{
+    createLogger(64);
+    logger->setDatabaseWriter([](const std::vector<LogEntry> &) { throw std::runtime_error("database is down"); });
+    EXPECT_TRUE(logger->info("test", "lost"));
+    logger->flush();
+    EXPECT_EQ(logger->getStatistics().writeErrors, 1U);
+}
+
+TEST(Logger, RejectsInvalidArguments)
+{
+    EXPECT_THROW(Logger("", 0), FBNetwork::InvalidArgumentException);
+    Logger logger("", 4);
+    EXPECT_THROW(logger.setRateLimit(LogLevel::INFO, 1, 0), FBNetwork::InvalidArgumentException);
+    EXPECT_THROW(logger.setFlushInterval(std::chrono::milliseconds(0)), FBNetwork::InvalidArgumentException);
+}
@@ -0,0 +1,198 @@
+#include "../include/rpc.hpp"
+#include "../include/server.hpp"
+#include "../include/taskPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using FBNetwork::RpcClient;
+using FBNetwork::RpcFrameType;
+
+static const int RPC_TEST_PORT = 47231;
+
+TEST(RpcFrame, RoundTripsTheHeader)
+{
+    for (RpcFrameType type : {RpcFrameType::REQUEST, RpcFrameType::RESPONSE, RpcFrameType::ERROR})
+    {
+        for (uint64_t correlationID : {uint64_t{0}, uint64_t{1}, uint64_t{0x0102030405060708}, UINT64_MAX})
+        {
+            std::string frame = RpcClient::encodeFrame(type, correlationID, "payload");
+            ASSERT_EQ(frame.size(), FBNetwork::Constants::RPC_FRAME_HEADER_SIZE + 7);
+            FBNetwork::RpcFrameHeader header = RpcClient::decodeHeader(frame.substr(0, FBNetwork::Constants::RPC_FRAME_HEADER_SIZE));
+            EXPECT_EQ(header.type, type);
+            EXPECT_EQ(header.correlationID, correlationID);
+            EXPECT_EQ(header.payloadSize, 7U);
+            EXPECT_EQ(frame.substr(FBNetwork::Constants::RPC_FRAME_HEADER_SIZE), "payload");
+        }
+    }
+}
+
+TEST(RpcFrame, RejectsMalformedHeaders)
+{
+    std::string header = RpcClient::encodeFrame(RpcFrameType::REQUEST, 1, "");
+    EXPECT_THROW(RpcClient::decodeHeader(header.substr(1)), FBNetwork::InvalidArgumentException);
+    header[0] = 3;
+    EXPECT_THROW(RpcClient::decodeHeader(header), FBNetwork::InvalidArgumentException);
+    header = RpcClient::encodeFrame(RpcFrameType::REQUEST, 1, "");
+    header[9] = '\x7f';
+    EXPECT_THROW(RpcClient::decodeHeader(header), FBNetwork::InvalidArgumentException);
+}
+
+TEST(RpcClient, MatchesOutOfOrderResponsesToTheirCalls)
+{
+    std::signal(SIGPIPE, SIG_IGN);
+    FBNetwork::Server server(FBNetwork::Domain::IPV4_DOMAIN, RPC_TEST_PORT, 4);
+    server.setTimeout({5, 0});
+    server.startServer();
+    server.startListening();
+    const size_t callCount = 8;
+
+    // The server collects every request first and answers them in reverse order, the last one with an error
+
+    std::thread serverThread(
+        [&server, callCount]()
+        {
+            std::vector<std::pair<uint64_t, std::string>> requests;
+            int                                           clientID = -1;
+            while (requests.size() < callCount)
+            {
+                for (const FBNetwork::eventTuple &event : server.getPendingEvents())
+                {
+                    if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_CONNECT)
+                    {
+                        server.acceptAll();
+                    }
+                    else if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA)
+                    {
+                        clientID              = std::get<1>(event);
+                        uint64_t correlationID = server.readRpcRequest(clientID);
+                        requests.emplace_back(correlationID, server.getData(clientID));
+                    }
+                }
+            }
+            for (size_t i = requests.size(); i-- > 0;)
+            {
+                if (requests[i].second == "request 0")
+                {
+                    server.sendRpcError(clientID, requests[i].first, "refused");
+                    continue;
+                }
+                server.sendRpcResponse(clientID, requests[i].first, "response to " + requests[i].second);
+            }
+        });
+
+    auto client = std::make_shared<FBNetwork::Client>(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", RPC_TEST_PORT);
+    client->setTimeout({5, 0});
+    client->connectToServer();
+    RpcClient                             rpcClient(client);
+    std::vector<std::future<std::string>> responses;
+    for (size_t i = 0; i < callCount; i++)
+    {
+        responses.push_back(rpcClient.call("request " + std::to_string(i), std::chrono::milliseconds(5000)));
+    }
+    std::future<std::string> unanswered = rpcClient.call("never answered", std::chrono::milliseconds(50));
+    serverThread.join();
+    EXPECT_THROW(responses[0].get(), FBNetwork::ClientRuntimeException);
+    for (size_t i = 1; i < callCount; i++)
+    {
+        EXPECT_EQ(responses[i].get(), "response to request " + std::to_string(i));
+    }
+    EXPECT_THROW(unanswered.get(), FBNetwork::ClientTimeoutException);
+    EXPECT_EQ(rpcClient.getPendingCount(), 0U);
+    rpcClient.close();
+    server.stopServer();
+}
+
+TEST(RpcClient, DispatchRpcAnswersAHandlerThatThrowsAnything)
+{
+    std::signal(SIGPIPE, SIG_IGN);
+    FBNetwork::Server server(FBNetwork::Domain::IPV4_DOMAIN, RPC_TEST_PORT + 1, 4);
+    server.setTimeout({5, 0});
+    server.startServer();
+    server.startListening();
+    auto concurrencyLimit = std::make_shared<FBNetwork::ConcurrencyLimit>();
+    server.setConcurrencyLimit(concurrencyLimit);
+    FBNetwork::TaskPool taskPool(2);
+    std::atomic<bool>   isRunning{true};
+
+    // A handler that throws something other than an exception must still release its slot and fail only its own call
+
+    std::thread serverThread(
+        [&]()
+        {
+            while (isRunning.load())
+            {
+                for (const FBNetwork::eventTuple &event : server.getPendingEvents())
+                {
+                    int clientID = std::get<1>(event);
+                    if (std::get<0>(event) == FBNetwork::EventType::CLIENT_WANTS_TO_CONNECT)
+                    {
+                        server.acceptAll();
+                        continue;
+                    }
+                    try
+                    {
+                        uint64_t    correlationID = server.readRpcRequest(clientID);
+                        std::string request       = server.getData(clientID);
+                        server.dispatchRpc(taskPool, clientID, correlationID,
+                                           [request]() -> std::string
+                                           {
+                                               if (request == "throw")
+                                               {
+                                                   throw 42;
+                                               }
+                                               return "response to " + request;
+                                           });
+                    }
+                    catch (const std::exception &)
+                    {
+                        server.closeClient(clientID);
+                    }
+                }
+            }
+        });
+
+    auto client = std::make_shared<FBNetwork::Client>(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", RPC_TEST_PORT + 1);
+    client->setTimeout({5, 0});
+    client->connectToServer();
+    RpcClient                rpcClient(client);
+    std::future<std::string> failed   = rpcClient.call("throw", std::chrono::milliseconds(5000));
+    std::future<std::string> answered = rpcClient.call("request", std::chrono::milliseconds(5000));
+    EXPECT_THROW(failed.get(), FBNetwork::ClientRuntimeException);
+    EXPECT_EQ(answered.get(), "response to request");
+    EXPECT_EQ(concurrencyLimit->getInFlight(), 0U);
+    isRunning.store(false);
+    rpcClient.close();
+    client->disconnectFromServer();
+    serverThread.join();
+    server.stopServer();
+}
+
+TEST(RpcServer, ReadRpcRequestKeepsTheHeaderOfAStalledFrame)
+{
+    std::signal(SIGPIPE, SIG_IGN);
+    FBNetwork::Server server(FBNetwork::Domain::IPV4_DOMAIN, RPC_TEST_PORT + 2, 4);
+    server.setTimeout({0, 200000});
+    server.startServer();
+    server.startListening();
+    FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", RPC_TEST_PORT + 2);
+    client.connectToServer();
+    int         clientID = server.acceptClient();
+    std::string frame    = RpcClient::encodeFrame(RpcFrameType::REQUEST, 7, "payload");
+
+    // The client stops between the header and the payload, the next read must start at the header again
+
+    client.sendData(frame.substr(0, FBNetwork::Constants::RPC_FRAME_HEADER_SIZE));
+    EXPECT_THROW(server.readRpcRequest(clientID), FBNetwork::ServerTimeoutException);
+    client.sendData(frame.substr(FBNetwork::Constants::RPC_FRAME_HEADER_SIZE));
+    EXPECT_EQ(server.readRpcRequest(clientID), 7U);
+    EXPECT_EQ(server.getData(clientID), "payload");
+    server.stopServer();
+}
@@ -0,0 +1,315 @@
+#include "../include/client.hpp"
+#include "../include/compression.hpp"
+#include "../include/server.hpp"
+#include "../include/taskPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <csignal>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+/**
+ * @brief Represents a started server on a loopback port with a short timeout.
+ * @version 1.0.0
+ */
+class ServerFixture : public ::testing::Test
+{
+protected:
+    static constexpr int PORT = 47241;
+
+    FBNetwork::Server server{FBNetwork::Domain::IPV4_DOMAIN, PORT, 4};
+
+    void SetUp() override
+    {
+        std::signal(SIGPIPE, SIG_IGN);
+        server.setTimeout({0, 200000});
+        server.startServer();
+        server.startListening();
+    }
+
+    void TearDown() override
+    {
+        server.stopServer();
+    }
+};
+
+TEST_F(ServerFixture, AcceptClientTimesOutWithoutAConnection)
+{
+    auto start = steady_clock::now();
+    EXPECT_THROW(server.acceptClient(), FBNetwork::ServerTimeoutException);
+    EXPECT_GE(steady_clock::now() - start, milliseconds(190));
+    EXPECT_LT(steady_clock::now() - start, milliseconds(2000));
+}
+
+TEST_F(ServerFixture, AcceptClientReturnsAWaitingConnection)
+{
+    FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+    client.connectToServer();
+    int clientID = server.acceptClient();
+    EXPECT_EQ(clientID, 0);
+    EXPECT_NO_THROW(server.getClientMetrics(clientID));
+    EXPECT_THROW(server.getClientMetrics(clientID + 1), std::out_of_range);
+    EXPECT_THROW(server.getClientMetrics(-1), std::out_of_range);
+}
+
+TEST_F(ServerFixture, AcceptClientDoesNotWaitAfterARejectedConnection)
+{
+    FBNetwork::RateLimits rateLimits;
+    rateLimits.connectionsPerSecond = 0.1;
+    rateLimits.connectionsBurst     = 1;
+    server.setRateLimits(rateLimits);
+    server.setTimeout({5, 0});
+    FBNetwork::Client first(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+    FBNetwork::Client second(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+    first.connectToServer();
+    second.connectToServer();
+    EXPECT_EQ(server.acceptClient(), 0);
+    auto start = steady_clock::now();
+    EXPECT_THROW(server.acceptClient(), FBNetwork::ServerRuntimeException);
+    EXPECT_LT(steady_clock::now() - start, milliseconds(1000));
+    EXPECT_EQ(server.getMetrics().rejectedAccepts, 1U);
+}
+
+/**
+ * @brief Waits for the next event of a client.
+ * @param t_server The server.
+ * @param t_clientID The ID of the client.
+ * @return The type of the event.
+ * @version 1.0.0
+ */
+static FBNetwork::EventType waitForEvent(FBNetwork::Server &t_server, const int t_clientID)
+{
+    while (true)
+    {
+        for (const FBNetwork::eventTuple &event : t_server.getPendingEvents())
+        {
+            if (std::get<1>(event) == t_clientID)
+            {
+                return std::get<0>(event);
+            }
+        }
+    }
+}
+
+TEST_F(ServerFixture, ReadDeadlineDoesNotRunBeforeAMessageStarts)
+{
+    server.setReadTimeout(milliseconds(200));
+    FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+    client.connectToServer();
+    int clientID = server.acceptClient();
+    std::this_thread::sleep_for(milliseconds(400));
+    client.sendData("hello");
+    ASSERT_EQ(waitForEvent(server, clientID), FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA);
+    server.readXData(clientID, 5);
+    EXPECT_EQ(server.getData(clientID), "hello");
+
+    // The next message gets its own deadline, even though the connection is older than the read timeout
+
+    std::this_thread::sleep_for(milliseconds(300));
+    client.sendData("world");
+    ASSERT_EQ(waitForEvent(server, clientID), FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA);
+    server.readXData(clientID, 5);
+    EXPECT_EQ(server.getData(clientID), "world");
+}
+
+TEST_F(ServerFixture, ReadDeadlineClosesAClientThatStopsInAMessage)
+{
+    server.setTimeout({0, 20000});
+    server.setReadTimeout(milliseconds(200));
+    FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+    client.connectToServer();
+    int clientID = server.acceptClient();
+    client.sendData("he");
+    ASSERT_EQ(waitForEvent(server, clientID), FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA);
+    auto            start = steady_clock::now();
+    std::error_code error;
+    server.readXData(clientID, 5, error);
+    EXPECT_EQ(error, FBNetwork::NetworkError::TIMEOUT);
+    EXPECT_EQ(waitForEvent(server, clientID), FBNetwork::EventType::CLIENT_TIMED_OUT);
+    EXPECT_GE(steady_clock::now() - start, milliseconds(150));
+    EXPECT_LT(steady_clock::now() - start, milliseconds(1000));
+}
+
+/**
+ * @brief Creates a payload larger than the socket buffers of a loopback connection.
+ * @return The payload, a repeating pattern so misplaced bytes are detected.
+ * @version 1.0.0
+ */
+static std::string makeLargePayload()
+{
+    std::string payload(32 << 20, '\0');
+    for (size_t i = 0; i < payload.size(); i++)
+    {
+        payload[i] = static_cast<char>('a' + i % 26);
+    }
+    return payload;
+}
+
+TEST_F(ServerFixture, SendDataQueuesBehindABroadcast)
+{
+    server.setTimeout({5, 0});
+    server.setOutputQueueLimit(64 << 20, FBNetwork::SlowClientPolicy::DROP_MESSAGE);
+    FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+    client.setTimeout({5, 0});
+    client.connectToServer();
+    int         clientID = server.acceptClient();
+    std::string payload  = makeLargePayload();
+    EXPECT_EQ(server.broadcast(std::make_shared<const std::string>(payload)), 1U);
+    ASSERT_GT(server.getQueuedBytes(clientID), 0U);
+    server.sendData(clientID, "tail");
+
+    // The event loop writes the rest of the queue when the client makes room
+
+    std::atomic<bool> isRunning{true};
+    std::thread       eventLoop([&]() {
+        while (isRunning.load())
+        {
+            server.getPendingEvents();
+        }
+    });
+    client.readXData(static_cast<ssize_t>(payload.size()) + 4);
+    std::string data = client.getData();
+
+    // Posted tasks do not end a wait for events, the disconnect does
+
+    isRunning.store(false);
+    client.disconnectFromServer();
+    eventLoop.join();
+    EXPECT_TRUE(data == payload + "tail");
+}
+
+TEST_F(ServerFixture, SendFileWritesTheQueuedPayloadsFirst)
+{
+    server.setTimeout({5, 0});
+    FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+    client.setTimeout({5, 0});
+    client.connectToServer();
+    int         clientID = server.acceptClient();
+    std::string payload  = makeLargePayload();
+    std::string filePath = "/tmp/fbnetwork-test-" + std::to_string(getpid()) + ".txt";
+    FILE       *file     = std::fopen(filePath.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    std::fputs("file", file);
+    std::fclose(file);
+    EXPECT_EQ(server.broadcast(std::make_shared<const std::string>(payload)), 1U);
+    ASSERT_GT(server.getQueuedBytes(clientID), 0U);
+    std::thread sender([&]() { server.sendFile(clientID, filePath); });
+    client.readXData(static_cast<ssize_t>(payload.size()) + 4);
+    sender.join();
+    std::remove(filePath.c_str());
+    EXPECT_TRUE(client.getData() == payload + "file");
+}
+
+TEST_F(ServerFixture, DispatchRejectsHandlersAboveTheConcurrencyLimit)
+{
+    FBNetwork::ConcurrencyLimitOptions options;
+    options.initialLimit  = 1;
+    options.maximumLimit  = 1;
+    auto concurrencyLimit = std::make_shared<FBNetwork::ConcurrencyLimit>(options);
+    server.setConcurrencyLimit(concurrencyLimit);
+    FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+    client.connectToServer();
+    int                      clientID = server.acceptClient();
+    FBNetwork::TaskPool      taskPool(1);
+    std::promise<void>       unblock;
+    std::shared_future<void> isUnblocked = unblock.get_future().share();
+    server.dispatch(taskPool, clientID,
+                    [isUnblocked]()
+                    {
+                        isUnblocked.wait();
+                        return std::string();
+                    });
+    EXPECT_THROW(server.dispatch(taskPool, clientID, []() { return std::string("rejected"); }), FBNetwork::ServerRuntimeException);
+    EXPECT_EQ(concurrencyLimit->getInFlight(), 1U);
+    EXPECT_EQ(server.getMetrics().shedRequests, 1U);
+    unblock.set_value();
+}
+
+TEST_F(ServerFixture, ReadCompressedDataKeepsTheHeaderOfAStalledFrame)
+{
+    FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+    client.connectToServer();
+    int                   clientID = server.acceptClient();
+    FBNetwork::Compressor compressor;
+    std::string           frame;
+    compressor.compress("hello", frame);
+    client.sendData(frame.substr(0, FBNetwork::Constants::COMPRESSION_FRAME_HEADER_SIZE));
+    ASSERT_EQ(waitForEvent(server, clientID), FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA);
+    EXPECT_THROW(server.readCompressedData(clientID), FBNetwork::ServerTimeoutException);
+    client.sendData(frame.substr(FBNetwork::Constants::COMPRESSION_FRAME_HEADER_SIZE));
+    ASSERT_EQ(waitForEvent(server, clientID), FBNetwork::EventType::CLIENT_WANTS_TO_SEND_DATA);
+    server.readCompressedData(clientID);
+    EXPECT_EQ(server.getData(clientID), "hello");
+}
+
+TEST_F(ServerFixture, ClientReadCompressedDataKeepsTheHeaderOfAStalledFrame)
+{
+    FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+    client.setTimeout({0, 200000});
+    client.connectToServer();
+    int                   clientID = server.acceptClient();
+    FBNetwork::Compressor compressor;
+    std::string           frame;
+    compressor.compress("hello", frame);
+    server.sendData(clientID, frame.substr(0, FBNetwork::Constants::COMPRESSION_FRAME_HEADER_SIZE));
+    EXPECT_THROW(client.readCompressedData(), FBNetwork::ClientTimeoutException);
+    server.sendData(clientID, frame.substr(FBNetwork::Constants::COMPRESSION_FRAME_HEADER_SIZE));
+    client.readCompressedData();
+    EXPECT_EQ(client.getData(), "hello");
+}
+
+TEST_F(ServerFixture, CloseClientReleasesTheIDOnceWhenThreadsRace)
+{
+    for (int round = 0; round < 20; round++)
+    {
+        FBNetwork::Client client(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+        client.connectToServer();
+        int                      clientID = server.acceptClient();
+        std::atomic<int>         readyClosers{0};
+        std::vector<std::thread> closers;
+        for (int i = 0; i < 4; i++)
+        {
+            closers.emplace_back(
+                [this, clientID, &readyClosers]()
+                {
+                    readyClosers++;
+                    while (readyClosers.load() < 4)
+                    {
+                        std::this_thread::yield();
+                    }
+                    server.closeClient(clientID);
+                });
+        }
+        for (std::thread &closer : closers)
+        {
+            closer.join();
+        }
+    }
+
+    // A double release would hand the same ID to both clients
+
+    FBNetwork::Client first(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+    FBNetwork::Client second(FBNetwork::Domain::IPV4_DOMAIN, "127.0.0.1", PORT);
+    first.connectToServer();
+    second.connectToServer();
+    EXPECT_NE(server.acceptClient(), server.acceptClient());
+    EXPECT_EQ(server.getMetrics().closes, 20U);
+}
+
+TEST(Server, TakeOverListenerTimesOutWithoutAHandOff)
+{
+    std::string       socketPath = "/tmp/fbnetwork-test-" + std::to_string(getpid()) + ".sock";
+    FBNetwork::Server server(FBNetwork::Domain::IPV4_DOMAIN, 0, 4);
+    server.setTimeout({0, 200000});
+    EXPECT_THROW(server.takeOverListener(socketPath), FBNetwork::ServerTimeoutException);
+    EXPECT_NE(access(socketPath.c_str(), F_OK), 0);
+}
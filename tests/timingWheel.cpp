@@ -0,0 +1,130 @@
+#include "../include/timingWheel.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace
+{
+    using milliseconds = std::chrono::milliseconds;
+
+    /**
+     * @brief Represents a timing wheel with a resolution of 1 ms and the time it was created at.
+     * @details The wheel takes its start time in its constructor, slightly before `start`, so a deadline of `start + k ms` expires
+     * between `start + k ms` and `start + (k + 1) ms`.
+     * @version 1.0.0
+     */
+    struct WheelFixture : public ::testing::Test
+    {
+        FBNetwork::TimingWheel                wheel{milliseconds(1)};
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        std::vector<int> advanceTo(const int64_t t_milliseconds)
+        {
+            std::vector<int> expiredKeys;
+            wheel.advance(start + milliseconds(t_milliseconds), expiredKeys);
+            return expiredKeys;
+        }
+
+        /**
+         * @brief Checks that a timer expires neither before its deadline nor more than one tick after it.
+         */
+        void expectExpiresAt(const int t_key, const int64_t t_deadline)
+        {
+            EXPECT_TRUE(advanceTo(t_deadline - 1).empty()) << "deadline " << t_deadline;
+            EXPECT_TRUE(wheel.isScheduled(t_key));
+            std::vector<int> expiredKeys = advanceTo(t_deadline + 1);
+            ASSERT_EQ(expiredKeys.size(), 1U) << "deadline " << t_deadline;
+            EXPECT_EQ(expiredKeys[0], t_key);
+            EXPECT_FALSE(wheel.isScheduled(t_key));
+        }
+    };
+}  // namespace
+
+TEST_F(WheelFixture, ExpiresOnTheFirstLevel)
+{
+    wheel.schedule(0, start + milliseconds(10));
+    EXPECT_EQ(wheel.getCount(), 1U);
+    expectExpiresAt(0, 10);
+    EXPECT_EQ(wheel.getCount(), 0U);
+}
+
+TEST_F(WheelFixture, CascadesFromEveryLevel)
+{
+
+    // One timer per level: below 64, below 64^2, below 64^3 and below 64^4 ticks
+
+    const int64_t deadlines[] = {50, 100, 5000, 300000};
+    for (int key = 0; key < 4; key++)
+    {
+        wheel.schedule(key, start + milliseconds(deadlines[key]));
+    }
+    EXPECT_EQ(wheel.getCount(), 4U);
+    for (int key = 0; key < 4; key++)
+    {
+        expectExpiresAt(key, deadlines[key]);
+    }
+    EXPECT_EQ(wheel.getCount(), 0U);
+}
+
+TEST_F(WheelFixture, ParksTimersBeyondTheSpan)
+{
+    const int64_t span = int64_t{1} << (FBNetwork::TimingWheel::SLOT_BITS * FBNetwork::TimingWheel::LEVEL_COUNT);
+    wheel.schedule(7, start + milliseconds(span + 1000));
+    expectExpiresAt(7, span + 1000);
+}
+
+TEST_F(WheelFixture, CancelsAfterCascade)
+{
+    wheel.schedule(3, start + milliseconds(5000));
+    wheel.schedule(4, start + milliseconds(5001));
+
+    // At 4096 ticks both timers have moved from the second level to the first one
+
+    EXPECT_TRUE(advanceTo(4200).empty());
+    EXPECT_TRUE(wheel.isScheduled(3));
+    wheel.cancel(3);
+    EXPECT_FALSE(wheel.isScheduled(3));
+    EXPECT_EQ(wheel.getCount(), 1U);
+    expectExpiresAt(4, 5001);
+    EXPECT_TRUE(advanceTo(10000).empty());
+    EXPECT_EQ(wheel.getCount(), 0U);
+}
+
+TEST_F(WheelFixture, ReschedulesAfterCascade)
+{
+    wheel.schedule(1, start + milliseconds(5000));
+    EXPECT_TRUE(advanceTo(4200).empty());
+    wheel.schedule(1, start + milliseconds(9000));
+    EXPECT_EQ(wheel.getCount(), 1U);
+    expectExpiresAt(1, 9000);
+}
+
+TEST_F(WheelFixture, ExpiresPastDeadlinesOnTheNextTick)
+{
+    advanceTo(100);
+    wheel.schedule(2, start + milliseconds(50));
+    std::vector<int> expiredKeys = advanceTo(102);
+    ASSERT_EQ(expiredKeys.size(), 1U);
+    EXPECT_EQ(expiredKeys[0], 2);
+}
+
+TEST_F(WheelFixture, ReportsTheNextExpiryNoLaterThanTheDeadline)
+{
+    EXPECT_EQ(wheel.getMillisecondsUntilNextExpiry(start), -1);
+    wheel.schedule(0, start + milliseconds(5000));
+    int wait = wheel.getMillisecondsUntilNextExpiry(start);
+    EXPECT_GE(wait, 0);
+    EXPECT_LE(wait, 5001);
+    wheel.schedule(1, start + milliseconds(20));
+    wait = wheel.getMillisecondsUntilNextExpiry(start);
+    EXPECT_GE(wait, 19);
+    EXPECT_LE(wait, 21);
+}
+
+TEST(TimingWheel, RejectsInvalidArguments)
+{
+    EXPECT_THROW(FBNetwork::TimingWheel(std::chrono::nanoseconds(0)), FBNetwork::InvalidArgumentException);
+    FBNetwork::TimingWheel wheel;
+    EXPECT_THROW(wheel.schedule(-1, std::chrono::steady_clock::now()), FBNetwork::InvalidArgumentException);
+    EXPECT_NO_THROW(wheel.cancel(42));
+}
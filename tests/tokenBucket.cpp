@@ -0,0 +1,73 @@
+#include "../include/tokenBucket.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+
+using FBNetwork::TokenBucket;
+using std::chrono::milliseconds;
+
+TEST(TokenBucket, StartsFullAndAllowsTheBurst)
+{
+    auto        now = std::chrono::steady_clock::now();
+    TokenBucket bucket(10, 5, now);
+    EXPECT_TRUE(bucket.isFull());
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_TRUE(bucket.tryConsume(1, now)) << "token " << i;
+    }
+    EXPECT_FALSE(bucket.tryConsume(1, now));
+    EXPECT_DOUBLE_EQ(bucket.getTokens(), 0.0);
+}
+
+TEST(TokenBucket, RefillsAtTheRateUpToTheBurst)
+{
+    auto        now = std::chrono::steady_clock::now();
+    TokenBucket bucket(10, 5, now);
+    EXPECT_TRUE(bucket.tryConsume(5, now));
+    bucket.refill(now + milliseconds(200));
+    EXPECT_NEAR(bucket.getTokens(), 2.0, 1e-9);
+    EXPECT_FALSE(bucket.tryConsume(3, now + milliseconds(200)));
+    EXPECT_TRUE(bucket.tryConsume(3, now + milliseconds(300)));
+    bucket.refill(now + milliseconds(60000));
+    EXPECT_DOUBLE_EQ(bucket.getTokens(), 5.0);
+    EXPECT_TRUE(bucket.isFull());
+}
+
+TEST(TokenBucket, IgnoresTimeGoingBackwards)
+{
+    auto        now = std::chrono::steady_clock::now();
+    TokenBucket bucket(10, 5, now);
+    EXPECT_TRUE(bucket.tryConsume(5, now));
+    bucket.refill(now - milliseconds(1000));
+    EXPECT_DOUBLE_EQ(bucket.getTokens(), 0.0);
+}
+
+TEST(TokenBucket, ConsumeMayGoIntoDebt)
+{
+    auto        now = std::chrono::steady_clock::now();
+    TokenBucket bucket(100, 10, now);
+
+    // A read larger than the bucket is charged after the fact, the debt delays the next one
+
+    bucket.consume(30);
+    EXPECT_DOUBLE_EQ(bucket.getTokens(), -20.0);
+    EXPECT_EQ(bucket.getTimeOf(1, now), now + milliseconds(210));
+    EXPECT_FALSE(bucket.tryConsume(1, now + milliseconds(200)));
+    EXPECT_TRUE(bucket.tryConsume(1, now + milliseconds(210)));
+}
+
+TEST(TokenBucket, UnlimitedBucketNeverRefuses)
+{
+    auto        now = std::chrono::steady_clock::now();
+    TokenBucket bucket;
+    EXPECT_TRUE(bucket.isFull());
+    EXPECT_TRUE(bucket.tryConsume(1e12, now));
+    EXPECT_EQ(bucket.getTimeOf(1e12, now), now);
+}
+
+TEST(TokenBucket, RejectsInvalidArguments)
+{
+    auto now = std::chrono::steady_clock::now();
+    EXPECT_THROW(TokenBucket(0, 5, now), FBNetwork::InvalidArgumentException);
+    EXPECT_THROW(TokenBucket(5, 0, now), FBNetwork::InvalidArgumentException);
+    EXPECT_THROW(TokenBucket(-1, 5, now), FBNetwork::InvalidArgumentException);
+}